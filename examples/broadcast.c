@@ -9,7 +9,7 @@ kbroadcast_t* broadcast = 0;
 int current_count = 0;
 int connector_count = MAX_CONNECTOR;
 
-/*  - ͻ˻ص */
+/* 服务端 - 客户端回调 */
 void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     if (e & channel_cb_event_close) {
         connector_count--;
@@ -23,25 +23,25 @@ void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
 void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {    
     char buffer[16] = {0};
     kstream_t* stream = knet_channel_ref_get_stream(channel);
-    if (e & channel_cb_event_recv) { /* ݿԶ */
+    if (e & channel_cb_event_recv) { /* 有数据可以读 */
         memset(buffer, 0, sizeof(buffer));
-        /* ȡ */
+        /* 读取 */
         knet_stream_pop(stream, buffer, sizeof(buffer));
         printf("recv: %s\n", buffer);
         knet_channel_ref_close(channel);
     }
 }
 
-/* ߻ص */
+/* 监听者回调 */
 void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
-    if (e & channel_cb_event_accept) { /*  */
-        /* ûص */
+    if (e & channel_cb_event_accept) { /* 新连接 */
+        /* 设置回调 */
         knet_channel_ref_set_cb(channel, client_cb);
         current_count++;
-        /* 뵽㲥 */
+        /* 加入到广播组 */
         knet_broadcast_join(broadcast, channel);
         if (current_count == MAX_CONNECTOR) {
-            /* ȫɣ㲥 */
+            /* 全部连接完成，广播 */
             knet_broadcast_write(broadcast, "hello world", 12);
         }
     }
@@ -4,34 +4,34 @@
 
 #include "knet.h"
 
-/* ͻ - ص */
+/* 客户端 - 连接器回调 */
 void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
-    if (e & channel_cb_event_connect_timeout) { /* ӳɹ */
+    if (e & channel_cb_event_connect_timeout) { /* 连接成功 */
         knet_channel_ref_close(channel);
-        /* ӳʱ˳ѭ */
+        /* 连接超时，退出循环 */
         knet_loop_exit(knet_channel_ref_get_loop(channel));
     } else if (e & channel_cb_event_close) {
-        /* ˳ѭ */
+        /* 发生错误，退出循环 */
         printf("connect failed!\n");
         knet_loop_exit(knet_channel_ref_get_loop(channel));
     }
 }
 
 int main() {
-    /* ѭ */
+    /* 创建循环 */
     kloop_t* loop = knet_loop_create();
-    /* ͻ */
+    /* 创建客户端 */
     kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, 1024);
-    /* ûص */
+    /* 设置回调 */
     knet_channel_ref_set_cb(connector, connector_cb);
-    /*  */
+    /* 连接 */
     if (error_ok != knet_channel_ref_connect(connector, "127.0.0.1", 8000, 2)) {
         printf("remote unreachable\n");
     } else {
-        /*  */
+        /* 启动 */
         knet_loop_run(loop);
     }
-    /* , connector, acceptorҪֶ */
+    /* 销毁, connector, acceptor不需要手动销毁 */
     knet_loop_destroy(loop);
     return 0;
 }
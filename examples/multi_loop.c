@@ -5,7 +5,7 @@
 #include "knet.h"
 
 /**
- 4߳+߳
+ 4线程+主线程
  */
 
 #define MAX_CLIENT 200
@@ -89,9 +89,9 @@ int main() {
     kloop_balancer_t* balancer = 0;
     int times = 0;
 
-    /* һؾ */
+    /* 建立一个负载均衡器 */
     balancer = knet_loop_balancer_create();
-    /* ̣߳ÿ߳һkloop_t */
+    /* 创建多个线程，每个线程运行一个kloop_t */
     for (i = 0; i < MAX_LOOP; i++) {
         sub_loop[i] = knet_loop_create();
         knet_loop_balancer_attach(balancer, sub_loop[i]);
@@ -108,7 +108,7 @@ int main() {
         printf("knet_channel_ref_accept failed: %d\n", error);
     }
     
-    /* β */
+    /* 多次测试 */
     for (; times < TEST_TIMES; times++) {
         total_connected = 0;
         recv_count = 0;
@@ -120,7 +120,7 @@ int main() {
             knet_channel_ref_connect(connector, "127.0.0.1", 80, 2);
         }
         while (client_count > 0) {
-            /* ߳ */
+            /* 主线程 */
             error = knet_loop_run_once(main_loop);
         }
         if (error != error_ok) {
@@ -0,0 +1,95 @@
+#include "example_config.h"
+
+#if COMPILE_SEND_FLUSH_BENCH
+
+#include "knet.h"
+#include "channel.h"
+#include "buffer.h"
+#include "misc.h"
+
+/**
+ 发送链表刷新开销: 聚集发送(一次sendmsg/WSASend) 与 逐个缓冲区调用send() 对比
+ */
+
+#define MSG_SIZE 64   /* 每个缓冲区字节数 */
+#define ROUNDS   1000 /* 每种队列深度的测试次数 */
+
+static const int depths[] = {1, 8, 32, 64, 200, 512, 1024};
+
+/* 读空对端 */
+void drain(socket_t fd) {
+    char buffer[16384];
+    while (socket_recv(fd, buffer, sizeof(buffer)) > 0);
+}
+
+/* 队列深度为depth时, 聚集发送一次刷新的平均耗时(微秒) */
+double bench_gather(socket_t pair[2], int depth) {
+    int         i       = 0;
+    int         j       = 0;
+    uint64_t    elapsed = 0;
+    uint64_t    start   = 0;
+    char        data[MSG_SIZE] = {0};
+    kbuffer_t*  buffer  = 0;
+    kchannel_t* channel = knet_channel_create_exist_socket_fd(pair[0], depth + 1, 1024);
+    for (i = 0; i < ROUNDS; i++) {
+        for (j = 0; j < depth; j++) {
+            buffer = knet_buffer_create(MSG_SIZE);
+            knet_buffer_put(buffer, data, MSG_SIZE);
+            knet_channel_send_buffer(channel, buffer);
+        }
+        start = time_get_microseconds();
+        knet_channel_update_send(channel);
+        elapsed += time_get_microseconds() - start;
+        drain(pair[1]);
+    }
+    knet_channel_destroy(channel);
+    return (double)elapsed / ROUNDS;
+}
+
+/* 队列深度为depth时, 逐个缓冲区调用send()刷新的平均耗时(微秒) */
+double bench_per_buffer(socket_t pair[2], int depth) {
+    int         i       = 0;
+    int         j       = 0;
+    uint64_t    elapsed = 0;
+    uint64_t    start   = 0;
+    char        data[MSG_SIZE] = {0};
+    kbuffer_t** buffers = (kbuffer_t**)malloc(sizeof(kbuffer_t*) * depth);
+    for (i = 0; i < ROUNDS; i++) {
+        for (j = 0; j < depth; j++) {
+            buffers[j] = knet_buffer_create(MSG_SIZE);
+            knet_buffer_put(buffers[j], data, MSG_SIZE);
+        }
+        start = time_get_microseconds();
+        for (j = 0; j < depth; j++) {
+            socket_send(pair[0], knet_buffer_get_ptr(buffers[j]), knet_buffer_get_length(buffers[j]));
+            knet_buffer_destroy(buffers[j]);
+        }
+        elapsed += time_get_microseconds() - start;
+        drain(pair[1]);
+    }
+    free(buffers);
+    return (double)elapsed / ROUNDS;
+}
+
+int main() {
+    int      i       = 0;
+    double   gather  = 0;
+    double   single  = 0;
+    socket_t pair[2] = {0};
+    printf("%8s %16s %16s %10s\n", "depth", "per-buffer(us)", "gather(us)", "syscalls");
+    for (i = 0; i < (int)(sizeof(depths) / sizeof(depths[0])); i++) {
+        if (socket_pair(pair)) {
+            printf("socket_pair() failed\n");
+            return 0;
+        }
+        socket_set_non_blocking_on(pair[1]);
+        single = bench_per_buffer(pair, depths[i]);
+        gather = bench_gather(pair, depths[i]);
+        printf("%8d %16.2f %16.2f %4d -> %d\n", depths[i], single, gather, depths[i],
+            (depths[i] + SOCKET_IOV_MAX - 1) / SOCKET_IOV_MAX);
+        socket_close(pair[1]);
+    }
+    return 0;
+}
+
+#endif /* COMPILE_SEND_FLUSH_BENCH */
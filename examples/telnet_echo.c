@@ -5,20 +5,20 @@
 #include "knet.h"
 
 /**
- telnet
+ telnet回显
  */
 
 kloop_t* loop = 0;
 
-/*  - ͻ˻ص */
+/* 服务端 - 客户端回调 */
 void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     int bytes = 0;
     char buffer[16] = {0};
     kstream_t* stream = knet_channel_ref_get_stream(channel);
-    if (e & channel_cb_event_recv) { /* ݿԶ */
+    if (e & channel_cb_event_recv) { /* 有数据可以读 */
         bytes = knet_stream_available(stream);
         memset(buffer, 0, sizeof(buffer));
-        /* ȡ */
+        /* 读取 */
         knet_stream_pop(stream, buffer, sizeof(buffer));
         if (*buffer == 'q') {
             printf("bye...\n");
@@ -31,11 +31,11 @@ void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     }
 }
 
-/* ߻ص */
+/* 监听者回调 */
 void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
-    if (e & channel_cb_event_accept) { /*  */
+    if (e & channel_cb_event_accept) { /* 新连接 */
         printf("telnet client accepted...\n");
-        /* ûص */
+        /* 设置回调 */
         knet_channel_ref_set_cb(channel, client_cb);
     }
 }
@@ -16,7 +16,7 @@ void ktimer_times_cb(ktimer_t* timer, void* data) {
     }
 }
 
-#define MAX_TIMES 10 /* ʱ */
+#define MAX_TIMES 10 /* 超时次数 */
 
 void ktimer_cb(ktimer_t* timer, void* data) {
     printf("peroid timer timeout\n");
@@ -27,11 +27,11 @@ int main() {
     ktimer_t* ktimer_once = ktimer_create(loop);
     ktimer_t* ktimer_period = ktimer_create(loop);
     ktimer_t* ktimer_times = ktimer_create(loop);
-    /* һִһεĶʱ */
+    /* 启动一个执行一次的定时器 */
     ktimer_start_once(ktimer_once, ktimer_once_cb, 0, 1000);
-    /* һִ޴εĶʱ */
+    /* 启动一个执行无限次的定时器 */
     ktimer_start(ktimer_period, ktimer_cb, 0, 1000);
-    /* һִ5εĶʱ */
+    /* 启动一个执行5次的定时器 */
     ktimer_start_times(ktimer_times, ktimer_times_cb, 0, 1000, MAX_TIMES);
     ktimer_loop_run(loop);
     return 0;
@@ -28,71 +28,71 @@
 #include "config.h"
 
 /**
- * @defgroup broadcast 㲥
- * 㲥
+ * @defgroup broadcast 广播
+ * 广播域
  *
  * <pre>
- * ܵԼ㲥򣬼ͨknet_broadcast_writeԷݵѾڵĹܵ.
- * knet_broadcast_createһ㲥knet_broadcast_destroyٹ㲥.
+ * 管道可以加入广播域，加入后通过knet_broadcast_write方法可以发送数据到所有已经加入域内的管道.
+ * 调用knet_broadcast_create创建一个广播域，knet_broadcast_destroy销毁广播域.
  *
- * knet_broadcast_joinһ㲥knet_broadcast_joinӼܵü,
- * knet_broadcast_leaveٹܵüӶkloop_tٹܵ.
+ * knet_broadcast_join加入一个广播域，knet_broadcast_join函数将增加加入管道的引用计数,调用
+ * knet_broadcast_leave减少管道的引用计数，从而可以让kloop_t真正销毁管道.
  *
- * knet_broadcast_get_countԵ֪㲥ڵĹܵknet_broadcast_writeһ
- * 㲥ڹܵյ㲥.
+ * 调用knet_broadcast_get_count可以得知广播域内的管道引用数量，调用knet_broadcast_write发起一个
+ * 广播操作，所有域内管道都会收到你广播的数据.
  * </pre>
  * @{
  */
 
 /**
- * 㲥
- * @return kbroadcast_tʵ
+ * 创建广播域
+ * @return kbroadcast_t实例
  */
 extern kbroadcast_t* knet_broadcast_create();
 
 /**
- * ٹ㲥
+ * 销毁广播域
  *
- * ٵͬʱὫлڵĹܵ
- * @param broadcast kbroadcast_tʵ
+ * 销毁的同时会将所有还在域内的管道引用销毁
+ * @param broadcast kbroadcast_t实例
  */
 extern void knet_broadcast_destroy(kbroadcast_t* broadcast);
 
 /**
- * 㲥
+ * 加入广播域
  *
- * ɹһµ
- * @param broadcast kbroadcast_tʵ
+ * 加入成功会生成一个新的引用
+ * @param broadcast kbroadcast_t实例
  * @param channel_ref kchannel_ref_t
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_broadcast_join(kbroadcast_t* broadcast, kchannel_ref_t* channel_ref);
 
 /**
- * 뿪㲥
+ * 离开广播域
  *
- * غܵѾ٣Ҫٴη
- * @param broadcast kbroadcast_tʵ
- * @param channel_ref kchannel_ref_tʵknet_broadcast_join()
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 函数返回后管道引用已经被销毁，不要尝试再次访问这个引用
+ * @param broadcast kbroadcast_t实例
+ * @param channel_ref kchannel_ref_t实例，由knet_broadcast_join()返回
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_broadcast_leave(kbroadcast_t* broadcast, kchannel_ref_t* channel_ref);
 
 /**
- * ȡù㲥ڹܵ
- * @param broadcast kbroadcast_tʵ
- * @return ܵ
+ * 取得广播域内管道数量
+ * @param broadcast kbroadcast_t实例
+ * @return 管道数量
  */
 extern int knet_broadcast_get_count(kbroadcast_t* broadcast);
 
 /**
- * 㲥
- * @param broadcast kbroadcast_tʵ
- * @param buffer ָ
- * @param size 
- * @return ͳɹܵ
+ * 广播
+ * @param broadcast kbroadcast_t实例
+ * @param buffer 缓冲区指针
+ * @param size 缓冲区长度
+ * @return 发送成功管道的数量
  */
 extern int knet_broadcast_write(kbroadcast_t* broadcast, char* buffer, uint32_t size);
 
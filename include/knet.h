@@ -43,6 +43,7 @@
 #include "misc_api.h"
 #include "logger_api.h"
 #include "ringbuffer_api.h"
+#include "write_batch_api.h"
 #include "version.h"
 
 #ifdef __cplusplus
@@ -28,109 +28,293 @@
 #include "config.h"
 
 /**
- * @defgroup loop ¼ѭ
- * ¼ѭ
+ * @defgroup loop 事件循环
+ * 网络事件循环
  *
  * <pre>
- * ¼APIΪͬϵͳѡȡİװ˲ͬƽ̨ľʵ֣
- * Ϊṩͳһĵýӿ.
+ * 网络事件API，作为各个不同操作系统网络选取器的包装，屏蔽了不同平台的具体实现，
+ * 为你提供统一的调用接口.
  *
- * ܵkchannel_ref_tͨknet_loop_create_channelknet_loop_create_channel_exist_socket_fd
- * knet_loop_run¼ѭȴknet_loop_exit˳ֶknet_loop_run_onceһ¼
- * ѭԼѭĵƵ.
+ * 管道引用kchannel_ref_t通过调用knet_loop_create_channel和knet_loop_create_channel_exist_socket_fd
+ * 创建，knet_loop_run将启动事件循环并等待调用knet_loop_exit退出，你可以手动调用knet_loop_run_once运行一次事件
+ * 循环自己控制循环的调用频率.
  *
- * ÿkloop_tڶά˻Ծܵѹر(δ)ܵ˫ͨknet_loop_get_active_channel_count
- * knet_loop_get_close_channel_countȡþ.
+ * 每个kloop_t内都维护了活跃管道和已关闭(未销毁)管道的双向链表，可以通过knet_loop_get_active_channel_count
+ * 和knet_loop_get_close_channel_count来取得具体数量.
  *
- * ڴܵʱҪעҪò
+ * 在创建管道时，要注意两个重要的配置参数：
  *
- * 1. max_send_list_len Ԫظ
- * 2. recv_ring_len     ܻ󳤶
+ * 1. max_send_list_len 发送链表最大元素个数
+ * 2. recv_ring_len     接受缓冲区最大长度
  *
- * ͨܵڷ(stream_push_ϵ)᳢ֱܵӷͣҪ͵ݣΪĳԭ
- * ²ֱӷͣݻᱻڷڵȴʵʱͣĳȴﵽޣܵᱻر.
- * ܻͬ׽ڽݶȡһֱkstream_tȡݣôᱻдܵҲ
- * ᱻر.
+ * 通常向管道内发送数据(stream_push_系列)，管道会尝试直接发送，并不缓存要发送的数据，如果因为某种原因
+ * 导致不能直接发送，数据会被缓存在发送链表内等待合适的时机发送，如果发送链表的长度达到上限，管道会被关闭.
+ * 同样，接受缓冲区会从套接字内将数据读取出来，如果你一直不从kstream_t内取数据，那么早晚会被写满，管道也
+ * 会被关闭.
  *
  * </pre>
  * @{
  */
 
 /**
- * һ¼ѭ
- * @return kloop_tʵ
+ * 创建一个事件循环
+ * @return kloop_t实例
  */
 extern kloop_t* knet_loop_create();
 
 /**
- * ¼ѭ
- * ¼ѭڵйܵҲᱻ
- * @param loop kloop_tʵ
+ * 使用指定选取器创建一个事件循环
+ * <pre>
+ * loop_backend_default按IOCP, epoll, io_uring, select的顺序选择第一个建立成功的选取器,
+ * 指定的选取器未编译进库或运行时不可用时返回0. 同一进程内不同loop可以使用不同的选取器
+ * </pre>
+ * @param backend 选取器类型
+ * @retval 0 失败
+ * @retval 其他 kloop_t实例
+ */
+extern kloop_t* knet_loop_create_with_backend(knet_loop_backend_e backend);
+
+/**
+ * 取得事件循环使用的选取器类型
+ * @param loop kloop_t实例
+ * @return 选取器类型
+ */
+extern knet_loop_backend_e knet_loop_get_backend(kloop_t* loop);
+
+/**
+ * 取得事件循环使用的选取器名称
+ * @param loop kloop_t实例
+ * @return 选取器名称
+ */
+extern const char* knet_loop_get_backend_name(kloop_t* loop);
+
+/**
+ * 销毁事件循环
+ * 事件循环内的所有管道也会被销毁
+ * @param loop kloop_t实例
  */
 extern void knet_loop_destroy(kloop_t* loop);
 
 /**
- * ܵ
- * @param loop kloop_tʵ
- * @param max_send_list_len ͻ󳤶
- * @param recv_ring_len ܻλ󳤶
- * @return kchannel_ref_tʵ
+ * 创建管道
+ * @param loop kloop_t实例
+ * @param max_send_list_len 发送缓冲区链最大长度
+ * @param recv_ring_len 接受环形缓冲区最大长度
+ * @return kchannel_ref_t实例
  */
 extern kchannel_ref_t* knet_loop_create_channel(kloop_t* loop, uint32_t max_send_list_len, uint32_t recv_ring_len);
 
 /**
- * ʹѴڵ׽ִܵ
- * @param loop kloop_tʵ
- * @param socket_fd ׽
- * @param max_send_list_len ͻ󳤶
- * @param recv_ring_len ܻλ󳤶
- * @return kchannel_ref_tʵ
+ * 使用已存在的套接字创建管道
+ * @param loop kloop_t实例
+ * @param socket_fd 套接字
+ * @param max_send_list_len 发送缓冲区链最大长度
+ * @param recv_ring_len 接受环形缓冲区最大长度
+ * @return kchannel_ref_t实例
  */
 extern kchannel_ref_t* knet_loop_create_channel_exist_socket_fd(kloop_t* loop, socket_t socket_fd,
     uint32_t max_send_list_len, uint32_t recv_ring_len);
 
 /**
- * һ¼ѭ
- * kloop_t̰߳ȫģڶ߳ͬʱͬһkloop_tʵknet_loop_run_once
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 运行一次事件循环
+ * kloop_t不是线程安全的，不能在多个线程内同时对同一个kloop_t实例调用knet_loop_run_once
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_run_once(kloop_t* loop);
 
 /**
- * ¼ѭֱknet_loop_exit()
- * kloop_t̰߳ȫģڶ߳ͬʱͬһkloop_tʵknet_loop_run
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 运行事件循环直到调用knet_loop_exit()
+ * kloop_t不是线程安全的，不能在多个线程内同时对同一个kloop_t实例调用knet_loop_run
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_run(kloop_t* loop);
 
 /**
- * ˳knet_loop_run()
- * @param loop kloop_tʵ
+ * 退出函数knet_loop_run()
+ * @param loop kloop_t实例
  */
 extern void knet_loop_exit(kloop_t* loop);
 
 /**
- * ȡԾܵ
- * @param loop kloop_tʵ
- * @return Ծܵ
+ * 设置事件循环空闲时的自旋次数
+ * <pre>
+ * 事件循环在没有事件时会阻塞在选取器内，直到最近一个定时器到期或者有新的事件到达.
+ * 对延迟敏感的kloop_t可以设置自旋次数，选取器会先以非阻塞方式轮询spin_count次，
+ * 仍然没有事件时才进入阻塞等待.
+ * </pre>
+ * @param loop kloop_t实例
+ * @param spin_count 自旋次数，0为不自旋（默认）
+ */
+extern void knet_loop_set_spin_count(kloop_t* loop, int spin_count);
+
+/**
+ * 取得事件循环空闲时的自旋次数
+ * @param loop kloop_t实例
+ * @return 自旋次数
+ */
+extern int knet_loop_get_spin_count(kloop_t* loop);
+
+/**
+ * 设置选取器单次最长等待时间
+ * <pre>
+ * 在同一个线程内轮流运行多个kloop_t时，需要限制单次等待时间，避免其他kloop_t得不到运行.
+ * </pre>
+ * @param loop kloop_t实例
+ * @param max_wait 最长等待时间（毫秒），-1为无限制（默认）
+ */
+extern void knet_loop_set_max_wait(kloop_t* loop, int max_wait);
+
+/**
+ * 取得选取器单次最长等待时间
+ * @param loop kloop_t实例
+ * @return 最长等待时间（毫秒），-1为无限制
+ */
+extern int knet_loop_get_max_wait(kloop_t* loop);
+
+/**
+ * 设置监听管道单次事件最多接受的连接数
+ * <pre>
+ * 监听管道有新连接时会循环接受直到没有等待的连接(EAGAIN)，或者达到本预算.
+ * 达到预算后剩余的连接在下一次循环继续接受，避免连接风暴时饿死其他管道.
+ * </pre>
+ * @param loop kloop_t实例
+ * @param accept_budget 最多接受的连接数，0为不限制，默认为64
+ */
+extern void knet_loop_set_accept_budget(kloop_t* loop, int accept_budget);
+
+/**
+ * 取得监听管道单次事件最多接受的连接数
+ * @param loop kloop_t实例
+ * @return 最多接受的连接数，0为不限制
+ */
+extern int knet_loop_get_accept_budget(kloop_t* loop);
+
+/**
+ * 设置管道单次事件最多读取的字节数
+ * <pre>
+ * 管道可读时会循环读取直到套接字读空(EAGAIN)或者读缓冲区满，或者达到本预算.
+ * 达到预算后管道被放入就绪链表，在下一次循环继续读取而不需要等待新的事件通知，
+ * 避免高流量管道独占一次循环.
+ * </pre>
+ * @param loop kloop_t实例
+ * @param read_budget 最多读取的字节数，0为不限制，默认为65536
+ */
+extern void knet_loop_set_read_budget(kloop_t* loop, int read_budget);
+
+/**
+ * 取得管道单次事件最多读取的字节数
+ * @param loop kloop_t实例
+ * @return 最多读取的字节数，0为不限制
+ */
+extern int knet_loop_get_read_budget(kloop_t* loop);
+
+/**
+ * 设置使用MSG_ZEROCOPY发送的最小缓冲区长度
+ * <pre>
+ * 发送链表内长度不小于threshold的缓冲区使用MSG_ZEROCOPY发送, 内核直接引用缓冲区内存,
+ * 缓冲区在内核通过套接字错误队列通知完成后才会释放. 适合发送knet_stream_push_owned()写入的大块数据,
+ * 较小的缓冲区锁定页面的开销高于拷贝, 建议不小于16384.
+ * 仅Linux(4.14以上)支持, 不支持的系统上正常发送.
+ * </pre>
+ * @param loop kloop_t实例
+ * @param threshold 最小缓冲区长度（字节），0为关闭，默认为0
+ */
+extern void knet_loop_set_zerocopy_threshold(kloop_t* loop, int threshold);
+
+/**
+ * 取得使用MSG_ZEROCOPY发送的最小缓冲区长度
+ * @param loop kloop_t实例
+ * @return 最小缓冲区长度（字节），0为关闭
+ */
+extern int knet_loop_get_zerocopy_threshold(kloop_t* loop);
+
+/**
+ * 设置弹性读缓冲区的初始长度
+ * <pre>
+ * 开启后, 之后建立的读缓冲区最大长度大于size的管道使用弹性读缓冲区:
+ * 1. 第一次可读时才从内存池分配size长度的缓冲区
+ * 2. 回调返回后读缓冲区仍然是满的(帧不完整), 下一次读取前长度翻倍, 直到建立管道时指定的最大长度
+ * 3. 读缓冲区为空且空闲knet_loop_set_recv_buffer_idle()设置的时间后, 缓冲区归还到本kloop_t的内存池
+ * 通过knet_stream_peek_iov()等函数取得的地址在缓冲区调整后失效
+ * </pre>
+ * @param loop kloop_t实例
+ * @param size 初始长度（字节），0为关闭，默认为0
+ */
+extern void knet_loop_set_recv_buffer_init(kloop_t* loop, uint32_t size);
+
+/**
+ * 取得弹性读缓冲区的初始长度
+ * @param loop kloop_t实例
+ * @return 初始长度（字节），0为关闭
+ */
+extern uint32_t knet_loop_get_recv_buffer_init(kloop_t* loop);
+
+/**
+ * 设置弹性读缓冲区空闲多久后归还到内存池
+ * @param loop kloop_t实例
+ * @param idle 空闲时间（毫秒），默认为5000
+ */
+extern void knet_loop_set_recv_buffer_idle(kloop_t* loop, int idle);
+
+/**
+ * 取得弹性读缓冲区空闲多久后归还到内存池
+ * @param loop kloop_t实例
+ * @return 空闲时间（毫秒）
+ */
+extern int knet_loop_get_recv_buffer_idle(kloop_t* loop);
+
+/**
+ * 设置固定长度的读缓冲区是否双重映射
+ * <pre>
+ * 开启后, 之后建立的非弹性读缓冲区通过ringbuffer_create_mirror()建立, 可读和可写空间总是连续的一段,
+ * 接收只需要一次系统调用填充一段地址, knet_stream_peek_iov()等函数不会返回第二段.
+ * 读缓冲区长度向上对齐到页长度, 小于页长度或系统不支持时使用普通的读缓冲区
+ * </pre>
+ * @param loop kloop_t实例
+ * @param on 非零开启, 零关闭, 默认关闭
+ */
+extern void knet_loop_set_recv_buffer_mirror(kloop_t* loop, int on);
+
+/**
+ * 取得固定长度的读缓冲区是否双重映射
+ * @param loop kloop_t实例
+ * @retval 0 关闭
+ * @retval 非零 开启
+ */
+extern int knet_loop_get_recv_buffer_mirror(kloop_t* loop);
+
+/**
+ * 获取活跃管道数量
+ * @param loop kloop_t实例
+ * @return 活跃管道数量
  */
 extern int knet_loop_get_active_channel_count(kloop_t* loop);
 
 /**
- * ȡѹرչܵ
- * @param loop kloop_tʵ
- * @return رչܵ
+ * 获取已关闭管道数量
+ * @param loop kloop_t实例
+ * @return 关闭管道数量
  */
 extern int knet_loop_get_close_channel_count(kloop_t* loop);
 
 /**
- * ȡͳ
- * @param loop kloop_tʵ
- * @return kloop_profile_tʵ
+ * 取得本次迭代的时间戳
+ * <pre>
+ * 每次迭代只读取一次单调时钟, 定时器, 管道超时和统计都使用这个时间戳
+ * </pre>
+ * @param loop kloop_t实例
+ * @return 单调时钟时间戳（毫秒）
+ */
+extern uint64_t knet_loop_get_time(kloop_t* loop);
+
+/**
+ * 取得统计器
+ * @param loop kloop_t实例
+ * @return kloop_profile_t实例
  */
 extern kloop_profile_t* knet_loop_get_profile(kloop_t* loop);
 
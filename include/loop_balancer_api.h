@@ -28,47 +28,47 @@
 #include "config.h"
 
 /**
- * @defgroup balancer ؾ
- * ؾ
+ * @defgroup balancer 负载均衡器
+ * 负载均衡器
  *
  * <pre>
- * ؾkloop_tkloop_tڼܵ¹ܵ
- * 븺ؾ⣬ؾĲkloop_tڻԾܵkloop_balancer_tѡ
- * Ծܵٵkloop_t½ܵĹܵ.
+ * 负载均衡器可以与任意数量的kloop_t关联，关联后的kloop_t内监听器接受到的新管道
+ * 将参与负载均衡，负载均衡的策略是kloop_t内活跃管道数量，kloop_balancer_t选择
+ * 活跃管道最少的kloop_t负载新接受的管道.
  *
- * knet_loop_balancer_attachkloop_balancer_tkloop_tknet_loop_balancer_detach
- * ȡ.
+ * 调用knet_loop_balancer_attach让kloop_balancer_t与kloop_t关联，调用knet_loop_balancer_detach
+ * 取消关联.
  * </pre>
  * @{
  */
 
 /**
- * ؾ
- * @return kloop_balancer_tʵ
+ * 创建负载均衡器
+ * @return kloop_balancer_t实例
  */
 extern kloop_balancer_t* knet_loop_balancer_create();
 
 /**
- * ٸؾ
- * @param balancer kloop_balancer_tʵ
+ * 销毁负载均衡器
+ * @param balancer kloop_balancer_t实例
  */
 extern void knet_loop_balancer_destroy(kloop_balancer_t* balancer);
 
 /**
- * ¼ѭؾ
- * @param balancer kloop_balancer_tʵ
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 添加事件循环到负载均衡器
+ * @param balancer kloop_balancer_t实例
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_balancer_attach(kloop_balancer_t* balancer, kloop_t* loop);
 
 /**
- * Ӹؾɾ¼ѭ
- * @param balancer kloop_balancer_tʵ
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 从负载均衡器内删除事件循环
+ * @param balancer kloop_balancer_t实例
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_balancer_detach(kloop_balancer_t* balancer, kloop_t* loop);
 
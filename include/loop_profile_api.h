@@ -28,77 +28,132 @@
 #include "config.h"
 
 /**
- * ȡѾӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return ӵĹܵ
+ * 取得已经建立连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 建立连接的管道数量
  */
 extern uint32_t knet_loop_profile_get_established_channel_count(kloop_profile_t* profile);
 
 /**
- * ȡѾδӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return δӵĹܵ
+ * 取得已经建立但还未连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 建立但还未连接的管道数量
  */
 extern uint32_t knet_loop_profile_get_active_channel_count(kloop_profile_t* profile);
 
 /**
- * ȡѾرյĹܵ
- * @param profile kloop_profile_tʵ
- * @return ѾرյĹܵ
+ * 取得已经关闭的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已经关闭的管道数量
  */
 extern uint32_t knet_loop_profile_get_close_channel_count(kloop_profile_t* profile);
 
 /**
- * ȡѾ͵ֽ
- * @param profile kloop_profile_tʵ
- * @return Ѿ͵ֽ
+ * 取得已经发送的字节数
+ * @param profile kloop_profile_t实例
+ * @return 已经发送的字节数
  */
 extern uint64_t knet_loop_profile_get_sent_bytes(kloop_profile_t* profile);
 
 /**
- * ȡѾյֽ
- * @param profile kloop_profile_tʵ
- * @return Ѿյֽ
+ * 取得已经接收的字节数
+ * @param profile kloop_profile_t实例
+ * @return 已经接收的字节数
  */
 extern uint64_t knet_loop_profile_get_recv_bytes(kloop_profile_t* profile);
 
 /**
- * ȡ÷ʹ
- * @param profile kloop_profile_tʵ
- * @return (ֽ/)
+ * 取得选取器注册/修改/删除事件的系统调用次数
+ * <pre>
+ * epoll为epoll_ctl的调用次数, 事件掩码未改变时不会调用epoll_ctl
+ * </pre>
+ * @param profile kloop_profile_t实例
+ * @return 系统调用次数
+ */
+extern uint64_t knet_loop_profile_get_impl_ctl_count(kloop_profile_t* profile);
+
+/**
+ * 取得MSG_ZEROCOPY发送次数
+ * @param profile kloop_profile_t实例
+ * @return 发送次数
+ */
+extern uint64_t knet_loop_profile_get_zerocopy_send_count(kloop_profile_t* profile);
+
+/**
+ * 取得内核通知完成的MSG_ZEROCOPY发送次数, 与发送次数的差值为仍在等待完成的发送
+ * @param profile kloop_profile_t实例
+ * @return 完成次数
+ */
+extern uint64_t knet_loop_profile_get_zerocopy_complete_count(kloop_profile_t* profile);
+
+/**
+ * 取得内核通知完成但实际拷贝了数据的MSG_ZEROCOPY发送次数
+ * <pre>
+ * 回环地址或网卡不支持时内核会退化为拷贝, 此时MSG_ZEROCOPY没有收益
+ * </pre>
+ * @param profile kloop_profile_t实例
+ * @return 拷贝次数
+ */
+extern uint64_t knet_loop_profile_get_zerocopy_copied_count(kloop_profile_t* profile);
+
+/**
+ * 取得通过knet_channel_ref_relay()在管道之间中继的字节数
+ * @param profile kloop_profile_t实例
+ * @return 中继的字节数
+ */
+extern uint64_t knet_loop_profile_get_relay_bytes(kloop_profile_t* profile);
+
+/**
+ * 取得接收数据的系统调用次数, 包括返回不可读的调用
+ * @param profile kloop_profile_t实例
+ * @return 系统调用次数
+ */
+extern uint64_t knet_loop_profile_get_recv_syscall_count(kloop_profile_t* profile);
+
+/**
+ * 取得平均每接收1KB数据的系统调用次数
+ * @param profile kloop_profile_t实例
+ * @return 每KB的系统调用次数, 尚未接收到数据时为0
+ */
+extern float64_t knet_loop_profile_get_recv_syscall_per_kb(kloop_profile_t* profile);
+
+/**
+ * 取得发送带宽
+ * @param profile kloop_profile_t实例
+ * @return 带宽(字节/秒)
  */
 extern uint32_t knet_loop_profile_get_sent_bandwidth(kloop_profile_t* profile);
 
 /**
- * ȡýմ
- * @param profile kloop_profile_tʵ
- * @return (ֽ/)
+ * 取得接收带宽
+ * @param profile kloop_profile_t实例
+ * @return 带宽(字节/秒)
  */
 extern uint32_t knet_loop_profile_get_recv_bandwidth(kloop_profile_t* profile);
 
 /**
- * ͳϢдļ
- * @param profile kloop_profile_tʵ
- * @param fp FILEָ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将统计信息写入文件
+ * @param profile kloop_profile_t实例
+ * @param fp FILE指针
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_profile_dump_file(kloop_profile_t* profile, FILE* fp);
 
 /**
- * ͳϢдܵ
- * @param profile kloop_profile_tʵ
- * @param stream kstream_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将统计信息写入管道流
+ * @param profile kloop_profile_t实例
+ * @param stream kstream_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_profile_dump_stream(kloop_profile_t* profile, kstream_t* stream);
 
 /**
- * ͳϢӡ׼
- * @param profile kloop_profile_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将统计信息打印到标准输出
+ * @param profile kloop_profile_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_loop_profile_dump_stdout(kloop_profile_t* profile);
 
@@ -28,171 +28,218 @@
 #include "config.h"
 
 /**
- * @defgroup stream 
- * ܵ
+ * @defgroup stream 流
+ * 管道流
  *
  * <pre>
- * ܵ
+ * 管道流
  *
- * kstream_tͨúknet_channel_ref_get_streamȡ. ܵṩ˻ݲ
- * ԼԵķ߲Ч.
+ * kstream_t通过调用函数knet_channel_ref_get_stream取得. 管道流提供了基于流的数据操作
+ * 以及特殊的针对性的方法用于提高操作效率.
  * 
- * 1. knet_stream_available   ȡڿɶֽ
- * 2. knet_stream_eat_all     пɶֽ
- * 3. knet_stream_eat         ָֽ
- * 4. knet_stream_pop         ڶȡ
- * 5. knet_stream_push        д
- * 6. knet_stream_copy        ڿָĿɶֽڣЩֽڣͨЭ
- * 7. knet_stream_push_stream пɶֽдһҪ⿽, صת
- * 8. knet_stream_copy_stream пɶֽдһҪ⿽, Щֽڣڹ㲥
+ * 1. knet_stream_available   获取流内可读字节数
+ * 2. knet_stream_eat_all     丢弃流内所有可读字节
+ * 3. knet_stream_eat         丢弃流内指定数量的字节
+ * 4. knet_stream_pop         从流内读取数据
+ * 5. knet_stream_push        向流内写数据
+ * 6. knet_stream_copy        从流内拷贝指定数量的可读字节，但不清除这些字节，通常用于协议检测
+ * 7. knet_stream_push_stream 将流内所有可读字节写入另一个流，不需要额外拷贝, 可用于网关的数据中转
+ * 8. knet_stream_copy_stream 将流内所有可读字节写入另一个流，不需要额外拷贝, 但不清除这些字节，可用于广播
+ * 9. knet_stream_push_owned  向流内写入调用者分配的缓冲区, 流取得缓冲区的所有权, 不拷贝数据
  *
- * ЩƳ˻Ĺ⣬ضӦãͬʱЧ.
+ * 以上这些函数的设计除了基础的流本身的功能以外，还考虑了特定领域的应用，同时兼顾了效率.
  *
  * </pre>
  * @{
  */
 
 /**
- * ȡڿɶֽ
- * @param stream kstream_tʵ
- * @return ɶֽ
+ * 取得数据流内可读字节数
+ * @param stream kstream_t实例
+ * @return 可读字节数
  */
 extern int knet_stream_available(kstream_t* stream);
 
 /**
- * 
- * @param stream kstream_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 清空数据流
+ * @param stream kstream_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_eat_all(kstream_t* stream);
 
 /**
- * ɾָ
- * @param stream kstream_tʵ
- * @param size Ҫɾĳ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 删除指定长度数据
+ * @param stream kstream_t实例
+ * @param size 需要删除的长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_eat(kstream_t* stream, int size);
 
 /**
- * ڶȡݲ
- * @param stream kstream_tʵ
- * @param buffer 
- * @param size С
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 从数据流内读取数据并清除数据
+ * @param stream kstream_t实例
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_pop(kstream_t* stream, void* buffer, int size);
 
 /**
- * ڲָĽȡݣ
- * @param stream kstream_tʵ
- * @param end 
- * @param buffer 
- * @param size СʵʵĶȡֽ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 从数据流内查找指定的结束符，并取出遍历过的数据（包含结束符）
+ * @param stream kstream_t实例
+ * @param end 结束符
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小，返回实际的读取的字节数
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_pop_until(kstream_t* stream, const char* end, void* buffer, int* size);
 
 /**
- * д
- * @param stream kstream_tʵ
- * @param buffer 
- * @param size С
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 向数据流内写数据
+ * @param stream kstream_t实例
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_push(kstream_t* stream, const void* buffer, int size);
 
 /**
- * дݣɱַ
+ * 向数据流内写数据, 并取得buffer的所有权
  *
- * һдĳȲܳ1024
- * @param stream kstream_tʵ
- * @param format ַʽ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * buffer直接放入发送链表, 发送完毕或管道关闭后调用free_cb释放, 调用失败时buffer也已被释放
+ * @param stream kstream_t实例
+ * @param buffer 调用者分配的缓冲区
+ * @param size 缓冲区大小
+ * @param free_cb 释放函数
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+extern int knet_stream_push_owned(kstream_t* stream, void* buffer, int size, knet_buffer_free_cb_t free_cb);
+
+/**
+ * 向数据流写数据，可变参数字符串
+ *
+ * 一次写入的长度不能超过1024
+ * @param stream kstream_t实例
+ * @param format 字符串格式
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_push_varg(kstream_t* stream, const char* format, ...);
 
 /**
- * ڿݣ
- * @param stream kstream_tʵ
- * @param buffer 
- * @param size С
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 从数据流内拷贝数据，但不清除数据流内数据
+ * @param stream kstream_t实例
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_copy(kstream_t* stream, void* buffer, int size);
 
 /**
- * 滻
- * @param stream kstream_tʵ
- * @param pos ʼλ
- * @param buffer 
- * @param size С
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 替换数据流内数据
+ * @param stream kstream_t实例
+ * @param pos 起始位置
+ * @param buffer 缓冲区
+ * @param size 缓冲区大小
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_replace(kstream_t* stream, int pos, void* buffer, int size);
 
+/**
+ * 取得数据流内全部数据的只读视图, 不拷贝也不清除
+ * <pre>
+ * 数据在读缓冲区内绕回时分为两段, 没有第二段时iov[1].iov_len为0.
+ * 视图在下一次清除数据或回调返回后失效, 处理完毕后调用knet_stream_consume清除
+ * </pre>
+ * @param stream kstream_t实例
+ * @param iov 两段数据的地址和长度
+ * @return 可读的总字节数
+ */
+extern int knet_stream_peek_iov(kstream_t* stream, kstream_iovec_t iov[2]);
+
+/**
+ * 取得数据流前size个字节的连续地址, 不清除
+ * <pre>
+ * 数据未绕回时直接返回读缓冲区内地址, 绕回时拷贝到buffer并返回buffer
+ * </pre>
+ * @param stream kstream_t实例
+ * @param buffer 数据绕回时使用的缓冲区, 长度不小于size
+ * @param size 需要的字节数
+ * @return 连续地址, 可读字节数不足size时返回0
+ */
+extern const void* knet_stream_peek(kstream_t* stream, void* buffer, int size);
+
+/**
+ * 清除数据流头部已经处理的数据
+ * @param stream kstream_t实例
+ * @param size 需要清除的字节数
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+extern int knet_stream_consume(kstream_t* stream, int size);
+
 typedef char(*knet_stream_operator_t)(char);
 
 /**
- * posʼÿֽڵknet_stream_operator_tӦĻص
- * @param stream kstream_tʵ
- * @param operate ص
- * @param pos ʼλ
- * @param size Ҫĳ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 从pos开始针对每个字节调用knet_stream_operator_t对应的回调并设置
+ * @param stream kstream_t实例
+ * @param operate 操作回调
+ * @param pos 起始位置
+ * @param size 需要处理的长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_operate(kstream_t* stream, knet_stream_operator_t operate, int pos, int size);
 
 /**
- * streamдtarget, stream
- * @param stream kstream_tʵ
- * @param target kstream_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将stream内数据写入target, 并清除stream内数据
+ * @param stream kstream_t实例
+ * @param target kstream_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_push_stream(kstream_t* stream, kstream_t* target);
 
 /**
- * streamдtarget, stream
- * @param stream kstream_tʵ
- * @param target kstream_tʵ
- * @param count д볤
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将stream内数据写入target, 并清除stream内数据
+ * @param stream kstream_t实例
+ * @param target kstream_t实例
+ * @param count 写入长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_push_stream_count(kstream_t* stream, kstream_t* target, int count);
 
 /**
- * streamдtarget, stream
- * @param stream kstream_tʵ
- * @param target kstream_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将stream内数据写入target, 但不清除stream内数据
+ * @param stream kstream_t实例
+ * @param target kstream_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_copy_stream(kstream_t* stream, kstream_t* target);
 
 /**
- * streamдringbuffer
- * @param stream kstream_tʵ
- * @param target kringbuffer_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 将stream内数据写入ringbuffer内
+ * @param stream kstream_t实例
+ * @param target kringbuffer_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_stream_drain_ringbuffer(kstream_t* stream, kringbuffer_t* target);
 
 /**
- * ȡĹܵ
- * @param stream kstream_tʵ
- * @return kchannel_ref_tʵ
+ * 获取流所属的管道引用
+ * @param stream kstream_t实例
+ * @return kchannel_ref_t实例
  */
 extern kchannel_ref_t* knet_stream_get_channel_ref(kstream_t* stream);
 
@@ -28,65 +28,65 @@
 #include "config.h"
 
 /**
- * @defgroup trie ַKV
- * ַ
+ * @defgroup trie 字符串KV树
+ * 字符串树
  * <pre>
- * ṩһ·ṹڿٲַ·ֱΪ{left, center, right}
- * left < center < rightңɾЧΪO(n)nΪַ.
- * ַʹַΪvoid*ΪֵҲΪϣʹãûṩ
- * һֵٺtrieʱԶֵص.
+ * 提供一个三路树结构用于快速查找字符串，三路树分别为{left, center, right}，
+ * 满足left < center < right，查找，删除，插入效率为O(n)，n为字符串长度.
+ * 字符串树使用字符串作为键，void*类型作为值，也可以作为哈希表使用，用户可以提供
+ * 一个值销毁函数用于trie树销毁时的自定义值清理回调.
  * </pre>
  * @{
  */
 
 /**
- * trie
- * @return ktrie_tʵ
+ * 建立trie
+ * @return ktrie_t实例
  */
 extern ktrie_t* trie_create();
 
 /**
- * trie
- * @param trie ktrie_tʵ
- * @param dtor ٺ
+ * 销毁trie
+ * @param trie ktrie_t实例
+ * @param dtor 销毁函数
  */
 extern void trie_destroy(ktrie_t* trie, knet_trie_dtor_t dtor);
 
 /**
- * trie
- * @param trie ktrie_tʵ
- * @param s 
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 销毁trie
+ * @param trie ktrie_t实例
+ * @param s 键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int trie_insert(ktrie_t* trie, const char* s, void* value);
 
 /**
- * 
- * @param trie ktrie_tʵ
- * @param s 
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 查找
+ * @param trie ktrie_t实例
+ * @param s 键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int trie_find(ktrie_t* trie, const char* s, void** value);
 
 /**
- * ɾ
- * @param trie ktrie_tʵ
- * @param s 
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 删除
+ * @param trie ktrie_t实例
+ * @param s 键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int trie_remove(ktrie_t* trie, const char* s, void** value);
 
 /**
- * 
- * @param trie ktrie_tʵ
- * @param func 
- * @param param 
+ * 遍历
+ * @param trie ktrie_t实例
+ * @param func 遍历函数
+ * @param param 遍历函数参数
  */
 extern int trie_for_each(ktrie_t* trie, knet_trie_for_each_func_t func, void* param);
 
@@ -28,60 +28,60 @@
 #include "config.h"
 
 /**
- * @defgroup vrouter ·
- * ·
+ * @defgroup vrouter 虚拟路由
+ * 虚拟路由
  *
  * <pre>
- * ṩһԵ㵥·ɹϵά˹ܵ·ɵ{c1, c2}ĶӦϵ
- * תϵǵģֻ֧c1c2ת֧c2c1ת
- * Ҫ֧c2c1תҪµתϵ{c2, c1}.
- * ʹԴܵUUIDΪͬһܵΪʼֻܵܳһ,
- * ΪĿĹܵԳN.
- * нתϵĹܵԶᱻüӶƹܵڣֹ
- * ⲿڲʹõĹܵ.
+ * 提供一个点对点单向的路由关系表，表内维护了管道路由的{c1, c2}的对应关系，
+ * 但这个转发关系是单向的，即只支持c1到c2的转发，但不支持c2到c1的转发，
+ * 如果要支持c2到c1的转发，需要添加新的转发关系{c2, c1}.
+ * 表内使用源管道的UUID作为键，所以同一个管道作为起始管道只能出现一次,但
+ * 作为目的管道可以出现N次.
+ * 所有建立转发关系的管道对都会被提升引用计数，从而控制管道的声明周期，防止在
+ * 外部销毁内部正在使用的管道.
  * </pre>
  * @{
  */
 
 /**
- * ·
- * @return kvrouter_tʵ
+ * 建立虚拟连接路由器
+ * @return kvrouter_t实例
  */
 extern kvrouter_t* knet_vrouter_create();
 
 /**
- * 
- * return kvrouter_tʵ
+ * 销毁
+ * return kvrouter_t实例
  */
 extern void knet_vrouter_destroy(kvrouter_t* router);
 
 /**
- * һתϵ
- * @param router kvrouter_tʵ
- * @param c1 kchannel_ref_tʵԴܵ
- * @param c2 kchannel_ref_tʵĿĹܵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 建立一条转发关系
+ * @param router kvrouter_t实例
+ * @param c1 kchannel_ref_t实例，源管道
+ * @param c2 kchannel_ref_t实例，目的管道
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_vrouter_add_wire(kvrouter_t* router, kchannel_ref_t* c1, kchannel_ref_t* c2);
 
 /**
- * ɾһתϵ
- * @param router kvrouter_tʵ
- * @param c kchannel_ref_tʵԴܵ(knet_vrouter_add_wireڶ)
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 删除一条转发关系
+ * @param router kvrouter_t实例
+ * @param c kchannel_ref_t实例，源管道(knet_vrouter_add_wire第二个参数)
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_vrouter_remove_wire(kvrouter_t* router, kchannel_ref_t* c);
 
 /**
- * ת
- * @param router kvrouter_tʵ
- * @param c kchannel_ref_tʵԴܵ(knet_vrouter_add_wireڶ)
- * @param buffer ݻ
- * @param size 
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 转发数据
+ * @param router kvrouter_t实例
+ * @param c kchannel_ref_t实例，源管道(knet_vrouter_add_wire第二个参数)
+ * @param buffer 数据缓冲区
+ * @param size 缓冲区长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_vrouter_route(kvrouter_t* router, kchannel_ref_t* c, const void* buffer, int size);
 
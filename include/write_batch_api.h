@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRITE_BATCH_API_H
+#define WRITE_BATCH_API_H
+
+#include "config.h"
+
+/**
+ * 开始一个批量写入
+ * <pre>
+ * 用于在kloop_t以外的线程向同一个kloop_t内的多个管道写入大量小消息, 所有写入先拷贝到批次内连续的缓冲区,
+ * 提交时整个批次作为一个跨线程事件交给kloop_t, 只唤醒一次. kloop_t处理时同一管道的数据合并后
+ * 在本次循环迭代结束时一次发送. 批次不是线程安全的, 只能在一个线程内使用
+ * </pre>
+ * @param loop 管道所属的kloop_t实例
+ * @return kwrite_batch_t实例
+ */
+extern kwrite_batch_t* knet_write_batch_begin(kloop_t* loop);
+
+/**
+ * 向批次内添加一次写入
+ * @param batch kwrite_batch_t实例
+ * @param channel_ref 目标管道, 必须属于建立批次时的kloop_t
+ * @param data 数据
+ * @param size 数据长度
+ * @retval error_ok 成功
+ * @retval error_invalid_channel 管道不属于批次的kloop_t
+ * @retval error_no_memory 内存不足
+ */
+extern int knet_write_batch_write(kwrite_batch_t* batch, kchannel_ref_t* channel_ref, const char* data, int size);
+
+/**
+ * 取得批次内的写入次数
+ * @param batch kwrite_batch_t实例
+ * @return 写入次数
+ */
+extern int knet_write_batch_get_count(kwrite_batch_t* batch);
+
+/**
+ * 提交批次
+ * <pre>
+ * 提交后批次由kloop_t负责销毁, 调用者不能再使用. 在kloop_t所在线程内提交时立即处理.
+ * 处理时已经关闭的管道的数据被丢弃
+ * </pre>
+ * @param batch kwrite_batch_t实例
+ * @retval error_ok 成功
+ */
+extern int knet_write_batch_commit(kwrite_batch_t* batch);
+
+/**
+ * 放弃批次内的所有写入并销毁批次
+ * @param batch kwrite_batch_t实例
+ */
+extern void knet_write_batch_cancel(kwrite_batch_t* batch);
+
+#endif /* WRITE_BATCH_API_H */
@@ -29,22 +29,22 @@
 #include "address_api.h"
 
 /**
- * һkaddress_tʵ
- * @return kaddress_tʵ
+ * 创建一个kaddress_t实例
+ * @return kaddress_t实例
  */
 kaddress_t* knet_address_create();
 
 /**
- * һkaddress_tʵ
- * @param address kaddress_tʵ
+ * 销毁一个kaddress_t实例
+ * @param address kaddress_t实例
  */
 void knet_address_destroy(kaddress_t* address);
 
 /**
- * IPͶ˿
- * @param address kaddress_tʵ
+ * 设置IP和端口
+ * @param address kaddress_t实例
  * @param ip IP
- * @param port ˿
+ * @param port 端口
  */
 void knet_address_set(kaddress_t* address, const char* ip, int port);
 
@@ -26,12 +26,12 @@
 #define ADDRESS_API_H
 
 /**
- * @defgroup address ַ
- * ַ
+ * @defgroup address 地址
+ * 地址
  *
  * <pre>
- * ַӿͨknet_channel_ref_get_local_addressknet_channel_ref_get_peer_address
- * ȡػԶ˵ĵַδӵĹܵҲԻȡַȡĵַЧ.
+ * 地址接口通过knet_channel_ref_get_local_address或knet_channel_ref_get_peer_address
+ * 获取本地或对端的地址，未建立连接的管道也可以获取地址，但获取的地址是无效的.
  * </pre>
  * @sa knet_channel_ref_get_local_address
  * @sa knet_channel_ref_get_peer_address
@@ -39,28 +39,28 @@
  */
 
 /**
- * ȡIP
- * @param address kaddress_tʵ
- * @retval Чָ IPַ
- * @retval 0 ܵδ
+ * 取得IP
+ * @param address kaddress_t实例
+ * @retval 有效的指针 IP字符串
+ * @retval 0 管道连接未建立
  */
 extern const char* address_get_ip(kaddress_t* address);
 
 /**
- * ȡport
- * @param address kaddress_tʵ
- * @retval ЧĶ˿ں ˿ں
- * @retval 0 ܵδ
+ * 取得port
+ * @param address kaddress_t实例
+ * @retval 有效的端口号 端口号
+ * @retval 0 管道连接未建立
  */
 extern int address_get_port(kaddress_t* address);
 
 /**
- * Ƿ
- * @param address kaddress_tʵ
+ * 测试是否相等
+ * @param address kaddress_t实例
  * @param ip IP
- * @param port ˿
- * @retval 0 
- * @retval  
+ * @param port 端口
+ * @retval 0 相等
+ * @retval 非零 不相等
  */
 extern int address_equal(kaddress_t* address, const char* ip, int port);
 
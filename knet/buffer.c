@@ -25,14 +25,22 @@
 #include "buffer.h"
 #include "logger.h"
 
+#if (defined(WIN32) || defined(_WIN64))
+    #include <io.h> /* _close */
+#endif /* defined(WIN32) || defined(_WIN64) */
+
 /**
- * ͻ
+ * 发送缓冲区
  */
 struct _buffer_t {
-    char*    m;   /* ַָ */
-    char*    ptr; /* ʼַ */
-    uint32_t len; /*  */
-    uint32_t pos; /* ǰλ */
+    char*    m;   /* 地址指针 */
+    char*    ptr; /* 缓冲区起始地址 */
+    uint32_t len; /* 缓冲区长度 */
+    uint32_t pos; /* 缓冲区当前位置 */
+    knet_buffer_free_cb_t free_cb; /* 调用者内存的释放函数, 为0时内存由缓冲区分配 */
+    int      file_fd;     /* 文件区域缓冲区的文件描述符, -1表示内存缓冲区 */
+    uint64_t file_offset; /* 文件内当前位置 */
+    uint64_t file_length; /* 文件区域未发送的长度 */
 };
 
 kbuffer_t* knet_buffer_create(uint32_t size) {
@@ -41,26 +49,100 @@ kbuffer_t* knet_buffer_create(uint32_t size) {
     if (!sb) {
         return 0;
     }
-    /* ָ */
+    memset(sb, 0, sizeof(kbuffer_t));
+    sb->file_fd = -1;
+    /* 数据指针 */
     sb->ptr = create_raw(size);
     verify(sb->ptr);
     if (!sb->ptr) {
         knet_buffer_destroy(sb);
         return 0;
     }
-    sb->m   = sb->ptr;
-    sb->pos = 0;
-    sb->len = size;
+    sb->m       = sb->ptr;
+    sb->pos     = 0;
+    sb->len     = size;
+    return sb;
+}
+
+kbuffer_t* knet_buffer_create_owned(char* data, uint32_t size, knet_buffer_free_cb_t free_cb) {
+    kbuffer_t* sb = 0;
+    verify(data);
+    verify(size);
+    verify(free_cb);
+    sb = create(kbuffer_t);
+    verify(sb);
+    if (!sb) {
+        free_cb(data);
+        return 0;
+    }
+    memset(sb, 0, sizeof(kbuffer_t));
+    /* 直接使用调用者的内存, 数据已经就绪 */
+    sb->m       = data;
+    sb->ptr     = data;
+    sb->pos     = size;
+    sb->len     = size;
+    sb->free_cb = free_cb;
+    sb->file_fd = -1;
+    return sb;
+}
+
+kbuffer_t* knet_buffer_create_file(int file_fd, uint64_t offset, uint64_t length) {
+    kbuffer_t* sb = 0;
+    verify(file_fd >= 0);
+    verify(length);
+    sb = create(kbuffer_t);
+    verify(sb);
+    if (!sb) {
+        return 0;
+    }
+    memset(sb, 0, sizeof(kbuffer_t));
+    /* 没有内存数据, 长度为0 */
+    sb->file_fd     = file_fd;
+    sb->file_offset = offset;
+    sb->file_length = length;
     return sb;
 }
 
+int knet_buffer_get_file_fd(kbuffer_t* sb) {
+    verify(sb);
+    return sb->file_fd;
+}
+
+uint64_t knet_buffer_get_file_offset(kbuffer_t* sb) {
+    verify(sb);
+    return sb->file_offset;
+}
+
+uint64_t knet_buffer_get_file_length(kbuffer_t* sb) {
+    verify(sb);
+    return sb->file_length;
+}
+
+void knet_buffer_adjust_file(kbuffer_t* sb, uint64_t gap) {
+    verify(sb);
+    verify(gap <= sb->file_length);
+    sb->file_offset += gap;
+    sb->file_length -= gap;
+}
+
 void knet_buffer_destroy(kbuffer_t* sb) {
     verify(sb);
     if (!sb) {
         return;
     }
+    if (sb->file_fd >= 0) {
+#if (defined(WIN32) || defined(_WIN64))
+        _close(sb->file_fd);
+#else
+        close(sb->file_fd);
+#endif /* defined(WIN32) || defined(_WIN64) */
+    }
     if (sb->m) {
-        knet_free(sb->m);
+        if (sb->free_cb) {
+            sb->free_cb(sb->m);
+        } else {
+            knet_free(sb->m);
+        }
     }
     if (sb) {
         knet_free(sb);
@@ -115,7 +197,7 @@ char* knet_buffer_get_ptr(kbuffer_t* sb) {
 }
 
 void knet_buffer_adjust(kbuffer_t* sb, uint32_t gap) {
-    verify(sb); /* gapΪ0 */
+    verify(sb); /* gap可以为0 */
     if (!sb) {
         return;
     }
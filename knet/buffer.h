@@ -28,68 +28,119 @@
 #include "config.h"
 
 /**
- * һ̶ȵĻ
- * @param size ȣֽڣ
- * @return kbuffer_tʵ
+ * 创建一个固定长度的缓冲区
+ * @param size 缓冲区长度（字节）
+ * @return kbuffer_t实例
  */
 kbuffer_t* knet_buffer_create(uint32_t size);
 
 /**
- * ٻ
- * @param sb kbuffer_tʵ
+ * 使用调用者的内存建立缓冲区, 不拷贝数据
+ *
+ * 缓冲区取得data的所有权, 销毁时调用free_cb释放data, 建立失败时也会调用free_cb
+ * @param data 数据指针
+ * @param size 数据长度（字节）
+ * @param free_cb 释放函数
+ * @return kbuffer_t实例
+ */
+kbuffer_t* knet_buffer_create_owned(char* data, uint32_t size, knet_buffer_free_cb_t free_cb);
+
+/**
+ * 建立文件区域缓冲区, 发送时使用sendfile()从文件直接发送到套接字, 不读入用户内存
+ *
+ * 缓冲区取得file_fd的所有权, 销毁时关闭file_fd
+ * @param file_fd 文件描述符
+ * @param offset 文件内起始位置
+ * @param length 发送长度（字节）
+ * @return kbuffer_t实例
+ */
+kbuffer_t* knet_buffer_create_file(int file_fd, uint64_t offset, uint64_t length);
+
+/**
+ * 取得文件区域缓冲区的文件描述符
+ * @param sb kbuffer_t实例
+ * @retval -1 不是文件区域缓冲区
+ * @retval 其他 文件描述符
+ */
+int knet_buffer_get_file_fd(kbuffer_t* sb);
+
+/**
+ * 取得文件区域缓冲区当前的文件内位置
+ * @param sb kbuffer_t实例
+ * @return 文件内位置
+ */
+uint64_t knet_buffer_get_file_offset(kbuffer_t* sb);
+
+/**
+ * 取得文件区域缓冲区未发送的长度
+ * @param sb kbuffer_t实例
+ * @return 未发送的长度, 不是文件区域缓冲区时为0
+ */
+uint64_t knet_buffer_get_file_length(kbuffer_t* sb);
+
+/**
+ * 调整文件区域缓冲区的起始位置
+ * @param sb kbuffer_t实例
+ * @param gap 调整的长度
+ */
+void knet_buffer_adjust_file(kbuffer_t* sb, uint64_t gap);
+
+/**
+ * 销毁缓冲区
+ * @param sb kbuffer_t实例
  */
 void knet_buffer_destroy(kbuffer_t* sb);
 
 /**
- * д
- * @param sb kbuffer_tʵ
- * @param temp ָֽ
- * @param size ֽ鳤
- * @retval 0 дʧ
- * @retval >0 ʵдֽ
+ * 写入
+ * @param sb kbuffer_t实例
+ * @param temp 字节数组指针
+ * @param size 字节数组长度
+ * @retval 0 写入失败
+ * @retval >0 实际写入的字节数
  */
 uint32_t knet_buffer_put(kbuffer_t* sb, const char* temp, uint32_t size);
 
 /**
- * ȡûݳ
- * @param sb kbuffer_tʵ
- * @return ݳ
+ * 取得缓冲区内数据长度
+ * @param sb kbuffer_t实例
+ * @return 数据长度
  */
 uint32_t knet_buffer_get_length(kbuffer_t* sb);
 
 /**
- * ȡû󳤶
- * @param sb kbuffer_tʵ
- * @return 󳤶
+ * 取得缓冲区内最大长度
+ * @param sb kbuffer_t实例
+ * @return 最大长度
  */
 uint32_t knet_buffer_get_max_size(kbuffer_t* sb);
 
 /**
- * ԻǷ㹻ռ
- * @param sb kbuffer_tʵ
- * @param size 󳤶
- * @retval 0 û㹻ռ
- * @retval  㹻ռ
+ * 测试缓冲区内是否有足够空间
+ * @param sb kbuffer_t实例
+ * @param size 需求长度
+ * @retval 0 没有足够空间
+ * @retval 非零 有足够空间
  */
 int knet_buffer_enough(kbuffer_t* sb, uint32_t size);
 
 /**
- * ȡûʼַ
- * @param sb kbuffer_tʵ
- * @return ݳ
+ * 取得缓冲区数据起始地址
+ * @param sb kbuffer_t实例
+ * @return 数据长度
  */
 char* knet_buffer_get_ptr(kbuffer_t* sb);
 
 /**
- * ʼַ
- * @param sb kbuffer_tʵ
- * @param gap ĳ
+ * 调整数据起始地址
+ * @param sb kbuffer_t实例
+ * @param gap 调整的长度
  */
 void knet_buffer_adjust(kbuffer_t* sb, uint32_t gap);
 
 /**
- * ջ
- * @param sb kbuffer_tʵ
+ * 清空缓冲区
+ * @param sb kbuffer_t实例
  */
 void knet_buffer_clear(kbuffer_t* sb);
 
@@ -31,46 +31,122 @@
 #include "logger.h"
 
 /**
- * ܵ
+ * 建立管道, 不设置套接字选项
+ */
+static kchannel_t* _channel_create(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len);
+
+/**
+ * 管道
  */
 struct _channel_t {
-    kdlist_t*      send_buffer_list;  /* , ʧܵݻȴ´η */
-    uint32_t       max_send_list_len; /* 󳤶 */
-    kringbuffer_t* recv_ringbuffer;   /* λ, ͨsocketȡݻ */
-    socket_t       socket_fd;         /* ׽ */
-    uint64_t       uuid;              /* ܵUUID */
+    kdlist_t*      send_buffer_list;  /* 发送链表, 发送失败的数据会加入这个链表等待下次发送 */
+    uint32_t       max_send_list_len; /* 发送链表最大长度 */
+    kringbuffer_t* recv_ringbuffer;   /* 读环形缓冲区, 通过socket读取函数读到的数据会放在这个缓冲区内 */
+    socket_t       socket_fd;         /* 套接字 */
+    uint64_t       uuid;              /* 管道UUID */
+    uint32_t       zerocopy_threshold; /* 使用MSG_ZEROCOPY发送的最小缓冲区长度, 0为关闭 */
+    int            zerocopy_on;       /* SO_ZEROCOPY状态, 0未设置, 1已开启, -1不支持 */
+    uint32_t       zerocopy_id;       /* 下一次MSG_ZEROCOPY发送的完成序号 */
+    int            zerocopy_head;     /* 发送链表头部缓冲区是否被内核引用 */
+    uint32_t       zerocopy_head_id;  /* 发送链表头部缓冲区最后一次MSG_ZEROCOPY发送的完成序号 */
+    kdlist_t*      zerocopy_list;     /* 已发送完毕, 等待内核通知完成的缓冲区 */
+    uint32_t       recv_ring_cap;     /* 弹性读缓冲区的最大长度, 0为固定长度 */
+    uint64_t       send_bytes;        /* 发送链表内未发送的字节数 */
+    uint32_t       send_high;         /* 发送高水位（字节）, 0为关闭 */
+    uint32_t       send_low;          /* 发送低水位（字节） */
 };
 
+/**
+ * 单次sendfile()最多发送的字节数
+ */
+#define CHANNEL_SENDFILE_MAX 0x40000000
+
+/**
+ * 设置发送高水位后, 未发送字节数达到高水位的倍数时仍然认为发送链表已满
+ */
+#define CHANNEL_SEND_HARD_CAP_FACTOR 4
+
+/**
+ * 等待内核通知完成的缓冲区
+ */
+typedef struct _channel_zerocopy_t {
+    kbuffer_t* send_buffer; /* 发送缓冲区 */
+    uint32_t   id;          /* 最后一次MSG_ZEROCOPY发送的完成序号 */
+} channel_zerocopy_t;
+
+/**
+ * 检查长度为length的缓冲区是否使用MSG_ZEROCOPY发送
+ */
+int _channel_zerocopy_check(kchannel_t* channel, uint32_t length) {
+    return ((channel->zerocopy_on > 0) && channel->zerocopy_threshold && (length >= channel->zerocopy_threshold));
+}
+
+/**
+ * 释放发送完毕的发送链表头部缓冲区, 被内核引用的缓冲区等待通知完成后再释放
+ */
+void _channel_release_buffer(kchannel_t* channel, kbuffer_t* send_buffer) {
+    channel_zerocopy_t* pending = 0;
+    if (!channel->zerocopy_head) {
+        knet_buffer_destroy(send_buffer);
+        return;
+    }
+    channel->zerocopy_head = 0;
+    if (!channel->zerocopy_list) {
+        channel->zerocopy_list = dlist_create();
+        verify(channel->zerocopy_list);
+    }
+    pending = create(channel_zerocopy_t);
+    verify(pending);
+    pending->send_buffer = send_buffer;
+    pending->id          = channel->zerocopy_head_id;
+    dlist_add_tail_node(channel->zerocopy_list, pending);
+}
+
 kchannel_t* knet_channel_create(uint32_t max_send_list_len, uint32_t recv_ring_len) {
-    /* socket */
+    /* 建立socket描述符 */
     socket_t socket_fd = socket_create();
     verify(socket_fd > 0);
     if (socket_fd <= 0) {
         return 0;
     }
-    /* ܵ */
+    /* 建立管道 */
     return knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len);
 }
 
 kchannel_t* knet_channel_create_exist_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+    kchannel_t* channel = _channel_create(socket_fd, max_send_list_len, recv_ring_len);
+    /* 设置为非阻塞 */
+    socket_set_non_blocking_on(channel->socket_fd);
+    /* 关闭延迟发送 */
+    socket_set_nagle_off(channel->socket_fd);
+    /* 关闭TIME_WAIT */
+    socket_set_linger_off(channel->socket_fd);
+    /* 关闭keep alive */
+    socket_set_keepalive_off(channel->socket_fd);
+    return channel;
+}
+
+kchannel_t* knet_channel_create_accepted_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+#if SOCKET_ACCEPT_INHERIT
+    /* 已经是非阻塞的, 其他选项与监听套接字相同, 监听套接字由knet_channel_create_exist_socket_fd()设置 */
+    return _channel_create(socket_fd, max_send_list_len, recv_ring_len);
+#else
+    /* 选项没有继承, 逐个设置 */
+    return knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len);
+#endif /* SOCKET_ACCEPT_INHERIT */
+}
+
+static kchannel_t* _channel_create(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
     kchannel_t* channel = create(kchannel_t);
     verify(channel);
     memset(channel, 0, sizeof(kchannel_t));
-    channel->uuid = uuid_create(); /* ܵUUID */
-    channel->send_buffer_list = dlist_create(); /*  */
+    channel->uuid = uuid_create(); /* 管道UUID */
+    channel->send_buffer_list = dlist_create(); /* 发送链表 */
     verify(channel->send_buffer_list);
-    channel->recv_ringbuffer = ringbuffer_create(recv_ring_len); /*  */
+    channel->recv_ringbuffer = ringbuffer_create(recv_ring_len); /* 读缓冲区 */
     verify(channel->recv_ringbuffer);
     channel->max_send_list_len = max_send_list_len;
     channel->socket_fd         = socket_fd;
-    /* Ϊ */
-    socket_set_non_blocking_on(channel->socket_fd);
-    /* رӳٷ */
-    socket_set_nagle_off(channel->socket_fd);
-    /* رTIME_WAIT */
-    socket_set_linger_off(channel->socket_fd);
-    /* رkeep alive */
-    socket_set_keepalive_off(channel->socket_fd);
     return channel;
 }
 
@@ -79,7 +155,7 @@ void knet_channel_destroy(kchannel_t* channel) {
     kdlist_node_t* temp        = 0;
     kbuffer_t*     send_buffer = 0;
     verify(channel);
-    /* δ͵ */
+    /* 销毁未发送的数据 */
     if (channel->send_buffer_list) {
         dlist_for_each_safe(channel->send_buffer_list, node, temp) {
             send_buffer = (kbuffer_t*)dlist_node_get_data(node);
@@ -87,18 +163,26 @@ void knet_channel_destroy(kchannel_t* channel) {
         }
         dlist_destroy(channel->send_buffer_list);
     }
-    /* ٽջ */
+    /* 销毁等待内核通知完成的数据, 套接字已关闭 */
+    if (channel->zerocopy_list) {
+        dlist_for_each_safe(channel->zerocopy_list, node, temp) {
+            knet_buffer_destroy(((channel_zerocopy_t*)dlist_node_get_data(node))->send_buffer);
+            knet_free(dlist_node_get_data(node));
+        }
+        dlist_destroy(channel->zerocopy_list);
+    }
+    /* 销毁接收缓冲区 */
     if (channel->recv_ringbuffer) {
         ringbuffer_destroy(channel->recv_ringbuffer);
     }
-    /* ٹܵ */
+    /* 销毁管道 */
     knet_free(channel);
 }
 
 int knet_channel_connect(kchannel_t* channel, const char* ip, int port) {
     verify(channel);
     verify(ip);
-    /* Ӳ */
+    /* 发起连接操作 */
     return socket_connect(channel->socket_fd, ip, port);
 }
 
@@ -111,7 +195,7 @@ int knet_channel_accept(kchannel_t* channel, const char* ip, int port, int backl
     if (!ip) {
         ip = "0.0.0.0";
     }
-    /* Ϊ״̬ */
+    /* 设置为监听状态 */
     return socket_bind_and_listen(channel->socket_fd, ip, port, backlog);
 }
 
@@ -119,14 +203,15 @@ int knet_channel_send_buffer(kchannel_t* channel, kbuffer_t* send_buffer) {
     verify(channel);
     verify(send_buffer);
     verify(channel->send_buffer_list);
-    /* ʼ޷ */
+    /* 始终无法发送 */
     if (knet_channel_send_list_reach_max(channel)) {
         knet_buffer_destroy(send_buffer);
         return error_send_fail;
     }
-    /* ͻӵβ */
+    /* 将发送缓冲区加到链表尾部 */
     dlist_add_tail_node(channel->send_buffer_list, send_buffer);
-    /* õд¼ */
+    channel->send_bytes += knet_buffer_get_length(send_buffer) + knet_buffer_get_file_length(send_buffer);
+    /* 让调用者重新设置写事件 */
     return error_send_patial;
 }
 
@@ -137,88 +222,310 @@ int knet_channel_send(kchannel_t* channel, const char* data, int size) {
     verify(data);
     verify(size);
     verify(channel->send_buffer_list);
-    /* ʼ޷ */
+    /* 始终无法发送 */
     if (knet_channel_send_list_reach_max(channel)) {
         return error_send_fail;
     }
     if (dlist_empty(channel->send_buffer_list)) {
-        /* ֱӷ */
+        /* 尝试直接发送 */
         bytes = socket_send(channel->socket_fd, data, size);
     }
     if (bytes < 0) {
         return error_send_fail;
     }
-    /* ֱӷʧܣûзϵֽڷ뷢ȴ´η */
+    /* 直接发送失败，或者没有发送完毕的字节放入发送链表等待下次发送 */
     if (size > bytes) {
         send_buffer = knet_buffer_create(size - bytes);
         verify(send_buffer);
         knet_buffer_put(send_buffer, data + bytes, size - bytes);
         dlist_add_tail_node(channel->send_buffer_list, send_buffer);
-        /* ҪԺ */
+        channel->send_bytes += (uint64_t)(size - bytes);
+        /* 需要稍后发送 */
         return error_send_patial;
     }
     return error_ok;
 }
 
+int knet_channel_send_owned(kchannel_t* channel, kbuffer_t* send_buffer) {
+    int      bytes    = 0;
+    int      zerocopy = 0;
+    uint32_t length   = 0;
+    verify(channel);
+    verify(send_buffer);
+    verify(channel->send_buffer_list);
+    /* 始终无法发送 */
+    if (knet_channel_send_list_reach_max(channel)) {
+        knet_buffer_destroy(send_buffer);
+        return error_send_fail;
+    }
+    length = knet_buffer_get_length(send_buffer);
+    if (dlist_empty(channel->send_buffer_list)) {
+        /* 尝试直接发送 */
+        if (_channel_zerocopy_check(channel, length)) {
+            bytes = socket_send_zerocopy(channel->socket_fd, knet_buffer_get_ptr(send_buffer), length, &zerocopy);
+        } else {
+            bytes = socket_send(channel->socket_fd, knet_buffer_get_ptr(send_buffer), length);
+        }
+    }
+    if (bytes < 0) {
+        knet_buffer_destroy(send_buffer);
+        return error_send_fail;
+    }
+    if (zerocopy) {
+        /* 缓冲区将成为发送链表头部或等待通知完成 */
+        channel->zerocopy_head    = 1;
+        channel->zerocopy_head_id = channel->zerocopy_id++;
+    }
+    if ((uint32_t)bytes == length) {
+        _channel_release_buffer(channel, send_buffer);
+        return error_ok;
+    }
+    /* 没有发送完毕的缓冲区直接放入发送链表等待下次发送 */
+    knet_buffer_adjust(send_buffer, bytes);
+    dlist_add_tail_node(channel->send_buffer_list, send_buffer);
+    channel->send_bytes += length - (uint32_t)bytes;
+    return error_send_patial;
+}
+
 int knet_channel_update_send(kchannel_t* channel) {
-    kdlist_node_t* node        = 0; /* ͻڵ */
-    kdlist_node_t* temp        = 0; /* ͻʱڵ */
-    kbuffer_t*     send_buffer = 0; /* ͻָ */
-    int            bytes       = 0; /* socket_sendʵʷ͵ֽ */
+    kdlist_node_t* node        = 0; /* 发送缓冲链表节点 */
+    kdlist_node_t* temp        = 0; /* 发送缓冲链表临时节点 */
+    kbuffer_t*     send_buffer = 0; /* 发送缓冲指针 */
+    int            bytes       = 0; /* 调用socket_sendv实际发送的字节 */
+    int            count       = 0; /* 本次聚集发送的缓冲区数量 */
+    int            zerocopy    = 0; /* 本次发送是否使用了MSG_ZEROCOPY */
+    uint32_t       length      = 0; /* 发送缓冲区长度 */
+    uint64_t       file_length = 0; /* 文件区域未发送的长度 */
+    socket_iovec_t iov[SOCKET_IOV_MAX];
     verify(channel);
     verify(channel->send_buffer_list);
-    /*  */
-    dlist_for_each_safe(channel->send_buffer_list, node, temp) {
+    /* 发送链表内所有数据, 每次系统调用最多发送SOCKET_IOV_MAX个缓冲区 */
+    while (!dlist_empty(channel->send_buffer_list)) {
+        node        = dlist_get_front(channel->send_buffer_list);
         send_buffer = (kbuffer_t*)dlist_node_get_data(node);
-        bytes = socket_send(channel->socket_fd, knet_buffer_get_ptr(send_buffer), knet_buffer_get_length(send_buffer));
+        length      = knet_buffer_get_length(send_buffer);
+        if (knet_buffer_get_file_fd(send_buffer) >= 0) {
+            /* 文件区域, 由内核从文件直接发送 */
+            file_length = knet_buffer_get_file_length(send_buffer);
+            length      = (file_length > CHANNEL_SENDFILE_MAX) ? CHANNEL_SENDFILE_MAX : (uint32_t)file_length;
+            bytes       = socket_sendfile(channel->socket_fd, knet_buffer_get_file_fd(send_buffer),
+                knet_buffer_get_file_offset(send_buffer), length);
+            if (bytes < 0) {
+                return error_send_fail;
+            }
+            channel->send_bytes -= (uint64_t)bytes;
+            knet_buffer_adjust_file(send_buffer, bytes);
+            if (knet_buffer_get_file_length(send_buffer)) {
+                if ((uint32_t)bytes < length) {
+                    /* 套接字缓冲区已满 */
+                    return error_send_patial;
+                }
+                continue;
+            }
+            knet_buffer_destroy(send_buffer);
+            dlist_delete(channel->send_buffer_list, node);
+            continue;
+        }
+        if (_channel_zerocopy_check(channel, length)) {
+            /* 大块数据单独使用MSG_ZEROCOPY发送 */
+            bytes = socket_send_zerocopy(channel->socket_fd, knet_buffer_get_ptr(send_buffer), length, &zerocopy);
+            if (bytes < 0) {
+                return error_send_fail;
+            }
+            channel->send_bytes -= (uint64_t)bytes;
+            if (zerocopy) {
+                /* 头部缓冲区被内核引用, 直到通知完成 */
+                channel->zerocopy_head    = 1;
+                channel->zerocopy_head_id = channel->zerocopy_id++;
+            }
+            if (length > (uint32_t)bytes) {
+                if (bytes) {
+                    knet_buffer_adjust(send_buffer, bytes);
+                }
+                return error_send_patial;
+            }
+            _channel_release_buffer(channel, send_buffer);
+            dlist_delete(channel->send_buffer_list, node);
+            continue;
+        }
+        count = 0;
+        dlist_for_each_safe(channel->send_buffer_list, node, temp) {
+            if (count >= SOCKET_IOV_MAX) {
+                break;
+            }
+            send_buffer = (kbuffer_t*)dlist_node_get_data(node);
+            length      = knet_buffer_get_length(send_buffer);
+            if (knet_buffer_get_file_fd(send_buffer) >= 0) {
+                /* 文件区域不能聚集发送 */
+                break;
+            }
+            if (count && _channel_zerocopy_check(channel, length)) {
+                /* 留给下一次MSG_ZEROCOPY发送 */
+                break;
+            }
+            socket_iovec_set(&iov[count], knet_buffer_get_ptr(send_buffer), length);
+            count++;
+        }
+        bytes = socket_sendv(channel->socket_fd, iov, count);
         if (bytes < 0) {
             return error_send_fail;
         }
-        if (knet_buffer_get_length(send_buffer) > (uint32_t)bytes) {
-            /* δϣbufferȣȴ´η */
-            knet_buffer_adjust(send_buffer, bytes);
-            /* ַ */
-            return error_send_patial;
-        } else {
-            /* ѷͽڵ */
-            knet_buffer_destroy(send_buffer);
+        channel->send_bytes -= (uint64_t)bytes;
+        /* 销毁已发送的节点, 调整部分发送的节点 */
+        dlist_for_each_safe(channel->send_buffer_list, node, temp) {
+            send_buffer = (kbuffer_t*)dlist_node_get_data(node);
+            length      = knet_buffer_get_length(send_buffer);
+            if (length > (uint32_t)bytes) {
+                if (bytes) {
+                    /* 本次未发送完毕，调整buffer长度，等待下次发送 */
+                    knet_buffer_adjust(send_buffer, bytes);
+                }
+                /* 部分发送 */
+                return error_send_patial;
+            }
+            bytes -= (int)length;
+            _channel_release_buffer(channel, send_buffer);
             dlist_delete(channel->send_buffer_list, node);
+            if (!--count) {
+                /* 本次提交的缓冲区全部发送 */
+                break;
+            }
         }
     }
-    /* ȫ */
+    /* 全部发送 */
     return error_ok;
 }
 
-int knet_channel_update_recv(kchannel_t* channel) {
-    int      bytes      = 0; /* socket_recvʵʽյֽ */
-    int      recv_bytes = 0; /* յֽ */
-    uint32_t size       = 0; /* ǰдֽ */ 
-    char*    ptr        = 0; /* дʼַ */
+int knet_channel_set_zerocopy_threshold(kchannel_t* channel, uint32_t threshold) {
+    verify(channel);
+    channel->zerocopy_threshold = threshold;
+    if (threshold && !channel->zerocopy_on) {
+        /* 只尝试一次, 失败后不再使用MSG_ZEROCOPY */
+        channel->zerocopy_on = socket_set_zerocopy_on(channel->socket_fd) ? -1 : 1;
+    }
+    return (channel->zerocopy_on > 0) ? error_ok : error_fail;
+}
+
+uint32_t knet_channel_get_zerocopy_threshold(kchannel_t* channel) {
+    verify(channel);
+    return channel->zerocopy_threshold;
+}
+
+uint32_t knet_channel_get_zerocopy_count(kchannel_t* channel) {
+    verify(channel);
+    return channel->zerocopy_id;
+}
+
+int knet_channel_check_zerocopy_pending(kchannel_t* channel) {
+    verify(channel);
+    return (channel->zerocopy_head || (channel->zerocopy_list && !dlist_empty(channel->zerocopy_list)));
+}
+
+int knet_channel_update_zerocopy(kchannel_t* channel, uint32_t* completed, uint32_t* copied) {
+    kdlist_node_t*     node     = 0;
+    kdlist_node_t*     temp     = 0;
+    channel_zerocopy_t* pending = 0;
+    uint32_t           lo       = 0;
+    uint32_t           hi       = 0;
+    int                records  = 0;
+    int                error    = 0;
+    int                is_copy  = 0;
+    verify(channel);
+    verify(completed);
+    verify(copied);
+    *completed = 0;
+    *copied    = 0;
+    for (error = socket_recv_zerocopy(channel->socket_fd, &lo, &hi, &is_copy); error > 0;
+        error = socket_recv_zerocopy(channel->socket_fd, &lo, &hi, &is_copy)) {
+        if (error != 1) {
+            continue;
+        }
+        records++;
+        *completed += hi - lo + 1;
+        if (is_copy) {
+            *copied += hi - lo + 1;
+        }
+        if (!channel->zerocopy_list) {
+            continue;
+        }
+        /* TCP按发送顺序通知完成, 释放序号不大于hi的缓冲区 */
+        dlist_for_each_safe(channel->zerocopy_list, node, temp) {
+            pending = (channel_zerocopy_t*)dlist_node_get_data(node);
+            if ((int32_t)(pending->id - hi) > 0) {
+                break;
+            }
+            knet_buffer_destroy(pending->send_buffer);
+            knet_free(pending);
+            dlist_delete(channel->zerocopy_list, node);
+        }
+    }
+    if (error < 0) {
+        return error_fail;
+    }
+    return records ? error_ok : error_recv_nothing;
+}
+
+int knet_channel_update_recv(kchannel_t* channel, uint32_t budget, uint32_t* syscalls) {
+    int            bytes      = 0; /* 调用socket_recvv实际接收的字节 */
+    int            recv_bytes = 0; /* 接收到字节总数 */
+    uint32_t       size       = 0; /* 读缓冲区当前可写入的字节数 */ 
+    uint32_t       calls      = 0; /* 接收系统调用次数 */
+    char*          ptr[2];         /* 读缓冲区两段可写空间的起始地址 */
+    uint32_t       len[2];         /* 读缓冲区两段可写空间的长度 */
+    socket_iovec_t iov[2];
     verify(channel);
     verify(channel->recv_ringbuffer);
+    if (syscalls) {
+        *syscalls = 0;
+    }
     if (ringbuffer_full(channel->recv_ringbuffer)) {
-        /* ر, , ɸС */
+        /* 读缓冲区满，关闭, 防攻击, 可根据需求调整大小 */
         return error_recv_buffer_full;
     }
-    for (; (size = ringbuffer_write_lock_size(channel->recv_ringbuffer));) {
-        ptr   = ringbuffer_write_lock_ptr(channel->recv_ringbuffer);
-        bytes = socket_recv(channel->socket_fd, ptr, size);
+    for (; (size = ringbuffer_write_lock_segments(channel->recv_ringbuffer, ptr, len));) {
+        if (budget) {
+            if ((uint32_t)recv_bytes >= budget) {
+                /* 达到预算, 剩余数据下一次循环读取 */
+                ringbuffer_write_unlock(channel->recv_ringbuffer);
+                break;
+            }
+            if (size > budget - (uint32_t)recv_bytes) {
+                size = budget - (uint32_t)recv_bytes;
+                if (len[0] >= size) {
+                    len[0] = size;
+                    len[1] = 0;
+                } else {
+                    len[1] = size - len[0];
+                }
+            }
+        }
+        socket_iovec_set(&iov[0], ptr[0], len[0]);
+        socket_iovec_set(&iov[1], ptr[1], len[1]);
+        bytes = socket_recvv(channel->socket_fd, iov, len[1] ? 2 : 1);
+        calls += 1;
+        if (syscalls) {
+            *syscalls = calls;
+        }
         if (bytes < 0) {
-            /* 󣬹ر */
+            /* 错误，关闭 */
             ringbuffer_write_commit(channel->recv_ringbuffer, 0);
             return error_recv_fail;
         } else if (bytes == 0) {
-            /* δյ, ´μ */
+            /* 未接收到, 下次继续接收 */
             ringbuffer_write_commit(channel->recv_ringbuffer, 0);
             return error_ok;
         } else {
             recv_bytes += bytes;
-            /* յ */
+            /* 接收到 */
             ringbuffer_write_commit(channel->recv_ringbuffer, (uint32_t)bytes);
+            if ((uint32_t)bytes < size) {
+                /* 未填满可写空间, 套接字已读空, 省去一次返回EAGAIN的系统调用 */
+                break;
+            }
         }
     }
     if (!recv_bytes) {
-        /* βɽգǹر */
+        /* 本次不能完成接收，非关闭类错误 */
         return error_recv_nothing;
     }
     return error_ok;
@@ -246,9 +553,30 @@ uint32_t knet_channel_get_max_send_list_len(kchannel_t* channel) {
 
 uint32_t knet_channel_get_max_recv_buffer_len(kchannel_t* channel) {
     verify(channel);
+    if (channel->recv_ring_cap) {
+        return channel->recv_ring_cap;
+    }
     return ringbuffer_get_max_size(channel->recv_ringbuffer);
 }
 
+void knet_channel_set_recv_buffer_cap(kchannel_t* channel, uint32_t cap) {
+    verify(channel);
+    channel->recv_ring_cap = cap;
+}
+
+void knet_channel_set_recv_buffer_mirror(kchannel_t* channel, uint32_t size) {
+    verify(channel);
+    verify(ringbuffer_empty(channel->recv_ringbuffer));
+    ringbuffer_destroy(channel->recv_ringbuffer);
+    channel->recv_ringbuffer = ringbuffer_create_mirror(size);
+    verify(channel->recv_ringbuffer);
+}
+
+uint32_t knet_channel_get_recv_buffer_cap(kchannel_t* channel) {
+    verify(channel);
+    return channel->recv_ring_cap;
+}
+
 uint64_t knet_channel_get_uuid(kchannel_t* channel) {
     verify(channel);
     return channel->uuid;
@@ -256,5 +584,35 @@ uint64_t knet_channel_get_uuid(kchannel_t* channel) {
 
 int knet_channel_send_list_reach_max(kchannel_t* channel) {
     verify(channel);
+    if (channel->send_high) {
+        /* 由发送高低水位通知调用者, 不限制缓冲区数量, 调用者忽略通知继续写入时按字节数限制 */
+        return (channel->send_bytes >= (uint64_t)channel->send_high * CHANNEL_SEND_HARD_CAP_FACTOR);
+    }
     return (dlist_get_count(channel->send_buffer_list) > (int)channel->max_send_list_len);
 }
+
+int knet_channel_send_list_empty(kchannel_t* channel) {
+    verify(channel);
+    return dlist_empty(channel->send_buffer_list);
+}
+
+uint64_t knet_channel_get_send_bytes(kchannel_t* channel) {
+    verify(channel);
+    return channel->send_bytes;
+}
+
+void knet_channel_set_send_watermark(kchannel_t* channel, uint32_t high, uint32_t low) {
+    verify(channel);
+    channel->send_high = high;
+    channel->send_low  = low;
+}
+
+uint32_t knet_channel_get_send_high_watermark(kchannel_t* channel) {
+    verify(channel);
+    return channel->send_high;
+}
+
+uint32_t knet_channel_get_send_low_watermark(kchannel_t* channel) {
+    verify(channel);
+    return channel->send_low;
+}
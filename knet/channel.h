@@ -28,134 +28,268 @@
 #include "config.h"
 
 /**
- * һkchannel_tʵ
- * @param max_send_list_len 󳤶
- * @param recv_ring_len ܻ󳤶
- * @return kchannel_tʵ
+ * 创建一个kchannel_t实例
+ * @param max_send_list_len 发送链表最大长度
+ * @param recv_ring_len 接受缓冲区最大长度
+ * @return kchannel_t实例
  */
 kchannel_t* knet_channel_create(uint32_t max_send_list_len, uint32_t recv_ring_len);
 
 /**
- * һkchannel_tʵ
- * @param socket_fd ѽ׽
- * @param max_send_list_len 󳤶
- * @param recv_ring_len ܻ󳤶
- * @return kchannel_tʵ
+ * 创建一个kchannel_t实例
+ * @param socket_fd 已建立的套接字
+ * @param max_send_list_len 发送链表最大长度
+ * @param recv_ring_len 接受缓冲区最大长度
+ * @return kchannel_t实例
  */
 kchannel_t* knet_channel_create_exist_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len);
 
 /**
- * kchannel_tʵ
- * @param channel kchannel_tʵ
+ * 使用socket_accept()接受的套接字创建一个kchannel_t实例
+ * <pre>
+ * 套接字选项已经从监听套接字继承时不再重复设置.
+ * </pre>
+ * @param socket_fd socket_accept()返回的套接字
+ * @param max_send_list_len 发送链表最大长度
+ * @param recv_ring_len 接受缓冲区最大长度
+ * @return kchannel_t实例
+ */
+kchannel_t* knet_channel_create_accepted_socket_fd(socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len);
+
+/**
+ * 销毁kchannel_t实例
+ * @param channel kchannel_t实例
  */
 void knet_channel_destroy(kchannel_t* channel);
 
 /**
- * Ӽ
- * @param channel kchannel_tʵ
+ * 连接监听器
+ * @param channel kchannel_t实例
  * @param ip IP
- * @param port ˿
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_connect(kchannel_t* channel, const char* ip, int port);
 
 /**
- * 
- * @param channel kchannel_tʵ
+ * 监听
+ * @param channel kchannel_t实例
  * @param ip IP
- * @param port ˿
- * @param backlog ȴг
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @param backlog 等待队列长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_accept(kchannel_t* channel, const char* ip, int port, int backlog);
 
 /**
- * ر
- * @param channel kchannel_tʵ
+ * 关闭
+ * @param channel kchannel_t实例
  */
 void knet_channel_close(kchannel_t* channel);
 
 /**
- * 
- * Ϊյʱ򣬻ȳֱӷ͵׽ֻ(zero copy)ŵĩβȴ
- * ʵʱ.
- * @param channel kchannel_tʵ
- * @param data ָ
- * @param size ݳ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 发送
+ * 当发送链表为空的时候，会首先尝试直接发送到套接字缓冲区(zero copy)，否则会放到发送链表末尾等待
+ * 适当时机发送.
+ * @param channel kchannel_t实例
+ * @param data 发送数据指针
+ * @param size 数据长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_send(kchannel_t* channel, const char* data, int size);
 
 /**
- * 
- * ŵĩβȴʵʱ.
- * @param channel kchannel_tʵ
- * @param send_buffer ͻkbuffer_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 发送
+ * 放到发送链表末尾等待适当时机发送.
+ * @param channel kchannel_t实例
+ * @param send_buffer 发送缓冲区kbuffer_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_send_buffer(kchannel_t* channel, kbuffer_t* send_buffer);
 
 /**
- * д¼֪ͨ
- * @param channel kchannel_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 发送
+ * 当发送链表为空的时候，会首先尝试直接发送，未发送完的send_buffer调整后直接放到发送链表末尾,
+ * 不拷贝数据. 发送完毕或失败时销毁send_buffer.
+ * @param channel kchannel_t实例
+ * @param send_buffer 发送缓冲区kbuffer_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+int knet_channel_send_owned(kchannel_t* channel, kbuffer_t* send_buffer);
+
+/**
+ * 可写事件通知
+ * @param channel kchannel_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_update_send(kchannel_t* channel);
 
 /**
- * ɶ¼֪ͨ
- * @param channel kchannel_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 设置使用MSG_ZEROCOPY发送的最小缓冲区长度
+ *
+ * 第一次设置非零值时为套接字开启SO_ZEROCOPY, 系统不支持时不再尝试
+ * @param channel kchannel_t实例
+ * @param threshold 最小缓冲区长度, 0为关闭
+ * @retval error_ok 成功
+ * @retval 其他 系统不支持
+ */
+int knet_channel_set_zerocopy_threshold(kchannel_t* channel, uint32_t threshold);
+
+/**
+ * 取得使用MSG_ZEROCOPY发送的最小缓冲区长度
+ * @param channel kchannel_t实例
+ * @return 最小缓冲区长度
+ */
+uint32_t knet_channel_get_zerocopy_threshold(kchannel_t* channel);
+
+/**
+ * 取得已使用MSG_ZEROCOPY发送的次数
+ * @param channel kchannel_t实例
+ * @return 发送次数
  */
-int knet_channel_update_recv(kchannel_t* channel);
+uint32_t knet_channel_get_zerocopy_count(kchannel_t* channel);
 
 /**
- * ȡ׽
- * @param channel kchannel_tʵ
- * @return ׽
+ * 检查是否有等待内核通知完成的MSG_ZEROCOPY发送
+ * @param channel kchannel_t实例
+ * @retval 0 没有
+ * @retval 非零 有
+ */
+int knet_channel_check_zerocopy_pending(kchannel_t* channel);
+
+/**
+ * 读取套接字错误队列内的MSG_ZEROCOPY完成通知, 释放已完成的缓冲区
+ * @param channel kchannel_t实例
+ * @param completed 返回完成的发送次数
+ * @param copied 返回其中内核实际拷贝了数据的次数
+ * @retval error_ok 读取到完成通知
+ * @retval error_recv_nothing 错误队列内没有完成通知
+ * @retval 其他 失败
+ */
+int knet_channel_update_zerocopy(kchannel_t* channel, uint32_t* completed, uint32_t* copied);
+
+/**
+ * 可读事件通知
+ * <pre>
+ * 读取直到套接字读空, 读缓冲区满或者达到预算.
+ * 读缓冲区写位置绕回时通过一次分散接收同时填充两段可写空间
+ * </pre>
+ * @param channel kchannel_t实例
+ * @param budget 最多读取的字节数, 0为不限制
+ * @param syscalls 返回本次调用的接收系统调用次数, 可以为0
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+int knet_channel_update_recv(kchannel_t* channel, uint32_t budget, uint32_t* syscalls);
+
+/**
+ * 取得套接字
+ * @param channel kchannel_t实例
+ * @return 套接字
  */
 socket_t knet_channel_get_socket_fd(kchannel_t* channel);
 
 /**
- * ȡö
- * @param channel kchannel_tʵ
- * @return kringbuffer_tʵ
+ * 取得读缓冲区
+ * @param channel kchannel_t实例
+ * @return kringbuffer_t实例
  */
 kringbuffer_t* knet_channel_get_ringbuffer(kchannel_t* channel);
 
 /**
- * ȡ÷󳤶
- * @param channel kchannel_tʵ
- * @return 󳤶
+ * 取得发送链表最大长度限制
+ * @param channel kchannel_t实例
+ * @return 发送链表最大长度限制
  */
 uint32_t knet_channel_get_max_send_list_len(kchannel_t* channel);
 
 /**
- * ȡýջ󳤶
- * @param channel kchannel_tʵ
- * @return ջ󳤶
+ * 取得接收缓冲区最大长度限制
+ * @param channel kchannel_t实例
+ * @return 接收缓冲区最大长度限制
  */
 uint32_t knet_channel_get_max_recv_buffer_len(kchannel_t* channel);
 
 /**
- * ȡܵUUID
- * @param channel kchannel_tʵ
- * @return ܵUUID
+ * 设置弹性读缓冲区的最大长度
+ * @param channel kchannel_t实例
+ * @param cap 最大长度, 0为固定长度的读缓冲区
+ */
+void knet_channel_set_recv_buffer_cap(kchannel_t* channel, uint32_t cap);
+
+/**
+ * 取得弹性读缓冲区的最大长度
+ * @param channel kchannel_t实例
+ * @return 最大长度, 0为固定长度的读缓冲区
+ */
+uint32_t knet_channel_get_recv_buffer_cap(kchannel_t* channel);
+
+/**
+ * 读缓冲区更换为双重映射的ringbuffer, 只能在接收数据前调用
+ * @param channel kchannel_t实例
+ * @param size 读缓冲区最大长度
+ */
+void knet_channel_set_recv_buffer_mirror(kchannel_t* channel, uint32_t size);
+
+/**
+ * 获取管道UUID
+ * @param channel kchannel_t实例
+ * @return 管道UUID
  */
 uint64_t knet_channel_get_uuid(kchannel_t* channel);
 
 /**
- * ڻǷﵽ
- * @param channel kchannel_tʵ
- * @retval 0 
- * @retval  
+ * 发送链表内缓冲区数量是否达到最大
+ * <pre>
+ * 设置了发送高水位后不再限制缓冲区数量, 未发送字节数达到高水位的4倍时认为已满
+ * </pre>
+ * @param channel kchannel_t实例
+ * @retval 0 不是
+ * @retval 非零 是
  */
 int knet_channel_send_list_reach_max(kchannel_t* channel);
 
+/**
+ * 取得发送链表内未发送的字节数
+ * @param channel kchannel_t实例
+ * @return 未发送的字节数
+ */
+uint64_t knet_channel_get_send_bytes(kchannel_t* channel);
+
+/**
+ * 设置发送高低水位
+ * @param channel kchannel_t实例
+ * @param high 高水位（字节）, 0为关闭
+ * @param low 低水位（字节）
+ */
+void knet_channel_set_send_watermark(kchannel_t* channel, uint32_t high, uint32_t low);
+
+/**
+ * 取得发送高水位
+ * @param channel kchannel_t实例
+ * @return 高水位（字节）, 0为关闭
+ */
+uint32_t knet_channel_get_send_high_watermark(kchannel_t* channel);
+
+/**
+ * 取得发送低水位
+ * @param channel kchannel_t实例
+ * @return 低水位（字节）
+ */
+uint32_t knet_channel_get_send_low_watermark(kchannel_t* channel);
+
+/**
+ * 发送链表是否为空
+ * @param channel kchannel_t实例
+ * @retval 0 不为空
+ * @retval 非零 为空
+ */
+int knet_channel_send_list_empty(kchannel_t* channel);
+
 #endif /* CHANNEL_H */
\ No newline at end of file
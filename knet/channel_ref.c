@@ -36,56 +36,333 @@
 #include "timer.h"
 
 /**
- * ܵϢ
+ * 管道信息
  */
 typedef struct _channel_ref_info_t {
-    /* ݳԱ */
-    int                           balance;              /* Ƿ񱻸ؾ־ */
-    kchannel_t*                   channel;              /* ڲܵ */
-    kdlist_node_t*                loop_node;            /* ܵڵ, ˽ڵԲ */
-    kstream_t*                    stream;               /* ܵ(/д) */
-    kloop_t*                      loop;                 /* ܵkloop_t */
-    kaddress_t*                   peer_address;         /* Զ˵ַ */
-    kaddress_t*                   local_address;        /* صַ */
-    knet_channel_event_e          event;                /* ܵͶ¼ */
-    volatile knet_channel_state_e state;                /* ܵ״̬ */
-    atomic_counter_t              ref_count;            /* ü */
-    knet_channel_ref_cb_t         cb;                   /* ص */
-    time_t                        last_recv_ts;         /* һζʱ룩 */
-    time_t                        timeout;              /* гʱ룩 */
-    time_t                        last_connect_timeout; /* һconnect()ʱ룩 */
-    time_t                        connect_timeout;      /* connect()ʱ룩 */
-    int                           auto_reconnect;       /* Զ־ */
-    int                           flag;                 /* ѡȡʹԶ־λ */
-    void*                         data;                 /* ѡȡʹԶ */
-    void*                         user_data;            /* ûָ - ڲʹ */
-    void*                         user_ptr;             /* ¶ⲿʹõָ - ⲿʹ */
-    /* չݳԱ */
+    /* 基础数据成员 */
+    int                           balance;              /* 是否被负载均衡标志 */
+    kchannel_t*                   channel;              /* 内部管道 */
+    kdlist_node_t*                loop_node;            /* 管道链表节点, 保存此节点可以不需遍历链表搜索 */
+    kdlist_node_t*                ready_node;           /* 就绪链表节点 */
+    kstream_t*                    stream;               /* 管道(读/写)数据流 */
+    kloop_t*                      loop;                 /* 管道所关联的kloop_t */
+    kaddress_t*                   peer_address;         /* 对端地址 */
+    kaddress_t*                   local_address;        /* 本地地址 */
+    knet_channel_event_e          event;                /* 管道投递事件 */
+    volatile knet_channel_state_e state;                /* 管道状态 */
+    atomic_counter_t              ref_count;            /* 引用计数 */
+    knet_channel_ref_cb_t         cb;                   /* 回调 */
+    uint64_t                      last_recv_ts;         /* 最后一次读操作时间戳（毫秒） */
+    time_t                        timeout;              /* 读空闲超时（秒） */
+    uint64_t                      last_connect_timeout; /* 最后一次connect()超时时间戳（毫秒） */
+    time_t                        connect_timeout;      /* connect()超时间隔（秒） */
+    int                           auto_reconnect;       /* 自动重连标志 */
+    int                           flag;                 /* 选取器所使用自定义标志位 */
+    void*                         data;                 /* 选取器所使用自定义数据 */
+    void*                         user_data;            /* 用户数据指针 - 内部使用 */
+    void*                         user_ptr;             /* 暴露给外部使用的数据指针 - 外部使用 */
+    /* 扩展数据成员 */
     /*
-     * ktimer_stopرնʱ, ʱڶʱѭڱ, ܵʱ
+     * 调用ktimer_stop将关闭定时器, 定时器将在定时器循环内被销毁, 管道将不清理定时器
      */
-    ktimer_t*    recv_timeout_timer;    /* гʱʱ */
-    ktimer_t*    connect_timeout_timer; /* ӳʱʱ */
-    volatile int close_cb_called;       /* ر¼ǷѾ */
+    ktimer_t*                     recv_timeout_timer;   /* 读空闲超时定时器 */
+    ktimer_t*                     connect_timeout_timer; /* 连接超时定时器 */
+    volatile int                  close_cb_called;      /* 关闭事件是否已经触发过 */
+    int                           recv_pending;         /* 上次读操作因读缓冲区满而未读空套接字 */
+    int                           recv_backpressure;    /* 读缓冲区满时暂停读取而不是关闭管道 */
+    int                           recv_paused;          /* 因读缓冲区满已经暂停读取 */
+    int                           reuseport;            /* SO_REUSEPORT监听模式, 0 未开启, 1 开启, 2 其他kloop_t上的分片监听器 */
+    kchannel_ref_t*               relay_target;         /* 中继目标管道 */
+    kchannel_ref_t*               relay_source;         /* 中继来源管道 */
+    int                           relay_pipe[2];        /* splice()使用的管道, -1表示通过读缓冲区拷贝 */
+    uint32_t                      relay_pending;        /* 管道内还未写入目标管道的字节数 */
+    int                           send_high;            /* 未发送字节数已达到高水位, 等待回落到低水位 */
+    knet_channel_cork_e           cork;                 /* 写合并方式 */
+    kbuffer_t*                    cork_buffer;          /* 合并写缓冲区, 本次循环迭代结束时放入发送链表 */
+    kdlist_node_t*                cork_node;            /* 合并写链表节点 */
+    kdlist_node_t*                buffer_node;          /* 持有弹性读缓冲区的管道链表节点 */
+    int                           tcp_corked;           /* 已经开启TCP_CORK, 发送链表清空时关闭 */
 } channel_ref_info_t;
 
 /**
- * ܵ
+ * 单次splice()最多移动的字节数, 与内核管道默认容量相同
+ */
+#define RELAY_SPLICE_MAX 65536
+
+/**
+ * 合并写缓冲区的最小长度
+ */
+#define CORK_CHUNK_SIZE 16384
+
+/**
+ * SO_REUSEPORT分片监听参数
+ */
+typedef struct _reuseport_param_t {
+    kchannel_ref_t* channel_ref; /* 主监听管道 */
+    const char*     ip;          /* IP */
+    int             port;        /* 端口 */
+    int             backlog;     /* 等待队列上限 */
+} reuseport_param_t;
+
+/**
+ * 管道引用
  */
 struct _channel_ref_t {
-    int                 share;     /* Ƿͨknet_channel_ref_share() */
-    uint64_t            domain_id; /* ID */
-    kdlist_node_t*      list_node; /* ڵ */
-    channel_ref_info_t* ref_info;  /* ܵϢ */
+    int                 share;     /* 是否通过knet_channel_ref_share()创建 */
+    uint64_t            domain_id; /* 域ID */
+    kdlist_node_t*      list_node; /* 域链表节点 */
+    channel_ref_info_t* ref_info;  /* 管道信息 */
 };
 
 /**
- * ܵʱص
- * @param timer ܵʱ
- * @param data ָܵ
+ * 管道定时器回调
+ * @param timer 管道定时器
+ * @param data 管道指针
  */
 void timer_cb(ktimer_t* timer, void* data);
 
+/**
+ * 在负载均衡器关联的kloop_t上建立分片监听器
+ * @param loop kloop_t实例
+ * @param param reuseport_param_t实例
+ * @retval 0 继续遍历
+ */
+int _accept_shard(kloop_t* loop, void* param);
+
+/**
+ * 新建立的管道继承原有管道的设置
+ * <pre>
+ * 接受的管道和SO_REUSEPORT分片监听器继承监听管道, 重连时新建立的管道继承重连前的管道,
+ * 新增需要继承的设置只需要修改这里
+ * </pre>
+ * @param source 监听管道或重连前的管道
+ * @param target 新建立的管道
+ */
+void _inherit_settings(kchannel_ref_t* source, kchannel_ref_t* target);
+
+/**
+ * 按kloop_t的配置设置管道的MSG_ZEROCOPY阈值
+ * @param channel_ref kchannel_ref_t实例
+ * @return 设置前管道已使用MSG_ZEROCOPY发送的次数
+ */
+uint32_t _zerocopy_prepare(kchannel_ref_t* channel_ref);
+
+/**
+ * 记录本次发送使用MSG_ZEROCOPY的次数
+ * @param channel_ref kchannel_ref_t实例
+ * @param count _zerocopy_prepare()的返回值
+ */
+void _zerocopy_commit(kchannel_ref_t* channel_ref, uint32_t count);
+
+/**
+ * 通过splice()中继, 在来源管道可读或目标管道可写时调用
+ * @param channel_ref 来源管道
+ * @retval error_ok 成功, 包括任意一端暂时无法继续
+ * @retval 其他 来源管道读取失败
+ */
+int _relay_update(kchannel_ref_t* channel_ref);
+
+/**
+ * 解除管道的中继关系(作为来源或目标)
+ * @param channel_ref kchannel_ref_t实例
+ * @param flush 非零时将内核管道内剩余的数据写入仍然活跃的目标管道
+ */
+void _relay_unbind(kchannel_ref_t* channel_ref, int flush);
+
+/**
+ * 读缓冲区有新数据, 中继到目标管道或调用回调
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _recv_notify(kchannel_ref_t* channel_ref);
+
+/**
+ * 弹性读缓冲区已满时扩大一倍, 直到最大长度; 未分配时分配初始长度
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _recv_buffer_reserve(kchannel_ref_t* channel_ref);
+
+/**
+ * 弹性读缓冲区为空时归还到内存池
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _recv_buffer_release(kchannel_ref_t* channel_ref);
+
+/**
+ * 读缓冲区是否已满且不能再扩大
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 未满或者还可以扩大
+ * @retval 非零 已满
+ */
+int _recv_buffer_full(kchannel_ref_t* channel_ref);
+
+/**
+ * 未发送字节数越过高水位或回落到低水位时调用回调
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _send_watermark_check(kchannel_ref_t* channel_ref);
+
+/**
+ * 发送链表已经清空, 取消写事件, 下次套接字不可写时再注册, 关闭TCP_CORK发送剩余的未满报文段
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _send_drained(kchannel_ref_t* channel_ref);
+
+/**
+ * 关闭已经开启的TCP_CORK
+ * @param channel_ref kchannel_ref_t实例
+ */
+void _tcp_uncork(kchannel_ref_t* channel_ref);
+
+/**
+ * 写入合并写缓冲区, 本次循环迭代结束时发送
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 数据
+ * @param size 数据长度
+ * @retval error_ok 成功
+ * @retval error_no_memory 内存不足
+ */
+int _cork_write(kchannel_ref_t* channel_ref, const char* data, int size);
+
+/**
+ * 合并写缓冲区放入发送链表末尾, 不发送
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 没有合并的数据
+ * @retval error_send_patial 已放入发送链表
+ * @retval error_send_fail 发送链表已满
+ */
+int _cork_append(kchannel_ref_t* channel_ref);
+
+void _recv_buffer_reserve(kchannel_ref_t* channel_ref) {
+    kchannel_t*    channel = channel_ref->ref_info->channel;
+    kloop_t*       loop    = channel_ref->ref_info->loop;
+    kringbuffer_t* rb      = knet_channel_get_ringbuffer(channel);
+    uint32_t       cap     = knet_channel_get_recv_buffer_cap(channel);
+    uint32_t       size    = ringbuffer_get_max_size(rb);
+    uint32_t       length  = 0;
+    char*          ptr     = 0;
+    char*          old     = 0;
+    if (!cap || (size >= cap) || !ringbuffer_full(rb)) {
+        return;
+    }
+    if (size) {
+        length = (size > cap / 2) ? cap : size * 2;
+    } else {
+        length = knet_loop_get_recv_buffer_init(loop);
+        if (!length || (length > cap)) {
+            /* 已经关闭弹性读缓冲区 */
+            length = cap;
+        }
+    }
+    ptr = knet_loop_alloc_recv_buffer(loop, length);
+    verify(ptr);
+    if (error_ok != ringbuffer_swap(rb, ptr, length, &old)) {
+        knet_loop_free_recv_buffer(loop, ptr, length);
+        return;
+    }
+    if (old) {
+        knet_loop_free_recv_buffer(loop, old, size);
+    } else {
+        /* 新分配的缓冲区由回收定时器检查 */
+        knet_loop_add_buffer_channel_ref(loop, channel_ref);
+    }
+}
+
+void _recv_buffer_release(kchannel_ref_t* channel_ref) {
+    kchannel_t*    channel = channel_ref->ref_info->channel;
+    kringbuffer_t* rb      = knet_channel_get_ringbuffer(channel);
+    uint32_t       size    = ringbuffer_get_max_size(rb);
+    char*          old     = 0;
+    if (!knet_channel_get_recv_buffer_cap(channel) || !size || !ringbuffer_empty(rb)) {
+        return;
+    }
+    if (error_ok != ringbuffer_swap(rb, 0, 0, &old)) {
+        return;
+    }
+    if (old) {
+        knet_loop_free_recv_buffer(channel_ref->ref_info->loop, old, size);
+    }
+    knet_loop_remove_buffer_channel_ref(channel_ref->ref_info->loop, channel_ref);
+}
+
+int _recv_buffer_full(kchannel_ref_t* channel_ref) {
+    kchannel_t*    channel = channel_ref->ref_info->channel;
+    kringbuffer_t* rb      = knet_channel_get_ringbuffer(channel);
+    if (!ringbuffer_full(rb)) {
+        return 0;
+    }
+    return (ringbuffer_get_max_size(rb) >= knet_channel_get_recv_buffer_cap(channel));
+}
+
+void _send_drained(kchannel_ref_t* channel_ref) {
+    if (!knet_channel_send_list_empty(channel_ref->ref_info->channel)) {
+        return;
+    }
+    if (knet_channel_ref_check_event(channel_ref, channel_event_send)) {
+        knet_channel_ref_clear_event(channel_ref, channel_event_send);
+    }
+    _tcp_uncork(channel_ref);
+}
+
+void _tcp_uncork(kchannel_ref_t* channel_ref) {
+    if (!channel_ref->ref_info->tcp_corked) {
+        return;
+    }
+    socket_set_cork(knet_channel_get_socket_fd(channel_ref->ref_info->channel), 0);
+    channel_ref->ref_info->tcp_corked = 0;
+}
+
+void _send_watermark_check(kchannel_ref_t* channel_ref) {
+    kchannel_t* channel = channel_ref->ref_info->channel;
+    uint64_t    bytes   = knet_channel_ref_get_send_bytes(channel_ref);
+    if (!knet_channel_get_send_high_watermark(channel)) {
+        return;
+    }
+    if (!channel_ref->ref_info->send_high) {
+        if (bytes < knet_channel_get_send_high_watermark(channel)) {
+            return;
+        }
+        channel_ref->ref_info->send_high = 1;
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(channel_ref, channel_cb_event_send_high);
+        }
+    } else {
+        if (bytes > knet_channel_get_send_low_watermark(channel)) {
+            return;
+        }
+        channel_ref->ref_info->send_high = 0;
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(channel_ref, channel_cb_event_drain);
+        }
+    }
+}
+
+int _cork_write(kchannel_ref_t* channel_ref, const char* data, int size) {
+    kbuffer_t* cork_buffer = channel_ref->ref_info->cork_buffer;
+    if (cork_buffer && knet_buffer_put(cork_buffer, data, (uint32_t)size)) {
+        return error_ok;
+    }
+    if (cork_buffer && (error_send_fail == _cork_append(channel_ref))) {
+        return error_send_fail;
+    }
+    cork_buffer = knet_buffer_create((size > CORK_CHUNK_SIZE) ? (uint32_t)size : CORK_CHUNK_SIZE);
+    if (!cork_buffer) {
+        return error_no_memory;
+    }
+    knet_buffer_put(cork_buffer, data, (uint32_t)size);
+    channel_ref->ref_info->cork_buffer = cork_buffer;
+    knet_loop_add_cork_channel_ref(channel_ref->ref_info->loop, channel_ref);
+    return error_ok;
+}
+
+int _cork_append(kchannel_ref_t* channel_ref) {
+    kbuffer_t* cork_buffer = channel_ref->ref_info->cork_buffer;
+    if (!cork_buffer) {
+        return error_ok;
+    }
+    channel_ref->ref_info->cork_buffer = 0;
+    return knet_channel_send_buffer(channel_ref->ref_info->channel, cork_buffer);
+}
+
 kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel) {
     kchannel_ref_t* channel_ref = create(kchannel_ref_t);
     verify(channel_ref);
@@ -98,9 +375,9 @@ kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel) {
     channel_ref->ref_info->channel      = channel;
     channel_ref->ref_info->ref_count    = 0;
     channel_ref->ref_info->loop         = loop;
-    channel_ref->ref_info->last_recv_ts = time(0);
+    channel_ref->ref_info->last_recv_ts = knet_loop_get_time(loop);
     channel_ref->ref_info->state        = channel_state_init;
-    /* ¼ͳ */
+    /* 记录统计数据 */
     knet_loop_profile_increase_active_channel_count(knet_loop_get_profile(loop));
     return channel_ref;
 }
@@ -109,41 +386,57 @@ int knet_channel_ref_destroy(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     if (channel_ref->ref_info) {        
         if (channel_ref->ref_info->state == channel_state_init) {
-            /* δ뵽 */
+            /* 未被加入到链表内 */
             knet_channel_close(channel_ref->ref_info->channel);
         }
-        /* ü */
+        /* 检测引用计数 */
         if (!atomic_counter_zero(&channel_ref->ref_info->ref_count)) {
             return error_ref_nonzero;
         }
-        /* ٶԶ˵ַ */
+        /* 解除中继 */
+        _relay_unbind(channel_ref, 0);
+        /* 销毁对端地址 */
         if (channel_ref->ref_info->peer_address) {
             knet_address_destroy(channel_ref->ref_info->peer_address);
         }
-        /* ٱصַ */
+        /* 销毁本地地址 */
         if (channel_ref->ref_info->local_address) {
             knet_address_destroy(channel_ref->ref_info->local_address);
         }
-        /* ֪ͨѡȡɾܵԴ */
-        if ((channel_ref->ref_info->state != channel_state_init) && /* Ѿ뵽loopܵ */
+        /* 通知选取器删除管道相关资源 */
+        if ((channel_ref->ref_info->state != channel_state_init) && /* 已经被加入到loop管道链表 */
             channel_ref->ref_info->loop) {
             knet_impl_remove_channel_ref(channel_ref->ref_info->loop, channel_ref);
         }
-        /* ٹܵ */
+        /* 销毁未发送的合并数据 */
+        if (channel_ref->ref_info->cork_node) {
+            knet_loop_remove_cork_channel_ref(channel_ref->ref_info->loop, channel_ref);
+        }
+        if (channel_ref->ref_info->cork_buffer) {
+            knet_buffer_destroy(channel_ref->ref_info->cork_buffer);
+        }
+        /* 销毁管道 */
         if (channel_ref->ref_info->channel) {
+            /* 弹性读缓冲区归还到内存池, 未读取的数据丢弃 */
+            ringbuffer_eat_all(knet_channel_get_ringbuffer(channel_ref->ref_info->channel));
+            _recv_buffer_release(channel_ref);
+            if (channel_ref->ref_info->buffer_node) {
+                /* 读缓冲区被锁定而未能归还, 随管道一起销毁 */
+                knet_loop_remove_buffer_channel_ref(channel_ref->ref_info->loop, channel_ref);
+            }
             knet_channel_destroy(channel_ref->ref_info->channel);
         }
-        /*  */
+        /* 销毁数据流 */
         if (channel_ref->ref_info->stream) {
             stream_destroy(channel_ref->ref_info->stream);
         }
-        /* ٶʱ */
+        /* 销毁定时器 */
         knet_channel_ref_stop_connect_timeout_timer(channel_ref);
         knet_channel_ref_stop_recv_timeout_timer(channel_ref);
-        /* ٹܵϢ */
+        /* 销毁管道信息 */
         knet_free(channel_ref->ref_info);
     }
-    /* ٹܵ */
+    /* 销毁管道引用 */
     knet_free(channel_ref);
     return error_ok;
 }
@@ -157,105 +450,95 @@ int knet_channel_ref_connect(kchannel_ref_t* channel_ref, const char* ip, int po
         ip = "127.0.0.1";
     }
     if (knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
-        /* Ѿ״̬ */
+        /* 已经处于连接状态 */
         return error_connect_in_progress;
     }
     if (!channel_ref->ref_info->peer_address) {
-        /* Զ˵ַ */
+        /* 建立对端地址对象 */
         channel_ref->ref_info->peer_address = knet_address_create();        
     }
-    /* öԶ˵ַ */
+    /* 设置对端地址 */
     knet_address_set(channel_ref->ref_info->peer_address, ip, port);
     if (timeout > 0) {
         channel_ref->ref_info->connect_timeout = timeout;
-        /* óʱʱ */
-        channel_ref->ref_info->last_connect_timeout = time(0) + timeout;
+        /* 设置超时时间戳, 可能在loop迭代之外调用, 先刷新缓存的时间戳 */
+        channel_ref->ref_info->last_connect_timeout = knet_loop_update_time(channel_ref->ref_info->loop) + timeout * 1000;
     }
-    /* Ŀܾʧ */
+    /* 如果目标积极拒绝，返回失败 */
     error = knet_channel_connect(channel_ref->ref_info->channel, ip, port);
     if (error_ok != error) {
         return error;
     }
     log_verb("start connecting to IP[%s], port[%d]", ip, port);
-    /* ؾ */
+    /* 负载均衡 */
     loop = knet_channel_ref_choose_loop(channel_ref);
     if (loop) {
-        /* ԭloopactiveܵ */
+        /* 减少原loop的active管道数量 */
         knet_loop_profile_decrease_active_channel_count(
             knet_loop_get_profile(channel_ref->ref_info->loop));
-        /* Ŀloop */
+        /* 设置目标loop */
         channel_ref->ref_info->loop = loop;
-        /* Ŀloopactiveܵ */
+        /* 增加目标loop的active管道数量 */
         knet_loop_profile_increase_active_channel_count(knet_loop_get_profile(loop));
-        /* ӵloop */
+        /* 添加到其他loop */
         knet_loop_notify_connect(loop, channel_ref);
         return error_ok;
     }
-    /* ǰ߳ڷ */
+    /* 当前线程内发起连接 */
     return knet_channel_ref_connect_in_loop(channel_ref);
 }
 
 int knet_channel_ref_reconnect(kchannel_ref_t* channel_ref, int timeout) {
-    int                   error               = error_ok; /*  */
+    int                   error               = error_ok; /* 错误码 */
     char                  ip[32]              = {0};      /* IP */
-    int                   port                = 0;        /* ˿ */
-    kchannel_ref_t*       new_channel         = 0;        /* ʱ½Ĺܵ */
-    kaddress_t*           peer_address        = 0;        /* Զ˵ַ */
-    time_t                connect_timeout     = 0;        /* ӳʱ() */
-    knet_channel_ref_cb_t cb                  = 0;        /* ܵص */
+    int                   port                = 0;        /* 端口 */
+    kchannel_ref_t*       new_channel         = 0;        /* 重连时新建立的管道 */
+    kaddress_t*           peer_address        = 0;        /* 对端地址 */
+    time_t                connect_timeout     = 0;        /* 连接超时(秒) */
     kloop_t*              loop                = 0;        /* loop */
-    uint32_t              max_send_list_len   = 0;        /* 󳤶 */
-    uint32_t              max_recv_buffer_len = 0;        /* ջ󳤶 */
-    int                   auto_reconnect      = 0;        /* Զ־ */
-    void*                 user_data           = 0;        /* ڲʹָ */
-    void*                 ptr                 = 0;        /* ûָ */
+    uint32_t              max_send_list_len   = 0;        /* 发送链表最大长度 */
+    uint32_t              max_recv_buffer_len = 0;        /* 接收缓冲区最大长度 */
+    int                   auto_reconnect      = 0;        /* 自动重连标志 */
     verify(channel_ref);
     verify(channel_ref->ref_info);
     verify(channel_ref->ref_info->channel);
     if (!knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
-        /* δ״̬Ĺܵ */
+        /* 未处于正在连接状态的管道不能重连 */
         return error_channel_not_connect;
     }
-    /* ȡԭйܵ */
+    /* 获取原有管道属性 */
     loop                = knet_channel_ref_get_loop(channel_ref);
     max_send_list_len   = knet_channel_get_max_send_list_len(channel_ref->ref_info->channel);
     max_recv_buffer_len = knet_channel_get_max_recv_buffer_len(channel_ref->ref_info->channel);
-    cb                  = knet_channel_ref_get_cb(channel_ref);
-    user_data           = knet_channel_ref_get_user_data(channel_ref);
-    ptr                 = knet_channel_ref_get_ptr(channel_ref);
     auto_reconnect      = knet_channel_ref_check_auto_reconnect(channel_ref);
     peer_address        = channel_ref->ref_info->peer_address;
     verify(peer_address);
     strcpy(ip, address_get_ip(peer_address));
     port = address_get_port(peer_address);
-    /* ¹ܵ */
+    /* 建立新管道 */
     new_channel = knet_loop_create_channel(loop, max_send_list_len, max_recv_buffer_len);
     verify(new_channel);
     if (timeout > 0) {
-        /* µĳʱʱ */
+        /* 设置新的超时时间戳 */
         connect_timeout = timeout;
     } else {
-        /* ʹԭеĳʱʱ */
+        /* 使用原有的超时时间戳 */
         if (channel_ref->ref_info->connect_timeout) {
             connect_timeout = channel_ref->ref_info->connect_timeout;
         }
     }
-    /* ԭлص */
-    knet_channel_ref_set_cb(new_channel, cb);
-    /* ԭû */
-    knet_channel_ref_set_user_data(new_channel, user_data);
-    /* ûָ */
-    knet_channel_ref_set_ptr(new_channel, ptr);
-    /* Զ־ */
+    /* 设置原有回调, 用户数据等 */
+    _inherit_settings(channel_ref, new_channel);
+    /* 设置自动重连标志 */
     knet_channel_ref_set_auto_reconnect(new_channel, auto_reconnect);
-    /* ӳʱʱ */
+    /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
-    /* µ */
+    /* 启动新的连接器 */
     error = knet_channel_ref_connect(new_channel, ip, port, (int)connect_timeout);
     if (error_ok != error) {
         return error;
     }
-    /* ԭйܵ */
+    /* 销毁原有管道 */
     knet_channel_ref_close(channel_ref);
     return error;
 }
@@ -270,54 +553,417 @@ int knet_channel_ref_check_auto_reconnect(kchannel_ref_t* channel_ref) {
     return channel_ref->ref_info->auto_reconnect;
 }
 
+void knet_channel_ref_set_recv_backpressure(kchannel_ref_t* channel_ref, int on) {
+    verify(channel_ref);
+    channel_ref->ref_info->recv_backpressure = on;
+    if (!on) {
+        /* 关闭时恢复已暂停的读取 */
+        knet_channel_ref_resume_recv(channel_ref);
+    }
+}
+
+int knet_channel_ref_check_recv_backpressure(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->recv_backpressure;
+}
+
+int knet_channel_ref_set_send_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low) {
+    verify(channel_ref);
+    if (high && (low >= high)) {
+        return error_invalid_parameters;
+    }
+    knet_channel_set_send_watermark(channel_ref->ref_info->channel, high, high ? low : 0);
+    /* 按新的水位重新判断 */
+    channel_ref->ref_info->send_high = 0;
+    return error_ok;
+}
+
+uint32_t knet_channel_ref_get_send_high_watermark(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return knet_channel_get_send_high_watermark(channel_ref->ref_info->channel);
+}
+
+uint32_t knet_channel_ref_get_send_low_watermark(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return knet_channel_get_send_low_watermark(channel_ref->ref_info->channel);
+}
+
+uint64_t knet_channel_ref_get_send_bytes(kchannel_ref_t* channel_ref) {
+    uint64_t bytes = 0;
+    verify(channel_ref);
+    bytes = knet_channel_get_send_bytes(channel_ref->ref_info->channel);
+    if (channel_ref->ref_info->cork_buffer) {
+        /* 还未放入发送链表的合并数据 */
+        bytes += knet_buffer_get_length(channel_ref->ref_info->cork_buffer);
+    }
+    return bytes;
+}
+
+void knet_channel_ref_set_auto_cork(kchannel_ref_t* channel_ref, knet_channel_cork_e cork) {
+    verify(channel_ref);
+    channel_ref->ref_info->cork = cork;
+    if (cork == channel_cork_off) {
+        /* 立即发送已经合并的数据 */
+        knet_channel_ref_flush_cork(channel_ref);
+    }
+    if ((cork != channel_cork_tcp) && channel_ref->ref_info->channel) {
+        /* 发送链表内剩余的数据不再等待凑满报文段 */
+        _tcp_uncork(channel_ref);
+    }
+}
+
+knet_channel_cork_e knet_channel_ref_get_auto_cork(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->cork;
+}
+
+void knet_channel_ref_flush_cork(kchannel_ref_t* channel_ref) {
+    int      error = error_ok;
+    uint32_t count = 0;
+    verify(channel_ref);
+    if (channel_ref->ref_info->cork_node) {
+        knet_loop_remove_cork_channel_ref(channel_ref->ref_info->loop, channel_ref);
+    }
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return;
+    }
+    if (error_send_fail == _cork_append(channel_ref)) {
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        return;
+    }
+    if (knet_channel_send_list_empty(channel_ref->ref_info->channel)) {
+        return;
+    }
+    if ((channel_ref->ref_info->cork == channel_cork_tcp) && !channel_ref->ref_info->tcp_corked) {
+        /* 发送链表内的数据凑满报文段后再发送, 直到发送链表清空 */
+        if (!socket_set_cork(knet_channel_get_socket_fd(channel_ref->ref_info->channel), 1)) {
+            channel_ref->ref_info->tcp_corked = 1;
+        }
+    }
+    /* 发送链表内所有数据, 包括本次迭代内写入的其他缓冲区 */
+    count = _zerocopy_prepare(channel_ref);
+    error = knet_channel_update_send(channel_ref->ref_info->channel);
+    _zerocopy_commit(channel_ref, count);
+    switch (error) {
+    case error_send_patial:
+        knet_channel_ref_set_event(channel_ref, channel_event_send);
+        _send_watermark_check(channel_ref);
+        break;
+    case error_send_fail: /* 发送失败 */
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        break;
+    default:
+        _send_drained(channel_ref);
+        _send_watermark_check(channel_ref);
+        break;
+    }
+}
+
+void knet_channel_ref_shrink_recv_buffer(kchannel_ref_t* channel_ref, uint64_t idle) {
+    verify(channel_ref);
+    if (!knet_channel_get_recv_buffer_cap(channel_ref->ref_info->channel)) {
+        return;
+    }
+    if (knet_loop_get_time(channel_ref->ref_info->loop) - channel_ref->ref_info->last_recv_ts < idle) {
+        return;
+    }
+    _recv_buffer_release(channel_ref);
+}
+
+uint32_t knet_channel_ref_get_recv_buffer_size(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return ringbuffer_get_max_size(knet_channel_get_ringbuffer(channel_ref->ref_info->channel));
+}
+
+void knet_channel_ref_resume_recv(kchannel_ref_t* channel_ref) {
+    kringbuffer_t* rb = 0;
+    verify(channel_ref);
+    if (!channel_ref->ref_info->recv_paused) {
+        return;
+    }
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return;
+    }
+    rb = knet_channel_get_ringbuffer(channel_ref->ref_info->channel);
+    if (ringbuffer_available(rb) > ringbuffer_get_max_size(rb) / 2) {
+        /* 取出到一半以下才恢复, 避免每取出少量数据就暂停和恢复一次 */
+        return;
+    }
+    channel_ref->ref_info->recv_paused = 0;
+    /* 重新注册读事件, 套接字内已有的数据会再次触发读事件 */
+    knet_channel_ref_set_event(channel_ref, channel_event_recv);
+}
+
 void knet_channel_ref_accept_async(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    /* ӵԾܵ */
+    /* 添加到活跃管道链表 */
     knet_loop_add_channel_ref(channel_ref->ref_info->loop, channel_ref);
-    /* ùܵ״̬ */
+    /* 设置管道状态 */
     knet_channel_ref_set_state(channel_ref, channel_state_accept);
-    /* ùע¼ */
+    /* 设置关注事件 */
     knet_channel_ref_set_event(channel_ref, channel_event_recv);
 }
 
 int knet_channel_ref_accept(kchannel_ref_t* channel_ref, const char* ip, int port, int backlog) {
-    int         error     = 0; /*  */
-    thread_id_t thread_id = 0; /* loopڵ߳ID */
+    int         error     = 0; /* 错误码 */
+    thread_id_t thread_id = 0; /* loop所在的线程ID */
     verify(channel_ref);
     verify(port);
     if (knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
-        /* Ѿڼ״̬ */
+        /* 已经处于监听状态 */
         return error_accept_in_progress;
     }
-    /*  */
+    if (channel_ref->ref_info->reuseport) {
+        /* 必须在bind()之前设置 */
+        if (socket_set_reuse_port_on(knet_channel_get_socket_fd(channel_ref->ref_info->channel))) {
+            log_error("knet_channel_ref_accept() failed, reason: SO_REUSEPORT not supported");
+            return error_reuseport_fail;
+        }
+    }
+    /* 监听 */
     error = knet_channel_accept(channel_ref->ref_info->channel, ip, port, backlog);
     if (error == error_ok) {
+        if ((channel_ref->ref_info->reuseport == 1) && knet_loop_get_balancer(channel_ref->ref_info->loop)) {
+            /* 每个kloop_t建立自己的监听器, 由内核分配连接, 不再跨线程转交 */
+            reuseport_param_t param;
+            param.channel_ref = channel_ref;
+            param.ip          = ip;
+            param.port        = port;
+            param.backlog     = backlog;
+            knet_loop_balancer_for_each(knet_loop_get_balancer(channel_ref->ref_info->loop), _accept_shard, &param);
+        }
         thread_id = knet_loop_get_thread_id(channel_ref->ref_info->loop);
-        if (thread_id) { /* kloop_tĳ߳й */
-            if (thread_id != thread_get_self_id()) { /* ߳ */
+        if (thread_id) { /* kloop_t在某个线程运行过 */
+            if (thread_id != thread_get_self_id()) { /* 跨线程启动监听器 */
                 knet_loop_notify_accept_async(channel_ref->ref_info->loop, channel_ref);
                 return error;
             }
         }
-        /* ǰ߳ */
+        /* 当前线程内 */
         knet_loop_add_channel_ref(channel_ref->ref_info->loop, channel_ref);
-        /* Ϊ״̬ */
+        /* 设置为监听状态 */
         knet_channel_ref_set_state(channel_ref, channel_state_accept);
-        /* Ͷݶ¼ */
+        /* 投递读事件 */
         knet_channel_ref_set_event(channel_ref, channel_event_recv);
     }
     return error;
 }
 
+uint32_t _zerocopy_prepare(kchannel_ref_t* channel_ref) {
+    kchannel_t* channel   = channel_ref->ref_info->channel;
+    uint32_t    threshold = (uint32_t)knet_loop_get_zerocopy_threshold(channel_ref->ref_info->loop);
+    if (threshold != knet_channel_get_zerocopy_threshold(channel)) {
+        knet_channel_set_zerocopy_threshold(channel, threshold);
+    }
+    return knet_channel_get_zerocopy_count(channel);
+}
+
+void _zerocopy_commit(kchannel_ref_t* channel_ref, uint32_t count) {
+    count = knet_channel_get_zerocopy_count(channel_ref->ref_info->channel) - count;
+    if (count) {
+        knet_loop_profile_add_zerocopy_send(knet_loop_get_profile(channel_ref->ref_info->loop), count);
+    }
+}
+
+int _relay_update(kchannel_ref_t* channel_ref) {
+    channel_ref_info_t* info    = channel_ref->ref_info;
+    kchannel_ref_t*     target  = info->relay_target;
+    kloop_t*            loop    = info->loop;
+    int                 budget  = knet_loop_get_read_budget(loop);
+    int                 bytes   = 0;
+    uint32_t            relayed = 0;
+    for (;;) {
+        if (info->relay_pending) {
+            if (!knet_channel_send_list_empty(target->ref_info->channel)) {
+                /* 先发送目标管道内已有的数据 */
+                knet_channel_ref_set_event(target, channel_event_send);
+                return error_ok;
+            }
+            bytes = socket_splice(info->relay_pipe[0], knet_channel_ref_get_socket_fd(target), info->relay_pending);
+            if (bytes < 0) {
+                knet_channel_ref_close_check_reconnect(target);
+                return error_ok;
+            }
+            if (!bytes) {
+                /* 目标不可写, 停止读取来源, 等待目标可写 */
+                knet_channel_ref_set_event(target, channel_event_send);
+                return error_ok;
+            }
+            info->relay_pending -= (uint32_t)bytes;
+            relayed += (uint32_t)bytes;
+            knet_loop_profile_add_relay_bytes(knet_loop_get_profile(loop), bytes);
+            continue;
+        }
+        if (budget && (relayed >= (uint32_t)budget)) {
+            /* 达到预算, 下一次循环继续 */
+            knet_loop_add_ready_channel_ref(loop, channel_ref);
+            return error_ok;
+        }
+        /* 管道为空时才从套接字读取, 返回0即表示套接字已读空 */
+        bytes = socket_splice(knet_channel_ref_get_socket_fd(channel_ref), info->relay_pipe[1], RELAY_SPLICE_MAX);
+        if (bytes < 0) {
+            return error_recv_fail;
+        }
+        if (!bytes) {
+            return error_ok;
+        }
+        info->relay_pending += (uint32_t)bytes;
+    }
+}
+
+void _relay_unbind(kchannel_ref_t* channel_ref, int flush) {
+    channel_ref_info_t* info   = channel_ref->ref_info;
+    kchannel_ref_t*     source = info->relay_source;
+    char*               buffer = 0;
+    uint32_t            length = 0;
+    int                 bytes  = 0;
+    if (source) {
+        /* 先断开来源, 双向中继时避免重复进入 */
+        info->relay_source = 0;
+        _relay_unbind(source, flush);
+    }
+    if (!info->relay_target) {
+        return;
+    }
+    if (info->relay_pipe[0] >= 0) {
+        if (flush && info->relay_pending && knet_channel_ref_check_state(info->relay_target, channel_state_active)) {
+            /* 剩余数据作为一个缓冲区写入目标管道, 不占用多个发送链表节点 */
+            buffer = create_raw(info->relay_pending);
+            verify(buffer);
+            while (length < info->relay_pending) {
+                bytes = splice_pipe_read(info->relay_pipe, buffer + length, info->relay_pending - length);
+                if (bytes <= 0) {
+                    break;
+                }
+                length += (uint32_t)bytes;
+            }
+            if (length) {
+                knet_loop_profile_add_relay_bytes(knet_loop_get_profile(info->loop), length);
+                knet_channel_ref_write_buffer(info->relay_target, buffer, (int)length, knet_free);
+            } else {
+                knet_free(buffer);
+            }
+        }
+        splice_pipe_close(info->relay_pipe);
+    }
+    info->relay_pending = 0;
+    info->relay_target->ref_info->relay_source = 0;
+    info->relay_target = 0;
+}
+
+void _recv_notify(kchannel_ref_t* channel_ref) {
+    int bytes = 0;
+    if (channel_ref->ref_info->relay_target) {
+        /* 中继到目标管道 */
+        bytes = knet_stream_available(channel_ref->ref_info->stream);
+        if (error_ok == knet_stream_push_stream(channel_ref->ref_info->stream,
+            knet_channel_ref_get_stream(channel_ref->ref_info->relay_target))) {
+            knet_loop_profile_add_relay_bytes(knet_loop_get_profile(channel_ref->ref_info->loop), bytes);
+        }
+    } else if (channel_ref->ref_info->cb) {
+        /* 调用回调 */
+        channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv);
+    }
+}
+
+int knet_channel_ref_relay(kchannel_ref_t* channel_ref, kchannel_ref_t* target) {
+    channel_ref_info_t* info = 0;
+    verify(channel_ref);
+    info = channel_ref->ref_info;
+    if (!target) {
+        if (info->relay_target) {
+            _relay_unbind(channel_ref, 1);
+        }
+        return error_ok;
+    }
+    if ((target->ref_info == info) || (target->ref_info->loop != info->loop)) {
+        return error_invalid_channel;
+    }
+    if (info->relay_target || target->ref_info->relay_source) {
+        /* 一个管道只能有一个中继目标, 也只能被一个管道中继 */
+        return error_invalid_channel;
+    }
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active) ||
+        !knet_channel_ref_check_state(target, channel_state_active)) {
+        return error_not_connected;
+    }
+    /* 不支持splice()时通过读缓冲区拷贝 */
+    splice_pipe_create(info->relay_pipe);
+    info->relay_pending = 0;
+    info->relay_target  = target;
+    target->ref_info->relay_source = channel_ref;
+    if (knet_stream_available(info->stream)) {
+        /* 读缓冲区内已有的数据 */
+        _recv_notify(channel_ref);
+    }
+    if (info->relay_pipe[0] >= 0) {
+        /* 套接字内可能已有数据, 边缘触发不会再次通知 */
+        knet_loop_add_ready_channel_ref(info->loop, channel_ref);
+    }
+    return error_ok;
+}
+
+int _accept_shard(kloop_t* loop, void* param) {
+    reuseport_param_t* reuseport = (reuseport_param_t*)param;
+    channel_ref_info_t* info     = reuseport->channel_ref->ref_info;
+    kchannel_ref_t*    shard     = 0;
+    int                error     = error_ok;
+    if (loop == info->loop) {
+        return 0;
+    }
+    /* 未开启loop_balancer_in配置的kloop_t不接受连接 */
+    if (!knet_loop_check_balance_options(loop, loop_balancer_in)) {
+        return 0;
+    }
+    shard = knet_loop_create_channel(loop, knet_channel_get_max_send_list_len(info->channel),
+        knet_channel_get_max_recv_buffer_len(info->channel));
+    verify(shard);
+    _inherit_settings(reuseport->channel_ref, shard);
+    shard->ref_info->reuseport = 2;
+    error = knet_channel_ref_accept(shard, reuseport->ip, reuseport->port, reuseport->backlog);
+    if (error != error_ok) {
+        log_error("SO_REUSEPORT shard listener failed, error: %d", error);
+        knet_channel_ref_destroy(shard);
+    }
+    return 0;
+}
+
+void _inherit_settings(kchannel_ref_t* source, kchannel_ref_t* target) {
+    channel_ref_info_t* info = source->ref_info;
+    knet_channel_ref_set_user_data(target, info->user_data);
+    knet_channel_ref_set_ptr(target, info->user_ptr);
+    /* 设置回调 */
+    knet_channel_ref_set_cb(target, info->cb);
+    /* 设置读空闲超时 */
+    knet_channel_ref_set_timeout(target, (int)info->timeout);
+    /* 设置读缓冲区满时的处理方式 */
+    knet_channel_ref_set_recv_backpressure(target, info->recv_backpressure);
+    /* 设置发送高低水位 */
+    knet_channel_ref_set_send_watermark(target, knet_channel_get_send_high_watermark(info->channel),
+        knet_channel_get_send_low_watermark(info->channel));
+    /* 设置写合并方式 */
+    knet_channel_ref_set_auto_cork(target, info->cork);
+}
+
+void knet_channel_ref_set_reuseport(kchannel_ref_t* channel_ref, int reuseport) {
+    verify(channel_ref);
+    channel_ref->ref_info->reuseport = reuseport ? 1 : 0;
+}
+
+int knet_channel_ref_check_reuseport(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->reuseport;
+}
+
 kchannel_ref_t* knet_channel_ref_share(kchannel_ref_t* channel_ref) {
     kchannel_ref_t* channel_ref_shared = 0;
     verify(channel_ref);
     channel_ref_shared = create(kchannel_ref_t);
     verify(channel_ref_shared);
     memset(channel_ref_shared, 0, sizeof(kchannel_ref_t));
-    /* ӹܵü */
+    /* 增加管道引用计数 */
     atomic_counter_inc(&channel_ref->ref_info->ref_count);
-    /* ܵϢָ */
+    /* 共享管道信息指针 */
     channel_ref_shared->ref_info = channel_ref->ref_info;
     channel_ref_shared->share = 1;
     return channel_ref_shared;
@@ -325,9 +971,9 @@ kchannel_ref_t* knet_channel_ref_share(kchannel_ref_t* channel_ref) {
 
 void knet_channel_ref_leave(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    /* ݼü */
+    /* 递减引用计数 */
     atomic_counter_dec(&channel_ref->ref_info->ref_count);
-    /* ܵϢkloop_t */
+    /* 管道信息最终由kloop_t销毁 */
     knet_free(channel_ref);
 }
 
@@ -335,33 +981,41 @@ void knet_channel_ref_update_close_in_loop(kloop_t* loop, kchannel_ref_t* channe
     verify(loop);
     verify(channel_ref);
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
-        /* Ѿӳٹر */
+        /* 已经在延迟关闭链表内 */
         return;
     }
-    /* Ϊر״̬ */
+    if (channel_ref->ref_info->cork_buffer) {
+        /* 尽量发送关闭前合并的数据, 与关闭前直接写入的行为一致 */
+        if (error_send_patial == _cork_append(channel_ref)) {
+            knet_channel_update_send(channel_ref->ref_info->channel);
+        }
+    }
+    /* 设置为关闭状态 */
     knet_channel_ref_set_state(channel_ref, channel_state_close);
-    /* ȡͶݶд¼ */
+    /* 解除中继, 已经读入内核管道的数据写入仍然活跃的目标管道 */
+    _relay_unbind(channel_ref, 1);
+    /* 取消投递读和写事件 */
     knet_channel_ref_clear_event(channel_ref, channel_event_recv | channel_event_send);
-    /* رչܵ */
+    /* 关闭管道 */
     knet_channel_close(channel_ref->ref_info->channel);
-    /* رչܵ */
+    /* 关闭管道引用 */
     knet_loop_close_channel_ref(channel_ref->ref_info->loop, channel_ref);
-    /* ٽճʱʱ */
+    /* 销毁接收超时定时器 */
     knet_channel_ref_stop_recv_timeout_timer(channel_ref);
-    /* ӳʱʱ */
+    /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
 }
 
 void knet_channel_ref_close_check_reconnect(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     if (knet_channel_ref_check_auto_reconnect(channel_ref)) {
-        /* Զ */
-        /* α쵱ǰ״̬ */
+        /* 自动重连 */
+        /* 伪造当前状态 */
         knet_channel_ref_set_state(channel_ref, channel_state_connect);
-        /*  */
+        /* 重连 */
         knet_channel_ref_reconnect(channel_ref, 0);
     } else {
-        /* رչܵ */
+        /* 关闭管道 */
         knet_channel_ref_close(channel_ref);
     }
 }
@@ -371,20 +1025,20 @@ void knet_channel_ref_close(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     loop = channel_ref->ref_info->loop;
     if (!knet_loop_get_thread_id(loop) || (channel_ref->ref_info->state == channel_state_init)) {
-        /* δ뵽 */
+        /* 未被加入到链表内 */
         knet_channel_ref_destroy(channel_ref);
         return;
     }
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
-        /* Ѿڹر */
+        /* 已经在关闭链表内 */
         return;
     }
     if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
-        /* ֪ͨܵ߳ */
+        /* 通知管道所属线程 */
         log_info("close channel cross thread, notify thread[id:%ld]", knet_loop_get_thread_id(loop));
         knet_loop_notify_close(loop, channel_ref);
     } else {
-        /* ߳ڹر */
+        /* 本线程内关闭 */
         log_info("close channel[%llu] in loop thread[id: %ld]", knet_channel_ref_get_uuid(channel_ref), knet_loop_get_thread_id(loop));
         knet_channel_ref_update_close_in_loop(loop, channel_ref);
     }
@@ -400,16 +1054,24 @@ void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel
     verify(loop);
     verify(channel_ref);
     verify(send_buffer);
-    /* ¼ͳ */
-    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), knet_buffer_get_length(send_buffer));
-    /*  */
+    /* 记录统计数据 */
+    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop),
+        knet_buffer_get_length(send_buffer) + knet_buffer_get_file_length(send_buffer));
+    /* 已经合并的数据在前, 保持写入顺序 */
+    if (error_send_fail == _cork_append(channel_ref)) {
+        knet_buffer_destroy(send_buffer);
+        knet_channel_ref_close_check_reconnect(channel_ref);
+        return;
+    }
+    /* 处理发送 */
     error = knet_channel_send_buffer(channel_ref->ref_info->channel, send_buffer);
     switch (error) {
-    case error_send_patial: /* ַͳɹ */
-        /* Ͷд¼ */
+    case error_send_patial: /* 部分发送成功 */
+        /* 继续投递写事件 */
         knet_channel_ref_set_event(channel_ref, channel_event_send);
+        _send_watermark_check(channel_ref);
         break;
-    case error_send_fail: /* ʧ */
+    case error_send_fail: /* 发送失败 */
         knet_channel_ref_close_check_reconnect(channel_ref);
         break;
     default:
@@ -417,6 +1079,26 @@ void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel
     }
 }
 
+void knet_channel_ref_update_write_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, const char* data, int size) {
+    int error = error_ok;
+    verify(loop);
+    verify(channel_ref);
+    verify(data);
+    verify(size);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        /* 批次提交后管道已经关闭 */
+        return;
+    }
+    knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
+    /* 同一批次内写入同一管道的数据合并, 本次循环迭代结束时一次发送 */
+    error = _cork_write(channel_ref, data, size);
+    if (error == error_ok) {
+        _send_watermark_check(channel_ref);
+    } else if (error == error_send_fail) {
+        knet_channel_ref_close_check_reconnect(channel_ref);
+    }
+}
+
 int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int size) {
     kloop_t*   loop        = 0;
     kbuffer_t* send_buffer = 0;
@@ -429,28 +1111,44 @@ int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int si
     }
     loop = channel_ref->ref_info->loop;
     if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
-        /* תloop̷߳ */
+        /* 转到loop所在线程发送 */
         log_info("send cross thread, notify thread[id:%ld]", knet_loop_get_thread_id(loop));
         send_buffer = knet_buffer_create(size);
         verify(send_buffer);
         if (!send_buffer) {
             return error_no_memory;
         }
-        /*  */
+        /* 打包到缓冲区 */
         knet_buffer_put(send_buffer, data, size);
-        /* ֪ͨĿ߳ */
+        /* 通知目标线程 */
         knet_loop_notify_send(loop, channel_ref, send_buffer);
     } else {
         knet_loop_profile_add_send_bytes(knet_loop_get_profile(channel_ref->ref_info->loop), size);
-        /* ǰ̷߳ */
+        if (channel_ref->ref_info->cork != channel_cork_off) {
+            /* 合并到本次循环迭代结束时发送 */
+            error = _cork_write(channel_ref, data, size);
+            if (error == error_ok) {
+                _send_watermark_check(channel_ref);
+            } else if (error == error_send_fail) {
+                knet_channel_ref_close_check_reconnect(channel_ref);
+            }
+            return error;
+        }
+        /* 批量写入合并的数据在前, 保持写入顺序 */
+        if (error_send_fail == _cork_append(channel_ref)) {
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            return error_send_fail;
+        }
+        /* 当前线程发送 */
         error = knet_channel_send(channel_ref->ref_info->channel, data, size);
         switch (error) {
         case error_send_patial:
             knet_channel_ref_set_event(channel_ref, channel_event_send);
-            /* ڵ߲Ǵ */
+            /* 对于调用者不是错误 */
             error = error_ok;
+            _send_watermark_check(channel_ref);
             break;
-        case error_send_fail: /* ʧ */
+        case error_send_fail: /* 发送失败 */
             knet_channel_ref_close_check_reconnect(channel_ref);
             break;
         default:
@@ -460,6 +1158,91 @@ int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int si
     return error;
 }
 
+int knet_channel_ref_write_buffer(kchannel_ref_t* channel_ref, char* data, int size, knet_buffer_free_cb_t free_cb) {
+    kloop_t*   loop        = 0;
+    kbuffer_t* send_buffer = 0;
+    int        error       = error_ok;
+    uint32_t   count       = 0;
+    verify(channel_ref);
+    verify(data);
+    verify(size);
+    verify(free_cb);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        free_cb(data);
+        return error_not_connected;
+    }
+    /* 不拷贝数据, 缓冲区负责释放data */
+    send_buffer = knet_buffer_create_owned(data, size, free_cb);
+    if (!send_buffer) {
+        return error_no_memory;
+    }
+    loop = channel_ref->ref_info->loop;
+    if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
+        /* 转到loop所在线程发送 */
+        knet_loop_notify_send(loop, channel_ref, send_buffer);
+    } else {
+        knet_loop_profile_add_send_bytes(knet_loop_get_profile(loop), size);
+        /* 已经合并的数据在前, 保持写入顺序 */
+        if (error_send_fail == _cork_append(channel_ref)) {
+            knet_buffer_destroy(send_buffer);
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            return error_send_fail;
+        }
+        /* 当前线程发送, 大块数据可能使用MSG_ZEROCOPY */
+        count = _zerocopy_prepare(channel_ref);
+        error = knet_channel_send_owned(channel_ref->ref_info->channel, send_buffer);
+        _zerocopy_commit(channel_ref, count);
+        switch (error) {
+        case error_send_patial:
+            knet_channel_ref_set_event(channel_ref, channel_event_send);
+            /* 对于调用者不是错误 */
+            error = error_ok;
+            _send_watermark_check(channel_ref);
+            break;
+        case error_send_fail: /* 发送失败 */
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            break;
+        default:
+            break;
+        }
+    }
+    return error;
+}
+
+int knet_channel_ref_send_file(kchannel_ref_t* channel_ref, int fd, uint64_t offset, uint64_t length) {
+    kloop_t*   loop        = 0;
+    kbuffer_t* send_buffer = 0;
+    verify(channel_ref);
+    verify(fd >= 0);
+    verify(length);
+    if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+        return error_not_connected;
+    }
+    loop = channel_ref->ref_info->loop;
+    if (knet_loop_get_thread_id(loop) == thread_get_self_id()) {
+        /* 缓冲区销毁时会关闭fd, 建立前检查发送链表, 失败时fd仍由调用者负责关闭 */
+        if (error_send_fail == _cork_append(channel_ref)) {
+            knet_channel_ref_close_check_reconnect(channel_ref);
+            return error_send_fail;
+        }
+        if (knet_channel_send_list_reach_max(channel_ref->ref_info->channel)) {
+            return error_send_fail;
+        }
+    }
+    send_buffer = knet_buffer_create_file(fd, offset, length);
+    if (!send_buffer) {
+        return error_no_memory;
+    }
+    if (knet_loop_get_thread_id(loop) != thread_get_self_id()) {
+        /* 转到loop所在线程发送 */
+        knet_loop_notify_send(loop, channel_ref, send_buffer);
+    } else {
+        /* 放入发送链表末尾, 与之前写入的数据保持顺序, 套接字可写时发送 */
+        knet_channel_ref_update_send_in_loop(loop, channel_ref, send_buffer);
+    }
+    return error_ok;
+}
+
 socket_t knet_channel_ref_get_socket_fd(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     return knet_channel_get_socket_fd(channel_ref->ref_info->channel);
@@ -476,7 +1259,7 @@ kloop_t* knet_channel_ref_get_loop(kchannel_ref_t* channel_ref) {
 }
 
 void knet_channel_ref_set_loop_node(kchannel_ref_t* channel_ref, kdlist_node_t* node) {
-    verify(channel_ref); /* nodeΪ0 */
+    verify(channel_ref); /* node可以为0 */
     channel_ref->ref_info->loop_node = node;
 }
 
@@ -485,6 +1268,36 @@ kdlist_node_t* knet_channel_ref_get_loop_node(kchannel_ref_t* channel_ref) {
     return channel_ref->ref_info->loop_node;
 }
 
+void knet_channel_ref_set_ready_node(kchannel_ref_t* channel_ref, kdlist_node_t* node) {
+    verify(channel_ref);
+    channel_ref->ref_info->ready_node = node;
+}
+
+kdlist_node_t* knet_channel_ref_get_ready_node(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->ready_node;
+}
+
+void knet_channel_ref_set_cork_node(kchannel_ref_t* channel_ref, kdlist_node_t* node) {
+    verify(channel_ref);
+    channel_ref->ref_info->cork_node = node;
+}
+
+kdlist_node_t* knet_channel_ref_get_cork_node(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->cork_node;
+}
+
+void knet_channel_ref_set_buffer_node(kchannel_ref_t* channel_ref, kdlist_node_t* node) {
+    verify(channel_ref);
+    channel_ref->ref_info->buffer_node = node;
+}
+
+kdlist_node_t* knet_channel_ref_get_buffer_node(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    return channel_ref->ref_info->buffer_node;
+}
+
 void knet_channel_ref_set_event(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
     verify(channel_ref);
     knet_impl_event_add(channel_ref, e);
@@ -518,11 +1331,11 @@ int knet_channel_ref_check_event(kchannel_ref_t* channel_ref, knet_channel_event
 }
 
 kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event) {
-    kchannel_t*     acceptor_channel    = 0; /* ܵ */
-    uint32_t        max_send_list_len   = 0; /*  */
-    uint32_t        max_ringbuffer_size = 0; /* ܻ */
-    kchannel_t*     client_channel      = 0; /* ͻ˹ܵ */
-    kchannel_ref_t* client_ref          = 0; /* ͻ˹ܵ */
+    kchannel_t*     acceptor_channel    = 0; /* 监听管道 */
+    uint32_t        max_send_list_len   = 0; /* 最大发送链表长度 */
+    uint32_t        max_ringbuffer_size = 0; /* 最大接受缓冲区长度 */
+    kchannel_t*     client_channel      = 0; /* 客户端管道 */
+    kchannel_ref_t* client_ref          = 0; /* 客户端管道引用 */
     verify(channel_ref);
     verify(channel_ref->ref_info);
     verify(client_fd > 0);
@@ -532,20 +1345,32 @@ kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_r
     if (!max_send_list_len) {
         max_send_list_len = INT_MAX;
     }
-    max_ringbuffer_size = ringbuffer_get_max_size(knet_channel_get_ringbuffer(acceptor_channel));
+    max_ringbuffer_size = knet_channel_get_max_recv_buffer_len(acceptor_channel);
     if (!max_ringbuffer_size) {
-        max_ringbuffer_size = 16 * 1024; /* Ĭ16K */
+        max_ringbuffer_size = 16 * 1024; /* 默认16K */
+    }
+    /* 建立客户端管道 */
+    if (knet_loop_check_recv_buffer_elastic(loop, max_ringbuffer_size)) {
+        /* 弹性读缓冲区在第一次可读时分配 */
+        client_channel = knet_channel_create_accepted_socket_fd(client_fd, max_send_list_len, 0);
+        verify(client_channel);
+        knet_channel_set_recv_buffer_cap(client_channel, max_ringbuffer_size);
+    } else if (knet_loop_check_recv_buffer_mirror(loop, max_ringbuffer_size)) {
+        /* 双重映射读缓冲区 */
+        client_channel = knet_channel_create_accepted_socket_fd(client_fd, max_send_list_len, 0);
+        verify(client_channel);
+        knet_channel_set_recv_buffer_mirror(client_channel, max_ringbuffer_size);
+    } else {
+        client_channel = knet_channel_create_accepted_socket_fd(client_fd, max_send_list_len, max_ringbuffer_size);
+        verify(client_channel);
     }
-    /* ͻ˹ܵ */
-    client_channel = knet_channel_create_exist_socket_fd(client_fd, max_send_list_len, max_ringbuffer_size);
-    verify(client_channel);
-    /* ܵ */
+    /* 建立管道引用 */
     client_ref = knet_channel_ref_create(loop, client_channel);
     verify(client_ref);
     if (event) {
-        /* ӵǰ߳loop */
+        /* 添加到当前线程loop */
         knet_loop_add_channel_ref(channel_ref->ref_info->loop, client_ref);
-        /* ͬʱ¼״̬ */
+        /* 创建的同时设置事件和状态 */
         knet_channel_ref_set_state(client_ref, channel_state_active);
         knet_channel_ref_set_event(client_ref, channel_event_recv);
     }
@@ -553,50 +1378,68 @@ kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_r
 }
 
 void knet_channel_ref_update_accept(kchannel_ref_t* channel_ref) {
-    kchannel_ref_t* client_ref = 0;
-    kloop_t*        loop       = 0;
-    socket_t        client_fd  = 0;
+    kloop_t*  loop      = 0;
+    socket_t  client_fd = 0;
+    socket_t  fd        = 0;
+    int       budget    = 0;
+    int       count     = 0;
     verify(channel_ref);
-    /* 鿴ѡȡǷԶʵ */
+    /* 查看选取器是否有自定义实现, 自定义实现每次完成一个连接 */
     client_fd = knet_impl_channel_accept(channel_ref);
-    if (!client_fd) {
-        /* Ĭʵ */
-        client_fd = socket_accept(knet_channel_get_socket_fd(channel_ref->ref_info->channel));
-    }
-    if (client_fd <= 0) {
+    if (client_fd > 0) {
+        knet_channel_ref_set_state(channel_ref, channel_state_accept);
+        knet_channel_ref_set_event(channel_ref, channel_event_recv);
+        knet_channel_ref_accept_client(channel_ref, knet_channel_ref_choose_loop(channel_ref), client_fd);
         return;
     }
+    /* 默认实现, 边缘触发时必须接受到EAGAIN, 否则剩余的连接不会再次通知 */
+    fd     = knet_channel_get_socket_fd(channel_ref->ref_info->channel);
+    budget = knet_loop_get_accept_budget(channel_ref->ref_info->loop);
+    for (;;) {
+        if (budget && (count >= budget)) {
+            /* 达到预算, 剩余连接下一次循环再接受 */
+            knet_loop_add_ready_channel_ref(channel_ref->ref_info->loop, channel_ref);
+            break;
+        }
+        client_fd = socket_accept(fd);
+        if (client_fd <= 0) {
+            break;
+        }
+        count++;
+        /* 每个连接单独做负载均衡选择, 突发的连接分散到多个loop */
+        loop = knet_channel_ref_choose_loop(channel_ref);
+        knet_channel_ref_accept_client(channel_ref, loop, client_fd);
+        if (!knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+            /* 回调内关闭了监听管道 */
+            return;
+        }
+    }
+    /* 没有接受到连接(虚假唤醒, EMFILE等)也要重新投递, 单次通知的选取器不会再次通知 */
     knet_channel_ref_set_state(channel_ref, channel_state_accept);
     knet_channel_ref_set_event(channel_ref, channel_event_recv);
-    if (client_fd) {
-        loop = knet_channel_ref_choose_loop(channel_ref);
-        if (loop) {
-            client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, loop, client_fd, 0);
-            verify(client_ref);
-            knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
-            knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
-            /* ûص */
-            knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
-            /* öгʱ */
-            knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
-            /* ӵloop */
-            knet_loop_notify_accept(loop, client_ref);
-        } else {
-            client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, channel_ref->ref_info->loop, client_fd, 1);
-            verify(client_ref);
-            knet_channel_ref_set_user_data(client_ref, channel_ref->ref_info->user_data);
-            knet_channel_ref_set_ptr(client_ref, channel_ref->ref_info->user_ptr);
-            /* ûص */
-            knet_channel_ref_set_cb(client_ref, channel_ref->ref_info->cb);
-            /* öгʱ */
-            knet_channel_ref_set_timeout(client_ref, (int)channel_ref->ref_info->timeout);
-            /* ûص */
-            if (channel_ref->ref_info->cb) {
-                channel_ref->ref_info->cb(client_ref, channel_cb_event_accept);
-            }
-            /* ճʱʱ */
-            knet_channel_ref_start_recv_timeout_timer(client_ref);
+}
+
+void knet_channel_ref_accept_client(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd) {
+    kchannel_ref_t* client_ref = 0;
+    verify(channel_ref);
+    if (loop) {
+        client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, loop, client_fd, 0);
+        verify(client_ref);
+        /* 继承监听管道的设置 */
+        _inherit_settings(channel_ref, client_ref);
+        /* 添加到其他loop */
+        knet_loop_notify_accept(loop, client_ref);
+    } else {
+        client_ref = knet_channel_ref_accept_from_socket_fd(channel_ref, channel_ref->ref_info->loop, client_fd, 1);
+        verify(client_ref);
+        /* 继承监听管道的设置 */
+        _inherit_settings(channel_ref, client_ref);
+        /* 调用回调 */
+        if (channel_ref->ref_info->cb) {
+            channel_ref->ref_info->cb(client_ref, channel_cb_event_accept);
         }
+        /* 建立接收超时定时器 */
+        knet_channel_ref_start_recv_timeout_timer(client_ref);
     }
 }
 
@@ -604,9 +1447,9 @@ int knet_channel_ref_start_connect_timeout_timer(kchannel_ref_t* channel_ref) {
     int       error         = error_ok;
     ktimer_t* connect_timer = 0;
     verify(channel_ref);
-    /*  */
+    /* 销毁 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
-    /* µ */
+    /* 建立新的 */
     if (channel_ref->ref_info->connect_timeout) {
         connect_timer = ktimer_create(knet_loop_get_timer_loop(channel_ref->ref_info->loop));
         verify(connect_timer);
@@ -623,14 +1466,14 @@ int knet_channel_ref_start_recv_timeout_timer(kchannel_ref_t* channel_ref) {
     int       error      = error_ok;
     ktimer_t* recv_timer = 0;
     verify(channel_ref);
-    /*  */
+    /* 销毁 */
     knet_channel_ref_stop_recv_timeout_timer(channel_ref);
-    /* µ */
+    /* 建立新的 */
     if (channel_ref->ref_info->timeout) {
-        /* ʱ */
+        /* 建立定时器 */
         recv_timer = ktimer_create(knet_loop_get_timer_loop(channel_ref->ref_info->loop));
         verify(recv_timer);
-        /* ʱ */
+        /* 启动定时器 */
         error = ktimer_start(recv_timer, knet_channel_ref_get_timer_cb(channel_ref),
             channel_ref, channel_ref->ref_info->timeout * 1000);
         if (error == error_ok) {
@@ -643,9 +1486,9 @@ int knet_channel_ref_start_recv_timeout_timer(kchannel_ref_t* channel_ref) {
 void knet_channel_ref_stop_recv_timeout_timer(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
     if (channel_ref->ref_info->recv_timeout_timer) {
-        /* ֹͣʱ */
+        /* 停止定时器 */
         ktimer_stop(channel_ref->ref_info->recv_timeout_timer);
-        /*  */
+        /* 置零 */
         channel_ref->ref_info->recv_timeout_timer = 0;
     }
 }
@@ -653,73 +1496,74 @@ void knet_channel_ref_stop_recv_timeout_timer(kchannel_ref_t* channel_ref) {
 void knet_channel_ref_update_accept_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* ӵǰ߳loop */
+    /* 添加到当前线程loop */
     knet_loop_add_channel_ref(loop, channel_ref);
-    /* ùܵΪԾ״̬ */
+    /* 设置管道为活跃状态 */
     knet_channel_ref_set_state(channel_ref, channel_state_active);
-    /* Ͷݶ¼ */
+    /* 投递读事件 */
     knet_channel_ref_set_event(channel_ref, channel_event_recv);    
     if (channel_ref->ref_info->cb) {
-        /* ûص */
+        /* 调用回调 */
         channel_ref->ref_info->cb(channel_ref, channel_cb_event_accept);
     }
-    /* ճʱʱ */
+    /* 建立接收超时定时器 */
     knet_channel_ref_start_recv_timeout_timer(channel_ref);
 }
 
 void knet_channel_ref_stop_connect_timeout_timer(kchannel_ref_t* channel_ref) {
     if (channel_ref->ref_info->connect_timeout_timer) {
-        /* ֹͣʱ */
+        /* 停止定时器 */
         ktimer_stop(channel_ref->ref_info->connect_timeout_timer);
-        /*  */
+        /* 置零 */
         channel_ref->ref_info->connect_timeout_timer = 0;
     }
 }
 
 void knet_channel_ref_update_connect(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    /* Ͷݶ¼ */
+    /* 投递读事件 */
     knet_channel_ref_set_event(channel_ref, channel_event_recv);
-    /* лܵΪԾ״̬ */
+    /* 切换管道为活跃状态 */
     knet_channel_ref_set_state(channel_ref, channel_state_active);
     if (channel_ref->ref_info->cb) {
-        /* ûص */
+        /* 调用回调 */
         log_error("channel connectd, channel[%llu]", knet_channel_ref_get_uuid(channel_ref));
         channel_ref->ref_info->cb(channel_ref, channel_cb_event_connect);
     }
-    /* ӳʱʱ */
+    /* 销毁连接超时定时器 */
     knet_channel_ref_stop_connect_timeout_timer(channel_ref);
-    /* ճʱʱ */
+    /* 启动接收超时定时器 */
     knet_channel_ref_start_recv_timeout_timer(channel_ref);
 }
 
 void timer_cb(ktimer_t* timer, void* data) {
-    time_t          now           = time(0); /* ǰʱ() */
-    kchannel_ref_t* channel_ref   = (kchannel_ref_t*)data; /* ǰܵ */
-    time_t          gap           = now - channel_ref->ref_info->last_recv_ts; /* ϴνվ뵱ǰʱ() */
-    ktimer_t*       recv_timer    = knet_channel_ref_get_recv_timeout_timer(channel_ref); /* նʱ */
-    ktimer_t*       connect_timer = knet_channel_ref_get_connect_timeout_timer(channel_ref); /* Ӷʱ */
-    if (connect_timer == timer) { /* ӳʱʱ */
+    kchannel_ref_t* channel_ref   = (kchannel_ref_t*)data; /* 当前管道 */
+    uint64_t        now           = knet_loop_get_time(channel_ref->ref_info->loop); /* 本次迭代的时间戳(毫秒) */
+    uint64_t        gap           = now - channel_ref->ref_info->last_recv_ts; /* 上次接收距离当前时间(毫秒) */
+    ktimer_t*       recv_timer    = knet_channel_ref_get_recv_timeout_timer(channel_ref); /* 接收定时器 */
+    ktimer_t*       connect_timer = knet_channel_ref_get_connect_timeout_timer(channel_ref); /* 连接定时器 */
+    if (connect_timer == timer) { /* 连接超时定时器 */
         if (socket_check_send_ready(knet_channel_ref_get_socket_fd(channel_ref))) {
             knet_impl_event_add(channel_ref, channel_event_send);
         }
-        /* δʵʳʱ */
+        /* 并未实际超时 */
         if (channel_ref->ref_info->last_connect_timeout > now) {
             return;
         }
-        /* ӳʱ */
+        /* 连接超时 */
         if (knet_channel_ref_get_cb(channel_ref)) {
             log_error("connect timeout, channel[%llu]", knet_channel_ref_get_uuid(channel_ref));
             knet_channel_ref_get_cb(channel_ref)(channel_ref, channel_cb_event_connect_timeout);
         }
-        /* Զ */
+        /* 自动重连 */
         if (knet_channel_ref_check_auto_reconnect(channel_ref)) {
             knet_channel_ref_reconnect(channel_ref, 0);
         }
-    } else if (recv_timer == timer) { /* ճʱʱ */
-        if (!knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
-            if (gap > channel_ref->ref_info->timeout) {
-                /* ʱ */
+    } else if (recv_timer == timer) { /* 接收超时定时器 */
+        if (!knet_channel_ref_check_state(channel_ref, channel_state_accept) && !channel_ref->ref_info->recv_paused) {
+            /* 暂停读取期间不是空闲 */
+            if (gap > (uint64_t)channel_ref->ref_info->timeout * 1000) {
+                /* 读超时，心跳 */
                 if (knet_channel_ref_get_cb(channel_ref)) {
                     knet_channel_ref_get_cb(channel_ref)(channel_ref, channel_cb_event_timeout);
                 }
@@ -734,94 +1578,166 @@ ktimer_cb_t knet_channel_ref_get_timer_cb(kchannel_ref_t* channel_ref) {
 }
 
 void knet_channel_ref_update_recv(kchannel_ref_t* channel_ref) {
-    int      error = 0;
-    uint32_t bytes = 0;
-    verify(channel_ref);
-    /* ȡֽܵ */
+    int      error    = 0;
+    int      budget   = 0;
+    uint32_t bytes    = 0;
+    uint32_t syscalls = 0;
+    verify(channel_ref);
+    if (channel_ref->ref_info->relay_target && (channel_ref->ref_info->relay_pipe[0] >= 0)) {
+        /* splice()中继, 数据不进入读缓冲区 */
+        if (error_ok != _relay_update(channel_ref)) {
+            knet_channel_ref_close_check_reconnect(channel_ref);
+        } else {
+            knet_channel_ref_set_event(channel_ref, channel_event_recv);
+        }
+        return;
+    }
+    /* 获取管道流内字节数量 */
     bytes = knet_stream_available(channel_ref->ref_info->stream);
-    /* ¼ */
-    error = knet_channel_update_recv(channel_ref->ref_info->channel);
+    /* 处理读事件 */
+    budget = knet_loop_get_read_budget(channel_ref->ref_info->loop);
+    /* 回调返回后读缓冲区仍然是满的, 扩大弹性读缓冲区 */
+    _recv_buffer_reserve(channel_ref);
+    error = knet_channel_update_recv(channel_ref->ref_info->channel, (uint32_t)budget, &syscalls);
+    knet_loop_profile_add_recv_syscall(knet_loop_get_profile(channel_ref->ref_info->loop), syscalls);
+    /* 读缓冲区被填满, 套接字内可能还有数据, 重新投递读事件时重新触发 */
+    channel_ref->ref_info->recv_pending = ringbuffer_full(knet_channel_get_ringbuffer(channel_ref->ref_info->channel));
+    if ((error == error_ok) && !channel_ref->ref_info->recv_pending && budget &&
+        (knet_stream_available(channel_ref->ref_info->stream) - bytes >= (uint32_t)budget)) {
+        /* 达到预算, 套接字内可能还有数据, 下一次循环继续读取 */
+        knet_loop_add_ready_channel_ref(channel_ref->ref_info->loop, channel_ref);
+    }
     if (error != error_ok) {
         bytes = knet_stream_available(channel_ref->ref_info->stream);
         if (bytes) {
-            /* ¼ͳ */
+            /* 记录统计数据 */
             knet_loop_profile_add_recv_bytes(knet_loop_get_profile(channel_ref->ref_info->loop),
                 knet_stream_available(channel_ref->ref_info->stream) - bytes);
-            if (channel_ref->ref_info->cb) {
-                /* ûص */
-                channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv);
-            }
+            _recv_notify(channel_ref);
         }
     }
     switch (error) {
-        case error_recv_fail: /* ʧ */
+        case error_recv_fail: /* 接收失败 */
             knet_channel_ref_close_check_reconnect(channel_ref);
             break;
-        case error_recv_buffer_full: /* ջ */
-            knet_channel_ref_close_check_reconnect(channel_ref);
+        case error_recv_buffer_full: /* 接收缓冲区满 */
+            if (channel_ref->ref_info->recv_backpressure) {
+                /* 暂停读取, 由TCP流量控制限制对端发送 */
+                channel_ref->ref_info->recv_paused = 1;
+                knet_channel_ref_clear_event(channel_ref, channel_event_recv);
+            } else {
+                knet_channel_ref_close_check_reconnect(channel_ref);
+            }
             break;
         default:
             break;
     }
     if (error == error_ok) {
-        /* ¼ͳ */
+        /* 记录统计数据 */
         knet_loop_profile_add_recv_bytes(knet_loop_get_profile(channel_ref->ref_info->loop),
             knet_stream_available(channel_ref->ref_info->stream) - bytes);
-        if (channel_ref->ref_info->cb) {
-            /* ûص */
-            channel_ref->ref_info->cb(channel_ref, channel_cb_event_recv);
+        if (knet_stream_available(channel_ref->ref_info->stream) > bytes) {
+            /* 就绪链表内的管道可能已经被读空, 没有新数据时不调用 */
+            _recv_notify(channel_ref);
+        }
+        if (channel_ref->ref_info->recv_backpressure && _recv_buffer_full(channel_ref)) {
+            /* 回调内未取出数据, 暂停读取直到数据流内的数据被取出 */
+            if (knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+                channel_ref->ref_info->recv_paused = 1;
+                knet_channel_ref_clear_event(channel_ref, channel_event_recv);
+            }
+        } else {
+            /* 重新投递读事件 */
+            knet_channel_ref_set_event(channel_ref, channel_event_recv);
         }
-        /* Ͷݶ¼ */
-        knet_channel_ref_set_event(channel_ref, channel_event_recv);
     }
 }
 
 void knet_channel_ref_update_send(kchannel_ref_t* channel_ref) {
-    int error = 0;
+    int             error  = 0;
+    uint32_t        count  = 0;
+    kchannel_ref_t* source = 0;
     verify(channel_ref);
-    /* ¼ */
+    if (knet_channel_check_zerocopy_pending(channel_ref->ref_info->channel)) {
+        /* 顺便回收已完成的MSG_ZEROCOPY缓冲区, 不依赖选取器报告错误队列事件 */
+        knet_channel_ref_update_zerocopy(channel_ref);
+    }
+    /* 处理发送事件 */
+    count = _zerocopy_prepare(channel_ref);
     error = knet_channel_update_send(channel_ref->ref_info->channel);
+    _zerocopy_commit(channel_ref, count);
     switch (error) {
-        case error_send_fail: /* ʧ */
+        case error_send_fail: /* 发送失败 */
             knet_channel_ref_close_check_reconnect(channel_ref);
             break;
-        case error_send_patial: /* δȫ */
+        case error_send_patial: /* 未发送全部数据 */
             knet_channel_ref_set_event(channel_ref, channel_event_send);
+            /* 未发送完毕也可能已经回落到低水位 */
+            _send_watermark_check(channel_ref);
             break;
         default:
             break;
     }
     if (error == error_ok) {
+        _send_drained(channel_ref);
+        _send_watermark_check(channel_ref);
+        source = channel_ref->ref_info->relay_source;
+        if (source && (source->ref_info->relay_pipe[0] >= 0)) {
+            /* 继续中继之前因不可写而停止的数据 */
+            if (error_ok != _relay_update(source)) {
+                knet_channel_ref_close_check_reconnect(source);
+            }
+        }
         if (channel_ref->ref_info->cb) {
-            /* ûص */
+            /* 调用回调 */
             channel_ref->ref_info->cb(channel_ref, channel_cb_event_send);
         }
     }
 }
 
-void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e, time_t ts) {
+int knet_channel_ref_update_zerocopy(kchannel_ref_t* channel_ref) {
+    int      error     = error_ok;
+    uint32_t completed = 0;
+    uint32_t copied    = 0;
+    verify(channel_ref);
+    if (!knet_channel_get_zerocopy_count(channel_ref->ref_info->channel)) {
+        /* 从未使用MSG_ZEROCOPY发送 */
+        return error_recv_nothing;
+    }
+    error = knet_channel_update_zerocopy(channel_ref->ref_info->channel, &completed, &copied);
+    if (completed) {
+        knet_loop_profile_add_zerocopy_complete(knet_loop_get_profile(channel_ref->ref_info->loop), completed, copied);
+    }
+    if (error != error_fail) {
+        /* 错误队列内只有完成通知(或者已经在发送时读取)且SO_ERROR为0时套接字才是正常的 */
+        error = socket_get_error(knet_channel_get_socket_fd(channel_ref->ref_info->channel)) ? error_fail : error_ok;
+    }
+    return error;
+}
+
+void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e, uint64_t ts) {
     verify(channel_ref);
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
-        /* ܵѾر */
+        /* 管道已经关闭 */
         return;
     }
     if ((e & channel_event_recv) && knet_channel_ref_check_event(channel_ref, channel_event_recv)) {
         if (knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
-            /*  */
+            /* 新连接 */
             knet_channel_ref_update_accept(channel_ref);
         } else {
-            /* һζȡݵʱ룩 */
+            /* 最后一次读取到数据的时间戳（毫秒） */
             channel_ref->ref_info->last_recv_ts = ts;
-            /*  */
+            /* 读 */
             knet_channel_ref_update_recv(channel_ref);
         }
     } 
     if ((e & channel_event_send) && knet_channel_ref_check_event(channel_ref, channel_event_send)) {
         if (knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
-            /*  */
+            /* 连接完成 */
             knet_channel_ref_update_connect(channel_ref);
         } else {
-            /* д */
+            /* 写 */
             knet_channel_ref_update_send(channel_ref);
         }
     }
@@ -842,7 +1758,11 @@ kloop_t* knet_channel_ref_choose_loop(kchannel_ref_t* channel_ref) {
     if (!balancer) {
         return 0;
     }
-    /* Ƿloop_balancer_out */
+    if (channel_ref->ref_info->reuseport) {
+        /* SO_REUSEPORT监听器接受的连接留在当前kloop_t */
+        return 0;
+    }
+    /* 检查是否开启了loop_balancer_out配置 */
     if (knet_loop_check_balance_options(channel_ref->ref_info->loop, loop_balancer_out)) {
         loop = knet_loop_balancer_choose(balancer);
         if (loop == channel_ref->ref_info->loop) {
@@ -862,6 +1782,12 @@ int knet_channel_ref_get_flag(kchannel_ref_t* channel_ref) {
     return channel_ref->ref_info->flag;
 }
 
+int knet_channel_ref_check_rearm(kchannel_ref_t* channel_ref) {
+    verify(channel_ref);
+    /* 读缓冲区满时, 套接字内可能仍有未读取的数据 */
+    return channel_ref->ref_info->recv_pending;
+}
+
 void knet_channel_ref_set_data(kchannel_ref_t* channel_ref, void* data) {
     verify(channel_ref);
     channel_ref->ref_info->data = data;
@@ -883,7 +1809,7 @@ int knet_channel_ref_check_balance(kchannel_ref_t* channel_ref) {
 }
 
 void knet_channel_ref_set_timeout(kchannel_ref_t* channel_ref, int timeout) {
-    verify(channel_ref); /* timeoutΪ0 */
+    verify(channel_ref); /* timeout可以为0 */
     channel_ref->ref_info->timeout = (time_t)timeout;
 }
 
@@ -909,13 +1835,13 @@ knet_channel_ref_cb_t knet_channel_ref_get_cb(kchannel_ref_t* channel_ref) {
 
 int knet_channel_ref_connect_in_loop(kchannel_ref_t* channel_ref) {
     verify(channel_ref);
-    /* ӵԾܵ */
+    /* 添加到活跃管道链表 */
     knet_loop_add_channel_ref(channel_ref->ref_info->loop, channel_ref);
-    /* ״̬ */
+    /* 设置连接状态 */
     knet_channel_ref_set_state(channel_ref, channel_state_connect);
-    /* ֪ͨѡȡͶݷ¼ */
+    /* 通知选取器投递发送事件 */
     knet_channel_ref_set_event(channel_ref, channel_event_send);
-    /* ӳʱʱ */
+    /* 启动连接超时定时器 */
     return knet_channel_ref_start_connect_timeout_timer(channel_ref);;
 }
 
@@ -924,7 +1850,7 @@ kaddress_t* knet_channel_ref_get_peer_address(kchannel_ref_t* channel_ref) {
     if (channel_ref->ref_info->peer_address) {
         return channel_ref->ref_info->peer_address;
     }
-    /* һν */
+    /* 第一次建立 */
     channel_ref->ref_info->peer_address = knet_address_create();
     socket_getpeername(channel_ref, channel_ref->ref_info->peer_address);
     return channel_ref->ref_info->peer_address;
@@ -935,7 +1861,7 @@ kaddress_t* knet_channel_ref_get_local_address(kchannel_ref_t* channel_ref) {
     if (channel_ref->ref_info->local_address) {
         return channel_ref->ref_info->local_address;
     }
-    /* һν */
+    /* 第一次建立 */
     channel_ref->ref_info->local_address = knet_address_create();
     socket_getsockname(channel_ref, channel_ref->ref_info->local_address);
     return channel_ref->ref_info->local_address;
@@ -29,388 +29,502 @@
 #include "channel_ref_api.h"
 
 /**
- * ܵ
- * @param loop kloop_tʵ
- * @param channel kchannel_tʵ
- * @return kchannel_ref_tʵ
+ * 创建管道引用
+ * @param loop kloop_t实例
+ * @param channel kchannel_t实例
+ * @return kchannel_ref_t实例
  */
 kchannel_ref_t* knet_channel_ref_create(kloop_t* loop, kchannel_t* channel);
 
 /**
- * ٹܵ
- * ܵüΪʱܱʵ
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 销毁管道引用
+ * 管道引用计数为零时才能被实际销毁
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_destroy(kchannel_ref_t* channel_ref);
 
 /**
- * رչܵ
- * @param channel_ref kchannel_ref_tʵ
+ * 关闭管道并检查重连
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_close_check_reconnect(kchannel_ref_t* channel_ref);
 
 /**
- * д
- * ܵüΪʱܱʵ
- * @param channel_ref kchannel_ref_tʵ
- * @param data дָ
- * @param size ݳ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 写入
+ * 管道引用计数为零时才能被实际销毁
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 写入数据指针
+ * @param size 数据长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_write(kchannel_ref_t* channel_ref, const char* data, int size);
 
 /**
- * Ϊͨaccept()ص׽ִܵ
- * @param channel_ref kchannel_ref_tʵ
- * @param loop kloop_tʵ
- * @param client_fd ͨaccept()õ׽
- * @param event ǷͶ¼ùܵ״̬
- * @return kchannel_ref_tʵ
+ * 写入并取得data的所有权, 不拷贝数据
+ *
+ * data发送完毕或管道关闭时调用free_cb释放, 调用失败时data也已被释放
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 写入数据指针
+ * @param size 数据长度
+ * @param free_cb 释放函数
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+int knet_channel_ref_write_buffer(kchannel_ref_t* channel_ref, char* data, int size, knet_buffer_free_cb_t free_cb);
+
+/**
+ * 为通过accept()返回的套接字创建管道引用
+ * @param channel_ref kchannel_ref_t实例
+ * @param loop kloop_t实例
+ * @param client_fd 通过accept()得到的套接字
+ * @param event 是否投递事件和设置管道状态
+ * @return kchannel_ref_t实例
  */
 kchannel_ref_t* knet_channel_ref_accept_from_socket_fd(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd, int event);
 
 /**
- * ȡùܵkloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kloop_tʵ
+ * 取得管道相关联的kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @return kloop_t实例
  */
 kloop_t* knet_channel_ref_choose_loop(kchannel_ref_t* channel_ref);
 
 /**
- * ùܵڵ
- * @param channel_ref kchannel_ref_tʵ
- * @param node ڵ
+ * 设置管道链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @param node 链表节点
  */
 void knet_channel_ref_set_loop_node(kchannel_ref_t* channel_ref, kdlist_node_t* node);
 
 /**
- * ȡùܵڵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kdlist_node_tʵ
+ * 取得管道链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* knet_channel_ref_get_loop_node(kchannel_ref_t* channel_ref);
 
 /**
- * kloop_tе߳
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 设置就绪链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @param node 就绪链表节点, 0表示不在就绪链表内
+ */
+void knet_channel_ref_set_ready_node(kchannel_ref_t* channel_ref, kdlist_node_t* node);
+
+/**
+ * 取得就绪链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @return 就绪链表节点
+ */
+kdlist_node_t* knet_channel_ref_get_ready_node(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置合并写链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @param node 合并写链表节点, 0表示不在合并写链表内
+ */
+void knet_channel_ref_set_cork_node(kchannel_ref_t* channel_ref, kdlist_node_t* node);
+
+/**
+ * 取得合并写链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @return 合并写链表节点
+ */
+kdlist_node_t* knet_channel_ref_get_cork_node(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置持有弹性读缓冲区的管道链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @param node 链表节点, 0表示未持有弹性读缓冲区
+ */
+void knet_channel_ref_set_buffer_node(kchannel_ref_t* channel_ref, kdlist_node_t* node);
+
+/**
+ * 取得持有弹性读缓冲区的管道链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @return 链表节点
+ */
+kdlist_node_t* knet_channel_ref_get_buffer_node(kchannel_ref_t* channel_ref);
+
+/**
+ * 在kloop_t所运行的线程内完成连接流程
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_connect_in_loop(kchannel_ref_t* channel_ref);
 
 /**
- * kloop_tе߳
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 在kloop_t所运行的线程内完成连接流程
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_connect_in_loop_address(kchannel_ref_t* channel_ref);
 
 /**
- * kloop_tе߳ɽ
- * ͨؾⴥ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 在kloop_t所运行的线程内完成接收新连接流程
+ * 通过负载均衡触发
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_accept_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * listen()bind()ڵǰ̵߳kloop_tڼ
- * @param channel_ref kchannel_ref_tʵ
+ * 在其他完成了listen()和bind()操作，在当前线程的kloop_t内监听
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_accept_async(kchannel_ref_t* channel_ref);
 
 /**
- * kloop_tе߳ɹر
- * ̹ͨ߳رմ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 在kloop_t所运行的线程内完成关闭流程
+ * 通过跨线程关闭触发
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_close_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * kloop_tе߳ڷ
- * ̷ͨ߳ʹ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @param send_buffer kbuffer_tʵ
+ * 在kloop_t所运行的线程内发送
+ * 通过跨线程发送触发
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @param send_buffer kbuffer_t实例
  */
 void knet_channel_ref_update_send_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer);
 
 /**
- * ùܵԶ־
- * @param channel_ref kchannel_ref_tʵ
- * @param flag Զ־
+ * 在kloop_t所运行的线程内写入
+ * 通过批量写入触发, 数据合并后在本次循环迭代结束时发送
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 数据
+ * @param size 数据长度
+ */
+void knet_channel_ref_update_write_in_loop(kloop_t* loop, kchannel_ref_t* channel_ref, const char* data, int size);
+
+/**
+ * 设置管道自定义标志
+ * @param channel_ref kchannel_ref_t实例
+ * @param flag 自定义标志
  */
 void knet_channel_ref_set_flag(kchannel_ref_t* channel_ref, int flag);
 
 /**
- * ȡùܵԶ־
- * @param channel_ref kchannel_ref_tʵ
- * @return Զ־
+ * 取得管道自定义标志
+ * @param channel_ref kchannel_ref_t实例
+ * @return 自定义标志
  */
 int knet_channel_ref_get_flag(kchannel_ref_t* channel_ref);
 
 /**
- * ùܵԶ
- * @param channel_ref kchannel_ref_tʵ
- * @param data Զָ
+ * 检查边缘触发的选取器是否需要重新注册事件
+ * <pre>
+ * 监听管道每次只接受一个连接, 读缓冲区被填满时套接字内可能还有未读取的数据,
+ * 这两种情况下即使事件掩码未改变也需要重新注册才能再次触发读事件
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 不需要
+ * @retval 非零 需要
+ */
+int knet_channel_ref_check_rearm(kchannel_ref_t* channel_ref);
+
+/**
+ * 数据流内的数据被取出后调用, 读缓冲区内的数据不超过一半时恢复因读缓冲区满而暂停的读取
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_channel_ref_resume_recv(kchannel_ref_t* channel_ref);
+
+/**
+ * 弹性读缓冲区为空且空闲超过idle毫秒时归还到内存池
+ * @param channel_ref kchannel_ref_t实例
+ * @param idle 空闲时间（毫秒）
+ */
+void knet_channel_ref_shrink_recv_buffer(kchannel_ref_t* channel_ref, uint64_t idle);
+
+/**
+ * 合并写缓冲区放入发送链表, 发送链表内的数据一次发送
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_channel_ref_flush_cork(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置管道自定义数据
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 自定义数据指针
  */
 void knet_channel_ref_set_data(kchannel_ref_t* channel_ref, void* data);
 
 /**
- * ȡùܵԶ
- * @param channel_ref kchannel_ref_tʵ
- * @return Զָ
+ * 取得管道自定义数据
+ * @param channel_ref kchannel_ref_t实例
+ * @return 自定义数据指针
  */
 void* knet_channel_ref_get_data(kchannel_ref_t* channel_ref);
 
 /**
- * ùܵkloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @param loop kloop_tʵ
+ * 设置管道所属（相关联）kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @param loop kloop_t实例
  */
 void knet_channel_ref_set_loop(kchannel_ref_t* channel_ref, kloop_t* loop);
 
 /**
- * Ͷݹܵ¼
- * @param channel_ref kchannel_ref_tʵ
- * @param e ܵ¼
+ * 投递管道事件
+ * @param channel_ref kchannel_ref_t实例
+ * @param e 管道事件
  */
 void knet_channel_ref_set_event(kchannel_ref_t* channel_ref, knet_channel_event_e e);
 
 /**
- * ȡܵѾͶݵ¼
- * @param channel_ref kchannel_ref_tʵ
- * @return ܵ¼
+ * 获取管道已经投递的事件集合
+ * @param channel_ref kchannel_ref_t实例
+ * @return 管道事件集合
  */
 knet_channel_event_e knet_channel_ref_get_event(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵ¼
- * @param channel_ref kchannel_ref_tʵ
- * @param e ܵ¼
+ * 取消管道事件
+ * @param channel_ref kchannel_ref_t实例
+ * @param e 管道事件
  */
 void knet_channel_ref_clear_event(kchannel_ref_t* channel_ref, knet_channel_event_e e);
 
 /**
- * ǷͶ¼
- * @param channel_ref kchannel_ref_tʵ
- * @param event ܵ¼
- * @retval 0 ûͶ
- * @retval  ѾͶ
+ * 检测是否投递了事件
+ * @param channel_ref kchannel_ref_t实例
+ * @param event 管道事件
+ * @retval 0 没有投递
+ * @retval 非零 已经投递
  */
 int knet_channel_ref_check_event(kchannel_ref_t* channel_ref, knet_channel_event_e event);
 
 /**
- * ùܵ״̬
- * @param channel_ref kchannel_ref_tʵ
- * @param state ܵ״̬
+ * 设置管道状态
+ * @param channel_ref kchannel_ref_t实例
+ * @param state 管道状态
  */
 void knet_channel_ref_set_state(kchannel_ref_t* channel_ref, knet_channel_state_e state);
 
 /**
- * ܵ¼֪ͨ
- * @param channel_ref kchannel_ref_tʵ
- * @param e ܵ¼
- * @param ts ǰʱ룩
+ * 管道事件通知
+ * @param channel_ref kchannel_ref_t实例
+ * @param e 管道事件
+ * @param ts 本次迭代的时间戳（毫秒）
  */
-void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e, time_t ts);
+void knet_channel_ref_update(kchannel_ref_t* channel_ref, knet_channel_event_e e, uint64_t ts);
 
 /**
- * ܵ¼-
- * @param channel_ref kchannel_ref_tʵ
+ * 管道事件处理-监听到新连接请求
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_accept(kchannel_ref_t* channel_ref);
 
 /**
- * ܵ¼-
- * @param channel_ref kchannel_ref_tʵ
+ * 建立新接受的连接, 并交给选定的kloop_t
+ * @param channel_ref 监听管道
+ * @param loop 负载均衡选定的kloop_t, 0为当前kloop_t
+ * @param client_fd 新连接套接字
+ */
+void knet_channel_ref_accept_client(kchannel_ref_t* channel_ref, kloop_t* loop, socket_t client_fd);
+
+/**
+ * 管道事件处理-发起连接完成
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_connect(kchannel_ref_t* channel_ref);
 
 /**
- * ܵ¼-ݿɶ
- * @param channel_ref kchannel_ref_tʵ
+ * 管道事件处理-有数据可读
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_recv(kchannel_ref_t* channel_ref);
 
 /**
- * ܵ¼-Է
- * @param channel_ref kchannel_ref_tʵ
+ * 管道事件处理-可以发送数据
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_update_send(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵгʱ
- * @param channel_ref kchannel_ref_tʵ
- * @return ܵгʱ
+ * 管道事件处理-套接字错误队列可读
+ *
+ * 选取器报告错误时调用, 读取MSG_ZEROCOPY完成通知并释放已完成的缓冲区
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 错误事件只由MSG_ZEROCOPY完成通知引起(SO_ERROR为0)
+ * @retval 其他 套接字确实出错
+ */
+int knet_channel_ref_update_zerocopy(kchannel_ref_t* channel_ref);
+
+/**
+ * 获取管道读空闲超时
+ * @param channel_ref kchannel_ref_t实例
+ * @return 管道读空闲超时
  */
 int knet_channel_ref_get_timeout(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵӳʱ
- * @param channel_ref kchannel_ref_tʵ
- * @return ܵӳʱ
+ * 获取管道连接超时
+ * @param channel_ref kchannel_ref_t实例
+ * @return 管道连接超时
  */
 int knet_channel_ref_get_connect_timeout(kchannel_ref_t* channel_ref);
 
 /**
- * ȡùܵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kringbuffer_tʵ
+ * 取得管道读缓冲区
+ * @param channel_ref kchannel_ref_t实例
+ * @return kringbuffer_t实例
  */
 kringbuffer_t* knet_channel_ref_get_ringbuffer(kchannel_ref_t* channel_ref);
 
 /**
- * ȡùܵ¼ص
- * @param channel_ref kchannel_ref_tʵ
- * @return صָ
+ * 取得管道事件回调
+ * @param channel_ref kchannel_ref_t实例
+ * @return 回调函数指针
  */
 knet_channel_ref_cb_t knet_channel_ref_get_cb(kchannel_ref_t* channel_ref);
 
 /**
- * ڵ
- * @param channel_ref kchannel_ref_tʵ
- * @param node ڵ
+ * 设置域链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @param node 域链表节点
  */
 void knet_channel_ref_set_domain_node(kchannel_ref_t* channel_ref, kdlist_node_t* node);
 
 /**
- * ȡڵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kdlist_node_tʵ
+ * 取得域链表节点
+ * @param channel_ref kchannel_ref_t实例
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* knet_channel_ref_get_domain_node(kchannel_ref_t* channel_ref);
 
 /**
- * ܵǷͨknet_channel_ref_share()
- * @param channel_ref kchannel_ref_tʵ
- * @retval 0 
- * @retval  
+ * 检查管道引用是否通过调用knet_channel_ref_share()建立
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 不是
+ * @retval 非零 是
  */
 int knet_channel_ref_check_share(kchannel_ref_t* channel_ref);
 
 /**
- * ID
- * @param channel_ref kchannel_ref_tʵ
- * @param domain_id ID
+ * 设置域ID
+ * @param channel_ref kchannel_ref_t实例
+ * @param domain_id 域ID
  */
 void knet_channel_ref_set_domain_id(kchannel_ref_t* channel_ref, uint64_t domain_id);
 
 /**
- * ȡID
- * @param channel_ref kchannel_ref_tʵ
- * @return ID
+ * 取得域ID
+ * @param channel_ref kchannel_ref_t实例
+ * @return 域ID
  */
 uint64_t knet_channel_ref_get_domain_id(kchannel_ref_t* channel_ref);
 
 /**
- * ԹܵǷΪ
- * @param channel_ref kchannel_ref_tʵ
- * @return 0 Ϊ
- * @return  Ϊ
+ * 测试管道引用是否为零
+ * @param channel_ref kchannel_ref_t实例
+ * @return 0 不为零
+ * @return 非零 为零
  */
 int knet_channel_ref_check_ref_zero(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵü
- * @param channel_ref kchannel_ref_tʵ
- * @return ܵü
+ * 获取管道引用计数
+ * @param channel_ref kchannel_ref_t实例
+ * @return 管道引用计数
  */
 int knet_channel_ref_get_ref(kchannel_ref_t* channel_ref);
 
 /**
- * ùܵû
- * @param channel_ref kchannel_ref_tʵ
- * @param data ûָ
+ * 设置管道用户数据
+ * @param channel_ref kchannel_ref_t实例
+ * @param data 用户数据指针
  */
 void knet_channel_ref_set_user_data(kchannel_ref_t* channel_ref, void* data);
 
 /**
- * ȡܵû
- * @param channel_ref kchannel_ref_tʵ
- * @return ûָ
+ * 获取管道用户数据
+ * @param channel_ref kchannel_ref_t实例
+ * @return 用户数据指针
  */
 void* knet_channel_ref_get_user_data(kchannel_ref_t* channel_ref);
 
 /**
- * ýճʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @param timer ʱ
+ * 设置接收超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @param timer 定时器
  */
 void knet_channel_ref_set_recv_timeout_timer(kchannel_ref_t* channel_ref, ktimer_t* timer);
 
 /**
- * ȡճʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @return ʱ
+ * 获取接收超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @return 定时器
  */
 ktimer_t* knet_channel_ref_get_recv_timeout_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ӳʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @param timer ʱ
+ * 设置连接超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @param timer 定时器
  */
 void knet_channel_ref_set_connect_timeout_timer(kchannel_ref_t* channel_ref, ktimer_t* timer);
 
 /**
- * ȡӳʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @return ʱ
+ * 获取连接超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @return 定时器
  */
 ktimer_t* knet_channel_ref_get_connect_timeout_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵʱص
- * @param channel_ref kchannel_ref_tʵ
- * @return ܵʱص
+ * 获取管道定时器回调函数
+ * @param channel_ref kchannel_ref_t实例
+ * @return 管道定时器回调函数
  */
 ktimer_cb_t knet_channel_ref_get_timer_cb(kchannel_ref_t* channel_ref);
 
 /**
- * ر¼ǷѾ
- * @param channel_ref kchannel_ref_tʵ
- * @retval 0 û
- * @retval  Ѿ
+ * 检查关闭事件是否已经被处理
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 没有
+ * @retval 非零 已经被处理
  */
 int knet_channel_ref_check_close_cb_called(kchannel_ref_t* channel_ref);
 
 /**
- * ùر¼־
- * @param channel_ref kchannel_ref_tʵ
+ * 设置关闭事件处理标志
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_set_close_cb_called(kchannel_ref_t* channel_ref);
 
 /**
- * ճʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 启动接收超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_start_recv_timeout_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ٽճʱʱ
- * @param channel_ref kchannel_ref_tʵ
+ * 销毁接收超时定时器
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_stop_recv_timeout_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ӳʱʱ
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 启动连接超时定时器
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_channel_ref_start_connect_timeout_timer(kchannel_ref_t* channel_ref);
 
 /**
- * ӳʱʱ
- * @param channel_ref kchannel_ref_tʵ
+ * 销毁连接超时定时器
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_channel_ref_stop_connect_timeout_timer(kchannel_ref_t* channel_ref);
 
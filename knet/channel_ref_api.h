@@ -28,246 +28,394 @@
 #include "config.h"
 
 /**
- * @defgroup ܵ ܵ
- * ܵ
+ * @defgroup 管道引用 管道引用
+ * 管道引用
  *
  * <pre>
- * kchannel_ref_tΪkchannel_tİװû͸˹ܵڲʵ֣ͬʱṩü
- * ܵڹ.
+ * kchannel_ref_t作为kchannel_t的包装器，对于用户透明化了管道的内部实现，同时提供了引用计数用于
+ * 管道的生命周期管理.
  *
- * ܵ3ͣ
+ * 管道有3种类型：
  * 
- * 1. 
- * 2. 
- * 3. ɼܵ¹ܵ
+ * 1. 连接器
+ * 2. 监听器
+ * 3. 由监听器接受的新管道
  *
- * ܵ3״̬:
+ * 管道有3种状态:
  * 
- * 1. ½ սȷΪ߼
- * 2. Ծ   ѾȷԼĽɫ
- * 3. ر   Ѿرգδ٣üΪ
+ * 1. 新建立 刚建立但不确定是作为连接器或者监听器存在
+ * 2. 活跃   已经确定了自己的角色
+ * 3. 关闭   已经关闭，但还未销毁，引用计数不为零
  *
- * ûиؾڵ(kloop_tûͨknet_loop_balancer_attachkloop_balancer_t),
- * ܵڵǰkloop_tУɼܵĹܵҲkloop_t.
- * kloop_tѾؾ/ܵĹܵܲڵǰkloop_t
- * УؾݻԾܵܵ䵽kloop_tУȻڵǰkloop_tУ
- * ȡڵǰkloop_tصԾܵ.
+ * 在没有负载均衡器存在的情况下(kloop_t没有通过knet_loop_balancer_attach关联到kloop_balancer_t),
+ * 所有连接器管道都会在当前kloop_t内运行，所有由监听器接受的管道也会在kloop_t内运行.
+ * 如果kloop_t已经关联到负载均衡器，连接器/监听器接受的管道可能不在当前kloop_t内
+ * 运行，负载均衡器会根据活跃管道的数量将这个管道分配到其他kloop_t运行，或者仍然在当前kloop_t内运行，
+ * 结果取决于当前所有kloop_t负载的情况（活跃管道的数量）.
  *
- * Եúknet_channel_ref_check_balanceȷܵǷ񱻸ؾ䣬knet_channel_ref_check_state
- * ܵǰ״̬knet_channel_ref_closeرչܵ۴ʱܵüǷΪ㣬ܵ׽ֶ
- * رգܵüΪʱkloop_tŻ.knet_channel_ref_equalжܵǷ
- * ָͬһܵ.
+ * 可以调用函数knet_channel_ref_check_balance确定管道是否被负载均衡调配，调用knet_channel_ref_check_state
+ * 检查管道当前所处的状态，knet_channel_ref_close关闭管道，无论此时管道的引用计数是否为零，管道的套接字都会
+ * 被关闭，当管道引用计数为零时，kloop_t才会真正销毁它.调用knet_channel_ref_equal可以判断两个管道引用是否
+ * 指向同一个管道.
  * 
- * ͨknet_channel_ref_set_timeoutùܵĶгʱ룩Ĵ
- * knet_channel_ref_connectʱһһֵӳʱ룩.
- * knet_channel_ref_get_socket_fdõܵ׽֣knet_channel_ref_get_uuidĵܵUUID.
+ * 可以通过调用knet_channel_ref_set_timeout设置管道的读空闲超时（秒），这可以用做心跳包的处理，调用
+ * knet_channel_ref_connect时最后一个参数传递一个非零值可以设置连接器的连接超时（秒），这可以用于重连.
+ * 调用knet_channel_ref_get_socket_fd得到管道套接字，调用knet_channel_ref_get_uuid的到管道UUID.
  * </pre>
  * @{
  */
 
 /**
- * ӹܵüܵµkchannel_ref_tʵ
+ * 增加管道引用计数，并创建与管道关联的新的kchannel_ref_t实例
  *
- * knet_channel_ref_shareɺ󣬿ڵǰ߳ڷ߳(kloop_t)еĹܵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kchannel_ref_tʵ
+ * knet_channel_ref_share调用完成后，可以在当前线程内访问其他线程(kloop_t)内运行的管道
+ * @param channel_ref kchannel_ref_t实例
+ * @return kchannel_ref_t实例
  */
 extern kchannel_ref_t* knet_channel_ref_share(kchannel_ref_t* channel_ref);
 
 /**
- * ٹܵükchannel_ref_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 减少管道引用计数，并销毁kchannel_ref_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 extern void knet_channel_ref_leave(kchannel_ref_t* channel_ref);
 
 /**
- * ܵתΪܵ
+ * 将管道转换为监听管道
  *
- * ܵܵӽʹܵͬķͻƺͽܻ,
- * knet_channel_ref_acceptܵӽؾ⣬ʵĸkloop_tʵе
- * @param channel_ref kchannel_ref_tʵ
+ * 由这个监听管道接受的新连接将使用与监听管道相同的发送缓冲区最大数量限制和接受缓冲区长度限制,
+ * knet_channel_ref_accept所接受的新连接将被负载均衡，实际运行在哪个kloop_t内依赖于实际运行的情况
+ * @param channel_ref kchannel_ref_t实例
  * @param ip IP
- * @param port ˿
- * @param backlog ȴޣlisten())
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @param backlog 等待队列上限（listen())
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_channel_ref_accept(kchannel_ref_t* channel_ref, const char* ip, int port, int backlog);
 
 /**
- * 
+ * 设置监听管道使用SO_REUSEPORT分片监听
  *
- * knet_channel_ref_connectĹܵᱻؾ⣬ʵĸkloop_tʵе
- * @param channel_ref kchannel_ref_tʵ
+ * <pre>
+ * 必须在knet_channel_ref_accept之前调用. 如果管道所在的kloop_t已经关联到负载均衡器,
+ * knet_channel_ref_accept会在负载均衡器内每个开启loop_balancer_in配置的kloop_t上建立一个监听同一端口的
+ * 监听器，由内核分配新连接，每个kloop_t在自己的线程内接受并运行新连接，不再跨线程转交.
+ * 其他kloop_t上的监听器属于所在的kloop_t，随kloop_t销毁.
+ * 系统不支持SO_REUSEPORT时knet_channel_ref_accept返回error_reuseport_fail.
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param reuseport 非零开启, 0关闭
+ */
+extern void knet_channel_ref_set_reuseport(kchannel_ref_t* channel_ref, int reuseport);
+
+/**
+ * 检查监听管道是否开启了SO_REUSEPORT分片监听
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 未开启
+ * @retval 非零 开启
+ */
+extern int knet_channel_ref_check_reuseport(kchannel_ref_t* channel_ref);
+
+/**
+ * 主动连接
+ *
+ * 调用knet_channel_ref_connect的管道会被负载均衡，实际运行在哪个kloop_t内依赖于实际运行的情况
+ * @param channel_ref kchannel_ref_t实例
  * @param ip IP
- * @param port ˿
- * @param timeout ӳʱ룩
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @param timeout 连接超时（秒）
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_channel_ref_connect(kchannel_ref_t* channel_ref, const char* ip, int port, int timeout);
 
 /**
- * ·
+ * 重新发起连接
  *
  * <pre>
- * ʱĹܵرգ¹ܵ¹ܵʹԭйܵԣصûָ
- * timeoutΪ0ʹԭеӳʱtimeout>0ʹµӳʱ
+ * 超时的管道将被关闭，建立新管道重连，新管道将使用原有管道的属性，包含回调函数和用户指针
+ * 如果timeout设置为0，则使用原有的连接超时，如果timeout>0则使用新的连接超时
  * </pre>
- * @param channel_ref kchannel_ref_tʵ
- * @param timeout ӳʱ룩
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param channel_ref kchannel_ref_t实例
+ * @param timeout 连接超时（秒）
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_channel_ref_reconnect(kchannel_ref_t* channel_ref, int timeout);
 
 /**
- * ùܵԶ
+ * 设置管道自动重连
  * <pre>
- * auto_reconnectΪֵԶзǴԵ¹ܵرգԶûֶ
- * knet_channel_ref_closeᴥԶ
+ * auto_reconnect为非零值则开启自动重连，所有非错误性导致管道关闭，都会自动重连，用户手动调用
+ * knet_channel_ref_close将不会触发自动重连
  * </pre>
- * @param channel_ref kchannel_ref_tʵ
- * @param auto_reconnect Զ־
+ * @param channel_ref kchannel_ref_t实例
+ * @param auto_reconnect 自动重连标志
  */
 extern void knet_channel_ref_set_auto_reconnect(kchannel_ref_t* channel_ref, int auto_reconnect);
 
 /**
- * ܵǷԶ
- * @param channel_ref kchannel_ref_tʵ
- * @retval 0 δ
- * @retval  
+ * 检查管道是否开启了自动重连
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 未开启
+ * @retval 非零 开启
  */
 extern int knet_channel_ref_check_auto_reconnect(kchannel_ref_t* channel_ref);
 
 /**
- * ܵǷͨؾǰkloop_t
- * @param channel_ref kchannel_ref_tʵ
- * @retval 0 
- * @retval 0 
+ * 设置读缓冲区满时的处理方式
+ * <pre>
+ * 默认读缓冲区满时关闭管道. on为非零值时改为暂停读取, 由TCP流量控制限制对端发送,
+ * 通过knet_stream_pop/knet_stream_eat等函数取出数据, 读缓冲区内的数据不超过一半时自动恢复读取,
+ * 暂停期间不触发读空闲超时.
+ * 监听管道的设置会被接受的管道继承
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param on 非零为暂停读取, 零为关闭管道
+ */
+extern void knet_channel_ref_set_recv_backpressure(kchannel_ref_t* channel_ref, int on);
+
+/**
+ * 检查读缓冲区满时是否暂停读取
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 关闭管道
+ * @retval 非零 暂停读取
+ */
+extern int knet_channel_ref_check_recv_backpressure(kchannel_ref_t* channel_ref);
+
+/**
+ * 取得读缓冲区当前占用的内存长度
+ * <pre>
+ * 固定长度的读缓冲区为建立管道时指定的长度, 弹性读缓冲区随数据调整, 空闲时为0
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @return 读缓冲区当前长度（字节）
+ */
+extern uint32_t knet_channel_ref_get_recv_buffer_size(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置发送高低水位
+ * <pre>
+ * 未发送字节数达到high时调用回调channel_cb_event_send_high, 之后回落到low及以下时调用回调channel_cb_event_drain,
+ * 调用者可以据此暂停和恢复写入. 设置高水位后不再按建立管道时的发送链表最大长度关闭管道,
+ * 而是在未发送字节数达到high的4倍时写入失败并关闭管道, 防止调用者忽略通知后内存无限增长.
+ * 监听管道的设置会被接受的管道继承
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param high 高水位（字节）, 0为关闭
+ * @param low 低水位（字节）, 必须小于high
+ * @retval error_ok 成功
+ * @retval error_invalid_parameters low不小于high
+ */
+extern int knet_channel_ref_set_send_watermark(kchannel_ref_t* channel_ref, uint32_t high, uint32_t low);
+
+/**
+ * 取得发送高水位
+ * @param channel_ref kchannel_ref_t实例
+ * @return 高水位（字节）, 0为关闭
+ */
+extern uint32_t knet_channel_ref_get_send_high_watermark(kchannel_ref_t* channel_ref);
+
+/**
+ * 取得发送低水位
+ * @param channel_ref kchannel_ref_t实例
+ * @return 低水位（字节）
+ */
+extern uint32_t knet_channel_ref_get_send_low_watermark(kchannel_ref_t* channel_ref);
+
+/**
+ * 取得发送链表内未发送的字节数
+ * <pre>
+ * 只统计已经进入管道所在kloop_t的数据, 其他线程写入但尚未被处理的数据不计入
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @return 未发送的字节数
+ */
+extern uint64_t knet_channel_ref_get_send_bytes(kchannel_ref_t* channel_ref);
+
+/**
+ * 设置写合并方式
+ * <pre>
+ * 开启后在管道所在线程内调用knet_channel_ref_write(包括knet_stream_push)写入的数据不立即发送,
+ * 合并到管道的缓冲区内, 在本次循环迭代处理完所有事件和定时器后一次发送, 减少系统调用和报文段数量.
+ * channel_cork_tcp在发送合并的数据时开启TCP_CORK(仅Linux), 直到发送链表清空后关闭. 关闭时立即发送已经合并的数据.
+ * 其他线程写入的数据不受影响. 监听管道的设置会被接受的管道继承
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param cork 写合并方式
+ */
+extern void knet_channel_ref_set_auto_cork(kchannel_ref_t* channel_ref, knet_channel_cork_e cork);
+
+/**
+ * 取得写合并方式
+ * @param channel_ref kchannel_ref_t实例
+ * @return 写合并方式
+ */
+extern knet_channel_cork_e knet_channel_ref_get_auto_cork(kchannel_ref_t* channel_ref);
+
+/**
+ * 检测管道是否是通过负载均衡关联到当前的kloop_t
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 不是
+ * @retval 非0 是
  */
 extern int knet_channel_ref_check_balance(kchannel_ref_t* channel_ref);
 
 /**
- * ܵǰ״̬
- * @param channel_ref kchannel_ref_tʵ
- * @param state ҪԵ״̬
- * @retval 1 
- * @retval 0 
+ * 检测管道当前状态
+ * @param channel_ref kchannel_ref_t实例
+ * @param state 需要测试的状态
+ * @retval 1 是
+ * @retval 0 不是
  */
 extern int knet_channel_ref_check_state(kchannel_ref_t* channel_ref, knet_channel_state_e state);
 
 /**
- * رչܵ
- * @param channel_ref kchannel_ref_tʵ
+ * 关闭管道
+ * @param channel_ref kchannel_ref_t实例
  */
 extern void knet_channel_ref_close(kchannel_ref_t* channel_ref);
 
 /**
- * ܵǷѾر
- * @param channel_ref kchannel_ref_tʵ
- * @retval 0 δر
- * @retval  ر
+ * 检查管道是否已经关闭
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 未关闭
+ * @retval 非零 关闭
  */
 extern int knet_channel_ref_check_close(kchannel_ref_t* channel_ref);
 
 /**
- * ȡùܵ׽
- * @param channel_ref kchannel_ref_tʵ
- * @return ׽
+ * 取得管道套接字
+ * @param channel_ref kchannel_ref_t实例
+ * @return 套接字
  */
 extern socket_t knet_channel_ref_get_socket_fd(kchannel_ref_t* channel_ref);
 
 /**
- * ȡùܵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kstream_tʵ
+ * 取得管道数据流
+ * @param channel_ref kchannel_ref_t实例
+ * @return kstream_t实例
  */
 extern kstream_t* knet_channel_ref_get_stream(kchannel_ref_t* channel_ref);
 
 /**
- * ȡùܵ¼ѭ
- * @param channel_ref kchannel_ref_tʵ
- * @return kloop_tʵ
+ * 取得管道所关联的事件循环
+ * @param channel_ref kchannel_ref_t实例
+ * @return kloop_t实例
  */
 extern kloop_t* knet_channel_ref_get_loop(kchannel_ref_t* channel_ref);
 
 /**
- * ùܵ¼ص
+ * 设置管道事件回调
  *
- * ¼صڹkloop_tʵ߳ڱص
- * @param channel_ref kchannel_ref_tʵ
- * @param cb ص
+ * 事件回调将在关联的kloop_t实例所在线程内被回调.
+ * channel_cb_event_recv只在本次读取到新数据时回调, 读事件没有读到新数据(例如达到读取预算后继续读取时套接字已经读空)时不回调,
+ * 回调内未取出的数据会留在数据流内, 直到下一次读取到新数据时才会再次回调
+ * @param channel_ref kchannel_ref_t实例
+ * @param cb 回调函数
  */
 extern void knet_channel_ref_set_cb(kchannel_ref_t* channel_ref, knet_channel_ref_cb_t cb);
 
 /**
- * ùܵгʱ
+ * 设置管道空闲超时
  *
- * ܵгʱΪжϣtimeoutδпɶݼȴʱ
- * @param channel_ref kchannel_ref_tʵ
- * @param timeout ʱ룩
+ * 管道空闲超时依赖读操作作为判断，在timeout间隔内未有可读数据既触发超时
+ * @param channel_ref kchannel_ref_t实例
+ * @param timeout 超时（秒）
  */
 extern void knet_channel_ref_set_timeout(kchannel_ref_t* channel_ref, int timeout);
 
 /**
- * ȡöԶ˵ַ
- * @param channel_ref kchannel_ref_tʵ
- * @return kaddress_tʵ
+ * 取得对端地址
+ * @param channel_ref kchannel_ref_t实例
+ * @return kaddress_t实例
  */
 extern kaddress_t* knet_channel_ref_get_peer_address(kchannel_ref_t* channel_ref);
 
 /**
- * ȡñصַ
- * @param channel_ref kchannel_ref_tʵ
- * @return kaddress_tʵ
+ * 取得本地地址
+ * @param channel_ref kchannel_ref_t实例
+ * @return kaddress_t实例
  */
 extern kaddress_t* knet_channel_ref_get_local_address(kchannel_ref_t* channel_ref);
 
 /**
- * ȡܵUUID
- * @param channel_ref kchannel_tʵ
- * @return ܵUUID
+ * 获取管道UUID
+ * @param channel_ref kchannel_t实例
+ * @return 管道UUID
  */
 extern uint64_t knet_channel_ref_get_uuid(kchannel_ref_t* channel_ref);
 
 /**
- * ܵǷָͬһܵ
- * @param a kchannel_tʵ
- * @param b kchannel_tʵ
- * @retval 0 ͬ
- * @retval  ͬ 
+ * 测试两个管道引用是否指向同一个管道
+ * @param a kchannel_t实例
+ * @param b kchannel_t实例
+ * @retval 0 不同
+ * @retval 非零 相同 
  */
 extern int knet_channel_ref_equal(kchannel_ref_t* a, kchannel_ref_t* b);
 
 /**
- * ûָ
- * @param channel_ref kchannel_tʵ
- * @param ptr ûָ
+ * 设置用户数据指针
+ * @param channel_ref kchannel_t实例
+ * @param ptr 用户数据指针
  */
 extern void knet_channel_ref_set_ptr(kchannel_ref_t* channel_ref, void* ptr);
 
 /**
- * ȡûָ
- * @param channel_ref kchannel_tʵ
- * @return ûָ
+ * 获取用户数据指针
+ * @param channel_ref kchannel_t实例
+ * @return 用户数据指针
  */
 extern void* knet_channel_ref_get_ptr(kchannel_ref_t* channel_ref);
 
 /**
- * ǰܵü
- * @param channel_ref kchannel_ref_tʵ
- * @return ǰü
+ * 递增当前管道引用计数
+ * @param channel_ref kchannel_ref_t实例
+ * @return 当前引用计数
  */
 extern int knet_channel_ref_incref(kchannel_ref_t* channel_ref);
 
 /**
- * ݼǰܵü
- * @param channel_ref kchannel_ref_tʵ
- * @return ǰü
+ * 递减当前管道引用计数
+ * @param channel_ref kchannel_ref_t实例
+ * @return 当前引用计数
  */
 extern int knet_channel_ref_decref(kchannel_ref_t* channel_ref);
 
+/**
+ * 发送文件区域
+ * <pre>
+ * 文件区域与之前写入的数据按顺序放入发送链表, 套接字可写时由sendfile()从文件直接发送到套接字,
+ * 数据不读入用户内存, 占用的内存与文件大小无关.
+ * 管道取得fd的所有权, 发送完毕或管道关闭时关闭fd, 多个管道发送同一文件时需要各自dup()一个描述符.
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param fd 文件描述符
+ * @param offset 文件内起始位置
+ * @param length 发送长度（字节）
+ * @retval error_ok 成功
+ * @retval 其他 失败, fd仍由调用者负责关闭
+ */
+extern int knet_channel_ref_send_file(kchannel_ref_t* channel_ref, int fd, uint64_t offset, uint64_t length);
+
+/**
+ * 将管道收到的数据中继到目标管道
+ * <pre>
+ * Linux上通过splice()经由内核管道在两个套接字之间移动数据, 不经过用户内存, 也不再触发channel_cb_event_recv.
+ * 目标管道不可写时停止读取, 由TCP流量控制通知对端, 目标管道可写后继续.
+ * 其他系统上收到的数据通过knet_stream_push_stream()写入目标管道.
+ * 双向中继需要调用两次, 两个管道必须属于同一个kloop_t, 在kloop_t所在线程内调用.
+ * 中继期间不要直接向目标管道写入数据, 任意一端关闭时中继解除.
+ * </pre>
+ * @param channel_ref kchannel_ref_t实例
+ * @param target 目标管道, 0表示解除中继
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+extern int knet_channel_ref_relay(kchannel_ref_t* channel_ref, kchannel_ref_t* target);
+
 /** @} */
 
 #endif /* CHANNEL_REF_API_H */
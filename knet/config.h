@@ -139,42 +139,52 @@ typedef struct _rwlock_t krwlock_t;
 typedef struct _cond_t kcond_t;
 typedef struct _rb_tree_t krbtree_t;
 typedef struct _rb_node_t krbnode_t;
+typedef struct _write_batch_t kwrite_batch_t;
 
-/* ܵͶ¼ */
+/* 管道可投递事件 */
 typedef enum _channel_event_e {
     channel_event_recv = 1,
     channel_event_send = 2,
 } knet_channel_event_e;
 
-/*! ܵ״̬ */
+/*! 管道状态 */
 typedef enum _channel_state_e {
-    channel_state_connect = 1, /*! ӣδ */
-    channel_state_accept = 2,  /*!  */
-    channel_state_close = 4,   /*! ܵѹر */
-    channel_state_active = 8,  /*! ܵѼշ */
-    channel_state_init = 16,   /*! ܵѽδ */
+    channel_state_connect = 1, /*! 主动发起连接，连接未完成 */
+    channel_state_accept = 2,  /*! 监听 */
+    channel_state_close = 4,   /*! 管道已关闭 */
+    channel_state_active = 8,  /*! 管道已激活，可以收发数据 */
+    channel_state_init = 16,   /*! 管道已建立，但未连接 */
 } knet_channel_state_e;
 
-/*! ʱ */
+/*! 定时器类型 */
 typedef enum _ktimer_type_e {
-    ktimer_type_once   = 1, /*! һ */
-    ktimer_type_period = 2, /*!  */
-    ktimer_type_times  = 3, /*!  */
+    ktimer_type_once   = 1, /*! 运行一次 */
+    ktimer_type_period = 2, /*! 无限 */
+    ktimer_type_times  = 3, /*! 多次运行 */
 } ktimer_type_e;
 
-/*! ؾ */
+/*! 选取器 */
+typedef enum _loop_backend_e {
+    loop_backend_default = 0, /*! 默认, 按IOCP, epoll, io_uring, select的顺序选择第一个可用的选取器 */
+    loop_backend_select,      /*! select, 套接字数量受FD_SETSIZE限制 */
+    loop_backend_epoll,       /*! epoll */
+    loop_backend_uring,       /*! io_uring */
+    loop_backend_iocp,        /*! IOCP */
+} knet_loop_backend_e;
+
+/*! 负载均衡配置 */
 typedef enum _loop_balance_option_e {
-    loop_balancer_in  = 1, /*! kloop_tĹܵڵǰkloop_t */
-    loop_balancer_out = 2, /*! ǰkloop_tĹܵkloop_tڸ */
+    loop_balancer_in  = 1, /*! 开启其他kloop_t的管道在当前kloop_t负载 */
+    loop_balancer_out = 2, /*! 开启当前kloop_t的管道到其他kloop_t内负载 */
 } knet_loop_balance_option_e;
 
-/*! ڵɫ */
+/*! 红黑树节点颜色 */
 typedef enum _rb_color_e {
-    rb_color_red = 1, /* ɫڵ */
-    rb_color_black,   /* ɫڵ */
+    rb_color_red = 1, /* 红色节点 */
+    rb_color_black,   /* 黑色节点 */
 } rb_color_e;
 
-/*  */
+/* 错误码 */
 typedef enum _error_e {
     error_ok = 0,
     error_fail,
@@ -225,72 +235,102 @@ typedef enum _error_e {
     error_router_wire_exist,
     error_ringbuffer_not_found,
     error_getaddrinfo_fail,
+    error_reuseport_fail,
+    error_ringbuffer_mirror,
 } knet_error_e;
 
-/*! ܵص¼ */
+/*! 管道回调事件 */
 typedef enum _channel_cb_event_e {
-    channel_cb_event_connect = 1,          /*!  */
-    channel_cb_event_accept = 2,           /*! ܵ */ 
-    channel_cb_event_recv = 4,             /*! ܵݿԶ */
-    channel_cb_event_send = 8,             /*! ֽܵڣ */
-    channel_cb_event_close = 16,           /*! ܵر */
-    channel_cb_event_timeout = 32,         /*! ܵ */
-    channel_cb_event_connect_timeout = 64, /*! ӣӳʱ */
+    channel_cb_event_connect = 1,          /*! 连接完成 */
+    channel_cb_event_accept = 2,           /*! 管道监听到了新连接请求 */ 
+    channel_cb_event_recv = 4,             /*! 管道读取到新数据 */
+    channel_cb_event_send = 8,             /*! 管道发送了字节，保留 */
+    channel_cb_event_close = 16,           /*! 管道关闭 */
+    channel_cb_event_timeout = 32,         /*! 管道读空闲 */
+    channel_cb_event_connect_timeout = 64, /*! 主动发起连接，但连接超时 */
+    channel_cb_event_send_high = 128,      /*! 未发送字节数达到高水位 */
+    channel_cb_event_drain = 256,          /*! 未发送字节数回落到低水位 */
 } knet_channel_cb_event_e;
 
-/* ־ȼ */
+/*! 管道写合并方式 */
+typedef enum _channel_cork_e {
+    channel_cork_off = 0, /*! 写入时立即发送 */
+    channel_cork_on,      /*! 写入合并到缓冲区, 本次循环迭代结束时发送 */
+    channel_cork_tcp,     /*! 同channel_cork_on, 发送链表清空前保持TCP_CORK */
+} knet_channel_cork_e;
+
+/* 日志等级 */
 typedef enum _logger_level_e {
-    logger_level_verbose = 1, /* verbose -  */
-    logger_level_information, /* information - ʾϢ */
-    logger_level_warning,     /* warning -  */ 
-    logger_level_error,       /* error -  */
-    logger_level_fatal,       /* fatal -  */
+    logger_level_verbose = 1, /* verbose - 尽量输出 */
+    logger_level_information, /* information - 提示信息 */
+    logger_level_warning,     /* warning - 警告 */ 
+    logger_level_error,       /* error - 错误 */
+    logger_level_fatal,       /* fatal - 致命错误 */
 } knet_logger_level_e;
 
-/* ־ģʽ */
+/* 日志模式 */
 typedef enum _logger_mode_e {
-    logger_mode_file = 1,     /* ־ļ */
-    logger_mode_console = 2,  /* ӡstderr */
-    logger_mode_flush = 4,    /* ÿд־ͬʱջ */
-    logger_mode_override = 8, /* Ѵڵ־ļ */
+    logger_mode_file = 1,     /* 生成日志文件 */
+    logger_mode_console = 2,  /* 打印到stderr */
+    logger_mode_flush = 4,    /* 每次写日志同时清空缓存 */
+    logger_mode_override = 8, /* 覆盖已存在的日志文件 */
 } knet_logger_mode_e;
 
-/*! ̺߳ */
+/*! 线程函数 */
 typedef void (*knet_thread_func_t)(kthread_runner_t*);
-/*! ܵ¼ص */
+/*! 管道事件回调函数 */
 typedef void (*knet_channel_ref_cb_t)(kchannel_ref_t*, knet_channel_cb_event_e);
-/*! ʱص */
+/*! 定时器回调函数 */
 typedef void (*ktimer_cb_t)(ktimer_t*, void*);
-/*! RPCܻص,   ܺ󳤶, 0 ʧ */
+/*! RPC加密回调函数, 返回 非零 加密后长度, 0 失败 */
 typedef uint16_t (*krpc_encrypt_t)(void*, uint16_t, void*, uint16_t);
-/*! RPCܻص,   ܺ󳤶, 0 ʧ */
+/*! RPC解密回调函数, 返回 非零 解密后长度, 0 失败 */
 typedef uint16_t (*krpc_decrypt_t)(void*, uint16_t, void*, uint16_t);
-/*! ϣԪٺ */
+/*! 哈希表元素销毁函数 */
 typedef void (*knet_hash_dtor_t)(void*);
-/*! trieԪٺ */
+/*! trie元素销毁函数 */
 typedef void (*knet_trie_dtor_t)(void*);
-/*! trie */
+/*! trie遍历函数 */
 typedef int (*knet_trie_for_each_func_t)(const char*, void*);
-/*! ڵٻص */
+/*! 红黑树节点销毁回调函数 */
 typedef void(*knet_rb_node_destroy_cb_t)(void*, uint64_t);
+/*! 移交所有权的发送缓冲区释放函数 */
+typedef void (*knet_buffer_free_cb_t)(void*);
 
-/* Ҫ ͬѡȡ */
+/*! 数据流只读视图, 内存布局与struct iovec相同 */
+typedef struct _stream_iovec_t {
+    void*  iov_base; /* 起始地址 */
+    size_t iov_len;  /* 长度 */
+} kstream_iovec_t;
+
+/* 编译进库的选取器, 运行时通过knet_loop_create_with_backend()选择 */
 #if (defined(WIN32) || defined(_WIN64))
     #define LOOP_IOCP 1    /* IOCP */
-    #define LOOP_SELECT 0  /* select */
+    #define LOOP_SELECT 1  /* select */
 #else
     #define LOOP_EPOLL 1   /* epoll */
-    #define LOOP_SELECT 0  /* select */
+    #define LOOP_SELECT 1  /* select */
+    #if defined(__has_include)
+        #if __has_include(<linux/io_uring.h>)
+            #define LOOP_URING 1 /* io_uring, 需要通过knet_loop_create_with_backend()选择 */
+        #endif /* __has_include(<linux/io_uring.h>) */
+    #endif /* defined(__has_include) */
 #endif /* defined(WIN32) || defined(_WIN64) */
 
+#define LOOP_DEFAULT_ACCEPT_BUDGET 64 /* 监听管道单次事件默认最多接受的连接数 */
+#define LOOP_DEFAULT_READ_BUDGET 65536 /* 管道单次事件默认最多读取的字节数 */
+#define LOOP_DEFAULT_ZEROCOPY_THRESHOLD 0 /* 使用MSG_ZEROCOPY发送的最小缓冲区长度, 0为关闭 */
+#define LOOP_DEFAULT_RECV_BUFFER_INIT 0 /* 弹性读缓冲区的初始长度, 0为关闭 */
+#define LOOP_DEFAULT_RECV_BUFFER_IDLE 5000 /* 弹性读缓冲区空闲多久后归还到内存池（毫秒） */
+
 #if defined(DEBUG) || defined(_DEBUG) || !defined(NDEBUG)
-    #define LOGGER_ON 1 /* ԰汾־ */
+    #define LOGGER_ON 1 /* 调试版本开启日志 */
 #else
-    #define LOGGER_ON 0 /* аر־ */
+    #define LOGGER_ON 0 /* 发行版关闭日志 */
 #endif /* defined(DEBUG) || defined(_DEBUG) */
 
-#define LOGGER_MODE (logger_mode_file | logger_mode_console | logger_mode_flush | logger_mode_override) /* ־ģʽ */
-#define LOGGER_LEVEL logger_level_fatal /* ־ȼ */
+#define LOGGER_MODE (logger_mode_file | logger_mode_console | logger_mode_flush | logger_mode_override) /* 日志模式 */
+#define LOGGER_LEVEL logger_level_fatal /* 日志等级 */
 
 #if defined(DEBUG) || defined(_DEBUG)
     #define verify(expr) assert(expr)
@@ -28,64 +28,64 @@
 #include "misc.h"
 
 /**
- * ϣ
+ * 哈希表
  */
 struct _hash_t {
-    uint32_t          size;         /* Ͱ */
-    uint32_t          count;        /* ǰԪظ */
-    kdlist_t**        buckets;      /* Ͱ */
-    knet_hash_dtor_t  dtor;         /* Զֵٺ */
-    uint32_t          it_index;     /*  - ǰͰ */
-    kdlist_node_t*    it_node_safe; /*  - ǰͰڽڵ */
-    kdlist_node_t*    it_node_next; /*  - ǰͰڽڵһڵ */
+    uint32_t          size;         /* 桶数量 */
+    uint32_t          count;        /* 当前表内元素个数 */
+    kdlist_t**        buckets;      /* 桶数组 */
+    knet_hash_dtor_t  dtor;         /* 自定义值销毁函数 */
+    uint32_t          it_index;     /* 遍历器 - 当前遍历的桶索引 */
+    kdlist_node_t*    it_node_safe; /* 遍历器 - 当前桶内节点 */
+    kdlist_node_t*    it_node_next; /* 遍历器 - 当前桶内节点的下一个节点 */
 };
 
 /**
- * ϣ-ֵ
+ * 哈希表键-值对
  */
 struct _hash_value_t {
-    uint32_t key;        /* ּ */
-    char*    string_key; /* ַ */
-    void*    value;      /* ֵ */
+    uint32_t key;        /* 数字键 */
+    char*    string_key; /* 字符串键 */
+    void*    value;      /* 值 */
 };
 
 /**
- * ֵ
- * @param key ּ
- * @param string_key ַ
- * @param value ֵ
- * @return khash_value_tʵ
+ * 创建值
+ * @param key 数字键
+ * @param string_key 字符串键
+ * @param value 值
+ * @return khash_value_t实例
  */
 khash_value_t* hash_value_create(uint32_t key, const char* string_key, void* value);
 
 /**
- * ֵ
- * @param hash_value khash_value_tʵ
+ * 销毁值
+ * @param hash_value khash_value_t实例
  */
 void hash_value_destroy(khash_value_t* hash_value);
 
 /**
- * ּǷ
- * @param hash_value khash_value_tʵ
- * @param key 
- * @retval 0 
- * @retval  
+ * 测试数字键是否相等
+ * @param hash_value khash_value_t实例
+ * @param key 整数键
+ * @retval 0 不相等
+ * @retval 非零 相等
  */
 int hash_value_equal(khash_value_t* hash_value, uint32_t key);
 
 /**
- * ַǷ
- * @param hash_value khash_value_tʵ
- * @param key ַ
- * @retval 0 
- * @retval  
+ * 测试字符串键是否相等
+ * @param hash_value khash_value_t实例
+ * @param key 字符串键
+ * @retval 0 不相等
+ * @retval 非零 相等
  */
 int hash_value_equal_string_key(khash_value_t* hash_value, const char* key);
 
 /**
- * ֵַ
- * @param key ַ
- * @return ֵ
+ * 计算字符串整数键值
+ * @param key 字符串
+ * @return 整数键值
  */
 uint32_t hash_string(const char* key);
 
@@ -93,14 +93,14 @@ khash_value_t* hash_value_create(uint32_t key, const char* string_key, void* val
     khash_value_t* hash_value = create(khash_value_t);
     verify(hash_value);
     memset(hash_value, 0, sizeof(khash_value_t));    
-    if (string_key) { /* ַ */
+    if (string_key) { /* 字符串键 */
         hash_value->string_key = create_type(char, strlen(string_key) + 1);
         if (!hash_value->string_key) {
             knet_free(hash_value);
             return 0;
         }
         strcpy(hash_value->string_key, string_key);
-    } else { /* ּ */
+    } else { /* 数字键 */
         hash_value->key = key;
     }
     hash_value->value = value;
@@ -139,7 +139,7 @@ int hash_value_equal_string_key(khash_value_t* hash_value, const char* key) {
     verify(hash_value);
     verify(key);
     if (!hash_value->string_key) {
-        /* ⲿĵ */
+        /* 外部错误的调用 */
         verify(0);
         return 0;
     }
@@ -152,11 +152,11 @@ khash_t* hash_create(uint32_t size, knet_hash_dtor_t dtor) {
     verify(hash);
     memset(hash, 0, sizeof(khash_t));
     if (!size) {
-        size = 64; /* Ĭbucket */
+        size = 64; /* 默认bucket数量 */
     }
     hash->dtor = dtor;
     hash->size = size;
-    /* Ͱ */
+    /* 创建桶数组 */
     hash->buckets = (kdlist_t**)create_type(kdlist_t*, sizeof(kdlist_t*) * size);
     verify(hash->buckets);
     if (!hash->buckets) {
@@ -164,7 +164,7 @@ khash_t* hash_create(uint32_t size, knet_hash_dtor_t dtor) {
         return 0;
     }
     memset(hash->buckets, 0, size * sizeof(kdlist_t*));
-    /* bucket */
+    /* 创建bucket链表 */
     for (; i < size; i++) {
         hash->buckets[i] = dlist_create();
     }
@@ -177,24 +177,24 @@ void hash_destroy(khash_t* hash) {
     kdlist_node_t* temp  = 0;
     khash_value_t* value = 0;
     verify(hash);
-    /* bucket */
+    /* 遍历所有bucket并销毁 */
     for (; i < hash->size; i++) {
         if (hash->buckets[i]) {
             dlist_for_each_safe(hash->buckets[i], node, temp) {
                 value = (khash_value_t*)dlist_node_get_data(node);
                 if (hash->dtor) {
-                    /* Զ */
+                    /* 自定义销毁 */
                     hash->dtor(value->value);
                 }
-                /* ֵ */
+                /* 销毁值 */
                 hash_value_destroy(value);
             }
-            /*  */
+            /* 销毁链表 */
             dlist_destroy(hash->buckets[i]);
             hash->buckets[i] = 0;
         }
     }
-    /* bucket */
+    /* 销毁bucket */
     knet_free(hash->buckets);
     knet_free(hash);
 }
@@ -205,13 +205,13 @@ int hash_add(khash_t* hash, uint32_t key, void* value) {
     verify(hash);
     verify(value);
     hash_key = key % hash->size;
-    /* ֵ */
+    /* 创建值 */
     hash_value = hash_value_create(key, 0, value);
     verify(hash_value);
     if (!hash_value) {
         return error_no_memory;
     }
-    /* ӵβ */
+    /* 添加到链表尾 */
     if (!dlist_add_tail_node(hash->buckets[hash_key], hash_value)) {
         return error_no_memory;
     }
@@ -225,12 +225,12 @@ int hash_add_string_key(khash_t* hash, const char* key, void* value) {
     verify(hash);
     verify(value);
     hash_key = hash_string(key) % hash->size;
-    /* ֵ */
+    /* 创建值 */
     hash_value = hash_value_create(0, key, value);
     if (!hash_value) {
         return error_no_memory;
     }
-    /* ӵβ */
+    /* 添加到链表尾 */
     if (!dlist_add_tail_node(hash->buckets[hash_key], hash_value)) {
         return error_no_memory;
     }
@@ -246,23 +246,23 @@ void* hash_remove(khash_t* hash, uint32_t key) {
     void*          value      = 0;
     verify(hash);
     hash_key = key % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each_safe(hash->buckets[hash_key], node, temp) {
-        if (node == hash->it_node_next) { /* ɾڱڵĺڵ */
+        if (node == hash->it_node_next) { /* 删除正在遍历节点的后续节点 */
             hash->it_node_next = dlist_next(hash->buckets[hash_key], hash->it_node_next);
         }
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal(hash_value, key)) {
             hash->count--;
             value = hash_value_get_value(hash_value);
-            /* ٽڵ */
+            /* 销毁节点 */
             dlist_delete(hash->buckets[hash_key], node);
-            /* ֵ */
+            /* 销毁值 */
             hash_value_destroy(hash_value);
-            return value; /* ظ */
+            return value; /* 返回给调用者 */
         }
     }
-    return 0; /* ûҵ */
+    return 0; /* 没找到 */
 }
 
 void* hash_remove_string_key(khash_t* hash, const char* key) {
@@ -273,23 +273,23 @@ void* hash_remove_string_key(khash_t* hash, const char* key) {
     void*          value      = 0;
     verify(hash);
     hash_key = hash_string(key) % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each_safe(hash->buckets[hash_key], node, temp) {
-        if (node == hash->it_node_next) { /* ɾڱڵĺڵ */
+        if (node == hash->it_node_next) { /* 删除正在遍历节点的后续节点 */
             hash->it_node_next = dlist_next(hash->buckets[hash_key], hash->it_node_next);
         }
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal_string_key(hash_value, key)) {
             hash->count--;
             value = hash_value_get_value(hash_value);
-            /* ٽڵ */
+            /* 销毁节点 */
             dlist_delete(hash->buckets[hash_key], node);
-            /* ֵ */
+            /* 销毁值 */
             hash_value_destroy(hash_value);
-            return value; /* ظ */
+            return value; /* 返回给调用者 */
         }
     }
-    return 0; /* ûҵ */
+    return 0; /* 没找到 */
 }
 
 int hash_delete(khash_t* hash, uint32_t key) {
@@ -302,7 +302,7 @@ int hash_delete(khash_t* hash, uint32_t key) {
     if (hash->dtor) {
         hash->dtor(value);
     } else {
-        /* ⲿڴ棬ֲṩٺڴй¶ */
+        /* 如果外部分配的内存，调用者又不提供销毁函数则内存泄露 */
     }
     return error_ok;
 }
@@ -314,7 +314,7 @@ int hash_replace(khash_t* hash, uint32_t key, void* value) {
     verify(hash);
     verify(value);
     hash_key = key % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each(hash->buckets[hash_key], node) {
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal(hash_value, key)) {
@@ -336,7 +336,7 @@ int hash_replace_string_key(khash_t* hash, const char* key, void* value) {
     verify(key);
     verify(value);
     hash_key = hash_string(key) % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each(hash->buckets[hash_key], node) {
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal_string_key(hash_value, key)) {
@@ -360,7 +360,7 @@ int hash_delete_string_key(khash_t* hash, const char* key) {
     if (hash->dtor) {
         hash->dtor(value);
     } else {
-        /* ⲿڴ棬ֲṩٺڴй¶ */
+        /* 如果外部分配的内存，调用者又不提供销毁函数可能造成内存泄露 */
     }
     return error_ok;
 }
@@ -371,14 +371,14 @@ void* hash_get(khash_t* hash, uint32_t key) {
     khash_value_t* hash_value = 0;
     verify(hash);
     hash_key = key % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each(hash->buckets[hash_key], node) {
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal(hash_value, key)) {
             return hash_value_get_value(hash_value);
         }
     }
-    return 0; /* ûҵ */
+    return 0; /* 没找到 */
 }
 
 void* hash_get_string_key(khash_t* hash, const char* key) {
@@ -388,14 +388,14 @@ void* hash_get_string_key(khash_t* hash, const char* key) {
     verify(hash);
     verify(key);
     hash_key = hash_string(key) % hash->size;
-    /*  */
+    /* 遍历链表查找 */
     dlist_for_each(hash->buckets[hash_key], node) {
         hash_value = (khash_value_t*)dlist_node_get_data(node);
         if (hash_value_equal_string_key(hash_value, key)) {
             return hash_value_get_value(hash_value);
         }
     }
-    return 0; /* ûҵ */
+    return 0; /* 没找到 */
 }
 
 uint32_t hash_get_size(khash_t* hash) {
@@ -405,7 +405,7 @@ uint32_t hash_get_size(khash_t* hash) {
 
 uint32_t hash_string(const char* key) {
     uint32_t hash_key = 0;
-    /* 򵥵ļkey */
+    /* 简单的计算出整数key */
     for(; *key; key++) {
         hash_key = *key + hash_key * 31;
     }
@@ -420,10 +420,10 @@ khash_value_t* hash_get_first(khash_t* hash) {
     hash->it_index     = 0;
     hash->it_node_safe = 0;
     hash->it_node_next = 0;
-    if (!hash->count) { /* ûԪ */
+    if (!hash->count) { /* 没有元素 */
         return 0;
     }
-    /* ҵһԪصͰ */
+    /* 找到第一个有元素的桶 */
     for (; i < hash->size; i++) {
         list = hash->buckets[i];
         verify(list);
@@ -438,7 +438,7 @@ khash_value_t* hash_get_first(khash_t* hash) {
     }
     hash->it_node_safe = dlist_get_front(list);
     verify(hash->it_node_safe);
-    /* ԤȡһԪأǷԪ */
+    /* 预先取下一个元素，不论是否有元素 */
     hash->it_node_next = dlist_next(list, hash->it_node_safe);
     hash_value = (khash_value_t*)dlist_node_get_data(hash->it_node_safe);
     verify(hash_value);
@@ -450,19 +450,19 @@ khash_value_t* hash_next(khash_t* hash) {
     kdlist_t*      list       = 0;
     khash_value_t* hash_value = 0;
     verify(hash);
-    if (!hash->it_node_safe) { /* δhash_get_first() */
+    if (!hash->it_node_safe) { /* 未调用hash_get_first() */
         hash_get_first(hash);
     }
-    if (hash->it_node_next) { /* ǰͰһԪ */
-        hash->it_node_safe = hash->it_node_next; /*  */
-    } else { /* һԪصͰ */
+    if (hash->it_node_next) { /* 当前桶还有下一个元素 */
+        hash->it_node_safe = hash->it_node_next; /* 交换 */
+    } else { /* 到下一个有元素的桶 */
         hash->it_node_safe = 0;
         if (hash->it_index >= hash->size) {
             return 0;
         }
-        /* δβ */
+        /* 未到达尾部 */
         hash->it_index++;
-        /* Ͱ */
+        /* 遍历后续桶 */
         for (i = hash->it_index; i < hash->size; i++) {
             list = hash->buckets[i];
             verify(list);
@@ -473,11 +473,11 @@ khash_value_t* hash_next(khash_t* hash) {
                 break;
             }
         }
-        if (!hash->it_node_safe) { /* ͰΪ */
+        if (!hash->it_node_safe) { /* 后续桶都为空 */
             return 0;
         }
     }
-    /* ԤȡһԪأǷԪ */
+    /* 预先取下一个元素，不论是否有元素 */
     hash->it_node_next = dlist_next(list, hash->it_node_safe);
     hash_value = (khash_value_t*)dlist_node_get_data(hash->it_node_safe);
     verify(hash_value);
@@ -28,162 +28,162 @@
 #include "config.h"
 
 /*
- * ϣͬʱַֻ֧Ϊkey
+ * 哈希表，同时支持数字或字符串作为key
  */
 
 /**
- * ȡԶֵ
- * @param hash_value khash_value_tʵ
- * @return Զֵ
+ * 取得自定义值
+ * @param hash_value khash_value_t实例
+ * @return 自定义值
  */
 extern void* hash_value_get_value(khash_value_t* hash_value);
 
 /**
- * ȡּ
- * @param hash_value khash_value_tʵ
- * @return ּ
+ * 取得数字键
+ * @param hash_value khash_value_t实例
+ * @return 数字键
  */
 extern uint32_t hash_value_get_key(khash_value_t* hash_value);
 
 /**
- * ȡַ
- * @param hash_value khash_value_tʵ
- * @return ַ
+ * 取得字符串键
+ * @param hash_value khash_value_t实例
+ * @return 字符串键
  */
 extern const char* hash_value_get_string_key(khash_value_t* hash_value);
 
 /**
- * ϣ
- * @param size ϣͰ, 0ʹĬͰ
- * @param dtor ûԶֵٺ
- * @return khash_tʵ
+ * 建立哈希表
+ * @param size 哈希表桶数量, 0将使用默认桶数量
+ * @param dtor 用户自定义值销毁函数
+ * @return khash_t实例
  */
 extern khash_t* hash_create(uint32_t size, knet_hash_dtor_t dtor);
 
 /**
- * ٹϣ
- * @param hash khash_tʵ
+ * 销毁哈希表
+ * @param hash khash_t实例
  */
 extern void hash_destroy(khash_t* hash);
 
 /**
- * Ԫ
- * @param hash khash_tʵ
- * @param key 
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 添加元素
+ * @param hash khash_t实例
+ * @param key 键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_add(khash_t* hash, uint32_t key, void* value);
 
 /**
- * Ԫ
- * @param hash khash_tʵ
- * @param key ַ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 添加元素
+ * @param hash khash_t实例
+ * @param key 字符串键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_add_string_key(khash_t* hash, const char* key, void* value);
 
 /**
- * ƳԪ
- * @param hash khash_tʵ
- * @param key 
- * @retval 0 δҵ
- * @retval Чָ ֵ
+ * 移除元素
+ * @param hash khash_t实例
+ * @param key 键
+ * @retval 0 未找到
+ * @retval 有效指针 值
  */
 extern void* hash_remove(khash_t* hash, uint32_t key);
 
 /**
- * ƳԪ
- * @param hash khash_tʵ
- * @param key ַ
- * @retval 0 δҵ
- * @retval Чָ ֵ
+ * 移除元素
+ * @param hash khash_t实例
+ * @param key 字符串键
+ * @retval 0 未找到
+ * @retval 有效指针 值
  */
 extern void* hash_remove_string_key(khash_t* hash, const char* key);
 
 /**
- * Ԫ
- * @param hash khash_tʵ
- * @param key 
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 销毁元素
+ * @param hash khash_t实例
+ * @param key 键
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_delete(khash_t* hash, uint32_t key);
 
 /**
- * 滻
- * @param hash khash_tʵ
- * @param key 
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 替换
+ * @param hash khash_t实例
+ * @param key 键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_replace(khash_t* hash, uint32_t key, void* value);
 
 /**
- * 滻
- * @param hash khash_tʵ
- * @param key ַ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 替换
+ * @param hash khash_t实例
+ * @param key 字符串键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_replace_string_key(khash_t* hash, const char* key, void* value);
 
 /**
- * Ԫ
- * @param hash khash_tʵ
- * @param key ַ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 销毁元素
+ * @param hash khash_t实例
+ * @param key 字符串键
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int hash_delete_string_key(khash_t* hash, const char* key);
 
 /**
- * ȡԪ
- * @param hash khash_tʵ
- * @param key 
- * @retval 0 δҵ
- * @retval Чָ
+ * 获取元素
+ * @param hash khash_t实例
+ * @param key 键
+ * @retval 0 未找到
+ * @retval 有效指针
  */
 extern void* hash_get(khash_t* hash, uint32_t key);
 
 /**
- * ȡԪ
- * @param hash khash_tʵ
- * @param key ַ
- * @retval 0 δҵ
- * @retval Чָ
+ * 获取元素
+ * @param hash khash_t实例
+ * @param key 字符串键
+ * @retval 0 未找到
+ * @retval 有效指针
  */
 extern void* hash_get_string_key(khash_t* hash, const char* key);
 
 /**
- * ȡԪ
- * @param hash khash_tʵ
- * @return Ԫ
+ * 取得元素数量
+ * @param hash khash_t实例
+ * @return 元素数量
  */
 extern uint32_t hash_get_size(khash_t* hash);
 
 /**
- * ñȡһԪ
- * @param hash khash_tʵ
- * @retval 0 ûԪ
- * @retval khash_value_tʵ
+ * 重置遍历器，取第一个元素
+ * @param hash khash_t实例
+ * @retval 0 没有元素
+ * @retval khash_value_t实例
  */
 extern khash_value_t* hash_get_first(khash_t* hash);
 
 /**
- * ϣһԪ
- * @param hash khash_tʵ
- * @retval 0 ûԪ
- * @retval khash_value_tʵ
+ * 哈希表遍历器的下一个元素
+ * @param hash khash_t实例
+ * @retval 0 没有元素
+ * @retval khash_value_t实例
  */
 extern khash_value_t* hash_next(khash_t* hash);
 
-/* ϣڱɾٵǰԪ, 겻̰߳ȫ */
+/* 遍历哈希表，可以在遍历过程中删除或销毁当前元素, 遍历宏不是线程安全的 */
 #define hash_for_each_safe(hash, value) \
     for (value = hash_get_first(hash); (value); value = hash_next(hash))
 
@@ -34,15 +34,15 @@ struct _ip_filter_t {
 };
 
 /**
- * ȥַʼͽĿհ
+ * 去除字符串起始和结束的空白
  * @param ip IP
- * @param size ַ
- * @return ȥհ׺ַµַֹ
+ * @param size 字符串长度
+ * @return 去除空白后字符串新的起止地址
  */
 char* _trim(char* ip, int size);
 
 /**
- * 
+ * 遍历函数
  */
 int _ip_filter_for_each_func(const char* ip, void* param);
 
@@ -60,7 +60,7 @@ int _ip_filter_for_each_func(const char* ip, void* param) {
 char* _trim(char* ip, int size) {
     char* ptr = 0;
     int   i   = 0;
-    /*  */
+    /* 左侧 */
     for (; i < size; i++) {
         if (isdigit(ip[i]) || !ip[i]) {
             break;
@@ -68,7 +68,7 @@ char* _trim(char* ip, int size) {
     }
     ptr = ip + i;
     if (*ptr) {
-        /* Ҳ */
+        /* 右侧 */
         i = size - 1;
         for (; i >= 0; i--) {
             if (!isdigit(ip[i])) {
@@ -28,103 +28,103 @@
 #include "config.h"
 
 /**
- * @defgroup ip_filter IP
- * IP
+ * @defgroup ip_filter IP过滤
+ * IP过滤
  * <pre>
- * ṩ˿жָIPǷIPϽӿڣIP߰.
- * ip_filter_tԼѾڵIPļͬʱҲԱIPļ
- * IPļĸʽΪ
- * IP 
- * IP 
+ * 提供了快速判定指定IP是否属于IP集合接口，可以用于IP黑名单或者白名单.
+ * ip_filter_t可以加载已经存在的IP过滤文件，同时也可以保存IP过滤文件，
+ * IP过滤文件的格式为：
+ * IP 换行
+ * IP 换行
  * ......
- * ʹκı༭ֹ༭.
- * ҲʹýӿڷʵʱµIPɾIP
- * ͨ淽滻ɵIP.
+ * 可以使用任何文本编辑器手工编辑.
+ * 也可以使用接口方法实时的向过滤器内添加新的IP项或删除IP项，过滤器内容
+ * 通过保存方法即可以替换旧的IP库.
  * </pre>
  * @{
  */
 
 /**
- * IP
- * @return kip_filter_tʵ
+ * 建立IP过滤器
+ * @return kip_filter_t实例
  */
 extern kip_filter_t* knet_ip_filter_create();
 
 /**
- * IP
- * @param ip_filter kip_filter_tʵ
+ * 销毁IP过滤器
+ * @param ip_filter kip_filter_t实例
  */
 extern void knet_ip_filter_destroy(kip_filter_t* ip_filter);
 
 /**
- * IPļ
+ * 加载IP过滤文件
  *
  * <pre>
- * ļʽΪ:
+ * 文件格式为:
  * [IP]\n
  * [IP]\n
  * ......
  * </pre>
- * @param ip_filter kip_filter_tʵ
- * @param path ļ·
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param ip_filter kip_filter_t实例
+ * @param path 文件路径
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_ip_filter_load_file(kip_filter_t* ip_filter, const char* path);
 
 /**
- * ӵIP
- * @param ip_filter kip_filter_tʵ
+ * 添加单个IP
+ * @param ip_filter kip_filter_t实例
  * @param ip IP
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_ip_filter_add(kip_filter_t* ip_filter, const char* ip);
 
 /**
- * ɾIP
- * @param ip_filter kip_filter_tʵ
+ * 删除单个IP
+ * @param ip_filter kip_filter_t实例
  * @param ip IP
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_ip_filter_remove(kip_filter_t* ip_filter, const char* ip);
 
 /**
- * 浽ļ
- * @param ip_filter kip_filter_tʵ
- * @param path ļ·
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 保存到文件
+ * @param ip_filter kip_filter_t实例
+ * @param path 文件路径
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int knet_ip_filter_save(kip_filter_t* ip_filter, const char* path);
 
 /**
- * IPǷ񱻹
- * @param ip_filter kip_filter_tʵ
+ * 检查IP是否被过滤
+ * @param ip_filter kip_filter_t实例
  * @param ip IP
- * @retval 0 δ
- * @retval  
+ * @retval 0 未被过滤
+ * @retval 其他 被过滤
  */
 extern int knet_ip_filter_check(kip_filter_t* ip_filter, const char* ip);
 
 /**
- * IPǷ񱻹
- * @param ip_filter kip_filter_tʵ
- * @param address ַ
- * @retval 0 δ
- * @retval  
+ * 检查IP是否被过滤
+ * @param ip_filter kip_filter_t实例
+ * @param address 地址
+ * @retval 0 未被过滤
+ * @retval 其他 被过滤
  */
 extern int knet_ip_filter_check_address(kip_filter_t* ip_filter, kaddress_t* address);
 
 /**
- * IPǷ񱻹
+ * 检查IP是否被过滤
  *
- * ˶Զ˵ַ(peer address);
- * @param ip_filter kip_filter_tʵ
- * @param channel kchannel_ref_tʵ
- * @retval 0 δ
- * @retval  
+ * 过滤对端地址(peer address);
+ * @param ip_filter kip_filter_t实例
+ * @param channel kchannel_ref_t实例
+ * @retval 0 未被过滤
+ * @retval 其他 被过滤
  */
 extern int knet_ip_filter_check_channel(kip_filter_t* ip_filter, kchannel_ref_t* channel);
 
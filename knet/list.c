@@ -28,19 +28,19 @@
 #include "logger.h"
 
 
-/* ڵ */
+/* 链表节点 */
 struct _dlist_node_t {
-    struct _dlist_node_t* prev; /* һڵ */
-    struct _dlist_node_t* next; /* һڵ */
-    void*                 data; /* ûָ */
-    int                   init; /* Ƿͨdlist_node_initʼ */
+    struct _dlist_node_t* prev; /* 上一个节点 */
+    struct _dlist_node_t* next; /* 下一个节点 */
+    void*                 data; /* 用户数据指针 */
+    int                   init; /* 是否通过调用dlist_node_init初始化 */
 };
 
-/* ˫ѭ */
+/* 双向循环链表 */
 struct _dlist_t {
-    kdlist_node_t*   head;  /* ͷ */
-    atomic_counter_t count; /* ڽڵ */
-    int              init;  /* Ƿͨdlist_initʼ */
+    kdlist_node_t*   head;  /* 链表头 */
+    atomic_counter_t count; /* 链表内节点数量 */
+    int              init;  /* 是否通过调用dlist_init初始化 */
 };
 
 kdlist_node_t* dlist_node_create() {
@@ -64,7 +64,7 @@ kdlist_node_t* dlist_node_init(kdlist_node_t* node) {
 
 void dlist_node_destroy(kdlist_node_t* node) {
     verify(node);
-    /* dataⲿ */
+    /* data在外部销毁 */
     if (!node->init) {
         knet_free(node);
     }
@@ -28,148 +28,148 @@
 #include "config.h"
 
 /**
- * ڵ
- * @return kdlist_node_tʵ
+ * 创建链表节点
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* dlist_node_create();
 
 /**
- * ʼڵ
- * @param node kdlist_node_tʵ
- * @return kdlist_node_tʵ
+ * 初始化链表节点
+ * @param node kdlist_node_t实例
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* dlist_node_init(kdlist_node_t* node);
 
 /**
- * ڵ
- * @param node kdlist_node_tʵ
+ * 销毁链表节点
+ * @param node kdlist_node_t实例
  */
 void dlist_node_destroy(kdlist_node_t* node);
 
 /**
- * ýڵԶ
- * @param node kdlist_node_tʵ
- * @param data Զָ
- * @return kdlist_node_tʵ
+ * 设置节点自定义数据
+ * @param node kdlist_node_t实例
+ * @param data 自定义数据指针
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* dlist_node_set_data(kdlist_node_t* node, void* data);
 
 /**
- * ȡýڵԶ
- * @param node kdlist_node_tʵ
- * @return Զָ
+ * 取得节点自定义数据
+ * @param node kdlist_node_t实例
+ * @return 自定义数据指针
  */
 void* dlist_node_get_data(kdlist_node_t* node);
 
 /**
- * 
- * @return kdlist_tʵ
+ * 创建链表
+ * @return kdlist_t实例
  */
 kdlist_t* dlist_create();
 
 /**
- * ʼ
- * @param dlist kdlist_tʵ
- * @return kdlist_tʵ
+ * 初始化链表
+ * @param dlist kdlist_t实例
+ * @return kdlist_t实例
  */
 kdlist_t* dlist_init(kdlist_t* dlist);
 
 /**
- * нڵ㣨ٽڵԶݣ
- * @param dlist kdlist_tʵ
+ * 销毁整个链表，并销毁所有节点（不销毁节点内自定义数据）
+ * @param dlist kdlist_t实例
  */
 void dlist_destroy(kdlist_t* dlist);
 
 /**
- * ڵӵͷ
- * @param dlist kdlist_tʵ
- * @param node kdlist_node_tʵ
+ * 将节点添加到链表头部
+ * @param dlist kdlist_t实例
+ * @param node kdlist_node_t实例
  */
 void dlist_add_front(kdlist_t* dlist, kdlist_node_t* node);
 
 /**
- * ڵӵβ
- * @param dlist kdlist_tʵ
- * @param node kdlist_node_tʵ
+ * 将节点添加到链表尾部
+ * @param dlist kdlist_t实例
+ * @param node kdlist_node_t实例
  */
 void dlist_add_tail(kdlist_t* dlist, kdlist_node_t* node);
 
 /**
- * ½ڵ㲢ӵͷͬʱýڵԶ
- * @param dlist kdlist_tʵ
- * @param data Զָ
- * @return kdlist_node_tʵ
+ * 建立新节点并添加到链表头部，同时设置节点自定义数据
+ * @param dlist kdlist_t实例
+ * @param data 自定义数据指针
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* dlist_add_front_node(kdlist_t* dlist, void* data);
 
 /**
- * ½ڵ㲢ӵβͬʱýڵԶ
- * @param dlist kdlist_tʵ
- * @param data Զָ
- * @return kdlist_node_tʵ
+ * 建立新节点并添加到链表尾部，同时设置节点自定义数据
+ * @param dlist kdlist_t实例
+ * @param data 自定义数据指针
+ * @return kdlist_node_t实例
  */
 kdlist_node_t* dlist_add_tail_node(kdlist_t* dlist, void* data);
 
 /**
- * ȡڵ
- * @param dlist kdlist_tʵ
- * @return ڵ
+ * 取得链表节点数量
+ * @param dlist kdlist_t实例
+ * @return 节点数量
  */
 int dlist_get_count(kdlist_t* dlist);
 
 /**
- * 
- * @param dlist kdlist_tʵ
- * @retval 0 ǿ
- * @retval  
+ * 空
+ * @param dlist kdlist_t实例
+ * @retval 0 非空
+ * @retval 非零 空
  */
 int dlist_empty(kdlist_t* dlist);
 
 /**
- * ڵƳ
- * @param dlist kdlist_tʵ
- * @param node ǰڵ
- * @retval kdlist_node_tʵ
+ * 将节点从链表内移除但不销毁
+ * @param dlist kdlist_t实例
+ * @param node 当前节点
+ * @retval kdlist_node_t实例
  */
 kdlist_node_t* dlist_remove(kdlist_t* dlist, kdlist_node_t* node);
 
 /**
- * ڵ
- * @param dlist kdlist_tʵ
- * @param node ǰڵ
+ * 销毁链表节点
+ * @param dlist kdlist_t实例
+ * @param node 当前节点
  */
 void dlist_delete(kdlist_t* dlist, kdlist_node_t* node);
 
 /**
- * ȡͷǰڵһڵ
- * @param dlist kdlist_tʵ
- * @param node ǰڵ
- * @retval kdlist_node_tʵ
- * @retval 0 ûиڵ
+ * 取得链头当前节点的下一个节点
+ * @param dlist kdlist_t实例
+ * @param node 当前节点
+ * @retval kdlist_node_t实例
+ * @retval 0 没有更多节点
  */
 kdlist_node_t* dlist_next(kdlist_t* dlist, kdlist_node_t* node);
 
 /**
- * ȡͷڵ
- * @param dlist kdlist_tʵ
- * @retval kdlist_node_tʵ
- * @retval 0 Ϊ
+ * 取得链头节点
+ * @param dlist kdlist_t实例
+ * @retval kdlist_node_t实例
+ * @retval 0 链表为空
  */
 kdlist_node_t* dlist_get_front(kdlist_t* dlist);
 
 /**
- * ȡβڵ
- * @param dlist kdlist_tʵ
- * @retval kdlist_node_tʵ
- * @retval 0 Ϊ
+ * 取得链表尾节点
+ * @param dlist kdlist_t实例
+ * @retval kdlist_node_t实例
+ * @retval 0 链表为空
  */
 kdlist_node_t* dlist_get_back(kdlist_t* dlist);
 
-/* ڱͬʱɾڵ */
+/* 遍历链表，在遍历的同时不能删除或销毁链表节点 */
 #define dlist_for_each(list, node) \
     for (node = dlist_get_front(list); (node); node = dlist_next(list, node))
 
-/* ڱͬʱɾڵ */
+/* 遍历链表，可以在遍历同时进行删除或销毁链表节点 */
 #define dlist_for_each_safe(list, node, temp) \
     for (node = dlist_get_front(list), temp = dlist_next(list, node); (node); node = temp, temp = dlist_next(list, node))
 
@@ -27,13 +27,13 @@
 #include "misc.h"
 #include "logger.h"
 
-klogger_t* global_logger = 0; /* ȫ־ָ */
+klogger_t* global_logger = 0; /* 全局日志指针 */
 
 struct _logger_t {
-    FILE*               fd;    /* ļ */
-    knet_logger_level_e level; /* ־ȼ */
-    int                 mode;  /* ־ģʽ */
-    klock_t*            lock;  /*  */
+    FILE*               fd;    /* 文件 */
+    knet_logger_level_e level; /* 日志等级 */
+    int                 mode;  /* 日志模式 */
+    klock_t*            lock;  /* 锁 */
 };
 
 void set_console_blue() {
@@ -89,17 +89,17 @@ klogger_t* logger_create(const char* path, int level, int mode) {
     logger->lock  = lock_create();
     verify(logger->lock);
     if (!path) {
-        /* ־ڵǰĿ¼ */
+        /* 日志建立在当前目录 */
         path = path_getcwd(temp, sizeof(temp));
         strcat(temp, "/knet.log");
     }
     if (mode & logger_mode_file) {
         verify(path);
         if (mode & logger_mode_override) {
-            /* 򿪲 */
+            /* 打开并清空 */
             logger->fd = fopen(path, "w+");
         } else {
-            /* ӵԭ־ */
+            /* 添加到原有日志 */
             logger->fd = fopen(path, "a+");
         }
         if (!logger->fd) {
@@ -129,26 +129,26 @@ int logger_write(klogger_t* logger, int level, const char* format, ...) {
     verify(logger);
     verify(format);
     if (logger->level > level) {
-        /* ־ȼ */
+        /* 日志等级不足 */
         return error_ok;
     }
     va_start(va_ptr_file, format);
     va_start(va_ptr_console, format);
     time_get_string(buffer, sizeof(buffer));
     if (logger->mode & logger_mode_file) {
-        /* д־ļ */
+        /* 写入日志文件 */
         lock_lock(logger->lock);
         fprintf(logger->fd, "[%s][%s]", logger_level_name[level], buffer);
         vfprintf(logger->fd, format, va_ptr_file);
         fprintf(logger->fd, "\n");
         if (logger->mode & logger_mode_flush) {
-            /* д */
+            /* 立即写入 */
             fflush(logger->fd);
         }
         lock_unlock(logger->lock);
     }
     if (logger->mode & logger_mode_console) {
-        /* дstderr */
+        /* 写入stderr */
         lock_lock(logger->lock);
         if (level == logger_level_verbose) {
             set_console_blue();
@@ -165,7 +165,7 @@ int logger_write(klogger_t* logger, int level, const char* format, ...) {
         vfprintf(stderr, format, va_ptr_console);
         fprintf(stderr, "\n");
         if (logger->mode & logger_mode_flush) {
-            /* д */
+            /* 立即写入 */
             fflush(stderr);
         }
         lock_unlock(logger->lock);
@@ -28,10 +28,10 @@
 #include "config.h"
 #include "logger_api.h"
 
-/* ȫ־ */
+/* 全局日志 */
 extern klogger_t* global_logger;
 
-/* ȫ־ʵ */
+/* 建立全局日志实例 */
 #define GLOBAL_LOGGER_INITIALIZE() \
     do { \
         if (!global_logger) global_logger = logger_create(0, LOGGER_LEVEL, LOGGER_MODE); \
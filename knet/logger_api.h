@@ -28,27 +28,27 @@
 #include "config.h"
 
 /**
- * ־
- * @param path ־ļ·, Ϊ0ʹõǰĿ¼
- * @param level ־ȼ
- * @param mode ־ģʽ
- * @return klogger_tʵ
+ * 建立日志
+ * @param path 日志文件路径, 如果为0将使用当前目录
+ * @param level 日志等级
+ * @param mode 日志模式
+ * @return klogger_t实例
  */
 extern klogger_t* logger_create(const char* path, int level, int mode);
 
 /**
- * ־
- * @param logger klogger_tʵ
+ * 销毁日志
+ * @param logger klogger_t实例
  */
 extern void logger_destroy(klogger_t* logger);
 
 /**
- * д־
- * @param logger klogger_tʵ
- * @param level ־ȼ
- * @param format ־ʽ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 写日志
+ * @param logger klogger_t实例
+ * @param level 日志等级
+ * @param format 日志格式
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int logger_write(klogger_t* logger, int level, const char* format, ...);
 
@@ -33,55 +33,170 @@
 #include "stream.h"
 #include "logger.h"
 #include "timer.h"
+#include "write_batch.h"
 
 /**
- * ѭ
+ * 网络线程事件类型
+ */
+typedef enum _loop_event_e {
+    loop_event_accept = 1,    /* 接受新连接事件 */
+    loop_event_connect,       /* 发起连接事件 */
+    loop_event_send,          /* 发送事件 */
+    loop_event_close,         /* 关闭事件 */
+    loop_event_accept_async,  /* 异步发起监听 */
+    loop_event_write_batch,   /* 批量写入 */
+} loop_event_e;
+
+/**
+ * 网络线程事件
+ */
+typedef struct _loop_event_t {
+    kchannel_ref_t*                 channel_ref; /* 事件相关管道 */
+    kbuffer_t*                      send_buffer; /* 发送缓冲区指针 */
+    kwrite_batch_t*                 batch;       /* 批量写入 */
+    loop_event_e                    event;       /* 事件类型 */
+    struct _loop_event_t* volatile  next;        /* 事件队列内下一个事件 */
+} loop_event_t;
+
+/**
+ * 弹性读缓冲区内存池的长度级别数量, 第i级的长度为初始长度的2^i倍
+ */
+#define LOOP_RECV_POOL_CLASSES 16
+
+/**
+ * 弹性读缓冲区内存池每个级别最多缓存的数量
+ */
+#define LOOP_RECV_POOL_MAX 256
+
+/**
+ * 网络循环
  */
 struct _loop_t {
-    kdlist_t*                  active_channel_list; /* Ծܵ */
-    kdlist_t*                  close_channel_list;  /* ѹرչܵ */
-    kdlist_t*                  event_list;          /* ߳¼ */
-    klock_t*                   lock;                /* -߳¼ */
-    kchannel_ref_t*            notify_channel;      /* ¼֪ͨдܵ */
-    kchannel_ref_t*            read_channel;        /* ¼֪ͨܵ */
-    kloop_balancer_t*          balancer;            /* ؾ */
-    void*                      impl;                /* ¼ѡȡʵ */
-    volatile int               running;             /* ¼ѭб־ */
-    thread_id_t                thread_id;           /* ¼ѡȡǰ߳ID */
-    knet_loop_balance_option_e balance_options;     /* ؾ */
-    kloop_profile_t*           profile;             /* ͳ */
-    void*                      data;                /* ûָ */
-    ktimer_loop_t*             timer_loop;          /* ʱѭ */
+    kdlist_t*                  active_channel_list; /* 活跃管道链表 */
+    kdlist_t*                  close_channel_list;  /* 已关闭管道链表 */
+    kdlist_t*                  ready_channel_list;  /* 就绪管道链表, 上次读取达到预算仍有数据未读的管道 */
+    kdlist_t*                  cork_channel_list;   /* 合并写管道链表, 本次循环迭代结束时发送 */
+    kdlist_t*                  buffer_channel_list; /* 持有弹性读缓冲区的管道链表, 回收定时器只检查这些管道 */
+    loop_event_t* volatile     event_tail;          /* 跨线程事件队列尾, 生产者线程原子交换 */
+    loop_event_t*              event_head;          /* 跨线程事件队列头, 只在loop线程内访问 */
+    loop_event_t               event_stub;          /* 跨线程事件队列哨兵节点 */
+    loop_event_t* volatile     event_free;          /* 已处理事件的空闲链表, 只有loop线程放入, 生产者线程整体取走 */
+    kchannel_ref_t*            notify_channel;      /* 事件通知写管道 */
+    kchannel_ref_t*            read_channel;        /* 事件通知读管道 */
+    int                        notify_channel_count; /* 活跃管道链表内的事件通知管道数量 */
+    kloop_balancer_t*          balancer;            /* 负载均衡器 */
+    loop_backend_t*            backend;             /* 事件选取器方法表 */
+    void*                      impl;                /* 事件选取器实现 */
+    volatile int               running;             /* 事件循环运行标志 */
+    thread_id_t                thread_id;           /* 事件选取器当前运行线程ID */
+    knet_loop_balance_option_e balance_options;     /* 负载均衡配置 */
+    kloop_profile_t*           profile;             /* 统计 */
+    void*                      data;                /* 用户数据指针 */
+    ktimer_loop_t*             timer_loop;          /* 定时器循环 */
+    int                        spin_count;          /* 阻塞前非阻塞轮询次数 */
+    int                        max_wait;            /* 选取器单次最长等待时间（毫秒）, -1为无限制 */
+    int                        dedicated;           /* 是否由独占线程驱动, 独占线程允许无限期阻塞 */
+    atomic_counter_t           notified;            /* 是否已经唤醒过, loop处理事件前不再重复唤醒 */
+    atomic_counter_t           accept_pending;      /* 已经分配到本loop但还未处理的新连接数量 */
+    int                        accept_budget;       /* 监听管道单次事件最多接受的连接数, 0为直到EAGAIN */
+    uint64_t                   now;                 /* 本次迭代的单调时钟时间戳（毫秒） */
+    int                        read_budget;         /* 管道单次事件最多读取的字节数, 0为不限制 */
+    int                        zerocopy_threshold;  /* 使用MSG_ZEROCOPY发送的最小缓冲区长度, 0为关闭 */
+    uint32_t                   recv_buffer_init;    /* 弹性读缓冲区的初始长度, 0为关闭 */
+    int                        recv_buffer_idle;    /* 弹性读缓冲区空闲多久后归还到内存池（毫秒） */
+    ktimer_t*                  recv_buffer_timer;   /* 回收空闲弹性读缓冲区的定时器 */
+    int                        recv_buffer_mirror;  /* 固定长度的读缓冲区是否双重映射 */
+    char*                      recv_pool[LOOP_RECV_POOL_CLASSES];       /* 弹性读缓冲区内存池, 按长度级别链接 */
+    uint32_t                   recv_pool_count[LOOP_RECV_POOL_CLASSES]; /* 每个级别缓存的数量 */
 };
 
 /**
- * ߳¼
+ * 取得长度为size的缓冲区在内存池内的级别
+ * @param loop kloop_t实例
+ * @param size 缓冲区长度
+ * @retval -1 不属于任何级别
+ * @retval 其他 级别
  */
-typedef enum _loop_event_e {
-    loop_event_accept = 1,    /* ¼ */
-    loop_event_connect,       /* ¼ */
-    loop_event_send,          /* ¼ */
-    loop_event_close,         /* ر¼ */
-    loop_event_accept_async,  /* 첽 */
-} loop_event_e;
+int _loop_recv_pool_class(kloop_t* loop, uint32_t size);
 
 /**
- * ߳¼
+ * 释放内存池内缓存的所有缓冲区
+ * @param loop kloop_t实例
+ */
+void _loop_recv_pool_clear(kloop_t* loop);
+
+/**
+ * 取得一个跨线程事件, 优先使用空闲链表内的事件
+ * @param loop kloop_t实例
+ * @return loop_event_t实例
+ */
+loop_event_t* _loop_event_alloc(kloop_t* loop);
+
+/**
+ * 处理完的跨线程事件放入空闲链表, 只在loop线程内调用
+ * @param loop kloop_t实例
+ * @param loop_event loop_event_t实例
+ */
+void _loop_event_recycle(kloop_t* loop, loop_event_t* loop_event);
+
+/**
+ * 定时回收空闲的弹性读缓冲区
+ * @param timer 定时器
+ * @param data kloop_t实例
+ */
+void _loop_recv_buffer_timer_cb(ktimer_t* timer, void* data);
+
+/**
+ * 按当前配置重新启动或停止回收定时器
+ * @param loop kloop_t实例
+ */
+void _loop_recv_buffer_timer_reset(kloop_t* loop);
+
+/*
+ * 跨线程事件空闲链表:
+ * 1. loop线程放入处理完的事件, 比较并交换链表头, 即使链表头被取走后又变回原值, 新节点的next仍然是当前链表头
+ * 2. 生产者线程原子交换链表头为0整体取走, 使用第一个节点, 剩余节点只在链表仍然为空时整体放回, 否则释放
+ * 3. 不存在逐个取出节点的操作, 因此没有ABA问题, 空闲链表长度不超过同时未处理的事件数量
  */
-typedef struct _loop_event_t {
-    kchannel_ref_t* channel_ref; /* ¼عܵ */
-    kbuffer_t*      send_buffer; /* ͻָ */
-    loop_event_e    event;       /* ¼ */
-} loop_event_t;
 
-loop_event_t* loop_event_create(kchannel_ref_t* channel_ref, kbuffer_t* send_buffer, loop_event_e e) {
+loop_event_t* _loop_event_alloc(kloop_t* loop) {
+    loop_event_t* ev   = 0;
+    loop_event_t* rest = 0;
+    loop_event_t* temp = 0;
+    ev = (loop_event_t*)atomic_ptr_exchange((void* volatile*)&loop->event_free, 0);
+    if (!ev) {
+        ev = create(loop_event_t);
+        verify(ev);
+        return ev;
+    }
+    rest = ev->next;
+    if (rest && atomic_ptr_cas((void* volatile*)&loop->event_free, 0, rest)) {
+        /* loop线程已经放入了新的节点, 释放剩余节点 */
+        for (; rest; rest = temp) {
+            temp = rest->next;
+            knet_free(rest);
+        }
+    }
+    return ev;
+}
+
+void _loop_event_recycle(kloop_t* loop, loop_event_t* loop_event) {
+    loop_event_t* head = 0;
+    do {
+        head = (loop_event_t*)atomic_ptr_get((void* volatile*)&loop->event_free);
+        loop_event->next = head;
+    } while (atomic_ptr_cas((void* volatile*)&loop->event_free, head, loop_event) != head);
+}
+
+loop_event_t* loop_event_create(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer, loop_event_e e) {
     loop_event_t* ev = 0;
-    verify(channel_ref); /* send_bufferΪ0 */
-    ev = create(loop_event_t);
-    verify(ev);
+    verify(channel_ref); /* send_buffer可以为0 */
+    ev = _loop_event_alloc(loop);
     ev->channel_ref = channel_ref;
     ev->send_buffer = send_buffer;
+    ev->batch       = 0;
     ev->event       = e;
+    ev->next        = 0;
     return ev;
 }
 
@@ -105,44 +220,135 @@ loop_event_e loop_event_get_event(loop_event_t* loop_event) {
     return loop_event->event;
 }
 
+/*
+ * 跨线程事件队列为无锁多生产者/单消费者队列:
+ * 1. 生产者原子交换队列尾, 再将原队列尾的next指向新节点, 不会阻塞
+ * 2. 只有loop线程消费, 队列头不需要同步
+ * 3. 生产者交换队列尾后, 设置next前, 消费者看到的队列是断开的, 此时停止消费,
+ *    生产者随后发送的通知会再次触发消费
+ */
+
+void loop_event_push(kloop_t* loop, loop_event_t* loop_event) {
+    loop_event_t* prev = 0;
+    loop_event->next = 0;
+    prev = (loop_event_t*)atomic_ptr_exchange((void* volatile*)&loop->event_tail, loop_event);
+    atomic_ptr_exchange((void* volatile*)&prev->next, loop_event);
+}
+
+loop_event_t* loop_event_pop(kloop_t* loop) {
+    loop_event_t* head = loop->event_head;
+    loop_event_t* next = (loop_event_t*)atomic_ptr_get((void* volatile*)&head->next);
+    if (head == &loop->event_stub) {
+        if (!next) {
+            /* 队列为空 */
+            return 0;
+        }
+        /* 跳过哨兵节点 */
+        loop->event_head = next;
+        head = next;
+        next = (loop_event_t*)atomic_ptr_get((void* volatile*)&head->next);
+    }
+    if (next) {
+        loop->event_head = next;
+        return head;
+    }
+    if (head != (loop_event_t*)atomic_ptr_get((void* volatile*)&loop->event_tail)) {
+        /* 生产者正在添加节点 */
+        return 0;
+    }
+    /* 只剩最后一个节点, 重新放入哨兵节点后才能取出 */
+    loop_event_push(loop, &loop->event_stub);
+    next = (loop_event_t*)atomic_ptr_get((void* volatile*)&head->next);
+    if (next) {
+        loop->event_head = next;
+        return head;
+    }
+    return 0;
+}
+
 kloop_t* knet_loop_create() {
-    socket_t pair[2] = {0}; /* ߳¼д */
-    kloop_t* loop    = create(kloop_t);
+    return knet_loop_create_with_backend(loop_backend_default);
+}
+
+kloop_t* knet_loop_create_with_backend(knet_loop_backend_e backend) {
+    loop_backend_t** backends = knet_loop_get_backends();
+    kloop_t*         loop     = create(kloop_t);
     verify(loop);
     memset(loop, 0, sizeof(kloop_t));
-    /* ѡȡʵ */
-    if (knet_impl_create(loop)) {
+    loop->active_channel_list = dlist_create();                       /* 活跃管道链表 */
+    loop->close_channel_list  = dlist_create();                       /* 延迟关闭管道链表 */
+    loop->ready_channel_list  = dlist_create();                       /* 就绪管道链表 */
+    loop->cork_channel_list   = dlist_create();                       /* 合并写管道链表 */
+    loop->buffer_channel_list = dlist_create();                       /* 持有弹性读缓冲区的管道链表 */
+    loop->event_head          = &loop->event_stub;                    /* 跨线程事件队列头 */
+    loop->event_tail          = &loop->event_stub;                    /* 跨线程事件队列尾 */
+    loop->timer_loop          = ktimer_loop_create(0);                /* 建立定时器循环 */
+    knet_loop_update_time(loop);                                      /* 本次迭代的时间戳 */
+    loop->profile             = knet_loop_profile_create(loop);       /* 统计 */
+    loop->balance_options     = loop_balancer_in | loop_balancer_out; /* 负载均衡配置 */
+    loop->max_wait            = -1;                                   /* 由定时器决定等待时间 */
+    loop->accept_budget       = LOOP_DEFAULT_ACCEPT_BUDGET;           /* 单次事件最多接受的连接数 */
+    loop->read_budget         = LOOP_DEFAULT_READ_BUDGET;             /* 单次事件最多读取的字节数 */
+    loop->zerocopy_threshold  = LOOP_DEFAULT_ZEROCOPY_THRESHOLD;      /* MSG_ZEROCOPY最小缓冲区长度 */
+    loop->recv_buffer_idle    = LOOP_DEFAULT_RECV_BUFFER_IDLE;        /* 弹性读缓冲区空闲回收时间 */
+    /* 建立选取器实现, 选取器同时建立跨线程事件唤醒机制, 默认选择第一个建立成功的选取器 */
+    for (; *backends; backends++) {
+        if ((backend != loop_backend_default) && ((*backends)->type != backend)) {
+            continue;
+        }
+        /* 选取器建立过程中可能已经添加管道, 需要先设置方法表 */
+        loop->backend = *backends;
+        if (error_ok == knet_impl_create(loop)) {
+            break;
+        }
+        log_info("loop backend %s unavailable", (*backends)->name);
+        loop->backend = 0;
+        loop->impl    = 0;
+        if (backend != loop_backend_default) {
+            break;
+        }
+    }
+    if (!loop->backend) {
+        if ((backend != loop_backend_default) && !*backends) {
+            log_info("knet_loop_create_with_backend() failed, reason: backend %d not built in", backend);
+        } else {
+            log_fatal("knet_loop_create_with_backend() failed, reason: knet_impl_create(), backend: %d", backend);
+        }
+        ktimer_loop_destroy(loop->timer_loop);
+        dlist_destroy(loop->buffer_channel_list);
+        dlist_destroy(loop->cork_channel_list);
+        dlist_destroy(loop->ready_channel_list);
+        dlist_destroy(loop->close_channel_list);
+        dlist_destroy(loop->active_channel_list);
+        knet_loop_profile_destroy(loop->profile);
         knet_free(loop);
-        log_fatal("knet_loop_create() failed, reason: knet_impl_create()");
         return 0;
     }
-    /* ߳¼д */
+    return loop;
+}
+
+int knet_loop_create_notify_channel(kloop_t* loop) {
+    socket_t pair[2] = {0}; /* 线程事件读写描述符 */
+    verify(loop);
+    /* 建立线程事件读写描述符 */
     if (socket_pair(pair)) {
-        knet_free(loop);
-        log_fatal("knet_loop_create() failed, reason: socket_pair()");
-        return 0;
+        log_fatal("knet_loop_create_notify_channel() failed, reason: socket_pair()");
+        return error_loop_impl_init_fail;
     }
-    loop->profile             = knet_loop_profile_create(loop);       /* ͳ */
-    loop->active_channel_list = dlist_create();                       /* Ծܵ */
-    loop->close_channel_list  = dlist_create();                       /* ӳٹرչܵ */
-    loop->event_list          = dlist_create();                       /* ߳¼ */
-    loop->lock                = lock_create();                        /*  - ߳¼ */
-    loop->timer_loop          = ktimer_loop_create(0);                /* ʱѭ */
-    loop->balance_options     = loop_balancer_in | loop_balancer_out; /* ؾ */
-    loop->notify_channel      = knet_loop_create_channel_exist_socket_fd(loop, pair[0], 0, 0); /* ߳¼֪ͨдܵ */
+    loop->notify_channel = knet_loop_create_channel_exist_socket_fd(loop, pair[0], 0, 0); /* 跨线程事件通知写管道 */
     verify(loop->notify_channel);
-    loop->read_channel = knet_loop_create_channel_exist_socket_fd(loop, pair[1], 0, 1024 * 16); /* ߳¼֪ͨܵ */
+    loop->read_channel = knet_loop_create_channel_exist_socket_fd(loop, pair[1], 0, 1024 * 16); /* 跨线程事件通知读管道 */
     verify(loop->read_channel);
-    /* ¼ܵ뵽ԾܵΪԾ״̬*/
+    /* 将事件管道加入到活跃管道链并设置为活跃状态*/
     knet_loop_add_channel_ref(loop, loop->notify_channel);
     knet_loop_add_channel_ref(loop, loop->read_channel);
     knet_channel_ref_set_state(loop->notify_channel, channel_state_active);
     knet_channel_ref_set_state(loop->read_channel, channel_state_active);
-    /* ע¼ */
+    /* 注册读事件 */
     knet_channel_ref_set_event(loop->read_channel, channel_event_recv);
-    /* ö¼ص */
+    /* 设置读事件回调 */
     knet_channel_ref_set_cb(loop->read_channel, knet_loop_queue_cb);
-    return loop;
+    return error_ok;
 }
 
 void knet_loop_destroy(kloop_t* loop) {
@@ -151,156 +357,215 @@ void knet_loop_destroy(kloop_t* loop) {
     kchannel_ref_t* channel_ref = 0;
     loop_event_t*   event       = 0;
     verify(loop);
-    /* رлԾܵ */
+    /* 关闭所有活跃管道 */
     dlist_for_each_safe(loop->active_channel_list, node, temp) {
         channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
-        /* رյĻԾܵǨƵӳٹر */
+        /* 关闭的活跃管道将被迁移到延迟关闭链表 */
         knet_channel_ref_update_close_in_loop(knet_channel_ref_get_loop(channel_ref), channel_ref);
     }
-    /* ѹرչܵ */
+    /* 销毁已关闭管道 */
     dlist_for_each_safe(loop->close_channel_list, node, temp) {
         channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
         knet_channel_ref_destroy(channel_ref);
     }
-    /* ѡȡʵ */
+    /* 销毁选取器本地实现 */
     knet_impl_destroy(loop);
-    dlist_destroy(loop->close_channel_list); /* ٹر */
-    dlist_destroy(loop->active_channel_list); /* ٻԾ */
-    /* δ߳¼ */
-    dlist_for_each_safe(loop->event_list, node, temp) {
-        event = (loop_event_t*)dlist_node_get_data(node);
-        knet_free(event);
-    }
-    /* ͳ */
+    dlist_destroy(loop->ready_channel_list); /* 销毁就绪链表 */
+    dlist_destroy(loop->cork_channel_list); /* 销毁合并写链表 */
+    dlist_destroy(loop->buffer_channel_list); /* 销毁弹性读缓冲区管道链表 */
+    dlist_destroy(loop->close_channel_list); /* 销毁关闭链表 */
+    dlist_destroy(loop->active_channel_list); /* 销毁活跃链表 */
+    /* 销毁未处理跨线程事件 */
+    for (event = loop_event_pop(loop); event; event = loop_event_pop(loop)) {
+        if (event->batch) {
+            knet_write_batch_destroy(event->batch);
+        }
+        loop_event_destroy(event);
+    }
+    /* 销毁空闲事件 */
+    while (loop->event_free) {
+        event = loop->event_free;
+        loop->event_free = event->next;
+        loop_event_destroy(event);
+    }
+    /* 销毁统计器 */
     knet_loop_profile_destroy(loop->profile);
-    /* ¼ */
-    dlist_destroy(loop->event_list);
-    /* ¼ */
-    lock_destroy(loop->lock);
-    /* ٶʱѭ, йܵʱ */
+    /* 销毁定时器循环, 所有管道定时器将被销毁 */
     ktimer_loop_destroy(loop->timer_loop);
-    /* ѭ */
+    /* 销毁弹性读缓冲区内存池, 管道已经全部销毁 */
+    _loop_recv_pool_clear(loop);
+    /* 销毁网络循环 */
     knet_free(loop);
 }
 
 void loop_add_event(kloop_t* loop, loop_event_t* loop_event) {
     verify(loop);
     verify(loop_event);
-    lock_lock(loop->lock); /*  */
     log_verb("invoke loop_add_event(), event[type:%d]", loop_event->event);
-    /* ¼ӵβ */
-    dlist_add_tail_node(loop->event_list, loop_event);
-    lock_unlock(loop->lock); /*  */
-    knet_loop_notify(loop); /* ֪ͨĿ */
+    /* 事件添加到队列尾部 */
+    loop_event_push(loop, loop_event);
+    knet_loop_notify(loop); /* 通知目标 */
 }
 
 void knet_loop_notify_accept(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* accept¼ */
-    loop_add_event(loop, loop_event_create(channel_ref, 0, loop_event_accept));
+    /* 负载均衡选择时计入未处理的新连接 */
+    atomic_counter_inc(&loop->accept_pending);
+    /* 添加accept事件 */
+    loop_add_event(loop, loop_event_create(loop, channel_ref, 0, loop_event_accept));
 }
 
 void knet_loop_notify_accept_async(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* 첽accept¼ */
-    loop_add_event(loop, loop_event_create(channel_ref, 0, loop_event_accept_async));
+    /* 添加异步accept事件 */
+    loop_add_event(loop, loop_event_create(loop, channel_ref, 0, loop_event_accept_async));
 }
 
 void knet_loop_notify_connect(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* connect¼ */
-    loop_add_event(loop, loop_event_create(channel_ref, 0, loop_event_connect));
+    /* 添加connect事件 */
+    loop_add_event(loop, loop_event_create(loop, channel_ref, 0, loop_event_connect));
 }
 
 void knet_loop_notify_send(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer) {
     verify(loop);
     verify(channel_ref);
     verify(send_buffer);
-    /* send¼ */
-    loop_add_event(loop, loop_event_create(channel_ref, send_buffer, loop_event_send));
+    /* 添加send事件 */
+    loop_add_event(loop, loop_event_create(loop, channel_ref, send_buffer, loop_event_send));
+}
+
+void knet_loop_notify_write_batch(kloop_t* loop, kwrite_batch_t* batch) {
+    loop_event_t* ev = 0;
+    verify(loop);
+    verify(batch);
+    /* 批量写入事件不关联管道 */
+    ev = _loop_event_alloc(loop);
+    memset(ev, 0, sizeof(loop_event_t));
+    ev->batch = batch;
+    ev->event = loop_event_write_batch;
+    /* 添加批量写入事件 */
+    loop_add_event(loop, ev);
 }
 
 void knet_loop_notify_close(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* ӹر¼ */
-    loop_add_event(loop, loop_event_create(channel_ref, 0, loop_event_close));
+    /* 添加关闭事件 */
+    loop_add_event(loop, loop_event_create(loop, channel_ref, 0, loop_event_close));
 }
 
 void knet_loop_queue_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     verify(channel);
     if (e & channel_cb_event_recv) {
-        /* ж, Щ(ûʵ)ֻǴ¼loop̷߳͹¼ */
+        /* 清空所有读到的数据, 这些数据(没有实际意义)只是触发读事件来让loop处理其他线程发送过来的事件 */
         knet_stream_eat_all(knet_channel_ref_get_stream(channel));
-        /* һȫ¼ */
+        /* 一次全部处理完所有事件 */
         knet_loop_event_process(knet_channel_ref_get_loop(channel));
     } else if (e & channel_cb_event_close) {
         if (knet_loop_check_running(knet_channel_ref_get_loop(channel))) {
-            /* ӶϿ,  */
+            /* 连接断开, 致命错误 */
             verify(0);
         }
     }
 }
 
 void knet_loop_notify(kloop_t* loop) {
+    verify(loop);
+    if (atomic_counter_cas(&loop->notified, 0, 1)) {
+        /* 已经唤醒过, loop还未处理事件 */
+        return;
+    }
+    knet_impl_notify(loop);
+}
+
+void knet_loop_notify_channel_send(kloop_t* loop) {
     char c = 1;
     verify(loop);
-    /* һֽڴص  */
+    /* 发送一个字节触发读回调  */
     socket_send(knet_channel_ref_get_socket_fd(loop->notify_channel), &c, sizeof(c));
 }
 
 void knet_loop_event_process(kloop_t* loop) {
     /*
-     * loop̵߳Ĵԭ:
-     * 1. κιܵ(kchannel_ref_t)вֻһ߳, ܵ߳ǰ󶨵Ĺϵ
-     * 2. κһ߳ڲܵ, ܵ߳ûа󶨹ϵ, ¼ʽ̴߳
+     * loop多线程的处理原则如下:
+     * 1. 任何管道(kchannel_ref_t)的所有操作只会在一个线程内, 即管道与线程是绑定的关系
+     * 2. 在任何一个线程内操作管道, 如果管道与线程没有绑定关系, 都会以事件方式发送至绑定线程处理
      */
-    kdlist_node_t* node       = 0;
-    kdlist_node_t* temp       = 0;
-    loop_event_t*  loop_event = 0;
-    verify(loop);
-    lock_lock(loop->lock); /*  */
-    /* ÿζ¼صڴ¼ */
-    dlist_for_each_safe(loop->event_list, node, temp) {
-        loop_event = (loop_event_t*)dlist_node_get_data(node);
+    loop_event_t* loop_event = 0;
+    verify(loop);
+    /* 先清除唤醒标志, 之后加入的事件会再次唤醒loop */
+    atomic_counter_set(&loop->notified, 0);
+    /* 每次读事件回调内处理整个事件队列 */
+    for (loop_event = loop_event_pop(loop); loop_event; loop_event = loop_event_pop(loop)) {
         switch(loop_event->event) {
-            case loop_event_accept: /*  */
+            case loop_event_accept: /* 接受新连接 */
                 knet_channel_ref_update_accept_in_loop(loop, loop_event->channel_ref);
+                atomic_counter_dec(&loop->accept_pending);
                 break;
-            case loop_event_accept_async: /* ǰloopaccept() */
+            case loop_event_accept_async: /* 当前loop内accept() */
                 knet_channel_ref_accept_async(loop_event->channel_ref);
                 break;
-            case loop_event_connect: /* ǰloopconnect */
+            case loop_event_connect: /* 当前loop内connect */
                 knet_channel_ref_connect_in_loop(loop_event->channel_ref);
                 break;
-            case loop_event_send: /* ǰloopsend */
+            case loop_event_send: /* 当前loop内send */
                 knet_channel_ref_update_send_in_loop(loop, loop_event->channel_ref, loop_event->send_buffer);
                 break;
-            case loop_event_close: /* ǰloopclose */
+            case loop_event_close: /* 当前loop内close */
                 knet_channel_ref_update_close_in_loop(loop, loop_event->channel_ref);
                 break;
+            case loop_event_write_batch: /* 当前loop内批量写入 */
+                knet_write_batch_process(loop_event->batch);
+                knet_write_batch_destroy(loop_event->batch);
+                break;
             default:
                 break;
         }
-        /* ¼ */
-        loop_event_destroy(loop_event);
-        /* ڵ */
-        dlist_delete(loop->event_list, node);
+        /* 放入空闲链表 */
+        _loop_event_recycle(loop, loop_event);
     }
-    lock_unlock(loop->lock); /*  */
 }
 
 kchannel_ref_t* knet_loop_create_channel_exist_socket_fd(kloop_t* loop, socket_t socket_fd, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+    kchannel_t* channel = 0;
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len));
+    if (knet_loop_check_recv_buffer_elastic(loop, recv_ring_len)) {
+        /* 弹性读缓冲区在第一次可读时分配 */
+        channel = knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, 0);
+        knet_channel_set_recv_buffer_cap(channel, recv_ring_len);
+    } else if (knet_loop_check_recv_buffer_mirror(loop, recv_ring_len)) {
+        /* 双重映射读缓冲区 */
+        channel = knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, 0);
+        knet_channel_set_recv_buffer_mirror(channel, recv_ring_len);
+    } else {
+        channel = knet_channel_create_exist_socket_fd(socket_fd, max_send_list_len, recv_ring_len);
+    }
+    return knet_channel_ref_create(loop, channel);
 }
 
 kchannel_ref_t* knet_loop_create_channel(kloop_t* loop, uint32_t max_send_list_len, uint32_t recv_ring_len) {
+    kchannel_t* channel = 0;
     verify(loop);
-    return knet_channel_ref_create(loop, knet_channel_create(max_send_list_len, recv_ring_len));
+    if (knet_loop_check_recv_buffer_elastic(loop, recv_ring_len)) {
+        /* 弹性读缓冲区在第一次可读时分配 */
+        channel = knet_channel_create(max_send_list_len, 0);
+        if (channel) {
+            knet_channel_set_recv_buffer_cap(channel, recv_ring_len);
+        }
+    } else if (knet_loop_check_recv_buffer_mirror(loop, recv_ring_len)) {
+        /* 双重映射读缓冲区 */
+        channel = knet_channel_create(max_send_list_len, 0);
+        if (channel) {
+            knet_channel_set_recv_buffer_mirror(channel, recv_ring_len);
+        }
+    } else {
+        channel = knet_channel_create(max_send_list_len, recv_ring_len);
+    }
+    return knet_channel_ref_create(loop, channel);
 }
 
 thread_id_t knet_loop_get_thread_id(kloop_t* loop) {
@@ -310,7 +575,7 @@ thread_id_t knet_loop_get_thread_id(kloop_t* loop) {
 
 int knet_loop_run_once(kloop_t* loop) {
     verify(loop);
-    /* ȡǰ߳ID */
+    /* 获取当前线程ID */
     loop->thread_id = thread_get_self_id();
     return knet_impl_run_once(loop);
 }
@@ -331,6 +596,15 @@ int knet_loop_run(kloop_t* loop) {
 void knet_loop_exit(kloop_t* loop) {
     verify(loop);
     loop->running = 0;
+    if (loop->thread_id && (loop->thread_id != thread_get_self_id())) {
+        /* 唤醒阻塞在选取器内的loop线程 */
+        knet_loop_notify(loop);
+    }
+}
+
+int knet_loop_get_accept_pending(kloop_t* loop) {
+    verify(loop);
+    return (int)loop->accept_pending;
 }
 
 kdlist_t* knet_loop_get_active_list(kloop_t* loop) {
@@ -349,28 +623,45 @@ void knet_loop_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     node = knet_channel_ref_get_loop_node(channel_ref);
     if (node) {
-        /* ѾҪڵ */
+        /* 已经加入过链表，不需要创建链表节点 */
         dlist_add_front(loop->active_channel_list, node);
     } else {
-        /* ڵ */
+        /* 创建链表节点 */
         dlist_add_front_node(loop->active_channel_list, channel_ref);
     }
     knet_loop_profile_decrease_active_channel_count(loop->profile);
-    knet_loop_profile_increase_established_channel_count(loop->profile);
-    /* ýڵ */
+    if (!knet_loop_check_notify_channel(loop, channel_ref)) {
+        knet_loop_profile_increase_established_channel_count(loop->profile);
+    } else {
+        loop->notify_channel_count++;
+    }
+    /* 设置节点 */
     knet_channel_ref_set_loop_node(channel_ref, dlist_get_front(loop->active_channel_list));
-    /* ֪ͨѡȡӹܵ */
+    /* 通知选取器添加管道 */
     knet_impl_add_channel_ref(loop, channel_ref);
 }
 
+int knet_loop_check_notify_channel(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    /* 事件通知管道不计入统计数据 */
+    return ((channel_ref == loop->notify_channel) || (channel_ref == loop->read_channel));
+}
+
 void knet_loop_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* 뵱ǰٽڵ */
+    /* 解除与当前链表关联，但不销毁节点 */
     dlist_remove(loop->active_channel_list, knet_channel_ref_get_loop_node(channel_ref));
-    /* ͳϢ */
-    knet_loop_profile_decrease_established_channel_count(loop->profile);
-    knet_loop_profile_increase_close_channel_count(loop->profile);
+    /* 不再需要继续读取 */
+    knet_loop_remove_ready_channel_ref(loop, channel_ref);
+    /* 不再需要合并发送 */
+    knet_loop_remove_cork_channel_ref(loop, channel_ref);
+    /* 统计信息 */
+    if (!knet_loop_check_notify_channel(loop, channel_ref)) {
+        knet_loop_profile_decrease_established_channel_count(loop->profile);
+        knet_loop_profile_increase_close_channel_count(loop->profile);
+    } else {
+        loop->notify_channel_count--;
+    }
 }
 
 void knet_loop_set_impl(kloop_t* loop, void* impl) {
@@ -379,6 +670,52 @@ void knet_loop_set_impl(kloop_t* loop, void* impl) {
     loop->impl = impl;
 }
 
+knet_loop_backend_e knet_loop_get_backend(kloop_t* loop) {
+    verify(loop);
+    return loop->backend->type;
+}
+
+const char* knet_loop_get_backend_name(kloop_t* loop) {
+    verify(loop);
+    return loop->backend->name;
+}
+
+int knet_impl_create(kloop_t* loop) {
+    return loop->backend->impl_create(loop);
+}
+
+void knet_impl_destroy(kloop_t* loop) {
+    loop->backend->impl_destroy(loop);
+}
+
+int knet_impl_run_once(kloop_t* loop) {
+    return loop->backend->impl_run_once(loop);
+}
+
+int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    return knet_channel_ref_get_loop(channel_ref)->backend->impl_event_add(channel_ref, e);
+}
+
+int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    return knet_channel_ref_get_loop(channel_ref)->backend->impl_event_remove(channel_ref, e);
+}
+
+int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    return loop->backend->impl_add_channel_ref(loop, channel_ref);
+}
+
+int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    return loop->backend->impl_remove_channel_ref(loop, channel_ref);
+}
+
+void knet_impl_notify(kloop_t* loop) {
+    loop->backend->impl_notify(loop);
+}
+
+socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref) {
+    return knet_channel_ref_get_loop(channel_ref)->backend->impl_channel_accept(channel_ref);
+}
+
 void* knet_loop_get_impl(kloop_t* loop) {
     verify(loop);
     return loop->impl;
@@ -387,15 +724,15 @@ void* knet_loop_get_impl(kloop_t* loop) {
 void knet_loop_close_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     verify(loop);
     verify(channel_ref);
-    /* 㺯׽Ѿر */
-    /* ӻԾȡ */
+    /* 在外层函数内套接字已经被关闭 */
+    /* 从活跃链表内取出 */
     knet_loop_remove_channel_ref(loop, channel_ref);
-    /* 뵽ѹر */
+    /* 加入到已关闭链表 */
     dlist_add_front(loop->close_channel_list, knet_channel_ref_get_loop_node(channel_ref));
 }
 
 void knet_loop_set_balancer(kloop_t* loop, kloop_balancer_t* balancer) {
-    verify(loop); /* balancerΪ0 */
+    verify(loop); /* balancer可以为0 */
     loop->balancer = balancer;
 }
 
@@ -404,12 +741,58 @@ kloop_balancer_t* knet_loop_get_balancer(kloop_t* loop) {
     return loop->balancer;
 }
 
-void knet_loop_check_timeout(kloop_t* loop, time_t ts) {
+uint64_t knet_loop_update_time(kloop_t* loop) {
+    verify(loop);
+    loop->now = time_get_monotonic_milliseconds();
+    /* 定时器循环使用同一个时间戳 */
+    ktimer_loop_set_now(loop->timer_loop, loop->now);
+    return loop->now;
+}
+
+uint64_t knet_loop_get_time(kloop_t* loop) {
+    verify(loop);
+    return loop->now;
+}
+
+void knet_loop_check_timeout(kloop_t* loop, uint64_t ts) {
     (void)ts;
-    /* ܵʱ, ӳʱͶʱ */
+    /* 检测管道超时, 包含连接超时和读超时 */
     ktimer_loop_run_once(loop->timer_loop);
 }
 
+int knet_loop_get_wait_timeout(kloop_t* loop) {
+    int timeout = 0;
+    verify(loop);
+    /* 最近一个定时器的到期时间 */
+    timeout = ktimer_loop_get_timeout(loop->timer_loop);
+    if (!dlist_empty(loop->ready_channel_list)) {
+        /* 就绪管道不需要等待事件通知 */
+        return 0;
+    }
+    if (!dlist_empty(loop->cork_channel_list)) {
+        /* 循环外写入的合并数据尽快发送 */
+        return 0;
+    }
+    if (dlist_get_count(loop->close_channel_list)) {
+        /* 关闭链表内的管道等待其他线程释放引用, 需要定期检查 */
+        if ((timeout < 0) || (timeout > 1)) {
+            timeout = 1;
+        }
+    }
+    if (!loop->running && !loop->dedicated) {
+        /* 由使用者自行调用knet_loop_run_once, 不能无限期阻塞调用者 */
+        if ((timeout < 0) || (timeout > 1)) {
+            timeout = 1;
+        }
+    }
+    if (loop->max_wait >= 0) {
+        if ((timeout < 0) || (timeout > loop->max_wait)) {
+            timeout = loop->max_wait;
+        }
+    }
+    return timeout;
+}
+
 void knet_loop_check_close(kloop_t* loop) {
     kdlist_node_t*  node        = 0;
     kdlist_node_t*  temp        = 0;
@@ -417,16 +800,16 @@ void knet_loop_check_close(kloop_t* loop) {
     verify(loop);
     dlist_for_each_safe(knet_loop_get_close_list(loop), node, temp) {
         channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
-        /* ڶ̻߳, ڶ̳߳йܵõüΪ, ֤ûصڱֻ߳ᱻһ */
+        /* 在多线程环境下, 由于多线程持有管道引用导致引用计数不为零, 保证用户回调在本线程只会被调用一次 */
         if (!knet_channel_ref_check_close_cb_called(channel_ref)) {
-            /* ûص */
+            /* 调用用户回调 */
             if (knet_channel_ref_get_cb(channel_ref)) {
                 knet_channel_ref_get_cb(channel_ref)(channel_ref, channel_cb_event_close);
             }
-            /* ùر¼ص־ */
+            /* 设置关闭事件回调标志 */
             knet_channel_ref_set_close_cb_called(channel_ref);
         }
-        /* ٹܵ */
+        /* 销毁管道 */
         if (error_ok == knet_channel_ref_destroy(channel_ref)) {
             knet_loop_profile_decrease_close_channel_count(loop->profile);
             dlist_delete(knet_loop_get_close_list(loop), node);
@@ -441,7 +824,8 @@ int knet_loop_check_running(kloop_t* loop) {
 
 int knet_loop_get_active_channel_count(kloop_t* loop) {
     verify(loop);
-    return dlist_get_count(loop->active_channel_list);
+    /* 事件通知管道不计入, eventfd唤醒的选取器没有事件通知管道 */
+    return dlist_get_count(loop->active_channel_list) - loop->notify_channel_count;
 }
 
 int knet_loop_get_close_channel_count(kloop_t* loop) {
@@ -479,6 +863,292 @@ kloop_profile_t* knet_loop_get_profile(kloop_t* loop) {
     return loop->profile;
 }
 
+void knet_loop_set_dedicated(kloop_t* loop, int dedicated) {
+    verify(loop);
+    loop->dedicated = dedicated;
+}
+
+void knet_loop_set_spin_count(kloop_t* loop, int spin_count) {
+    verify(loop);
+    loop->spin_count = (spin_count > 0) ? spin_count : 0;
+}
+
+int knet_loop_get_spin_count(kloop_t* loop) {
+    verify(loop);
+    return loop->spin_count;
+}
+
+void knet_loop_set_max_wait(kloop_t* loop, int max_wait) {
+    verify(loop);
+    loop->max_wait = (max_wait >= 0) ? max_wait : -1;
+}
+
+int knet_loop_get_max_wait(kloop_t* loop) {
+    verify(loop);
+    return loop->max_wait;
+}
+
+void knet_loop_set_accept_budget(kloop_t* loop, int accept_budget) {
+    verify(loop);
+    loop->accept_budget = (accept_budget > 0) ? accept_budget : 0;
+}
+
+int knet_loop_get_accept_budget(kloop_t* loop) {
+    verify(loop);
+    return loop->accept_budget;
+}
+
+void knet_loop_set_read_budget(kloop_t* loop, int read_budget) {
+    verify(loop);
+    loop->read_budget = (read_budget > 0) ? read_budget : 0;
+}
+
+int knet_loop_get_read_budget(kloop_t* loop) {
+    verify(loop);
+    return loop->read_budget;
+}
+
+void knet_loop_set_zerocopy_threshold(kloop_t* loop, int threshold) {
+    verify(loop);
+    loop->zerocopy_threshold = (threshold > 0) ? threshold : 0;
+}
+
+int knet_loop_get_zerocopy_threshold(kloop_t* loop) {
+    verify(loop);
+    return loop->zerocopy_threshold;
+}
+
+int _loop_recv_pool_class(kloop_t* loop, uint32_t size) {
+    int      i    = 0;
+    uint32_t temp = loop->recv_buffer_init;
+    if (!temp) {
+        return -1;
+    }
+    for (; i < LOOP_RECV_POOL_CLASSES; i++, temp <<= 1) {
+        if (temp == size) {
+            return i;
+        }
+        if ((temp > size) || (temp & 0x80000000)) {
+            break;
+        }
+    }
+    return -1;
+}
+
+void _loop_recv_pool_clear(kloop_t* loop) {
+    int   i    = 0;
+    char* ptr  = 0;
+    char* next = 0;
+    for (; i < LOOP_RECV_POOL_CLASSES; i++) {
+        for (ptr = loop->recv_pool[i]; ptr; ptr = next) {
+            next = *(char**)ptr;
+            knet_free(ptr);
+        }
+        loop->recv_pool[i]       = 0;
+        loop->recv_pool_count[i] = 0;
+    }
+}
+
+void _loop_recv_buffer_timer_cb(ktimer_t* timer, void* data) {
+    kloop_t*        loop        = (kloop_t*)data;
+    kdlist_node_t*  node        = 0;
+    kdlist_node_t*  temp        = 0;
+    kchannel_ref_t* channel_ref = 0;
+    (void)timer;
+    /* 只检查持有弹性读缓冲区的管道, 归还后管道从链表内删除 */
+    dlist_for_each_safe(loop->buffer_channel_list, node, temp) {
+        channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
+        knet_channel_ref_shrink_recv_buffer(channel_ref, (uint64_t)loop->recv_buffer_idle);
+    }
+}
+
+void _loop_recv_buffer_timer_reset(kloop_t* loop) {
+    if (loop->recv_buffer_timer) {
+        ktimer_stop(loop->recv_buffer_timer);
+        loop->recv_buffer_timer = 0;
+    }
+    if (!loop->recv_buffer_init) {
+        return;
+    }
+    loop->recv_buffer_timer = ktimer_create(loop->timer_loop);
+    verify(loop->recv_buffer_timer);
+    ktimer_start(loop->recv_buffer_timer, _loop_recv_buffer_timer_cb, loop,
+        (time_t)(loop->recv_buffer_idle ? loop->recv_buffer_idle : 1));
+}
+
+void knet_loop_set_recv_buffer_init(kloop_t* loop, uint32_t size) {
+    verify(loop);
+    if (size && (size < sizeof(char*))) {
+        /* 内存池使用缓冲区起始位置链接 */
+        size = sizeof(char*);
+    }
+    if (size == loop->recv_buffer_init) {
+        return;
+    }
+    /* 长度级别改变, 已缓存的缓冲区不再适用 */
+    _loop_recv_pool_clear(loop);
+    loop->recv_buffer_init = size;
+    _loop_recv_buffer_timer_reset(loop);
+}
+
+uint32_t knet_loop_get_recv_buffer_init(kloop_t* loop) {
+    verify(loop);
+    return loop->recv_buffer_init;
+}
+
+void knet_loop_set_recv_buffer_idle(kloop_t* loop, int idle) {
+    verify(loop);
+    loop->recv_buffer_idle = (idle > 0) ? idle : 0;
+    _loop_recv_buffer_timer_reset(loop);
+}
+
+int knet_loop_get_recv_buffer_idle(kloop_t* loop) {
+    verify(loop);
+    return loop->recv_buffer_idle;
+}
+
+void knet_loop_set_recv_buffer_mirror(kloop_t* loop, int on) {
+    verify(loop);
+    loop->recv_buffer_mirror = on;
+}
+
+int knet_loop_get_recv_buffer_mirror(kloop_t* loop) {
+    verify(loop);
+    return loop->recv_buffer_mirror;
+}
+
+int knet_loop_check_recv_buffer_mirror(kloop_t* loop, uint32_t recv_ring_len) {
+    verify(loop);
+    return (loop->recv_buffer_mirror && recv_ring_len && !knet_loop_check_recv_buffer_elastic(loop, recv_ring_len));
+}
+
+int knet_loop_check_recv_buffer_elastic(kloop_t* loop, uint32_t recv_ring_len) {
+    verify(loop);
+    return (loop->recv_buffer_init && (recv_ring_len > loop->recv_buffer_init));
+}
+
+char* knet_loop_alloc_recv_buffer(kloop_t* loop, uint32_t size) {
+    char* ptr   = 0;
+    int   level = 0;
+    verify(loop);
+    verify(size);
+    level = _loop_recv_pool_class(loop, size);
+    if ((level >= 0) && loop->recv_pool[level]) {
+        ptr = loop->recv_pool[level];
+        loop->recv_pool[level] = *(char**)ptr;
+        loop->recv_pool_count[level]--;
+        return ptr;
+    }
+    return create_raw(size);
+}
+
+void knet_loop_free_recv_buffer(kloop_t* loop, char* ptr, uint32_t size) {
+    int level = 0;
+    verify(loop);
+    verify(ptr);
+    level = _loop_recv_pool_class(loop, size);
+    if ((level < 0) || (loop->recv_pool_count[level] >= LOOP_RECV_POOL_MAX)) {
+        knet_free(ptr);
+        return;
+    }
+    *(char**)ptr = loop->recv_pool[level];
+    loop->recv_pool[level] = ptr;
+    loop->recv_pool_count[level]++;
+}
+
+void knet_loop_add_ready_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    verify(loop);
+    verify(channel_ref);
+    if (knet_channel_ref_get_ready_node(channel_ref)) {
+        /* 已经在就绪链表内 */
+        return;
+    }
+    knet_channel_ref_set_ready_node(channel_ref, dlist_add_tail_node(loop->ready_channel_list, channel_ref));
+}
+
+void knet_loop_remove_ready_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    kdlist_node_t* node = 0;
+    verify(loop);
+    verify(channel_ref);
+    node = knet_channel_ref_get_ready_node(channel_ref);
+    if (node) {
+        dlist_delete(loop->ready_channel_list, node);
+        knet_channel_ref_set_ready_node(channel_ref, 0);
+    }
+}
+
+void knet_loop_process_ready(kloop_t* loop, uint64_t ts) {
+    kdlist_node_t*  node        = 0;
+    kchannel_ref_t* channel_ref = 0;
+    int             count       = 0;
+    verify(loop);
+    /* 只处理上一次循环留下的管道, 本次再次达到预算的管道加入链表尾部, 下一次循环处理 */
+    count = dlist_get_count(loop->ready_channel_list);
+    for (; count && !dlist_empty(loop->ready_channel_list); count--) {
+        node        = dlist_get_front(loop->ready_channel_list);
+        channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
+        dlist_delete(loop->ready_channel_list, node);
+        knet_channel_ref_set_ready_node(channel_ref, 0);
+        knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+    }
+}
+
+void knet_loop_add_cork_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    verify(loop);
+    verify(channel_ref);
+    if (knet_channel_ref_get_cork_node(channel_ref)) {
+        /* 已经在合并写链表内 */
+        return;
+    }
+    knet_channel_ref_set_cork_node(channel_ref, dlist_add_tail_node(loop->cork_channel_list, channel_ref));
+}
+
+void knet_loop_remove_cork_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    kdlist_node_t* node = 0;
+    verify(loop);
+    verify(channel_ref);
+    node = knet_channel_ref_get_cork_node(channel_ref);
+    if (node) {
+        dlist_delete(loop->cork_channel_list, node);
+        knet_channel_ref_set_cork_node(channel_ref, 0);
+    }
+}
+
+void knet_loop_add_buffer_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    verify(loop);
+    verify(channel_ref);
+    if (knet_channel_ref_get_buffer_node(channel_ref)) {
+        /* 已经在链表内 */
+        return;
+    }
+    knet_channel_ref_set_buffer_node(channel_ref, dlist_add_tail_node(loop->buffer_channel_list, channel_ref));
+}
+
+void knet_loop_remove_buffer_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    kdlist_node_t* node = 0;
+    verify(loop);
+    verify(channel_ref);
+    node = knet_channel_ref_get_buffer_node(channel_ref);
+    if (node) {
+        dlist_delete(loop->buffer_channel_list, node);
+        knet_channel_ref_set_buffer_node(channel_ref, 0);
+    }
+}
+
+void knet_loop_process_cork(kloop_t* loop) {
+    kdlist_node_t*  node        = 0;
+    kchannel_ref_t* channel_ref = 0;
+    verify(loop);
+    /* 发送时可能关闭管道并从链表内删除, 每次取链表头部 */
+    while (!dlist_empty(loop->cork_channel_list)) {
+        node        = dlist_get_front(loop->cork_channel_list);
+        channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
+        dlist_delete(loop->cork_channel_list, node);
+        knet_channel_ref_set_cork_node(channel_ref, 0);
+        knet_channel_ref_flush_cork(channel_ref);
+    }
+}
+
 ktimer_loop_t* knet_loop_get_timer_loop(kloop_t* loop) {
     verify(loop);
     return loop->timer_loop;
@@ -29,257 +29,468 @@
 #include "loop_api.h"
 
 /**
- * kchannel_ref_tʵԾ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 添加kchannel_ref_t实例到活跃链表
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ӵԾɾkchannel_ref_tʵ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 从到活跃链表删除kchannel_ref_t实例
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ӵԾɾkchannel_ref_tʵر
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 添加kchannel_ref_t实例到就绪链表
+ * <pre>
+ * 读取达到预算或者接受连接达到预算的管道, 下一次循环不等待事件通知继续处理
+ * </pre>
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_add_ready_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 从就绪链表删除kchannel_ref_t实例
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_remove_ready_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 处理就绪链表内的管道
+ * <pre>
+ * 选取器在分发事件前调用
+ * </pre>
+ * @param loop kloop_t实例
+ * @param ts 本次迭代的时间戳（毫秒）
+ */
+void knet_loop_process_ready(kloop_t* loop, uint64_t ts);
+
+/**
+ * 添加kchannel_ref_t实例到合并写链表
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_add_cork_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 从合并写链表删除kchannel_ref_t实例
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_remove_cork_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 添加kchannel_ref_t实例到持有弹性读缓冲区的管道链表
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_add_buffer_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 从持有弹性读缓冲区的管道链表删除kchannel_ref_t实例
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ */
+void knet_loop_remove_buffer_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 发送合并写链表内管道合并的数据
+ * <pre>
+ * 选取器在本次循环迭代处理完事件和定时器后调用
+ * </pre>
+ * @param loop kloop_t实例
+ */
+void knet_loop_process_cork(kloop_t* loop);
+
+/**
+ * 检查是否是内部使用的事件通知管道
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @retval 0 不是
+ * @retval 非零 是
+ */
+int knet_loop_check_notify_channel(kloop_t* loop, kchannel_ref_t* channel_ref);
+
+/**
+ * 从到活跃链表删除kchannel_ref_t实例，并放入关闭链表
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_close_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ȡûԾ
- * @param loop kloop_tʵ
- * @return kdlist_tʵ
+ * 取得活跃链表
+ * @param loop kloop_t实例
+ * @return kdlist_t实例
  */
 kdlist_t* knet_loop_get_active_list(kloop_t* loop);
 
 /**
- * ȡùر
- * @param loop kloop_tʵ
- * @return kdlist_tʵ
+ * 取得已经分配到本loop但还未处理的新连接数量
+ * @param loop kloop_t实例
+ * @return 新连接数量
+ */
+int knet_loop_get_accept_pending(kloop_t* loop);
+
+/**
+ * 取得关闭链表
+ * @param loop kloop_t实例
+ * @return kdlist_t实例
  */
 kdlist_t* knet_loop_get_close_list(kloop_t* loop);
 
 /**
- * ѡȡʵ
- * @param loop kloop_tʵ
- * @param impl ѡȡʵ
+ * 设置选取器实现
+ * @param loop kloop_t实例
+ * @param impl 选取器实现
  */
 void knet_loop_set_impl(kloop_t* loop, void* impl);
 
 /**
- * ȡѡȡʵ
- * @param loop kloop_tʵ
- * @return ѡȡʵ
+ * 取得选取器实现
+ * @param loop kloop_t实例
+ * @return 选取器实现
  */
 void* knet_loop_get_impl(kloop_t* loop);
 
 /**
- * ȡѡȡǰ߳ID
- * @param loop kloop_tʵ
- * @return ߳ID
+ * 取得选取器当前线程ID
+ * @param loop kloop_t实例
+ * @return 线程ID
  */
 thread_id_t knet_loop_get_thread_id(kloop_t* loop);
 
 /**
- * øؾ(kloop_balancer_tʵ
- * @param loop kloop_tʵ
- * @param balancer kloop_balancer_tʵ
+ * 设置负载均衡器(kloop_balancer_t实例）
+ * @param loop kloop_t实例
+ * @param balancer kloop_balancer_t实例
  */
 void knet_loop_set_balancer(kloop_t* loop, kloop_balancer_t* balancer);
 
 /**
- * ȡøؾ(kloop_balancer_tʵ
- * @param loop kloop_tʵ
- * @return kloop_balancer_tʵ
+ * 取得负载均衡器(kloop_balancer_t实例）
+ * @param loop kloop_t实例
+ * @return kloop_balancer_t实例
  */
 kloop_balancer_t* knet_loop_get_balancer(kloop_t* loop);
 
 /**
- * ¼֪ͨ - 
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 发送事件通知 - 监听到新连接
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_notify_accept(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ֪ͨ - ǰloopڼ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 发起监听通知 - 当前loop内监听
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_notify_accept_async(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ¼֪ͨ - 
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 发送事件通知 - 发起连接
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_notify_connect(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ¼֪ͨ - ̷߳
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @param send_buffer kbuffer_tʵ
+ * 发送事件通知 - 跨线程发送
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @param send_buffer kbuffer_t实例
  */
 void knet_loop_notify_send(kloop_t* loop, kchannel_ref_t* channel_ref, kbuffer_t* send_buffer);
 
 /**
- * ¼֪ͨ - رչܵ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
+ * 发送事件通知 - 关闭管道
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
  */
 void knet_loop_notify_close(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /**
- * ֪ͨܵص
- * @param channel kchannel_ref_tʵ
- * @param e ܵ¼
+ * 发送事件通知 - 批量写入
+ * @param loop kloop_t实例
+ * @param batch kwrite_batch_t实例, 处理后由kloop_t销毁
+ */
+void knet_loop_notify_write_batch(kloop_t* loop, kwrite_batch_t* batch);
+
+/**
+ * 通知管道回调函数
+ * @param channel kchannel_ref_t实例
+ * @param e 管道事件
  */
 void knet_loop_queue_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e);
 
 /**
- * ¼صknet_loop_queue_cb
- * @param loop kloop_tʵ
+ * 唤醒loop处理跨线程事件
+ * <pre>
+ * loop处理事件前多次调用只会唤醒一次
+ * </pre>
+ * @param loop kloop_t实例
  */
 void knet_loop_notify(kloop_t* loop);
 
 /**
- * ¼
- * @param loop kloop_tʵ
+ * 建立事件通知管道
+ * <pre>
+ * 供没有原生唤醒机制的选取器使用, 通过套接字对发送一个字节触发读事件回调knet_loop_queue_cb
+ * </pre>
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+int knet_loop_create_notify_channel(kloop_t* loop);
+
+/**
+ * 通过事件通知管道唤醒loop
+ * @param loop kloop_t实例
+ */
+void knet_loop_notify_channel_send(kloop_t* loop);
+
+/**
+ * 处理事件
+ * @param loop kloop_t实例
  */
 void knet_loop_event_process(kloop_t* loop);
 
 /**
- * Ծܵгʱ
- * @param loop kloop_tʵ
- * @param ts ǰʱ룩
+ * 检查活跃管道空闲超时
+ * @param loop kloop_t实例
+ * @param ts 本次迭代的时间戳（毫秒）
  */
-void knet_loop_check_timeout(kloop_t* loop, time_t ts);
+void knet_loop_check_timeout(kloop_t* loop, uint64_t ts);
 
 /**
- * رչܵǷ
- * @param loop kloop_tʵ
+ * 更新本次迭代的时间戳
+ * <pre>
+ * 选取器在等待返回后调用一次, 本次迭代内的定时器, 管道超时和统计都使用这个时间戳, 不再读取时钟
+ * </pre>
+ * @param loop kloop_t实例
+ * @return 单调时钟时间戳（毫秒）
+ */
+uint64_t knet_loop_update_time(kloop_t* loop);
+
+/**
+ * 计算选取器本次最长等待时间
+ * <pre>
+ * 由最近一个定时器的到期时间决定, 没有定时器时无限等待, 跨线程事件通过事件通知管道唤醒.
+ * 使用者自行调用knet_loop_run_once时最长等待1毫秒
+ * </pre>
+ * @param loop kloop_t实例
+ * @retval -1 无限等待
+ * @retval 其他 最长等待时间（毫秒）
+ */
+int knet_loop_get_wait_timeout(kloop_t* loop);
+
+/**
+ * 设置是否由独占线程驱动
+ * @param loop kloop_t实例
+ * @param dedicated 非零表示由独占线程驱动, 选取器可以无限期阻塞
+ */
+void knet_loop_set_dedicated(kloop_t* loop, int dedicated);
+
+/**
+ * 检查关闭管道是否可以销毁
+ * @param loop kloop_t实例
  */
 void knet_loop_check_close(kloop_t* loop);
 
 /**
- * Ƿ
- * @param loop kloop_tʵ
+ * 检查是否正在运行
+ * @param loop kloop_t实例
  */
 int knet_loop_check_running(kloop_t* loop);
 
 /**
- * øؾ
- * @param loop kloop_tʵ
- * @param options ѡloop_balancer_in loop_balancer_out
+ * 设置负载均衡配置
+ * @param loop kloop_t实例
+ * @param options 选项（loop_balancer_in， loop_balancer_out）
  */
 void knet_loop_set_balance_options(kloop_t* loop, knet_loop_balance_option_e options);
 
 /**
- * ȡøؾ
- * @param loop kloop_tʵ
- * @return ؾ
+ * 取得负载均衡配置
+ * @param loop kloop_t实例
+ * @return 负载均衡配置
  */
 knet_loop_balance_option_e knet_loop_get_balance_options(kloop_t* loop);
 
 /**
- * 鸺ؾǷ
- * @param loop kloop_tʵ
- * @param options ؾ
- * @retval 0 δ
- * @retval  
+ * 检查负载均衡配置是否开启
+ * @param loop kloop_t实例
+ * @param options 负载均衡配置
+ * @retval 0 未开启
+ * @retval 非零 开启
  */
 int knet_loop_check_balance_options(kloop_t* loop, knet_loop_balance_option_e options);
 
+/**
+ * 选取器方法表
+ * <pre>
+ * 每个选取器实现导出一个方法表, loop建立时选定, knet_impl_*将调用转发到loop所选取器
+ * </pre>
+ */
+typedef struct _loop_backend_t {
+    knet_loop_backend_e type; /* 选取器类型 */
+    const char*         name; /* 选取器名称 */
+    /* 建立并初始化, 失败时需要释放已分配的资源 */
+    int (*impl_create)(kloop_t*);
+    /* 停止并销毁 */
+    void (*impl_destroy)(kloop_t*);
+    /* 运行一次事件循环 */
+    int (*impl_run_once)(kloop_t*);
+    /* 投递一个（多个）事件 */
+    int (*impl_event_add)(kchannel_ref_t*, knet_channel_event_e);
+    /* 取消一个（多个）事件 */
+    int (*impl_event_remove)(kchannel_ref_t*, knet_channel_event_e);
+    /* 通知有新的管道加入了活跃链表 */
+    int (*impl_add_channel_ref)(kloop_t*, kchannel_ref_t*);
+    /* 通知管道关闭并销毁 */
+    int (*impl_remove_channel_ref)(kloop_t*, kchannel_ref_t*);
+    /* 从其他线程唤醒阻塞在选取器内的loop, 唤醒后调用knet_loop_event_process */
+    void (*impl_notify)(kloop_t*);
+    /* 新连接到来时检测选取器自定义实现 */
+    socket_t (*impl_channel_accept)(kchannel_ref_t*);
+} loop_backend_t;
+
+/**
+ * 取得所有编译进库的选取器
+ * @return 以0结尾的选取器方法表数组, 按默认选择的优先顺序排列
+ */
+loop_backend_t** knet_loop_get_backends();
+
 /* 
- * ѡȡҪʵֵĺ - ʼ
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用loop所选选取器 - 建立并初始化
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 
 int knet_impl_create(kloop_t* loop);
 
 /* 
- * ѡȡҪʵֵĺ - ֹͣ
- * @param loop kloop_tʵ
+ * 调用loop所选选取器 - 停止并销毁
+ * @param loop kloop_t实例
  */
 void knet_impl_destroy(kloop_t* loop);
 
 /* 
- * ѡȡҪʵֵĺ - һ¼ѭ
- * @param loop kloop_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用loop所选选取器 - 运行一次事件循环
+ * @param loop kloop_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_impl_run_once(kloop_t* loop);
 
 /* 
- * ѡȡҪʵֵĺ - Ͷһ¼
- * @param loop kloop_tʵ
- * @param e ¼
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用管道所属loop的选取器 - 投递一个（多个）事件
+ * @param loop kloop_t实例
+ * @param e 事件
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e);
 
 /* 
- * ѡȡҪʵֵĺ - ȡһ¼
- * @param loop kloop_tʵ
- * @param e ¼
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用管道所属loop的选取器 - 取消一个（多个）事件
+ * @param loop kloop_t实例
+ * @param e 事件
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e);
 
 /* 
- * ѡȡҪʵֵĺ - ֪ͨµĹܵ˻Ծ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用loop所选选取器 - 通知有新的管道加入了活跃链表
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /* 
- * ѡȡҪʵֵĺ - ֪ͨܵرղ
- * @param loop kloop_tʵ
- * @param channel_ref kchannel_ref_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 调用loop所选选取器 - 通知管道关闭并销毁
+ * @param loop kloop_t实例
+ * @param channel_ref kchannel_ref_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref);
 
 /* 
- * ѡȡҪʵֵĺ - ӵʱѡȡԶʵ
- * @param channel_ref kchannel_ref_tʵ
- * @return ׽
+ * 调用loop所选选取器 - 从其他线程唤醒阻塞在选取器内的loop, 唤醒后调用knet_loop_event_process
+ * @param loop kloop_t实例
+ */
+void knet_impl_notify(kloop_t* loop);
+
+/* 
+ * 调用管道所属loop的选取器 - 新连接到来时检测选取器自定义实现
+ * @param channel_ref kchannel_ref_t实例
+ * @return 套接字
  */
 socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref);
 
 /**
- * ȡûָ
- * @param loop kloop_tʵ
- * @return ûָ
+ * 取得用户数据指针
+ * @param loop kloop_t实例
+ * @return 用户数据指针
  */
 void* knet_loop_get_data(kloop_t* loop);
 
 /**
- * ûָ
- * @param loop kloop_tʵ
- * @param data ûָ
+ * 设置用户数据指针
+ * @param loop kloop_t实例
+ * @param data 用户数据指针
  */
 void knet_loop_set_data(kloop_t* loop, void* data);
 
 /**
- * ȡʱѭ
- * @param loop kloop_tʵ
- * @return ktimer_loop_tʵ
+ * 获取定时器循环
+ * @param loop kloop_t实例
+ * @return ktimer_loop_t实例
  */
 ktimer_loop_t* knet_loop_get_timer_loop(kloop_t* loop);
 
+/**
+ * 检查最大长度为recv_ring_len的读缓冲区是否使用弹性读缓冲区
+ * @param loop kloop_t实例
+ * @param recv_ring_len 读缓冲区最大长度
+ * @retval 0 固定长度
+ * @retval 非零 弹性读缓冲区
+ */
+int knet_loop_check_recv_buffer_elastic(kloop_t* loop, uint32_t recv_ring_len);
+
+/**
+ * 检查最大长度为recv_ring_len的读缓冲区是否使用双重映射的ringbuffer
+ * @param loop kloop_t实例
+ * @param recv_ring_len 读缓冲区最大长度
+ * @retval 0 普通的ringbuffer
+ * @retval 非零 双重映射
+ */
+int knet_loop_check_recv_buffer_mirror(kloop_t* loop, uint32_t recv_ring_len);
+
+/**
+ * 分配弹性读缓冲区, 优先从内存池取出
+ * @param loop kloop_t实例
+ * @param size 缓冲区长度
+ * @return 缓冲区
+ */
+char* knet_loop_alloc_recv_buffer(kloop_t* loop, uint32_t size);
+
+/**
+ * 归还弹性读缓冲区到内存池, 长度不属于任何级别或内存池已满时释放
+ * @param loop kloop_t实例
+ * @param ptr 缓冲区
+ * @param size 缓冲区长度
+ */
+void knet_loop_free_recv_buffer(kloop_t* loop, char* ptr, uint32_t size);
+
 #endif /* LOOP_H */
@@ -30,14 +30,14 @@
 
 
 typedef struct _loop_info_t {
-    kloop_t*  loop;    /* kloop_tʵ */
-    uint64_t  choose;  /* ѡȡ */
+    kloop_t*  loop;    /* kloop_t实例 */
+    uint64_t  choose;  /* 被选取次数，保留 */
 } loop_info_t;
 
 struct _loop_balancer_t {
-    kdlist_t* loop_info_list; /* kloop_tʵ */
-    klock_t*  lock;           /*  - , kloop_tʵɾ */
-    void*     data;           /* û */
+    kdlist_t* loop_info_list; /* kloop_t实例链表 */
+    klock_t*  lock;           /* 锁 - 链表访问, kloop_t实例的添加删除 */
+    void*     data;           /* 用户数据 */
 };
 
 kloop_balancer_t* knet_loop_balancer_create() {
@@ -126,13 +126,14 @@ kloop_t* knet_loop_balancer_choose(kloop_balancer_t* balancer) {
     int            count         = 0;
     verify(balancer);
     lock_lock(balancer->lock);
-    /* ѡȡǰԾܵٵkloop_t */
+    /* 选取当前活跃管道数最少的kloop_t */
     dlist_for_each_safe(balancer->loop_info_list, node, temp) {
         loop_info = (loop_info_t*)dlist_node_get_data(node);
-        /* Ƿloop_balancer_in */
+        /* 是否开启loop_balancer_in配置 */
         if (knet_loop_check_balance_options(loop_info->loop, loop_balancer_in)) {
             channel_list = knet_loop_get_active_list(loop_info->loop);
-            count = dlist_get_count(channel_list);
+            /* 计入已经分配但还未加入活跃链表的新连接, 突发连接不会集中到同一个kloop_t */
+            count = dlist_get_count(channel_list) + knet_loop_get_accept_pending(loop_info->loop);
             if (count < channel_count) {
                 found = loop_info;
                 channel_count = count;
@@ -140,7 +141,7 @@ kloop_t* knet_loop_balancer_choose(kloop_balancer_t* balancer) {
         }
     }
     if (found) {
-        /* ¼ѡȡ */
+        /* 记录被选取次数，保留 */
         found->choose++;
     }
     lock_unlock(balancer->lock);
@@ -150,6 +151,25 @@ kloop_t* knet_loop_balancer_choose(kloop_balancer_t* balancer) {
     return 0;
 }
 
+int knet_loop_balancer_for_each(kloop_balancer_t* balancer, knet_loop_balancer_for_each_func_t func, void* param) {
+    kdlist_node_t* node      = 0;
+    kdlist_node_t* temp      = 0;
+    loop_info_t*   loop_info = 0;
+    int            error     = 0;
+    verify(balancer);
+    verify(func);
+    lock_lock(balancer->lock);
+    dlist_for_each_safe(balancer->loop_info_list, node, temp) {
+        loop_info = (loop_info_t*)dlist_node_get_data(node);
+        error = func(loop_info->loop, param);
+        if (error) {
+            break;
+        }
+    }
+    lock_unlock(balancer->lock);
+    return error;
+}
+
 void knet_loop_balancer_set_data(kloop_balancer_t* balancer, void* data) {
     verify(balancer);
     verify(data);
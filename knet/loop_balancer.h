@@ -29,23 +29,36 @@
 #include "loop_balancer_api.h"
 
 /**
- * ؾ - ѡȡһkloop_tʵ
- * @param balancer kloop_balancer_tʵ
- * @return kloop_tʵ
+ * 负载均衡 - 选取一个kloop_t实例
+ * @param balancer kloop_balancer_t实例
+ * @return kloop_t实例
  */
 kloop_t* knet_loop_balancer_choose(kloop_balancer_t* balancer);
 
+/*! 遍历函数, 返回非零值停止遍历 */
+typedef int (*knet_loop_balancer_for_each_func_t)(kloop_t*, void*);
+
+/**
+ * 遍历所有关联的kloop_t实例
+ * @param balancer kloop_balancer_t实例
+ * @param func 遍历函数
+ * @param param 遍历函数参数
+ * @retval 0 遍历完成
+ * @retval 其他 遍历函数返回的非零值
+ */
+int knet_loop_balancer_for_each(kloop_balancer_t* balancer, knet_loop_balancer_for_each_func_t func, void* param);
+
 /**
- * û
- * @param balancer kloop_balancer_tʵ
- * @param data ûָ
+ * 设置用户数据
+ * @param balancer kloop_balancer_t实例
+ * @param data 用户数据指针
  */
 void knet_loop_balancer_set_data(kloop_balancer_t* balancer, void* data);
 
 /**
- * ȡû
- * @param balancer kloop_balancer_tʵ
- * @return ûָ
+ * 取得用户数据
+ * @param balancer kloop_balancer_t实例
+ * @return 用户数据指针
  */
 void* knet_loop_balancer_get_data(kloop_balancer_t* balancer);
 
@@ -22,22 +22,26 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef LOOP_EPOLL
+#if LOOP_EPOLL
 
 #include "loop.h"
 #include "list.h"
 #include "channel_ref.h"
 #include "channel.h"
 #include "logger.h"
+#include "loop_profile.h"
+#include <sys/eventfd.h>
 
 typedef struct _loop_epoll_t {
-    int                 epoll_fd; /* epoll */
-    struct epoll_event* events;   /* epoll¼ */
+    int                 epoll_fd; /* epoll描述符 */
+    int                 event_fd; /* 跨线程事件唤醒描述符 */
+    struct epoll_event* events;   /* epoll事件数组 */
 } loop_epoll_t;
 
-#define MAXEVENTS 8192 /* epoll_create */
+#define MAXEVENTS 8192 /* epoll_create参数 */
 
-int knet_impl_create(kloop_t* loop) {
+int _epoll_create(kloop_t* loop) {
+    struct epoll_event event;
     loop_epoll_t* impl = create(loop_epoll_t);
     knet_loop_set_impl(loop, impl);
     impl->epoll_fd = epoll_create(MAXEVENTS);
@@ -45,42 +49,94 @@ int knet_impl_create(kloop_t* loop) {
         knet_free(impl);
         return 1;
     }
+    /* 跨线程事件唤醒描述符直接注册到epoll, 水平触发, 事件数据为空指针 */
+    impl->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (impl->event_fd < 0) {
+        close(impl->epoll_fd);
+        knet_free(impl);
+        return 1;
+    }
+    memset(&event, 0, sizeof(event));
+    event.events   = EPOLLIN;
+    event.data.ptr = 0;
+    epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, impl->event_fd, &event);
     impl->events = create_type(struct epoll_event, sizeof(struct epoll_event) * MAXEVENTS);
     assert(impl->events);
     return error_ok;
 }
 
-void knet_impl_destroy(kloop_t* loop) {
+void _epoll_destroy(kloop_t* loop) {
     loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
+    close(impl->event_fd);
     close(impl->epoll_fd);
     knet_free(impl->events);
     knet_free(impl);
 }
 
-int _select(kloop_t* loop, int* count) {
-    loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
-    *count = epoll_wait(impl->epoll_fd, impl->events, MAXEVENTS, 1);
+int _epoll_wait(kloop_t* loop, int* count) {
+    int           i       = 0;
+    int           spin    = knet_loop_get_spin_count(loop);
+    int           timeout = knet_loop_get_wait_timeout(loop);
+    loop_epoll_t* impl    = (loop_epoll_t*)knet_loop_get_impl(loop);
+    /* 阻塞前先自旋轮询 */
+    for (; timeout && (i < spin); i++) {
+        *count = epoll_wait(impl->epoll_fd, impl->events, MAXEVENTS, 0);
+        if (*count) {
+            break;
+        }
+    }
+    if (!timeout || (i >= spin)) {
+        /* 等待到最近一个定时器到期, 没有定时器时一直等待直到有事件到达 */
+        *count = epoll_wait(impl->epoll_fd, impl->events, MAXEVENTS, timeout);
+    }
     if (*count < 0) {
+        if (errno == EINTR) {
+            /* 被信号中断 */
+            *count = 0;
+            return error_ok;
+        }
         return error_loop_fail;
     }
     return error_ok;
 }
 
-int knet_impl_run_once(kloop_t* loop) {
+void _epoll_drain(loop_epoll_t* impl) {
+    uint64_t count = 0;
+    if (read(impl->event_fd, &count, sizeof(count)) < 0) {
+        /* EAGAIN, 已经被读取 */
+    }
+}
+
+int _epoll_run_once(kloop_t* loop) {
     int count = 0;
     int i = 0;
     kchannel_ref_t* channel_ref = 0;
     struct epoll_event event;
-    time_t ts = time(0);
+    uint64_t ts = 0;
     struct epoll_event* events = 0;
     loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
-    int error = _select(loop, &count);
+    int error = _epoll_wait(loop, &count);
     if (error != error_ok) {
         return error;
     }
+    /* 本次迭代的时间戳 */
+    ts = knet_loop_update_time(loop);
+    /* 上一次循环达到读取预算的管道继续读取 */
+    knet_loop_process_ready(loop, ts);
     events = impl->events;
     for (; i < count; i++) {
         channel_ref = (kchannel_ref_t*)events[i].data.ptr;
+        if (!channel_ref) {
+            /* 其他线程唤醒, 读取并清零计数 */
+            _epoll_drain(impl);
+            knet_loop_event_process(loop);
+            continue;
+        }
+        if ((events[i].events & EPOLLERR) && !(events[i].events & EPOLLHUP) &&
+            (error_ok == knet_channel_ref_update_zerocopy(channel_ref))) {
+            /* 错误队列内是MSG_ZEROCOPY完成通知且SO_ERROR为0, 套接字正常, 继续处理读写事件 */
+            events[i].events &= ~EPOLLERR;
+        }
         if ((events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP)) {
            /* ManPage: In kernel versions before 2.6.9, the EPOLL_CTL_DEL operation required a non-NULL pointer
               in event, even though this argument is ignored. Since Linux 2.6.9, event can be specified
@@ -88,84 +144,129 @@ int knet_impl_run_once(kloop_t* loop) {
               2.6.9 should specify a non-NULL pointer in event.
             */
             epoll_ctl(impl->epoll_fd, EPOLL_CTL_DEL, knet_channel_ref_get_socket_fd(channel_ref), &event);
-        } else if (events[i].events & EPOLLIN) {
-            knet_channel_ref_update(channel_ref, channel_event_recv, ts);
-        } else if (events[i].events & EPOLLOUT) {
-            knet_channel_ref_update(channel_ref, channel_event_send, ts);
+            knet_loop_profile_increase_impl_ctl_count(knet_loop_get_profile(loop));
         } else {
+            /* 读写事件可能同时到达, 事件掩码未改变时不会再次调用epoll_ctl, 必须逐个处理 */
+            if (events[i].events & EPOLLIN) {
+                knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+            }
+            if ((events[i].events & EPOLLOUT) && !knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+                knet_channel_ref_update(channel_ref, channel_event_send, ts);
+            }
         }
     }
     knet_loop_check_timeout(loop, ts);
+    /* 发送本次迭代内合并的数据 */
+    knet_loop_process_cork(loop);
     knet_loop_check_close(loop);
     return error_ok;
 }
 
-int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+/**
+ * 向epoll注册管道事件
+ * <pre>
+ * 管道引用的选取器标志位保存了当前注册在epoll内的事件掩码(始终包含EPOLLET, 因此非零即表示已注册),
+ * 掩码未改变且不需要重新触发边缘事件时不调用epoll_ctl
+ * </pre>
+ * @param channel_ref 管道引用
+ * @param events 事件掩码
+ * @param rearm 非零时即使掩码未改变也调用epoll_ctl, 重新触发边缘事件
+ */
+void _epoll_ctl(kchannel_ref_t* channel_ref, uint32_t events, int rearm) {
     struct epoll_event event;
-    loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(knet_channel_ref_get_loop(channel_ref));
-    knet_channel_event_e old_event = knet_channel_ref_get_event(channel_ref);
+    kloop_t*      loop = knet_channel_ref_get_loop(channel_ref);
+    loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(loop);
+    uint32_t      flag = (uint32_t)knet_channel_ref_get_flag(channel_ref);
+    if ((flag == events) && !rearm) {
+        /* 已注册的事件掩码未改变 */
+        return;
+    }
     memset(&event, 0, sizeof(event));
     event.data.ptr = channel_ref;
-    event.events |= EPOLLET;
+    event.events   = events;
+    knet_channel_ref_set_flag(channel_ref, (int)events);
+    knet_loop_profile_increase_impl_ctl_count(knet_loop_get_profile(loop));
+    if (flag) {
+        epoll_ctl(impl->epoll_fd, EPOLL_CTL_MOD, knet_channel_ref_get_socket_fd(channel_ref), &event);
+    } else {
+        epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, knet_channel_ref_get_socket_fd(channel_ref), &event);
+    }
+}
+
+int _epoll_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    uint32_t events = EPOLLET;
+    knet_channel_event_e old_event = knet_channel_ref_get_event(channel_ref);
     if (e & channel_event_recv) {
-        if (old_event & channel_event_send) { /* Ѿעд¼ */
-            event.events |= EPOLLOUT;
+        if (old_event & channel_event_send) { /* 已经注册写事件 */
+            events |= EPOLLOUT;
         }
-        event.events |= EPOLLIN;
+        events |= EPOLLIN;
     }
     if (e & channel_event_send) {
-        if (old_event & channel_event_recv) { /* Ѿע¼ */
-            event.events |= EPOLLIN;
+        if (old_event & channel_event_recv) { /* 已经注册读事件 */
+            events |= EPOLLIN;
         }
-        event.events |= EPOLLOUT;
-    }
-    if (knet_channel_ref_get_flag(channel_ref)) {
-        epoll_ctl(impl->epoll_fd, EPOLL_CTL_MOD, knet_channel_ref_get_socket_fd(channel_ref), &event);
-    } else {
-        knet_channel_ref_set_flag(channel_ref, 1);
-        epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, knet_channel_ref_get_socket_fd(channel_ref), &event);
+        events |= EPOLLOUT;
     }
+    /* 
+     * 发送链表清空时取消写事件, 已注册写事件时发送链表内有数据且套接字曾经不可写, 可写时一定会触发边缘事件,
+     * 与读事件相同, 事件掩码未改变时不调用epoll_ctl
+     */
+    _epoll_ctl(channel_ref, events, knet_channel_ref_check_rearm(channel_ref));
     return error_ok;
 }
 
-int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
-    struct epoll_event event;
-    loop_epoll_t* impl = (loop_epoll_t*)knet_loop_get_impl(knet_channel_ref_get_loop(channel_ref));
+int _epoll_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    uint32_t events = EPOLLET;
     knet_channel_event_e old_event = knet_channel_ref_get_event(channel_ref);
-    memset(&event, 0, sizeof(event));
-    event.data.ptr = channel_ref;
-    event.events |= EPOLLET;
     if (e & channel_event_recv) {
-        if (old_event & channel_event_send) { /* Ѿעд¼ */
-            event.events |= EPOLLOUT;
+        if (old_event & channel_event_send) { /* 已经注册写事件 */
+            events |= EPOLLOUT;
         }
     } 
     if (e & channel_event_send) {
-        if (old_event & channel_event_recv) { /* Ѿע¼ */
-            event.events |= EPOLLIN;
+        if (old_event & channel_event_recv) { /* 已经注册读事件 */
+            events |= EPOLLIN;
         }
     }
-    if (knet_channel_ref_get_flag(channel_ref)) {
-        epoll_ctl(impl->epoll_fd, EPOLL_CTL_MOD, knet_channel_ref_get_socket_fd(channel_ref), &event);
-    } else {
-        knet_channel_ref_set_flag(channel_ref, 1);
-        epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, knet_channel_ref_get_socket_fd(channel_ref), &event);
-    }
+    _epoll_ctl(channel_ref, events, 0);
     return error_ok;
 }
 
-int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+void _epoll_notify(kloop_t* loop) {
+    uint64_t      count = 1;
+    loop_epoll_t* impl  = (loop_epoll_t*)knet_loop_get_impl(loop);
+    if (write(impl->event_fd, &count, sizeof(count)) < 0) {
+        /* 计数溢出时loop必然还未读取, 忽略 */
+    }
+}
+
+int _epoll_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     return error_ok;
 }
 
-int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
-    /* ӱ */
+int _epoll_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    /* 清除添加标记 */
     knet_channel_ref_set_flag(channel_ref, 0);
     return error_ok;
 }
 
-socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref) {
+socket_t _epoll_channel_accept(kchannel_ref_t* channel_ref) {
     return 0;
 }
 
+loop_backend_t loop_epoll_backend = {
+    loop_backend_epoll,
+    "epoll",
+    _epoll_create,
+    _epoll_destroy,
+    _epoll_run_once,
+    _epoll_event_add,
+    _epoll_event_remove,
+    _epoll_add_channel_ref,
+    _epoll_remove_channel_ref,
+    _epoll_notify,
+    _epoll_channel_accept,
+};
+
 #endif
@@ -23,11 +23,42 @@
  */
 
 #include "config.h"
+#include "loop.h"
 
-#if LOOP_SELECT
-    #include "loop_select.c" /* select */
-#elif LOOP_IOCP
+/*
+ * 所有编译进库的选取器在同一个编译单元内, 各自导出一个loop_backend_t方法表
+ */
+
+#if LOOP_IOCP
     #include "loop_iocp.c" /* IOCP */
-#elif LOOP_EPOLL
+#endif /* LOOP_IOCP */
+#if LOOP_URING
+    #include "loop_uring.c" /* io_uring */
+#endif /* LOOP_URING */
+#if LOOP_EPOLL
     #include "loop_epoll.c" /* EPOLL */
-#endif
+#endif /* LOOP_EPOLL */
+#if LOOP_SELECT
+    #include "loop_select.c" /* select */
+#endif /* LOOP_SELECT */
+
+/* 按默认选择的优先顺序排列 */
+loop_backend_t* loop_backends[] = {
+#if LOOP_IOCP
+    &loop_iocp_backend,
+#endif /* LOOP_IOCP */
+#if LOOP_EPOLL
+    &loop_epoll_backend,
+#endif /* LOOP_EPOLL */
+#if LOOP_URING
+    &loop_uring_backend, /* 不作为默认选取器, 通过knet_loop_create_with_backend()选择 */
+#endif /* LOOP_URING */
+#if LOOP_SELECT
+    &loop_select_backend,
+#endif /* LOOP_SELECT */
+    0
+};
+
+loop_backend_t** knet_loop_get_backends() {
+    return loop_backends;
+}
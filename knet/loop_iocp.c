@@ -22,7 +22,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef LOOP_IOCP
+#if LOOP_IOCP
 
 #include "loop.h"
 #include "list.h"
@@ -34,101 +34,101 @@
     #pragma comment(lib,"Ws2_32.lib")
 #endif /* defined(_MSC_VER) */
 
-#define ACCEPTEX_ADDR_SIZE   sizeof(struct sockaddr_in) + 16 /* AcceptExMSDN */
-#define ACCEPTEX_BUFFER_SIZE 1024                            /* AcceptExMSDN */
-#define ACCEPTEX             LPFN_ACCEPTEX                   /* AcceptExָ룬MSDN */
+#define ACCEPTEX_ADDR_SIZE   sizeof(struct sockaddr_in) + 16 /* AcceptEx函数参数，详见MSDN */
+#define ACCEPTEX_BUFFER_SIZE 1024                            /* AcceptEx函数参数，详见MSDN */
+#define ACCEPTEX             LPFN_ACCEPTEX                   /* AcceptEx函数指针，详见MSDN */
 
 /**
- * ¼
+ * 事件类型
  */
 typedef enum _io_type_e {
-    io_type_accept  = 1,  /* ӵ */
-    io_type_connect = 2,  /* ӽ */
-    io_type_recv    = 4,  /*  */
-    io_type_send    = 8,  /*  */
-    io_type_close   = 16, /* ܵر */
+    io_type_accept  = 1,  /* 新连接到来 */
+    io_type_connect = 2,  /* 连接建立 */
+    io_type_recv    = 4,  /* 接收 */
+    io_type_send    = 8,  /* 发送 */
+    io_type_close   = 16, /* 管道关闭 */
 } io_type_e;
 
 /**
- * per-I/O
+ * per-I/O数据
  */
 typedef struct _per_io_t {  
-    OVERLAPPED ov;   /* windowsصI/Oݽṹ */
-    io_type_e  type; /* ǰI/O */
+    OVERLAPPED ov;   /* windows重叠I/O所需数据结构 */
+    io_type_e  type; /* 当前I/O类型 */
 } per_io_t;
 
 /**
- * AcceptEx
+ * AcceptEx函数相关
  */
 typedef struct _AcceptEx_t {
-    ACCEPTEX       fn_AcceptEx;                  /* AcceptExָ */
-    socket_t       socket_fd;                    /* ǰδĿͻ׽ - AcceptEx */
-    char           buffer[ACCEPTEX_BUFFER_SIZE]; /*  - AcceptEx */
+    ACCEPTEX       fn_AcceptEx;                  /* AcceptEx函数指针 */
+    socket_t       socket_fd;                    /* 当前未决的客户端套接字 - AcceptEx */
+    char           buffer[ACCEPTEX_BUFFER_SIZE]; /* 参数 - AcceptEx */
 } AcceptEx_t;
 
 /**
- * per-socket
+ * per-socket数据
  */
 typedef struct _per_sock_t {  
-    kchannel_ref_t* channel_ref;  /* ǰܵ */
-    AcceptEx_t*    AcceptEx_info; /* AcceptEx_tָ */
-    per_io_t       io_recv;       /* ǰʵֻ֧ͬһʱֻͶһrecv */
-    per_io_t       io_send;       /* ǰʵֻ֧ͬһʱֻͶһsend */
+    kchannel_ref_t* channel_ref;  /* 当前管道 */
+    AcceptEx_t*    AcceptEx_info; /* AcceptEx_t指针 */
+    per_io_t       io_recv;       /* 当前实现只支持同一个时刻只投递一个recv请求 */
+    per_io_t       io_send;       /* 当前实现只支持同一个时刻只投递一个send请求 */
 } per_sock_t;
 
 /**
- * IOCPʵ
+ * IOCP实现
  */
 typedef struct _loop_iocp_t {
-    HANDLE iocp; /* IOCP */
+    HANDLE iocp; /* IOCP句柄 */
 } loop_iocp_t;
 
 /**
- * per-socket
- * @return per_sock_tʵ
+ * 建立per-socket数据
+ * @return per_sock_t实例
  */
 per_sock_t* socket_data_create();
 
 /**
- * per-socket
- * @param data per_sock_tʵ
+ * 销毁per-socket数据
+ * @param data per_sock_t实例
  */
 void socket_data_destroy(per_sock_t* data);
 
 /**
- * ȡùܵper-socket
- * @param channel_ref ܵ
- * @return per_sock_tʵ
+ * 取得管道的per-socket数据
+ * @param channel_ref 管道引用
+ * @return per_sock_t实例
  */
 per_sock_t* get_data(kchannel_ref_t* channel_ref);
 
 /**
- * ȡAcceptExָ
- * @return AcceptExָ
+ * 获取监听的描述符的AcceptEx函数指针
+ * @return AcceptEx函数指针
  */
 ACCEPTEX get_fn_AcceptEx(socket_t fd);
 
 /**
- * ׼µ
- * @return AcceptExָ
+ * 准备接受新的连接
+ * @return AcceptEx函数指针
  */
 AcceptEx_t* socket_data_prepare_accept(per_sock_t* data);
 
 /**
- * ȡѭIOCPʵ
- * @return loop_iocp_tʵ
+ * 取得网络循环的IOCP实现
+ * @return loop_iocp_t实例
  */
 loop_iocp_t* get_impl(kloop_t* loop);
 
 /**
- * עRECV¼
- * @param channel_ref kchannel_ref_tʵ
+ * 注册RECV事件
+ * @param channel_ref kchannel_ref_t实例
  */
 void on_iocp_recv(kchannel_ref_t* channel_ref);
 
 /**
- * עSEND¼
- * @param channel_ref kchannel_ref_tʵ
+ * 注册SEND事件
+ * @param channel_ref kchannel_ref_t实例
  */
 void on_iocp_send(kchannel_ref_t* channel_ref);
 
@@ -142,7 +142,7 @@ per_sock_t* socket_data_create() {
 void socket_data_destroy(per_sock_t* data) {
     verify(data);
     if (data->AcceptEx_info) {
-        /* ر׽ */
+        /* 关闭套接字 */
         if (data->AcceptEx_info->socket_fd) {
             socket_close(data->AcceptEx_info->socket_fd);
         }
@@ -163,7 +163,7 @@ AcceptEx_t* socket_data_prepare_accept(per_sock_t* data) {
     if (!data->AcceptEx_info->fn_AcceptEx) {
         data->AcceptEx_info->fn_AcceptEx = get_fn_AcceptEx(fd);
     }
-    /* һ֧صI/O׽ */
+    /* 建立一个支持重叠I/O的套接字 */
     data->AcceptEx_info->socket_fd = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, 0, 0, WSA_FLAG_OVERLAPPED);
     if (data->AcceptEx_info->socket_fd == INVALID_SOCKET) {
         verify(0);
@@ -180,7 +180,7 @@ per_sock_t* get_data(kchannel_ref_t* channel_ref) {
     return (per_sock_t*)knet_channel_ref_get_data(channel_ref);
 }
 
-int knet_impl_create(kloop_t* loop) {
+int _iocp_create(kloop_t* loop) {
     WSADATA wsa;
     loop_iocp_t* impl = create(loop_iocp_t);
     verify(impl);
@@ -192,10 +192,11 @@ int knet_impl_create(kloop_t* loop) {
         return error_loop_impl_init_fail;
     }
     WSAStartup(MAKEWORD(2, 2), &wsa);
-    return error_ok;
+    /* 通过套接字对唤醒 */
+    return knet_loop_create_notify_channel(loop);
 }
 
-void knet_impl_destroy(kloop_t* loop) {
+void _iocp_destroy(kloop_t* loop) {
     loop_iocp_t* impl = get_impl(loop);
     verify(impl);
     CloseHandle(impl->iocp);
@@ -203,7 +204,7 @@ void knet_impl_destroy(kloop_t* loop) {
     WSACleanup();
 }
 
-int _select(kloop_t* loop, time_t ts) {
+int _iocp_wait(kloop_t* loop) {
     BOOL            error       = FALSE;
     DWORD           bytes       = 0;
     DWORD           last_error  = 0;
@@ -211,14 +212,21 @@ int _select(kloop_t* loop, time_t ts) {
     per_sock_t*     per_sock    = 0;
     kchannel_ref_t* channel_ref = 0;
     loop_iocp_t*    impl        = get_impl(loop);
-    error = GetQueuedCompletionStatus(impl->iocp, &bytes, (PULONG_PTR)&per_sock, (LPOVERLAPPED*)&per_io, 1);
+    int             timeout     = knet_loop_get_wait_timeout(loop);
+    uint64_t        ts          = 0;
+    error = GetQueuedCompletionStatus(impl->iocp, &bytes, (PULONG_PTR)&per_sock, (LPOVERLAPPED*)&per_io,
+        (timeout < 0) ? INFINITE : (DWORD)timeout);
     last_error = GetLastError();
+    /* 本次迭代的时间戳 */
+    ts = knet_loop_update_time(loop);
+    /* 上一次循环达到读取预算的管道继续读取 */
+    knet_loop_process_ready(loop, ts);
     if (FALSE == error) {
         if (last_error == WAIT_TIMEOUT) {
             return error_ok;
         }
         if (last_error == ERROR_OPERATION_ABORTED) {
-            /* ȡĲ */
+            /* 取消的操作 */
             verify(per_sock);
             knet_channel_ref_decref(per_sock->channel_ref);
             return error_ok;
@@ -235,25 +243,30 @@ int _select(kloop_t* loop, time_t ts) {
             knet_channel_ref_update(channel_ref, channel_event_send, ts);
         }
     }
-    /* ܵ¼ϣü */
+    /* 管道事件处理完毕，减少引用计数 */
     knet_channel_ref_decref(channel_ref);
     return error_ok;
 }
 
-int knet_impl_run_once(kloop_t* loop) {
-    int    error = 0;
-    time_t ts    = time(0);
+int _iocp_run_once(kloop_t* loop) {
+    int error = 0;
     verify(loop);
-    error = _select(loop, ts);
+    error = _iocp_wait(loop);
     if (error != error_ok) {
         return error;
     }
-    knet_loop_check_timeout(loop, ts);
+    knet_loop_check_timeout(loop, knet_loop_get_time(loop));
+    /* 发送本次迭代内合并的数据 */
+    knet_loop_process_cork(loop);
     knet_loop_check_close(loop);
     return error_ok;
 }
 
-socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref) {
+void _iocp_notify(kloop_t* loop) {
+    knet_loop_notify_channel_send(loop);
+}
+
+socket_t _iocp_channel_accept(kchannel_ref_t* channel_ref) {
     socket_t    acceptor = 0;
     per_sock_t* per_sock = 0;
     socket_t    client   = 0;
@@ -278,7 +291,7 @@ ACCEPTEX get_fn_AcceptEx(socket_t fd) {
     DWORD    bytes         = 0;
     ACCEPTEX fn_AcceptEx   = 0;
     GUID     guid_AcceptEx = WSAID_ACCEPTEX;
-    /* ȡAcceptExָ */
+    /* 获取AcceptEx指针 */
     error = WSAIoctl(fd, SIO_GET_EXTENSION_FUNCTION_POINTER, &guid_AcceptEx, sizeof(guid_AcceptEx),
                 &fn_AcceptEx, sizeof(ACCEPTEX), &bytes, NULL, NULL);
     if (error) {
@@ -305,7 +318,7 @@ void on_iocp_recv(kchannel_ref_t* channel_ref) {
     if (knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
         per_io->type = io_type_accept;
         AcceptEx_ptr = socket_data_prepare_accept(per_sock);
-        /* Ͷһaccept */
+        /* 投递一个accept请求 */
         result = AcceptEx_ptr->fn_AcceptEx(fd, AcceptEx_ptr->socket_fd, AcceptEx_ptr->buffer,
                     0, ACCEPTEX_ADDR_SIZE, ACCEPTEX_ADDR_SIZE, 0, &per_io->ov);
         if (result == FALSE) {
@@ -313,25 +326,25 @@ void on_iocp_recv(kchannel_ref_t* channel_ref) {
             if (error != ERROR_IO_PENDING) {
                 knet_channel_ref_close(channel_ref);
             }
-            /* ü */
+            /* 增加引用计数 */
             knet_channel_ref_incref(channel_ref);
             return;
         }
     } else {
         per_io->type = io_type_recv;
-        /* Ͷһ0recv */
+        /* 投递一个0长度recv请求 */
         result = WSARecv(fd, &sbuf, 1, &bytes, &flags, &per_io->ov, 0);
         if (result != 0) {
             error = GetLastError();
             if ((error != ERROR_IO_PENDING) && (error != WSAENOTCONN)) {
                 knet_channel_ref_close(channel_ref);
             }
-            /* ü */
+            /* 增加引用计数 */
             knet_channel_ref_incref(channel_ref);
             return;
         }
     }
-    /* ü */
+    /* 增加引用计数 */
     knet_channel_ref_incref(channel_ref);
     flag |= io_type_recv;
     knet_channel_ref_set_flag(channel_ref, flag);
@@ -350,43 +363,43 @@ void on_iocp_send(kchannel_ref_t* channel_ref) {
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
         return;
     }
-    /* Ͷ¼ */
+    /* 设置投递事件类型 */
     if (knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
         per_io->type = io_type_connect;
     } else {
         per_io->type = io_type_send;
     }
-    /* ״̬ĹܵǷѾ */
+    /* 连接状态的管道，检查是否已经完成 */
     if (knet_channel_ref_check_state(channel_ref, channel_state_connect)) {
         if (!socket_check_send_ready(knet_channel_ref_get_socket_fd(channel_ref))) {
-            /* δӲͶsend */
+            /* 未完成连接不投递send请求 */
             return;
         }
     }
-    /* Ͷһ0send */
+    /* 投递一个0长度send请求 */
     result = WSASend(fd, &sbuf, 1, &bytes, flags, &per_io->ov, 0);
     if (result != 0) {
         error = GetLastError();
         if ((error != ERROR_IO_PENDING) && (error != WSAENOTCONN)) {
             knet_channel_ref_close(channel_ref);
         }
-        /* ü */
+        /* 增加引用计数 */
         knet_channel_ref_incref(channel_ref);
         return;
     }
-    /* ü */
+    /* 增加引用计数 */
     knet_channel_ref_incref(channel_ref);
-    /* Ͷݱ־ */
+    /* 设置投递标志 */
     flag |= io_type_send;
     knet_channel_ref_set_flag(channel_ref, flag);
 }
 
-int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+int _iocp_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
     verify(channel_ref);
     if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
         return error_already_close;
     }
-    /* Ͷ¼ */
+    /* 投递事件 */
     if (channel_event_recv & e) {
         on_iocp_recv(channel_ref);
     } 
@@ -396,7 +409,7 @@ int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
     return error_ok;
 }
 
-int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+int _iocp_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
     int flag = 0;
     verify(e);
     verify(channel_ref);
@@ -411,7 +424,7 @@ int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e)
     return error_ok;
 }
 
-int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+int _iocp_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     loop_iocp_t* impl      = 0;
     socket_t     socket_fd = 0;
     HANDLE       iocp      = 0;
@@ -424,7 +437,7 @@ int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     per_sock  = socket_data_create();
     verify(per_sock);
     per_sock->channel_ref  = channel_ref;
-    /* IOCP */
+    /* 与IOCP关联 */
     iocp = CreateIoCompletionPort((HANDLE)socket_fd, impl->iocp, (ULONG_PTR)per_sock, 0);
     if (!iocp) {
         socket_data_destroy(per_sock);
@@ -434,15 +447,29 @@ int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     return error_ok;
 }
 
-int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+int _iocp_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
     per_sock_t* per_sock  = 0;
     verify(loop);
     verify(channel_ref);
     per_sock = get_data(channel_ref);
     verify(per_sock);
-    /* Դ */
+    /* 销毁相关资源 */
     socket_data_destroy(per_sock);
     return error_ok;
 }
 
+loop_backend_t loop_iocp_backend = {
+    loop_backend_iocp,
+    "IOCP",
+    _iocp_create,
+    _iocp_destroy,
+    _iocp_run_once,
+    _iocp_event_add,
+    _iocp_event_remove,
+    _iocp_add_channel_ref,
+    _iocp_remove_channel_ref,
+    _iocp_notify,
+    _iocp_channel_accept,
+};
+
 #endif
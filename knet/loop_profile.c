@@ -29,17 +29,23 @@
 #include "logger.h"
 
 struct _loop_profile_t {
-    kloop_t*  loop;                /* ¼ѭ */
-    uint64_t recv_bytes;          /* ѽյֽ */
-    uint64_t send_bytes;          /* ѷ͵ֽ */
-    uint32_t established_channel; /* ѾӵĹܵ */
-    uint32_t active_channel;      /* δӵĹܵ */
-    uint32_t close_channel;       /* ѹرյĹܵ */
-    uint32_t __padding;           /*  */
-    uint64_t last_send_bytes;     /* ϴεknet_loop_profile_get_sent_bandwidthʱķֽ */
-    uint64_t last_recv_bytes;     /* ϴεknet_loop_profile_get_recv_bandwidthʱĽֽ */
-    time_t   last_send_tick;      /* ϴεknet_loop_profile_get_sent_bandwidthʱʱ룩 */
-    time_t   last_recv_tick;      /* ϴεknet_loop_profile_get_recv_bandwidthʱʱ룩 */
+    kloop_t*  loop;                /* 网络事件循环 */
+    uint64_t recv_bytes;          /* 已接收的字节数 */
+    uint64_t send_bytes;          /* 已发送的字节数 */
+    uint32_t established_channel; /* 已经建立连接的管道数量 */
+    uint32_t active_channel;      /* 还未建立连接的管道数量 */
+    uint32_t close_channel;       /* 已关闭的管道数量 */
+    uint32_t __padding;           /* 填充 */
+    uint64_t impl_ctl_count;      /* 选取器注册/修改/删除事件的系统调用次数 */
+    uint64_t zerocopy_send;       /* MSG_ZEROCOPY发送次数 */
+    uint64_t zerocopy_complete;   /* 内核通知完成的MSG_ZEROCOPY发送次数 */
+    uint64_t zerocopy_copied;     /* 内核通知完成但实际拷贝了数据的MSG_ZEROCOPY发送次数 */
+    uint64_t relay_bytes;         /* 管道之间中继的字节数 */
+    uint64_t recv_syscall;        /* 接收数据的系统调用次数 */
+    uint64_t last_send_bytes;     /* 上次调用knet_loop_profile_get_sent_bandwidth时的发送字节数 */
+    uint64_t last_recv_bytes;     /* 上次调用knet_loop_profile_get_recv_bandwidth时的接收字节数 */
+    uint64_t last_send_tick;      /* 上次调用knet_loop_profile_get_sent_bandwidth时的时间戳（毫秒） */
+    uint64_t last_recv_tick;      /* 上次调用knet_loop_profile_get_recv_bandwidth时的时间戳（毫秒） */
 };
 
 kloop_profile_t* knet_loop_profile_create(kloop_t* loop) {
@@ -49,7 +55,7 @@ kloop_profile_t* knet_loop_profile_create(kloop_t* loop) {
     verify(profile);
     memset(profile, 0, sizeof(kloop_profile_t));
     profile->loop           = loop;
-    profile->last_send_tick = time(0);
+    profile->last_send_tick = knet_loop_get_time(loop);
     profile->last_recv_tick = profile->last_send_tick;
     return profile;
 }
@@ -70,7 +76,7 @@ uint32_t knet_loop_profile_decrease_established_channel_count(kloop_profile_t* p
 
 uint32_t knet_loop_profile_get_established_channel_count(kloop_profile_t* profile) {
     verify(profile);
-    return profile->established_channel - 2; /* ¼֪ͨܵͳ */
+    return profile->established_channel;
 }
 
 uint32_t knet_loop_profile_increase_active_channel_count(kloop_profile_t* profile) {
@@ -103,6 +109,74 @@ uint32_t knet_loop_profile_get_close_channel_count(kloop_profile_t* profile) {
     return profile->close_channel;
 }
 
+uint64_t knet_loop_profile_increase_impl_ctl_count(kloop_profile_t* profile) {
+    verify(profile);
+    return ++profile->impl_ctl_count;
+}
+
+uint64_t knet_loop_profile_get_impl_ctl_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->impl_ctl_count;
+}
+
+uint64_t knet_loop_profile_add_zerocopy_send(kloop_profile_t* profile, uint32_t count) {
+    verify(profile);
+    profile->zerocopy_send += count;
+    return profile->zerocopy_send;
+}
+
+uint64_t knet_loop_profile_add_zerocopy_complete(kloop_profile_t* profile, uint32_t count, uint32_t copied) {
+    verify(profile);
+    profile->zerocopy_complete += count;
+    profile->zerocopy_copied   += copied;
+    return profile->zerocopy_complete;
+}
+
+uint64_t knet_loop_profile_get_zerocopy_send_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->zerocopy_send;
+}
+
+uint64_t knet_loop_profile_get_zerocopy_complete_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->zerocopy_complete;
+}
+
+uint64_t knet_loop_profile_get_zerocopy_copied_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->zerocopy_copied;
+}
+
+uint64_t knet_loop_profile_add_relay_bytes(kloop_profile_t* profile, uint64_t relay_bytes) {
+    verify(profile);
+    profile->relay_bytes += relay_bytes;
+    return profile->relay_bytes;
+}
+
+uint64_t knet_loop_profile_get_relay_bytes(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->relay_bytes;
+}
+
+uint64_t knet_loop_profile_add_recv_syscall(kloop_profile_t* profile, uint32_t count) {
+    verify(profile);
+    profile->recv_syscall += count;
+    return profile->recv_syscall;
+}
+
+uint64_t knet_loop_profile_get_recv_syscall_count(kloop_profile_t* profile) {
+    verify(profile);
+    return profile->recv_syscall;
+}
+
+float64_t knet_loop_profile_get_recv_syscall_per_kb(kloop_profile_t* profile) {
+    verify(profile);
+    if (!profile->recv_bytes) {
+        return 0.0;
+    }
+    return (float64_t)profile->recv_syscall * 1024.0 / (float64_t)profile->recv_bytes;
+}
+
 uint64_t knet_loop_profile_add_send_bytes(kloop_profile_t* profile, uint64_t send_bytes) {
     verify(profile);
     return (profile->send_bytes += send_bytes);
@@ -124,38 +198,40 @@ uint64_t knet_loop_profile_get_recv_bytes(kloop_profile_t* profile) {
 }
 
 uint32_t knet_loop_profile_get_sent_bandwidth(kloop_profile_t* profile) {
-    time_t   tick      = time(0);
+    uint64_t tick      = 0;
     uint64_t bandwidth = 0;
     uint64_t intval    = 0;
     uint64_t bytes     = 0;
     verify(profile);
+    /* 使用loop本次迭代的时间戳 */
+    tick  = knet_loop_get_time(profile->loop);
     bytes = profile->send_bytes - profile->last_send_bytes;
-    if (tick == profile->last_send_tick) {
-        /* СΪ1 */
-        intval = 1;
-    } else {
-        intval = tick - profile->last_send_tick;
+    intval = tick - profile->last_send_tick;
+    if (intval < 1000) {
+        /* 最小为1秒 */
+        intval = 1000;
     }
-    bandwidth = bytes / intval;
+    bandwidth = bytes * 1000 / intval;
     profile->last_send_tick  = tick;
     profile->last_send_bytes = profile->send_bytes;
     return (uint32_t)bandwidth;
 }
 
 uint32_t knet_loop_profile_get_recv_bandwidth(kloop_profile_t* profile) {
-    time_t   tick      = time(0);
+    uint64_t tick      = 0;
     uint64_t bandwidth = 0;
     uint64_t intval    = 0;
     uint64_t bytes     = 0;
     verify(profile);
+    /* 使用loop本次迭代的时间戳 */
+    tick  = knet_loop_get_time(profile->loop);
     bytes = profile->recv_bytes - profile->last_recv_bytes;
-    if (tick == profile->last_recv_tick) {
-        /* СΪ1 */
-        intval = 1;
-    } else {
-        intval = tick - profile->last_recv_tick;
+    intval = tick - profile->last_recv_tick;
+    if (intval < 1000) {
+        /* 最小为1秒 */
+        intval = 1000;
     }
-    bandwidth = bytes / intval;
+    bandwidth = bytes * 1000 / intval;
     profile->last_recv_tick  = tick;
     profile->last_recv_bytes = profile->recv_bytes;
     return (uint32_t)bandwidth;
@@ -173,14 +249,18 @@ int knet_loop_profile_dump_file(kloop_profile_t* profile, FILE* fp) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Selector ctl calls:  %lld\n"
+        "Recv calls per KB:   %.3f\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_impl_ctl_count(profile),
+        knet_loop_profile_get_recv_syscall_per_kb(profile));
     if (len <= 0) {
         return error_fail;
     }
@@ -198,14 +278,18 @@ int knet_loop_profile_dump_stream(kloop_profile_t* profile, kstream_t* stream) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Selector ctl calls:  %lld\n"
+        "Recv calls per KB:   %.3f\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_impl_ctl_count(profile),
+        knet_loop_profile_get_recv_syscall_per_kb(profile));
 }
 
 int knet_loop_profile_dump_stdout(kloop_profile_t* profile) {
@@ -219,14 +303,18 @@ int knet_loop_profile_dump_stdout(kloop_profile_t* profile) {
         "Received bytes:      %lld\n"
         "Sent bytes:          %lld\n"
         "Received bandwidth:  %ld(B/s)\n"
-        "Sent bandwidth:      %ld(B/s)\n",
+        "Sent bandwidth:      %ld(B/s)\n"
+        "Selector ctl calls:  %lld\n"
+        "Recv calls per KB:   %.3f\n",
         (long)knet_loop_profile_get_established_channel_count(profile),
         (long)knet_loop_profile_get_active_channel_count(profile),
         (long)knet_loop_profile_get_close_channel_count(profile),
         (long long)knet_loop_profile_get_recv_bytes(profile),
         (long long)knet_loop_profile_get_sent_bytes(profile),
         (long)knet_loop_profile_get_recv_bandwidth(profile),
-        (long)knet_loop_profile_get_sent_bandwidth(profile));
+        (long)knet_loop_profile_get_sent_bandwidth(profile),
+        (long long)knet_loop_profile_get_impl_ctl_count(profile),
+        knet_loop_profile_get_recv_syscall_per_kb(profile));
     if (len <= 0) {
         return error_fail;
     }
@@ -29,73 +29,113 @@
 #include "loop_profile_api.h"
 
 /**
- * kloop_tͳ
- * @param loop kloop_tʵ
- * @return kloop_profile_tʵ
+ * 建立kloop_t统计器
+ * @param loop kloop_t实例
+ * @return kloop_profile_t实例
  */
 kloop_profile_t* knet_loop_profile_create(kloop_t* loop);
 
 /**
- * ͳ
- * @param profile kloop_profile_tʵ
+ * 销毁统计器
+ * @param profile kloop_profile_t实例
  */
 void knet_loop_profile_destroy(kloop_profile_t* profile);
 
 /**
- * ѽӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return ѽӵĹܵ
+ * 增加已建立连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已建立连接的管道数量
  */
 uint32_t knet_loop_profile_increase_established_channel_count(kloop_profile_t* profile);
 
 /**
- * ѽӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return ѽӵĹܵ
+ * 减少已建立连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已建立连接的管道数量
  */
 uint32_t knet_loop_profile_decrease_established_channel_count(kloop_profile_t* profile);
 
 /**
- * ѽδӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return ѽδӵĹܵ
+ * 增加已建立但未连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已建立但未连接的管道数量
  */
 uint32_t knet_loop_profile_increase_active_channel_count(kloop_profile_t* profile);
 
 /**
- * ѽδӵĹܵ
- * @param profile kloop_profile_tʵ
- * @return ѽδӵĹܵ
+ * 减少已建立但未连接的管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已建立但未连接的管道数量
  */
 uint32_t knet_loop_profile_decrease_active_channel_count(kloop_profile_t* profile);
 
 /**
- * ѹرչܵ
- * @param profile kloop_profile_tʵ
- * @return ѹرչܵ
+ * 增加已关闭管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已关闭管道数量
  */
 uint32_t knet_loop_profile_increase_close_channel_count(kloop_profile_t* profile);
 
 /**
- * ѹرչܵ
- * @param profile kloop_profile_tʵ
- * @return ѹرչܵ
+ * 减少已关闭管道数量
+ * @param profile kloop_profile_t实例
+ * @return 已关闭管道数量
  */
 uint32_t knet_loop_profile_decrease_close_channel_count(kloop_profile_t* profile);
 
 /**
- * ӷֽ
- * @param profile kloop_profile_tʵ
- * @param send_bytes ѷ͵ֽ
- * @return ֽ
+ * 增加选取器事件注册系统调用次数
+ * @param profile kloop_profile_t实例
+ * @return 系统调用次数
+ */
+uint64_t knet_loop_profile_increase_impl_ctl_count(kloop_profile_t* profile);
+
+/**
+ * 增加MSG_ZEROCOPY发送次数
+ * @param profile kloop_profile_t实例
+ * @param count 发送次数
+ * @return MSG_ZEROCOPY发送次数
+ */
+uint64_t knet_loop_profile_add_zerocopy_send(kloop_profile_t* profile, uint32_t count);
+
+/**
+ * 增加内核通知完成的MSG_ZEROCOPY发送次数
+ * @param profile kloop_profile_t实例
+ * @param count 完成次数
+ * @param copied 其中内核实际拷贝了数据的次数
+ * @return 完成次数
+ */
+uint64_t knet_loop_profile_add_zerocopy_complete(kloop_profile_t* profile, uint32_t count, uint32_t copied);
+
+/**
+ * 增加管道之间中继的字节数
+ * @param profile kloop_profile_t实例
+ * @param relay_bytes 中继的字节数
+ * @return 中继的字节数
+ */
+uint64_t knet_loop_profile_add_relay_bytes(kloop_profile_t* profile, uint64_t relay_bytes);
+
+/**
+ * 增加接收数据的系统调用次数
+ * @param profile kloop_profile_t实例
+ * @param count 本次增加的次数
+ * @return 系统调用总次数
+ */
+uint64_t knet_loop_profile_add_recv_syscall(kloop_profile_t* profile, uint32_t count);
+
+/**
+ * 增加发送字节数
+ * @param profile kloop_profile_t实例
+ * @param send_bytes 已发送的字节数
+ * @return 发送字节数
  */
 uint64_t knet_loop_profile_add_send_bytes(kloop_profile_t* profile, uint64_t send_bytes);
 
 /**
- * ӽֽ
- * @param profile kloop_profile_tʵ
- * @param recv_bytes ѽյֽ
- * @return ֽ
+ * 增加接收字节数
+ * @param profile kloop_profile_t实例
+ * @param recv_bytes 已接收的字节数
+ * @return 接收字节数
  */
 uint64_t knet_loop_profile_add_recv_bytes(kloop_profile_t* profile, uint64_t recv_bytes);
 
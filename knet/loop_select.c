@@ -22,7 +22,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef LOOP_SELECT
+#if LOOP_SELECT
 
 #include "loop.h"
 #include "list.h"
@@ -30,11 +30,11 @@
 #include "logger.h"
 
 typedef struct _loop_select_t {
-    fd_set read_fds[FD_SETSIZE]; /* select */
-    fd_set send_fds[FD_SETSIZE]; /* selectд */
+    fd_set read_fds; /* select读描述符集合 */
+    fd_set send_fds; /* select写描述符集合 */
 } loop_select_t;
 
-int knet_impl_create(kloop_t* loop) {
+int _select_create(kloop_t* loop) {
 #if defined(WIN32) || defined(WIN64)
     WSADATA wsa;
 #endif /* defined(WIN32) || defined(WIN64) */
@@ -43,101 +43,151 @@ int knet_impl_create(kloop_t* loop) {
 #if defined(WIN32) || defined(WIN64)
     WSAStartup(MAKEWORD(2, 2), &wsa);
 #endif /* defined(WIN32) || defined(WIN64) */
-    return error_ok;
+    /* 通过套接字对唤醒 */
+    return knet_loop_create_notify_channel(loop);
 }
 
-void knet_impl_destroy(kloop_t* loop) {
+void _select_destroy(kloop_t* loop) {
     knet_free(knet_loop_get_impl(loop));
 #if defined(WIN32) || defined(WIN64)
     WSACleanup();
 #endif /* defined(WIN32) || defined(WIN64) */
 }
 
-int _select(kloop_t* loop) {
+int _select_wait(kloop_t* loop) {
     socket_t max_fd = 0;
     socket_t fd = 0;
     int error = 0;
-    dlist_node_t* node = 0;
-    dlist_node_t* temp = 0;
+    kdlist_node_t* node = 0;
+    kdlist_node_t* temp = 0;
     kchannel_ref_t* channel_ref = 0;
-    struct timeval tv = {0, 100}; /* תʱȴ1ms */
+    struct timeval tv = {0, 0};
+    int timeout = knet_loop_get_wait_timeout(loop);
     loop_select_t* impl = (loop_select_t*)knet_loop_get_impl(loop);
-    FD_ZERO(impl->read_fds);
-    FD_ZERO(impl->send_fds);
+    FD_ZERO(&impl->read_fds);
+    FD_ZERO(&impl->send_fds);
     dlist_for_each_safe(knet_loop_get_active_list(loop), node, temp) {
         channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
         fd = knet_channel_ref_get_socket_fd(channel_ref);
-        if (knet_channel_ref_check_balance(channel_ref)) {
+#if !(defined(WIN32) || defined(WIN64))
+        if (fd >= FD_SETSIZE) {
+            /* 超出fd_set容量 */
+            continue;
         }
+#endif /* !(defined(WIN32) || defined(WIN64)) */
         if (knet_channel_ref_check_event(channel_ref, channel_event_recv)) {
-            FD_SET(fd, impl->read_fds);
-            max_fd = max(max_fd, fd);
+            FD_SET(fd, &impl->read_fds);
+            if (fd > max_fd) {
+                max_fd = fd;
+            }
         }
         if (knet_channel_ref_check_event(channel_ref, channel_event_send)) {
-            FD_SET(fd, impl->send_fds);
-            max_fd = max(max_fd, fd);
+            FD_SET(fd, &impl->send_fds);
+            if (fd > max_fd) {
+                max_fd = fd;
+            }
         }
     }
-    error = select(max_fd + 1, impl->read_fds, impl->send_fds, 0, &tv);
+    /* 等待到最近一个定时器到期, 跨线程事件通过事件通知管道唤醒 */
+    tv.tv_sec  = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    error = select((int)max_fd + 1, &impl->read_fds, &impl->send_fds, 0, (timeout < 0) ? 0 : &tv);
     if (0 > error) {
+#if !(defined(WIN32) || defined(WIN64))
+        if (errno == EINTR) {
+            /* 被信号中断 */
+            FD_ZERO(&impl->read_fds);
+            FD_ZERO(&impl->send_fds);
+            return error_ok;
+        }
+#endif /* !(defined(WIN32) || defined(WIN64)) */
         return error_loop_fail;
     }
     return error_ok;
 }
 
-int knet_impl_run_once(kloop_t* loop) {
-    dlist_node_t* node = 0;
-    dlist_node_t* temp = 0;
+int _select_run_once(kloop_t* loop) {
+    kdlist_node_t* node = 0;
+    kdlist_node_t* temp = 0;
     kchannel_ref_t* channel_ref = 0;
     socket_t fd = 0;
-    time_t ts = time(0);
+    uint64_t ts = 0;
     loop_select_t* impl = (loop_select_t*)knet_loop_get_impl(loop);
-    int error = _select(loop);
+    int error = _select_wait(loop);
     if (error != error_ok) {
         return error;
     }
+    /* 本次迭代的时间戳 */
+    ts = knet_loop_update_time(loop);
+    /* 上一次循环达到读取预算的管道继续读取 */
+    knet_loop_process_ready(loop, ts);
     dlist_for_each_safe(knet_loop_get_active_list(loop), node, temp) {
         channel_ref = (kchannel_ref_t*)dlist_node_get_data(node);
         fd = knet_channel_ref_get_socket_fd(channel_ref);
-        if (FD_ISSET(fd, impl->read_fds)) {
+#if !(defined(WIN32) || defined(WIN64))
+        if (fd >= FD_SETSIZE) {
+            continue;
+        }
+#endif /* !(defined(WIN32) || defined(WIN64)) */
+        if (FD_ISSET(fd, &impl->read_fds)) {
             knet_channel_ref_update(channel_ref, channel_event_recv, ts);
         }
-        if (FD_ISSET(fd, impl->send_fds)) {
+        if (FD_ISSET(fd, &impl->send_fds)) {
             knet_channel_ref_update(channel_ref, channel_event_send, ts);
         }
     }
     knet_loop_check_timeout(loop, ts);
+    /* 发送本次迭代内合并的数据 */
+    knet_loop_process_cork(loop);
     knet_loop_check_close(loop);
     return error_ok;
 }
 
-socket_t knet_impl_channel_accept(kchannel_ref_t* channel_ref) {
-    channel_ref;
+void _select_notify(kloop_t* loop) {
+    knet_loop_notify_channel_send(loop);
+}
+
+socket_t _select_channel_accept(kchannel_ref_t* channel_ref) {
+    (void)channel_ref;
     return 0;
 }
 
-int knet_impl_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
-    channel_ref;
-    e;
+int _select_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    (void)channel_ref;
+    (void)e;
     return error_ok;
 }
 
-int knet_impl_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
-    channel_ref;
-    e;
+int _select_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    (void)channel_ref;
+    (void)e;
     return error_ok;
 }
 
-int knet_impl_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
-    loop;
-    channel_ref;
+int _select_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    (void)loop;
+    (void)channel_ref;
     return error_ok;
 }
 
-int knet_impl_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
-    loop;
-    channel_ref;
+int _select_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    (void)loop;
+    (void)channel_ref;
     return error_ok;
 }
 
-#endif
+loop_backend_t loop_select_backend = {
+    loop_backend_select,
+    "select",
+    _select_create,
+    _select_destroy,
+    _select_run_once,
+    _select_event_add,
+    _select_event_remove,
+    _select_add_channel_ref,
+    _select_remove_channel_ref,
+    _select_notify,
+    _select_channel_accept,
+};
+
+#endif /* LOOP_SELECT */
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if LOOP_URING
+
+#include "loop.h"
+#include "list.h"
+#include "channel_ref.h"
+#include "channel.h"
+#include "logger.h"
+#include "loop_profile.h"
+#include "timer.h"
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <linux/io_uring.h>
+
+/*
+ * io_uring选取器:
+ * 1. 每个套接字同一时间最多只有一个单次poll请求, 完成后按当前事件掩码重新提交, 语义与水平触发相同
+ * 2. 新提交的请求先放在提交队列内, 在下一次io_uring_enter()等待事件时一起提交, 注册事件不需要额外的系统调用
+ * 3. 监听套接字使用multishot accept, 一个请求持续接受新连接, 不支持时回退到poll, 因错误(EMFILE等)结束时延迟重新提交
+ * 4. 请求的user_data为管道节点指针, 低2位为请求类型, 管道销毁后节点保留到所有请求结束
+ */
+
+#define URING_ENTRIES        4096 /* 提交队列长度 */
+#define URING_POLL           0    /* poll请求 */
+#define URING_ACCEPT         1    /* multishot accept请求 */
+#define URING_CANCEL         2    /* 取消请求, 完成事件忽略 */
+#define URING_WAKEUP         3    /* 跨线程唤醒eventfd的poll请求 */
+#define URING_TYPE_MASK      3
+#define URING_ACCEPT_BACKOFF 100  /* multishot accept因错误结束后延迟重新提交的时间(毫秒) */
+
+/**
+ * 管道节点, 保存在管道引用的选取器自定义数据内
+ */
+typedef struct _uring_node_t {
+    kchannel_ref_t* channel_ref;  /* 管道引用, 0表示管道已经销毁, 等待未完成的请求结束 */
+    kdlist_node_t*  list_node;    /* 节点链表节点 */
+    uint32_t        mask;         /* 期望的poll事件掩码 */
+    uint32_t        poll_mask;    /* 未完成的poll请求的事件掩码, 0表示没有poll请求 */
+    int             cancelling;   /* 未完成的poll请求正在被取消 */
+    int             accepting;    /* 是否有未完成的multishot accept请求 */
+    ktimer_t*       accept_timer; /* 延迟重新提交multishot accept的定时器 */
+} uring_node_t;
+
+typedef struct _loop_uring_t {
+    int                   ring_fd;          /* io_uring描述符 */
+    int                   event_fd;         /* 跨线程事件唤醒描述符 */
+    int                   wakeup_polling;   /* 唤醒描述符是否有未完成的poll请求 */
+    int                   accept_multishot; /* 是否支持multishot accept */
+    socket_t              accept_fd;        /* multishot accept接受的套接字, 由_uring_channel_accept取走 */
+    kdlist_t*             node_list;        /* 所有管道节点 */
+    void*                 sq_ptr;           /* 提交队列映射 */
+    size_t                sq_size;          /* 提交队列映射长度 */
+    void*                 cq_ptr;           /* 完成队列映射 */
+    size_t                cq_size;          /* 完成队列映射长度 */
+    struct io_uring_sqe*  sqes;             /* 提交队列元素数组 */
+    unsigned*             sq_head;          /* 提交队列头, 内核更新 */
+    unsigned*             sq_tail;          /* 提交队列尾 */
+    unsigned*             sq_mask;          /* 提交队列掩码 */
+    unsigned*             sq_array;         /* 提交队列索引数组 */
+    unsigned              sq_entries;       /* 提交队列长度 */
+    unsigned              to_submit;        /* 未提交的请求数量 */
+    unsigned*             cq_head;          /* 完成队列头 */
+    unsigned*             cq_tail;          /* 完成队列尾, 内核更新 */
+    unsigned*             cq_mask;          /* 完成队列掩码 */
+    struct io_uring_cqe*  cqes;             /* 完成队列元素数组 */
+} loop_uring_t;
+
+int _uring_setup(loop_uring_t* impl) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    impl->ring_fd = (int)syscall(__NR_io_uring_setup, URING_ENTRIES, &params);
+    if (impl->ring_fd < 0) {
+        return 1;
+    }
+    /* 需要带超时的等待(IORING_FEAT_EXT_ARG, 5.11) */
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)) {
+        close(impl->ring_fd);
+        return 1;
+    }
+    impl->sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    impl->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (impl->cq_size > impl->sq_size) {
+            impl->sq_size = impl->cq_size;
+        }
+        impl->cq_size = 0;
+    }
+    impl->sq_ptr = mmap(0, impl->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        impl->ring_fd, IORING_OFF_SQ_RING);
+    if (impl->sq_ptr == MAP_FAILED) {
+        close(impl->ring_fd);
+        return 1;
+    }
+    impl->cq_ptr = impl->sq_ptr;
+    if (impl->cq_size) {
+        impl->cq_ptr = mmap(0, impl->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            impl->ring_fd, IORING_OFF_CQ_RING);
+        if (impl->cq_ptr == MAP_FAILED) {
+            munmap(impl->sq_ptr, impl->sq_size);
+            close(impl->ring_fd);
+            return 1;
+        }
+    }
+    impl->sqes = (struct io_uring_sqe*)mmap(0, params.sq_entries * sizeof(struct io_uring_sqe),
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->ring_fd, IORING_OFF_SQES);
+    if (impl->sqes == MAP_FAILED) {
+        if (impl->cq_size) {
+            munmap(impl->cq_ptr, impl->cq_size);
+        }
+        munmap(impl->sq_ptr, impl->sq_size);
+        close(impl->ring_fd);
+        return 1;
+    }
+    impl->sq_head    = (unsigned*)((char*)impl->sq_ptr + params.sq_off.head);
+    impl->sq_tail    = (unsigned*)((char*)impl->sq_ptr + params.sq_off.tail);
+    impl->sq_mask    = (unsigned*)((char*)impl->sq_ptr + params.sq_off.ring_mask);
+    impl->sq_array   = (unsigned*)((char*)impl->sq_ptr + params.sq_off.array);
+    impl->sq_entries = params.sq_entries;
+    impl->cq_head    = (unsigned*)((char*)impl->cq_ptr + params.cq_off.head);
+    impl->cq_tail    = (unsigned*)((char*)impl->cq_ptr + params.cq_off.tail);
+    impl->cq_mask    = (unsigned*)((char*)impl->cq_ptr + params.cq_off.ring_mask);
+    impl->cqes       = (struct io_uring_cqe*)((char*)impl->cq_ptr + params.cq_off.cqes);
+    return 0;
+}
+
+void _uring_teardown(loop_uring_t* impl) {
+    munmap(impl->sqes, impl->sq_entries * sizeof(struct io_uring_sqe));
+    if (impl->cq_size) {
+        munmap(impl->cq_ptr, impl->cq_size);
+    }
+    munmap(impl->sq_ptr, impl->sq_size);
+    close(impl->ring_fd);
+}
+
+/**
+ * 提交队列内的请求并等待完成事件
+ * @param impl loop_uring_t实例
+ * @param wait 非零时至少等待一个完成事件
+ * @param timeout 等待时间(毫秒), -1为无限等待
+ * @retval error_ok 成功
+ * @retval 其他 失败
+ */
+int _uring_enter(loop_uring_t* impl, int wait, int timeout) {
+    int                            ret   = 0;
+    unsigned                       flags = IORING_ENTER_EXT_ARG;
+    struct __kernel_timespec       ts;
+    struct io_uring_getevents_arg  arg;
+    if (!wait && !impl->to_submit) {
+        return error_ok;
+    }
+    memset(&arg, 0, sizeof(arg));
+    if (wait) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeout >= 0) {
+            ts.tv_sec  = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000;
+            arg.ts     = (uint64_t)(uintptr_t)&ts;
+        }
+    }
+    ret = (int)syscall(__NR_io_uring_enter, impl->ring_fd, impl->to_submit, wait ? 1 : 0,
+        flags, &arg, sizeof(arg));
+    if (ret < 0) {
+        if ((errno == ETIME) || (errno == EINTR) || (errno == EBUSY) || (errno == EAGAIN)) {
+            /* 超时, 被信号中断, 或者完成队列已满需要先处理 */
+            return error_ok;
+        }
+        return error_loop_fail;
+    }
+    impl->to_submit -= ((unsigned)ret > impl->to_submit) ? impl->to_submit : (unsigned)ret;
+    return error_ok;
+}
+
+/**
+ * 取得一个空闲的提交队列元素, 队列满时先提交
+ */
+struct io_uring_sqe* _uring_get_sqe(kloop_t* loop, loop_uring_t* impl) {
+    struct io_uring_sqe* sqe  = 0;
+    unsigned             tail = *impl->sq_tail;
+    if (tail - __atomic_load_n(impl->sq_head, __ATOMIC_ACQUIRE) >= impl->sq_entries) {
+        /* 提交队列已满, 需要额外的系统调用 */
+        knet_loop_profile_increase_impl_ctl_count(knet_loop_get_profile(loop));
+        _uring_enter(impl, 0, 0);
+        if (tail - __atomic_load_n(impl->sq_head, __ATOMIC_ACQUIRE) >= impl->sq_entries) {
+            return 0;
+        }
+    }
+    sqe = &impl->sqes[tail & *impl->sq_mask];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    return sqe;
+}
+
+/**
+ * 将填写完成的提交队列元素放入队列, 在下一次_uring_enter时提交
+ */
+void _uring_push_sqe(loop_uring_t* impl) {
+    unsigned tail = *impl->sq_tail;
+    impl->sq_array[tail & *impl->sq_mask] = tail & *impl->sq_mask;
+    __atomic_store_n(impl->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    impl->to_submit++;
+}
+
+void _uring_prep(kloop_t* loop, loop_uring_t* impl, uint8_t opcode, int fd, uint64_t addr, uint32_t events, uint64_t user_data) {
+    struct io_uring_sqe* sqe = _uring_get_sqe(loop, impl);
+    if (!sqe) {
+        log_error("io_uring submission queue full, opcode: %d", opcode);
+        return;
+    }
+    sqe->opcode        = opcode;
+    sqe->fd            = fd;
+    sqe->addr          = addr;
+    sqe->poll32_events = events;
+    sqe->user_data     = user_data;
+    _uring_push_sqe(impl);
+}
+
+void _uring_poll_wakeup(kloop_t* loop, loop_uring_t* impl) {
+    if (impl->wakeup_polling) {
+        return;
+    }
+    impl->wakeup_polling = 1;
+    _uring_prep(loop, impl, IORING_OP_POLL_ADD, impl->event_fd, 0, POLLIN, URING_WAKEUP);
+}
+
+void _uring_accept(kloop_t* loop, loop_uring_t* impl, uring_node_t* node) {
+    struct io_uring_sqe* sqe = 0;
+    if (node->accepting) {
+        return;
+    }
+    sqe = _uring_get_sqe(loop, impl);
+    if (!sqe) {
+        return;
+    }
+    node->accepting   = 1;
+    sqe->opcode       = IORING_OP_ACCEPT;
+    sqe->fd           = knet_channel_ref_get_socket_fd(node->channel_ref);
+    sqe->ioprio       = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data    = (uint64_t)(uintptr_t)node | URING_ACCEPT;
+    _uring_push_sqe(impl);
+}
+
+/**
+ * 按当前事件掩码提交poll请求
+ */
+void _uring_arm(kloop_t* loop, loop_uring_t* impl, uring_node_t* node) {
+    if (!node->channel_ref || knet_channel_ref_check_state(node->channel_ref, channel_state_close)) {
+        /* 套接字已经关闭, 不能再提交 */
+        return;
+    }
+    if (node->poll_mask) {
+        if ((node->mask & ~node->poll_mask) && !node->cancelling) {
+            /* 未完成的poll请求不包含新的事件, 取消后按新的掩码重新提交 */
+            node->cancelling = 1;
+            _uring_prep(loop, impl, IORING_OP_POLL_REMOVE, -1, (uint64_t)(uintptr_t)node | URING_POLL, 0, URING_CANCEL);
+        }
+        return;
+    }
+    if (!node->mask) {
+        return;
+    }
+    node->poll_mask = node->mask;
+    _uring_prep(loop, impl, IORING_OP_POLL_ADD, knet_channel_ref_get_socket_fd(node->channel_ref), 0,
+        node->mask, (uint64_t)(uintptr_t)node | URING_POLL);
+}
+
+/**
+ * 取消节点所有未完成的请求, 没有未完成的请求时销毁节点
+ */
+void _uring_release(kloop_t* loop, loop_uring_t* impl, uring_node_t* node) {
+    if (node->accept_timer) {
+        ktimer_stop(node->accept_timer);
+        node->accept_timer = 0;
+    }
+    if (node->poll_mask && !node->cancelling) {
+        node->cancelling = 1;
+        _uring_prep(loop, impl, IORING_OP_POLL_REMOVE, -1, (uint64_t)(uintptr_t)node | URING_POLL, 0, URING_CANCEL);
+    }
+    if (node->accepting) {
+        _uring_prep(loop, impl, IORING_OP_ASYNC_CANCEL, -1, (uint64_t)(uintptr_t)node | URING_ACCEPT, 0, URING_CANCEL);
+    }
+    if (!node->channel_ref && !node->poll_mask && !node->accepting) {
+        dlist_delete(impl->node_list, node->list_node);
+        knet_free(node);
+    }
+}
+
+uring_node_t* _uring_get_node(kchannel_ref_t* channel_ref) {
+    uring_node_t* node = (uring_node_t*)knet_channel_ref_get_data(channel_ref);
+    loop_uring_t* impl = 0;
+    if (node) {
+        return node;
+    }
+    impl = (loop_uring_t*)knet_loop_get_impl(knet_channel_ref_get_loop(channel_ref));
+    node = create(uring_node_t);
+    verify(node);
+    memset(node, 0, sizeof(uring_node_t));
+    node->channel_ref = channel_ref;
+    node->list_node   = dlist_add_tail_node(impl->node_list, node);
+    knet_channel_ref_set_data(channel_ref, node);
+    return node;
+}
+
+int _uring_create(kloop_t* loop) {
+    loop_uring_t* impl = create(loop_uring_t);
+    verify(impl);
+    memset(impl, 0, sizeof(loop_uring_t));
+    if (_uring_setup(impl)) {
+        knet_free(impl);
+        return 1;
+    }
+    impl->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (impl->event_fd < 0) {
+        _uring_teardown(impl);
+        knet_free(impl);
+        return 1;
+    }
+    impl->accept_multishot = 1;
+    impl->node_list        = dlist_create();
+    knet_loop_set_impl(loop, impl);
+    _uring_poll_wakeup(loop, impl);
+    return error_ok;
+}
+
+void _uring_destroy(kloop_t* loop) {
+    kdlist_node_t* node = 0;
+    kdlist_node_t* temp = 0;
+    loop_uring_t*  impl = 0;
+    impl = (loop_uring_t*)knet_loop_get_impl(loop);
+    /* 关闭io_uring描述符会取消所有未完成的请求 */
+    _uring_teardown(impl);
+    close(impl->event_fd);
+    dlist_for_each_safe(impl->node_list, node, temp) {
+        knet_free(dlist_node_get_data(node));
+    }
+    dlist_destroy(impl->node_list);
+    knet_free(impl);
+}
+
+void _uring_complete_poll(kloop_t* loop, loop_uring_t* impl, uring_node_t* node, int res, uint64_t ts) {
+    kchannel_ref_t* channel_ref = node->channel_ref;
+    node->poll_mask  = 0;
+    node->cancelling = 0;
+    if (!channel_ref) {
+        /* 管道已经销毁 */
+        _uring_release(loop, impl, node);
+        return;
+    }
+    if ((res > 0) && (res & POLLERR) && !(res & (POLLHUP | POLLNVAL)) &&
+        (error_ok == knet_channel_ref_update_zerocopy(channel_ref))) {
+        /* 错误队列内是MSG_ZEROCOPY完成通知且SO_ERROR为0, 套接字正常 */
+        res &= ~POLLERR;
+    }
+    if ((res > 0) && (res & (POLLERR | POLLHUP | POLLNVAL))) {
+        if (!knet_channel_ref_check_state(channel_ref, channel_state_active)) {
+            /* 与epoll实现相同, 连接失败或监听出错的套接字不再提交, 由超时处理 */
+            return;
+        }
+        if (res & POLLIN) {
+            /* 先读取对端关闭前发送的数据, 读取失败时进入关闭流程 */
+            knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+        }
+        if (!knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+            /* 套接字出错或已挂断 */
+            knet_channel_ref_close_check_reconnect(channel_ref);
+        }
+        /* 已关闭的管道不会重新提交 */
+        _uring_arm(loop, impl, node);
+        return;
+    }
+    if (res > 0) {
+        if (res & POLLIN) {
+            knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+        }
+        if (res & POLLOUT) {
+            knet_channel_ref_update(channel_ref, channel_event_send, ts);
+        }
+    }
+    /* 单次poll请求, 按当前事件掩码重新提交 */
+    _uring_arm(loop, impl, node);
+}
+
+/**
+ * 延迟重新提交multishot accept的定时器回调
+ */
+void _uring_accept_timer_cb(ktimer_t* timer, void* data) {
+    uring_node_t*   node        = (uring_node_t*)data;
+    kchannel_ref_t* channel_ref = node->channel_ref;
+    kloop_t*        loop        = 0;
+    loop_uring_t*   impl        = 0;
+    (void)timer;
+    /* 单次定时器, 回调返回后由定时器循环销毁 */
+    node->accept_timer = 0;
+    if (!channel_ref || !knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+        return;
+    }
+    loop = knet_channel_ref_get_loop(channel_ref);
+    impl = (loop_uring_t*)knet_loop_get_impl(loop);
+    if (impl->accept_multishot) {
+        _uring_accept(loop, impl, node);
+    }
+}
+
+void _uring_complete_accept(kloop_t* loop, loop_uring_t* impl, uring_node_t* node, int res, uint32_t flags, uint64_t ts) {
+    kchannel_ref_t* channel_ref = node->channel_ref;
+    if (!(flags & IORING_CQE_F_MORE)) {
+        /* multishot accept请求已经结束 */
+        node->accepting = 0;
+    }
+    if (res >= 0) {
+        impl->accept_fd = res;
+        if (channel_ref && knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+            /* knet_channel_ref_update_accept()通过knet_impl_channel_accept()取走套接字 */
+            knet_channel_ref_update(channel_ref, channel_event_recv, ts);
+        }
+        if (impl->accept_fd) {
+            /* 没有被取走 */
+            close(impl->accept_fd);
+            impl->accept_fd = 0;
+        }
+    } else if ((res == -EINVAL) || (res == -EOPNOTSUPP)) {
+        /* 内核不支持multishot accept, 监听套接字改用poll */
+        impl->accept_multishot = 0;
+        if (channel_ref) {
+            node->mask = POLLIN;
+            _uring_arm(loop, impl, node);
+        }
+    } else if (channel_ref && !node->accepting && !node->accept_timer &&
+        knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+        /* EMFILE, ENFILE, ENOBUFS等错误结束了请求, 立即重新提交会再次失败, 延迟后再提交 */
+        node->accept_timer = ktimer_create(knet_loop_get_timer_loop(loop));
+        verify(node->accept_timer);
+        ktimer_start_once(node->accept_timer, _uring_accept_timer_cb, node, URING_ACCEPT_BACKOFF);
+    }
+    if (!channel_ref) {
+        _uring_release(loop, impl, node);
+        return;
+    }
+    if (!node->accepting && !node->accept_timer && impl->accept_multishot &&
+        knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+        /* 重新提交 */
+        _uring_accept(loop, impl, node);
+    }
+}
+
+int _uring_run_once(kloop_t* loop) {
+    int                 i       = 0;
+    int                 error   = error_ok;
+    int                 spin    = 0;
+    int                 timeout = 0;
+    int                 wakeup  = 0;
+    unsigned            head    = 0;
+    struct io_uring_cqe cqe;
+    uring_node_t*       node    = 0;
+    uint64_t            ts      = 0;
+    loop_uring_t*       impl    = 0;
+    impl    = (loop_uring_t*)knet_loop_get_impl(loop);
+    spin    = knet_loop_get_spin_count(loop);
+    timeout = knet_loop_get_wait_timeout(loop);
+    /* 提交队列内的请求同时等待完成事件, 阻塞前先自旋轮询 */
+    error = _uring_enter(impl, 0, 0);
+    for (; (error == error_ok) && timeout && (i < spin); i++) {
+        if (*impl->cq_head != __atomic_load_n(impl->cq_tail, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+    }
+    if ((error == error_ok) && (*impl->cq_head == __atomic_load_n(impl->cq_tail, __ATOMIC_ACQUIRE))) {
+        error = _uring_enter(impl, 1, timeout);
+    }
+    if (error != error_ok) {
+        return error;
+    }
+    /* 本次迭代的时间戳 */
+    ts = knet_loop_update_time(loop);
+    /* 上一次循环达到读取预算的管道继续读取 */
+    knet_loop_process_ready(loop, ts);
+    head = *impl->cq_head;
+    while (head != __atomic_load_n(impl->cq_tail, __ATOMIC_ACQUIRE)) {
+        /* 复制后立即归还完成队列元素, 处理过程中可能提交新的请求 */
+        cqe = impl->cqes[head & *impl->cq_mask];
+        head++;
+        __atomic_store_n(impl->cq_head, head, __ATOMIC_RELEASE);
+        node = (uring_node_t*)(uintptr_t)(cqe.user_data & ~(uint64_t)URING_TYPE_MASK);
+        if (!node) {
+            if ((cqe.user_data & URING_TYPE_MASK) == URING_WAKEUP) {
+                impl->wakeup_polling = 0;
+                wakeup = 1;
+            }
+            continue;
+        }
+        if ((cqe.user_data & URING_TYPE_MASK) == URING_ACCEPT) {
+            _uring_complete_accept(loop, impl, node, cqe.res, cqe.flags, ts);
+        } else {
+            _uring_complete_poll(loop, impl, node, cqe.res, ts);
+        }
+    }
+    if (wakeup) {
+        /* 其他线程唤醒, 读取并清零计数 */
+        uint64_t count = 0;
+        if (read(impl->event_fd, &count, sizeof(count)) < 0) {
+            /* EAGAIN, 已经被读取 */
+        }
+        _uring_poll_wakeup(loop, impl);
+        knet_loop_event_process(loop);
+    }
+    knet_loop_check_timeout(loop, ts);
+    /* 发送本次迭代内合并的数据 */
+    knet_loop_process_cork(loop);
+    knet_loop_check_close(loop);
+    return error_ok;
+}
+
+int _uring_event_add(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    kloop_t*             loop   = 0;
+    loop_uring_t*        impl   = 0;
+    uring_node_t*        node   = 0;
+    knet_channel_event_e events = knet_channel_ref_get_event(channel_ref) | e;
+    loop = knet_channel_ref_get_loop(channel_ref);
+    impl = (loop_uring_t*)knet_loop_get_impl(loop);
+    node = _uring_get_node(channel_ref);
+    if (impl->accept_multishot && knet_channel_ref_check_state(channel_ref, channel_state_accept)) {
+        /* 监听套接字不需要poll */
+        _uring_accept(loop, impl, node);
+        return error_ok;
+    }
+    node->mask = 0;
+    if (events & channel_event_recv) {
+        node->mask |= POLLIN;
+    }
+    if (events & channel_event_send) {
+        node->mask |= POLLOUT;
+    }
+    _uring_arm(loop, impl, node);
+    return error_ok;
+}
+
+int _uring_event_remove(kchannel_ref_t* channel_ref, knet_channel_event_e e) {
+    kloop_t*             loop   = 0;
+    loop_uring_t*        impl   = 0;
+    uring_node_t*        node   = 0;
+    knet_channel_event_e events = knet_channel_ref_get_event(channel_ref) & ~e;
+    node = (uring_node_t*)knet_channel_ref_get_data(channel_ref);
+    if (!node) {
+        return error_ok;
+    }
+    loop = knet_channel_ref_get_loop(channel_ref);
+    impl = (loop_uring_t*)knet_loop_get_impl(loop);
+    if (knet_channel_ref_check_state(channel_ref, channel_state_close)) {
+        /* 套接字即将关闭, 取消所有未完成的请求 */
+        node->mask = 0;
+        _uring_release(loop, impl, node);
+        return error_ok;
+    }
+    /* 未完成的poll请求完成时再按新的掩码提交, 多余的事件由管道过滤 */
+    node->mask = 0;
+    if (events & channel_event_recv) {
+        node->mask |= POLLIN;
+    }
+    if (events & channel_event_send) {
+        node->mask |= POLLOUT;
+    }
+    return error_ok;
+}
+
+void _uring_notify(kloop_t* loop) {
+    uint64_t      count = 1;
+    loop_uring_t* impl  = 0;
+    impl = (loop_uring_t*)knet_loop_get_impl(loop);
+    if (write(impl->event_fd, &count, sizeof(count)) < 0) {
+        /* 计数溢出时loop必然还未读取, 忽略 */
+    }
+}
+
+int _uring_add_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    return error_ok;
+}
+
+int _uring_remove_channel_ref(kloop_t* loop, kchannel_ref_t* channel_ref) {
+    uring_node_t* node = 0;
+    node = (uring_node_t*)knet_channel_ref_get_data(channel_ref);
+    if (!node) {
+        return error_ok;
+    }
+    /* 节点保留到所有未完成的请求结束 */
+    node->channel_ref = 0;
+    node->mask        = 0;
+    knet_channel_ref_set_data(channel_ref, 0);
+    _uring_release(loop, (loop_uring_t*)knet_loop_get_impl(loop), node);
+    return error_ok;
+}
+
+socket_t _uring_channel_accept(kchannel_ref_t* channel_ref) {
+    socket_t      client_fd = 0;
+    loop_uring_t* impl      = 0;
+    impl = (loop_uring_t*)knet_loop_get_impl(knet_channel_ref_get_loop(channel_ref));
+    /* 取走multishot accept接受的套接字 */
+    client_fd       = impl->accept_fd;
+    impl->accept_fd = 0;
+    return client_fd;
+}
+
+loop_backend_t loop_uring_backend = {
+    loop_backend_uring,
+    "io_uring",
+    _uring_create,
+    _uring_destroy,
+    _uring_run_once,
+    _uring_event_add,
+    _uring_event_remove,
+    _uring_add_channel_ref,
+    _uring_remove_channel_ref,
+    _uring_notify,
+    _uring_channel_accept,
+};
+
+#endif /* LOOP_URING */
@@ -22,10 +22,26 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE /* accept4() */
+#endif /* defined(__linux__) && !defined(_GNU_SOURCE) */
+
 #include <stdarg.h>
 #if (!defined(WIN32) && !defined(_WIN64))
     #include <linux/tcp.h> /* TCP_NODELAY */
 #endif /* (!defined(WIN32) && !defined(_WIN64)) */
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/syscall.h> /* SYS_memfd_create */
+#endif /* defined(__linux__) */
+#if defined(__linux__) && defined(SYS_memfd_create)
+    #define MIRROR_MEMORY 1
+    #ifndef MFD_CLOEXEC
+        #define MFD_CLOEXEC 0x0001U
+    #endif /* MFD_CLOEXEC */
+#else
+    #define MIRROR_MEMORY 0
+#endif /* defined(__linux__) && defined(SYS_memfd_create) */
 
 #include "misc.h"
 #include "loop.h"
@@ -35,29 +51,43 @@
 #include "list.h"
 #include "logger.h"
 
-struct _thread_runner_t {
-    knet_thread_func_t func;         /* ̺߳ */
-    void*              params;       /*  */
-    kdlist_t*          multi_params; /*  */
-    volatile int       running;      /* б־ */
-    volatile int       stop;         /* ˳־ */
-    thread_id_t        thread_id;    /* ߳ID */
 #if (defined(WIN32) || defined(_WIN64))
-    HANDLE thread_handle;            /* WIN32߳̾ */
-    DWORD  tls_key;                  /* WIN32 TLS */
+    #include <io.h> /* _lseeki64, _read */
 #else
-    pthread_key_t tls_key;           /* pthread TLS */
+    #include <sys/sendfile.h>
+    #include <linux/errqueue.h> /* sock_extended_err */
 #endif /* defined(WIN32) || defined(_WIN64) */
-};
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    #define SOCKET_ZEROCOPY 1
+#else
+    #define SOCKET_ZEROCOPY 0
+#endif /* defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY) */
 
 typedef enum _loop_type_e {
-    loop_type_loop = 1, /* ѭ */
-    loop_type_timer,    /* ʱѭ */
+    loop_type_loop = 1, /* 网络循环 */
+    loop_type_timer,    /* 定时器循环 */
 } loop_type_e;
 
+struct _thread_runner_t {
+    knet_thread_func_t func;         /* 线程函数 */
+    loop_type_e        type;         /* 线程内运行的循环类型, 0为普通线程函数 */
+    void*              params;       /* 单参数 */
+    kdlist_t*          multi_params; /* 多参数 */
+    volatile int       running;      /* 运行标志 */
+    volatile int       stop;         /* 退出标志 */
+    thread_id_t        thread_id;    /* 线程ID */
+#if (defined(WIN32) || defined(_WIN64))
+    HANDLE thread_handle;            /* WIN32线程句柄 */
+    DWORD  tls_key;                  /* WIN32 TLS键 */
+#else
+    pthread_key_t tls_key;           /* pthread TLS键 */
+#endif /* defined(WIN32) || defined(_WIN64) */
+};
+
 typedef struct _thread_param_t {
-    loop_type_e type; /* ѭ */
-    void*       loop; /* ѭָ */
+    loop_type_e type; /* 循环类型 */
+    void*       loop; /* 循环指针 */
 } thread_param_t;
 
 socket_t socket_create() {
@@ -144,7 +174,7 @@ int socket_bind_and_listen(socket_t socket_fd, const char* ip, int port, int bac
         log_error("bind() failed, system error: %d", sys_get_errno());
         return error_bind_fail;
     }
-    /*  */
+    /* 监听 */
     error = listen(socket_fd, backlog);
     if (error < 0) {
         log_error("listen() failed, system error: %d", sys_get_errno());
@@ -154,20 +184,30 @@ int socket_bind_and_listen(socket_t socket_fd, const char* ip, int port, int bac
 }
 
 socket_t socket_accept(socket_t socket_fd) {
-    socket_t     client_fd = 0; /* ͻ׽ */
+    socket_t     client_fd = 0; /* 客户端套接字 */
     socket_len_t addr_len  = sizeof(struct sockaddr_in);
     struct sockaddr_in sa;
     memset(&sa, 0, sizeof(sa));
-    /* ܿͻ */
+    /* 接受客户端 */
+#if SOCKET_ACCEPT_INHERIT
+    /* 一次系统调用同时设置非阻塞和close-on-exec */
+    client_fd = accept4(socket_fd, (struct sockaddr*)&sa, &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
     client_fd = accept(socket_fd, (struct sockaddr*)&sa, &addr_len);
+#endif /* SOCKET_ACCEPT_INHERIT */
 #if (defined(WIN32) || defined(_WIN64))
     if (INVALID_SOCKET == client_fd) {
-        log_error("accept() failed, system error: %d", sys_get_errno());
+        if (WSAEWOULDBLOCK != WSAGetLastError()) {
+            log_error("accept() failed, system error: %d", sys_get_errno());
+        }
         return 0;
     }
 #else
     if (client_fd < 0) {
-        log_error("accept() failed, system error: %d", sys_get_errno());
+        /* 没有等待的连接不是错误 */
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+            log_error("accept() failed, system error: %d", sys_get_errno());
+        }
         return 0;
     }
 #endif /* defined(WIN32) || defined(_WIN64) */    
@@ -179,6 +219,16 @@ int socket_set_reuse_addr_on(socket_t socket_fd) {
     return setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse_addr , sizeof(reuse_addr));
 }
 
+int socket_set_reuse_port_on(socket_t socket_fd) {
+#if defined(SO_REUSEPORT)
+    int reuse_port = 1;
+    return setsockopt(socket_fd, SOL_SOCKET, SO_REUSEPORT, (char*)&reuse_port , sizeof(reuse_port));
+#else
+    (void)socket_fd;
+    return -1;
+#endif /* defined(SO_REUSEPORT) */
+}
+
 int socket_set_non_blocking_on(socket_t socket_fd) {
 #if (defined(WIN32) || defined(_WIN64))
     u_long nonblocking = 1;
@@ -294,6 +344,332 @@ int socket_send(socket_t socket_fd, const char* data, uint32_t size) {
     return send_bytes;
 }
 
+int socket_sendv(socket_t socket_fd, socket_iovec_t* iov, int count) {
+#if (defined(WIN32) || defined(_WIN64))
+    DWORD send_bytes = 0;
+    DWORD error      = 0;
+    if (SOCKET_ERROR == WSASend(socket_fd, iov, (DWORD)count, &send_bytes, 0, 0, 0)) {
+        error = GetLastError();
+        if ((error == 0) || (error == WSAEINTR) || (error == WSAEINPROGRESS) || (error == WSAEWOULDBLOCK)) {
+            return 0;
+        }
+        log_error("WSASend() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return (int)send_bytes;
+#else
+    int           send_bytes = 0;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = count;
+    send_bytes = (int)sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+    if (send_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("sendmsg() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return send_bytes;
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
+int socket_recvv(socket_t socket_fd, socket_iovec_t* iov, int count) {
+#if (defined(WIN32) || defined(_WIN64))
+    DWORD recv_bytes = 0;
+    DWORD flags      = 0;
+    DWORD error      = 0;
+    if (SOCKET_ERROR == WSARecv(socket_fd, iov, (DWORD)count, &recv_bytes, &flags, 0, 0)) {
+        error = GetLastError();
+        if ((error == 0) || (error == WSAEINTR) || (error == WSAEINPROGRESS) || (error == WSAEWOULDBLOCK)) {
+            return 0;
+        }
+        log_error("WSARecv() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    if (!recv_bytes) {
+        log_error("WSARecv() failed, return 0, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return (int)recv_bytes;
+#else
+    int recv_bytes = (int)readv(socket_fd, iov, count);
+    if (recv_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("readv() failed, system error: %d", sys_get_errno());
+        return -1;
+    } else if (recv_bytes == 0) {
+        log_error("readv() failed, return 0, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return recv_bytes;
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
+int socket_sendfile(socket_t socket_fd, int file_fd, uint64_t offset, uint32_t size) {
+#if (defined(WIN32) || defined(_WIN64))
+    char buffer[16384];
+    int  read_bytes = 0;
+    if (size > sizeof(buffer)) {
+        size = sizeof(buffer);
+    }
+    if (_lseeki64(file_fd, (__int64)offset, SEEK_SET) < 0) {
+        return -1;
+    }
+    read_bytes = _read(file_fd, buffer, size);
+    if (read_bytes <= 0) {
+        /* 文件长度不足 */
+        return -1;
+    }
+    /* 未发送的部分下次重新读取 */
+    return socket_send(socket_fd, buffer, (uint32_t)read_bytes);
+#else
+    off_t file_offset = (off_t)offset;
+    int   send_bytes  = (int)sendfile(socket_fd, file_fd, &file_offset, size);
+    if (send_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("sendfile() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    if (send_bytes == 0) {
+        /* 文件长度不足 */
+        return -1;
+    }
+    return send_bytes;
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
+int splice_pipe_create(int pipe_fd[2]) {
+#if defined(__linux__) && defined(SPLICE_F_NONBLOCK)
+    if (pipe2(pipe_fd, O_NONBLOCK | O_CLOEXEC)) {
+        log_error("pipe2() failed, system error: %d", sys_get_errno());
+        pipe_fd[0] = pipe_fd[1] = -1;
+        return -1;
+    }
+    return 0;
+#else
+    pipe_fd[0] = pipe_fd[1] = -1;
+    return -1;
+#endif /* defined(__linux__) && defined(SPLICE_F_NONBLOCK) */
+}
+
+void splice_pipe_close(int pipe_fd[2]) {
+#if defined(__linux__) && defined(SPLICE_F_NONBLOCK)
+    if (pipe_fd[0] >= 0) {
+        close(pipe_fd[0]);
+    }
+    if (pipe_fd[1] >= 0) {
+        close(pipe_fd[1]);
+    }
+#endif /* defined(__linux__) && defined(SPLICE_F_NONBLOCK) */
+    pipe_fd[0] = pipe_fd[1] = -1;
+}
+
+int splice_pipe_read(int pipe_fd[2], char* buffer, uint32_t size) {
+#if defined(__linux__) && defined(SPLICE_F_NONBLOCK)
+    int bytes = 0;
+    if (pipe_fd[0] < 0) {
+        return -1;
+    }
+    bytes = (int)read(pipe_fd[0], buffer, size);
+    if (bytes < 0) {
+        if ((errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("read() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    return bytes;
+#else
+    (void)pipe_fd;
+    (void)buffer;
+    (void)size;
+    return -1;
+#endif /* defined(__linux__) && defined(SPLICE_F_NONBLOCK) */
+}
+
+int socket_splice(int fd_in, int fd_out, uint32_t size) {
+#if defined(__linux__) && defined(SPLICE_F_NONBLOCK)
+    int bytes = (int)splice(fd_in, 0, fd_out, 0, size, SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+    if (bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        log_error("splice() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    if (bytes == 0) {
+        /* 输入已关闭 */
+        return -1;
+    }
+    return bytes;
+#else
+    (void)fd_in;
+    (void)fd_out;
+    (void)size;
+    return -1;
+#endif /* defined(__linux__) && defined(SPLICE_F_NONBLOCK) */
+}
+
+int socket_set_cork(socket_t socket_fd, int on) {
+#if defined(__linux__) && defined(TCP_CORK)
+    return setsockopt(socket_fd, IPPROTO_TCP, TCP_CORK, (char*)&on, sizeof(on));
+#else
+    (void)socket_fd;
+    (void)on;
+    return -1;
+#endif /* defined(__linux__) && defined(TCP_CORK) */
+}
+
+char* mirror_memory_create(uint32_t size) {
+#if MIRROR_MEMORY
+    int   fd   = -1;
+    char* base = 0;
+    if (!size || (size % mirror_memory_get_page_size())) {
+        return 0;
+    }
+    fd = (int)syscall(SYS_memfd_create, "knet_ringbuffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        log_error("memfd_create() failed, system error: %d", sys_get_errno());
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)size)) {
+        log_error("ftruncate() failed, system error: %d", sys_get_errno());
+        close(fd);
+        return 0;
+    }
+    /* 先保留两倍长度的连续地址, 再把memfd映射到前后两半 */
+    base = (char*)mmap(0, (size_t)size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (char*)MAP_FAILED) {
+        log_error("mmap() failed, system error: %d", sys_get_errno());
+        close(fd);
+        return 0;
+    }
+    if ((mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) ||
+        (mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+        log_error("mmap() failed, system error: %d", sys_get_errno());
+        munmap(base, (size_t)size * 2);
+        close(fd);
+        return 0;
+    }
+    /* 映射持有memfd的引用 */
+    close(fd);
+    return base;
+#else
+    (void)size;
+    return 0;
+#endif /* MIRROR_MEMORY */
+}
+
+void mirror_memory_destroy(char* ptr, uint32_t size) {
+#if MIRROR_MEMORY
+    if (ptr) {
+        munmap(ptr, (size_t)size * 2);
+    }
+#else
+    (void)ptr;
+    (void)size;
+#endif /* MIRROR_MEMORY */
+}
+
+uint32_t mirror_memory_get_page_size() {
+#if MIRROR_MEMORY
+    static uint32_t page_size = 0;
+    if (!page_size) {
+        page_size = (uint32_t)sysconf(_SC_PAGESIZE);
+    }
+    return page_size;
+#else
+    return 0;
+#endif /* MIRROR_MEMORY */
+}
+
+int socket_set_zerocopy_on(socket_t socket_fd) {
+#if SOCKET_ZEROCOPY
+    int zerocopy = 1;
+    return setsockopt(socket_fd, SOL_SOCKET, SO_ZEROCOPY, (char*)&zerocopy, sizeof(zerocopy));
+#else
+    (void)socket_fd;
+    return -1;
+#endif /* SOCKET_ZEROCOPY */
+}
+
+int socket_send_zerocopy(socket_t socket_fd, const char* data, uint32_t size, int* zerocopy) {
+#if SOCKET_ZEROCOPY
+    int send_bytes = 0;
+    *zerocopy = 0;
+    send_bytes = (int)send(socket_fd, data, (int)size, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if (send_bytes < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        if (errno == ENOBUFS) {
+            /* 超出可锁定页面的限制(optmem_max), 本次拷贝发送 */
+            return socket_send(socket_fd, data, size);
+        }
+        log_error("send() failed, system error: %d", sys_get_errno());
+        return -1;
+    }
+    /* 发送了数据才会占用完成序号 */
+    *zerocopy = (send_bytes > 0);
+    return send_bytes;
+#else
+    *zerocopy = 0;
+    return socket_send(socket_fd, data, size);
+#endif /* SOCKET_ZEROCOPY */
+}
+
+int socket_recv_zerocopy(socket_t socket_fd, uint32_t* lo, uint32_t* hi, int* copied) {
+#if SOCKET_ZEROCOPY
+    char                      control[128];
+    struct msghdr             msg;
+    struct cmsghdr*           cmsg = 0;
+    struct sock_extended_err* serr = 0;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(socket_fd, &msg, MSG_ERRQUEUE) < 0) {
+        if ((errno == 0) || (errno == EAGAIN ) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return 0;
+        }
+        return -1;
+    }
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_RECVERR)) ||
+            ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR))) {
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_errno == 0) && (serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+                *lo     = serr->ee_info;
+                *hi     = serr->ee_data;
+                *copied = (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+                return 1;
+            }
+        }
+    }
+    return 2;
+#else
+    (void)socket_fd;
+    (void)lo;
+    (void)hi;
+    (void)copied;
+    return 0;
+#endif /* SOCKET_ZEROCOPY */
+}
+
+int socket_get_error(socket_t socket_fd) {
+    int          error = 0;
+    socket_len_t len   = sizeof(error);
+    if (getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, (char*)&error, &len)) {
+        return -1;
+    }
+    return error;
+}
+
 int socket_recv(socket_t socket_fd, char* data, uint32_t size) {
     int recv_bytes = 0;
 #if (defined(WIN32) || defined(_WIN64))
@@ -356,44 +732,44 @@ int socket_pair(socket_t pair[2]) {
     accept_addr.sin_port = htons(port);
     accept_addr.sin_family = AF_INET;
     accept_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    /* ˿ */
+    /* 绑定随机端口 */
     error = bind(accept_sock, (struct sockaddr*)&accept_addr,sizeof(accept_addr));
     while (error) {
         if (WSAEADDRINUSE != GetLastError()) {
             log_error("bind() failed, system error: %d", sys_get_errno());
             goto error_return;
         }
-        /* һ˿ */
+        /* 随机分配一个端口 */
         port = _get_random_port(port_begin, port_gap);
         memset(&accept_addr, 0, sizeof(accept_addr));
         accept_addr.sin_port = htons(port);
         accept_addr.sin_family = AF_INET;
         accept_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-        /* ° */
+        /* 重新绑定 */
         error = bind(accept_sock, (struct sockaddr*)&accept_addr,sizeof(accept_addr));
     }
-    /*  */
+    /* 监听 */
     error = listen(accept_sock, 1);
     if (error) {
         log_error("listen() failed, system error: %d", sys_get_errno());
         goto error_return;
     }
-    /* ȡַ */
+    /* 获取地址 */
     error = getsockname(accept_sock, (struct sockaddr*)&connect_addr, &addr_len);
     if (error) {
         log_error("getsockname() failed, system error: %d", sys_get_errno());
         goto error_return;
     }
-    /* ͻ׽ */
+    /* 建立客户端套接字 */
     pair[0] = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (pair[0] == INVALID_SOCKET) {
         log_error("socket() failed, system error: %d", sys_get_errno());
         goto error_return;
     }
-    /* ÷ */
+    /* 设置非阻塞 */
     ioctlsocket(pair[0], FIONBIO, (u_long*)&flag);
     connect_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-    /*  */
+    /* 建立连接 */
     error = connect(pair[0], (struct sockaddr*)&connect_addr, sizeof(connect_addr));
     if(error < 0) {
         error = WSAGetLastError();
@@ -402,7 +778,7 @@ int socket_pair(socket_t pair[2]) {
             goto error_return;
         }
     }
-    /*  */
+    /* 接受连接 */
     pair[1] = accept(accept_sock, (struct sockaddr*)&accept_addr, &addr_len);
     if(pair[1] == INVALID_SOCKET) {
         log_error("accept() failed, system error: %d", sys_get_errno());
@@ -518,6 +894,33 @@ int atomic_counter_zero(atomic_counter_t* counter) {
     return (*counter == 0);
 }
 
+void* atomic_ptr_exchange(void* volatile* ptr, void* value) {
+#if (defined(WIN32) || defined(_WIN64))
+    return InterlockedExchangePointer(ptr, value);
+#else
+    /* __sync_lock_test_and_set只提供acquire语义, 之前补充一个完整屏障 */
+    __sync_synchronize();
+    return __sync_lock_test_and_set(ptr, value);
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
+void* atomic_ptr_cas(void* volatile* ptr, void* target, void* value) {
+#if (defined(WIN32) || defined(_WIN64))
+    return InterlockedCompareExchangePointer(ptr, value, target);
+#else
+    return __sync_val_compare_and_swap(ptr, target, value);
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
+void* atomic_ptr_get(void* volatile* ptr) {
+#if (defined(WIN32) || defined(_WIN64))
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif /* defined(WIN32) || defined(_WIN64) */
+    return *ptr;
+}
+
 struct _lock_t {
     #if (defined(WIN32) || defined(_WIN64))
         CRITICAL_SECTION lock;
@@ -622,6 +1025,8 @@ void _thread_loop_func(void* params) {
     int error = 0;
     kthread_runner_t* runner = (kthread_runner_t*)params;
     kloop_t* loop = (kloop_t*)runner->params;
+    /* 独占线程, 空闲时阻塞直到定时器到期或被唤醒 */
+    knet_loop_set_dedicated(loop, 1);
     while (thread_runner_check_start(runner)) {
         error = knet_loop_run_once(loop);
         if (error != error_ok) {
@@ -750,6 +1155,7 @@ int thread_runner_start_loop(kthread_runner_t* runner, kloop_t* loop, int stack_
     verify(runner);
     verify(loop);
     runner->params = loop;
+    runner->type = loop_type_loop;
     runner->running = 1;
 #if (defined(WIN32) || defined(_WIN64))
     retval = _beginthread(thread_loop_func_win, stack_size, runner);
@@ -785,6 +1191,7 @@ int thread_runner_start_timer_loop(kthread_runner_t* runner, ktimer_loop_t* time
     verify(runner);
     verify(timer_loop);
     runner->params = timer_loop;
+    runner->type = loop_type_timer;
     runner->running = 1;
 #if (defined(WIN32) || defined(_WIN64))
     retval = _beginthread(thread_timer_loop_func_win, stack_size, runner);
@@ -829,6 +1236,8 @@ int thread_runner_start_multi_loop_varg(kthread_runner_t* runner, int stack_size
             param = create(thread_param_t);
             param->type = loop_type_loop;
             param->loop = va_arg(arg_ptr, kloop_t*);
+            /* 多个循环共用一个线程, 不能无限阻塞在某一个kloop_t内 */
+            knet_loop_set_max_wait((kloop_t*)param->loop, 1);
             dlist_add_tail_node(runner->multi_params, param);
             break;
         case 't':
@@ -871,6 +1280,10 @@ int thread_runner_start_multi_loop_varg(kthread_runner_t* runner, int stack_size
 void thread_runner_stop(kthread_runner_t* runner) {
     verify(runner);
     runner->running = 0;
+    if (runner->type == loop_type_loop) {
+        /* 唤醒阻塞在选取器内的kloop_t */
+        knet_loop_notify((kloop_t*)runner->params);
+    }
 }
 
 thread_id_t thread_runner_get_id(kthread_runner_t* runner) {
@@ -880,7 +1293,7 @@ thread_id_t thread_runner_get_id(kthread_runner_t* runner) {
 
 void thread_runner_join(kthread_runner_t* runner) {
     verify(runner);
-    /* δѾ */
+    /* 建立但未启动或已经结束 */
     if (!runner->thread_id || runner->stop) {
         return;
     }
@@ -985,6 +1398,16 @@ uint64_t time_get_milliseconds() {
 #endif /* defined(WIN32) || defined(_WIN64) */
 }
 
+uint64_t time_get_monotonic_milliseconds() {
+#if (defined(WIN32) || defined(_WIN64))
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000llu + (uint64_t)ts.tv_nsec / 1000000llu;
+#endif /* defined(WIN32) || defined(_WIN64) */
+}
+
 uint64_t time_get_milliseconds_19700101() {
     struct timeval tp;
     time_gettimeofday(&tp, 0);
@@ -1074,9 +1497,9 @@ uint64_t uuid_create() {
         fack_uuid_low = (uint32_t)time_get_microseconds();
     }
     atomic_counter_inc(&fack_uuid_high);
-    uuid = fack_uuid_high; /* 32λ */
+    uuid = fack_uuid_high; /* 高32位 */
     uuid <<= 32;
-    uuid += fack_uuid_low; /* 32λ */
+    uuid += fack_uuid_low; /* 低32位 */
     return uuid;
 }
 
@@ -1131,6 +1554,10 @@ const char* get_channel_cb_event_string(knet_channel_cb_event_e e) {
         return "channel idle timeout because there is no bytes received according to the idle timeout setting";
     case channel_cb_event_connect_timeout:
         return "channel try to connect remote host failed because the connect timeout setting reached";
+    case channel_cb_event_send_high:
+        return "unsent bytes reached the high watermark";
+    case channel_cb_event_drain:
+        return "unsent bytes fell back to the low watermark";
     }
     return "unknown channel callback event";
 }
@@ -1151,6 +1578,10 @@ const char* get_channel_cb_event_name(knet_channel_cb_event_e e) {
         return "channel_cb_event_timeout";
     case channel_cb_event_connect_timeout:
         return "channel_cb_event_connect_timeout";
+    case channel_cb_event_send_high:
+        return "channel_cb_event_send_high";
+    case channel_cb_event_drain:
+        return "channel_cb_event_drain";
     }
     return "unknown channel callback event";
 }
@@ -1332,9 +1763,9 @@ void cond_signal(kcond_t* cond) {
 }
 
 int split(const char* src, char delim, int n, ...) {
-    int   i   = 0; /* ǰָ */
-    int   j   = 0; /* ַ± */
-    char* arg = 0; /* ǰַ */
+    int   i   = 0; /* 当前分割数 */
+    int   j   = 0; /* 字符缓冲区下标 */
+    char* arg = 0; /* 当前字符缓冲区 */
     va_list arg_ptr;
     verify(src);
     verify(n);
@@ -1377,7 +1808,7 @@ int get_host_ip_string(const char* host_name, char* ip, int size) {
     verify(ip);
     verify(size);
     len = strlen(host_name);
-    /* Եļ */
+    /* 错略的检查 */
     for (i = 0; host_name[i]; i++) {
         c = host_name[i];
         if ((c != '.') && (!((c >= '0') && (c <= '9')))) {
@@ -1386,7 +1817,7 @@ int get_host_ip_string(const char* host_name, char* ip, int size) {
         }
     }
     if (stop) {
-        /* ȫΪIP */
+        /* 全数字认为是IP */
         if (len > size) {
             return error_getaddrinfo_fail;
         }
@@ -1469,13 +1900,13 @@ long long knet_atoll(const char *p) {
 }
 #endif /* defined(WIN32) && !defined(atoll) */
 
-/*! mallocָ  */
+/*! malloc函数指针  */
 knet_malloc_func_t _knet_malloc_func = malloc;
 
-/*! reallocָ  */
+/*! realloc函数指针  */
 knet_realloc_func_t _knet_realloc_func = realloc;
 
-/*! freeָ  */
+/*! free函数指针  */
 knet_free_func_t _knet_free_func = free;
 
 void knet_set_malloc_func(knet_malloc_func_t func) {
@@ -30,136 +30,324 @@
 #include "thread_api.h"
 #include "misc_api.h"
 
+#if !defined(WIN32) && !defined(_WIN64)
+    #include <sys/socket.h> /* SOCK_NONBLOCK, SOCK_CLOEXEC */
+    #include <sys/uio.h>    /* struct iovec */
+#endif /* !defined(WIN32) && !defined(_WIN64) */
+
 /**
- * һ׽
- * @return ׽
+ * 建立一个套接字
+ * @return 套接字
  */
 socket_t socket_create();
 
 /**
- * 첽connect
- * @param socket_fd ׽
+ * 发起异步connect
+ * @param socket_fd 套接字
  * @param ip IP
- * @param port ˿
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int socket_connect(socket_t socket_fd, const char* ip, int port);
 
 /**
  * bind & listen
- * @param socket_fd ׽
+ * @param socket_fd 套接字
  * @param ip IP
- * @param port ˿
- * @param backlog listen()
- * @retval error_ok ɹ
- * @retval  ʧ
+ * @param port 端口
+ * @param backlog 函数listen()参数
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int socket_bind_and_listen(socket_t socket_fd, const char* ip, int port, int backlog);
 
+/*
+ * Linux下使用accept4()接受连接, 返回的套接字已经是非阻塞的,
+ * TCP_NODELAY, SO_LINGER, SO_KEEPALIVE从监听套接字继承, 不需要再逐个设置
+ */
+#if defined(__linux__) && defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+    #define SOCKET_ACCEPT_INHERIT 1
+#else
+    #define SOCKET_ACCEPT_INHERIT 0
+#endif /* defined(__linux__) && defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC) */
+
 /**
  * accept
- * @param socket_fd ׽
- * @retval 0 ʧ
- * @retval Ч׽
+ * @param socket_fd 套接字
+ * @retval 0 失败或没有等待的连接
+ * @retval 有效的套接字, SOCKET_ACCEPT_INHERIT为1时已经是非阻塞的
  */
 socket_t socket_accept(socket_t socket_fd);
 
 /**
- * ر׽֣ǿƹرգ
- * @param socket_fd ׽
- * @retval 0 ɹ
- * @retval  ʧ
+ * 关闭套接字（强制关闭）
+ * @param socket_fd 套接字
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_close(socket_t socket_fd);
 
 /**
- * ַ
+ * 开启地址重用
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_reuse_addr_on(socket_t socket_fd);
 
 /**
- * ׽ַ
+ * 开启端口重用(SO_REUSEPORT), 多个套接字可以监听同一端口, 由内核分配连接
+ * @param socket_fd
+ * @retval 0 成功
+ * @retval 其他 失败或者系统不支持
+ */
+int socket_set_reuse_port_on(socket_t socket_fd);
+
+/**
+ * 开启套接字非阻塞
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_non_blocking_on(socket_t socket_fd);
 
 /**
- * رnagle㷨
+ * 关闭nagle算法
  *
- * ݸı
+ * 让数据更快的被发送
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_nagle_off(socket_t socket_fd);
 
 /**
- * رlinger
+ * 关闭linger
  *
- * ѹرյĶ˿ڽTIME_WAIT״̬
+ * 避免已关闭的端口进入TIME_WAIT状态
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_linger_off(socket_t socket_fd);
 
 /**
- * رkeep-alive
+ * 关闭keep-alive
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_keepalive_off(socket_t socket_fd);
 
 /**
- * SO_DONTROUTEδʹ
+ * 开启SO_DONTROUTE，未使用
  * @param socket_fd
- * @retval 0 ɹ
- * @retval  ʧ
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_donot_route_on(socket_t socket_fd);
 
 /**
- * ýջС
+ * 设置接收缓冲区大小
  * @param socket_fd
- * @param size ջС
- * @retval 0 ɹ
- * @retval  ʧ
+ * @param size 接收缓冲区大小
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_recv_buffer_size(socket_t socket_fd, int size);
 
 /**
- * ÷ͻС
+ * 设置发送缓冲区大小
  * @param socket_fd
- * @param size ͻС
- * @retval 0 ɹ
- * @retval  ʧ
+ * @param size 发送缓冲区大小
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 int socket_set_send_buffer_size(socket_t socket_fd, int size);
 
 /**
- * 
+ * 发送
  * @param socket_fd
- * @param data ָ
- * @param size ݳ
- * @retval >0 ɹ
- * @retval  ʧ
+ * @param data 数据指针
+ * @param size 数据长度
+ * @retval >0 成功
+ * @retval 其他 失败
  */
 int socket_send(socket_t socket_fd, const char* data, uint32_t size);
 
+/*
+ * 聚集发送的缓冲区描述, 单次最多SOCKET_IOV_MAX个
+ */
+#if (defined(WIN32) || defined(_WIN64))
+    typedef WSABUF socket_iovec_t;
+    #define socket_iovec_set(iov, ptr, size) ((iov)->buf = (char*)(ptr), (iov)->len = (ULONG)(size))
+    #define SOCKET_IOV_MAX 64
+#else
+    typedef struct iovec socket_iovec_t;
+    #define socket_iovec_set(iov, ptr, size) ((iov)->iov_base = (void*)(ptr), (iov)->iov_len = (size_t)(size))
+    #if defined(IOV_MAX) && (IOV_MAX < 1024)
+        #define SOCKET_IOV_MAX IOV_MAX
+    #else
+        #define SOCKET_IOV_MAX 1024
+    #endif /* defined(IOV_MAX) && (IOV_MAX < 1024) */
+#endif /* defined(WIN32) || defined(_WIN64) */
+
+/**
+ * 聚集发送, 一次系统调用发送多个缓冲区
+ * @param socket_fd
+ * @param iov 缓冲区数组
+ * @param count 缓冲区数量, 最多SOCKET_IOV_MAX个
+ * @retval >0 成功发送的字节数
+ * @retval 0 套接字不可写
+ * @retval <0 失败
+ */
+int socket_sendv(socket_t socket_fd, socket_iovec_t* iov, int count);
+
+/**
+ * 分散接收, 一次系统调用填充多个缓冲区
+ * @param socket_fd
+ * @param iov 缓冲区数组
+ * @param count 缓冲区数量, 最多SOCKET_IOV_MAX个
+ * @retval >0 成功接收的字节数
+ * @retval 0 套接字不可读
+ * @retval <0 失败或对端关闭
+ */
+int socket_recvv(socket_t socket_fd, socket_iovec_t* iov, int count);
+
 /**
- * 
+ * 从文件发送到套接字
+ *
+ * Linux使用sendfile(), 数据不经过用户内存; 其他系统读入栈上的临时缓冲区后发送
  * @param socket_fd
- * @param data ջָ
- * @param size ջ峤
- * @retval >0 ɹ
- * @retval  ʧ
+ * @param file_fd 文件描述符
+ * @param offset 文件内起始位置
+ * @param size 最多发送的字节数
+ * @retval >0 成功发送的字节数
+ * @retval 0 套接字不可写
+ * @retval <0 失败, 包括文件长度不足
+ */
+int socket_sendfile(socket_t socket_fd, int file_fd, uint64_t offset, uint32_t size);
+
+/**
+ * 建立splice()使用的非阻塞管道
+ * @param pipe_fd 返回管道读/写描述符
+ * @retval 0 成功
+ * @retval 其他 失败或系统不支持
+ */
+int splice_pipe_create(int pipe_fd[2]);
+
+/**
+ * 关闭splice()使用的管道
+ * @param pipe_fd 管道读/写描述符
+ */
+void splice_pipe_close(int pipe_fd[2]);
+
+/**
+ * 从splice()使用的管道读取数据到用户内存
+ * @param pipe_fd 管道读/写描述符
+ * @param buffer 缓冲区
+ * @param size 缓冲区长度
+ * @retval >0 读取的字节数
+ * @retval 0 管道内没有数据
+ * @retval <0 失败
+ */
+int splice_pipe_read(int pipe_fd[2], char* buffer, uint32_t size);
+
+/**
+ * 在两个描述符之间移动数据, 其中一个必须是管道, 数据不经过用户内存
+ * @param fd_in 输入描述符
+ * @param fd_out 输出描述符
+ * @param size 最多移动的字节数
+ * @retval >0 移动的字节数
+ * @retval 0 输入没有数据或输出不可写
+ * @retval <0 失败或输入已关闭
+ */
+int socket_splice(int fd_in, int fd_out, uint32_t size);
+
+/**
+ * 开启或关闭TCP_CORK, 开启期间不发送未满的报文段, 关闭时立即发送
+ * @param socket_fd
+ * @param on 非零开启, 零关闭
+ * @retval 0 成功
+ * @retval 其他 失败或系统不支持
+ */
+int socket_set_cork(socket_t socket_fd, int on);
+
+/**
+ * 建立双重映射的内存
+ * <pre>
+ * 同一块memfd内存映射到相邻的两段虚拟地址, [ptr, ptr + size)与[ptr + size, ptr + 2 * size)
+ * 访问相同的物理内存, 从任意位置开始连续访问size字节都不需要绕回
+ * </pre>
+ * @param size 长度, 必须是页长度的整数倍
+ * @return 起始地址, 失败或系统不支持时返回0
+ */
+char* mirror_memory_create(uint32_t size);
+
+/**
+ * 销毁双重映射的内存
+ * @param ptr mirror_memory_create()返回的起始地址
+ * @param size 建立时的长度
+ */
+void mirror_memory_destroy(char* ptr, uint32_t size);
+
+/**
+ * 取得双重映射内存的页长度
+ * @return 页长度, 系统不支持时返回0
+ */
+uint32_t mirror_memory_get_page_size();
+
+/**
+ * 开启套接字的MSG_ZEROCOPY支持(SO_ZEROCOPY)
+ * @param socket_fd
+ * @retval 0 成功
+ * @retval 其他 失败或系统不支持
+ */
+int socket_set_zerocopy_on(socket_t socket_fd);
+
+/**
+ * 使用MSG_ZEROCOPY发送, 内核锁定data所在页面直到通过错误队列通知完成
+ *
+ * 内核无法锁定页面(ENOBUFS)或系统不支持时退化为普通发送
+ * @param socket_fd
+ * @param data 数据指针
+ * @param size 数据长度
+ * @param zerocopy 返回非零表示本次发送使用了MSG_ZEROCOPY, 占用一个完成通知序号
+ * @retval >0 成功发送的字节数
+ * @retval 0 套接字不可写
+ * @retval <0 失败
+ */
+int socket_send_zerocopy(socket_t socket_fd, const char* data, uint32_t size, int* zerocopy);
+
+/**
+ * 从套接字错误队列读取一条MSG_ZEROCOPY完成通知
+ * @param socket_fd
+ * @param lo 返回完成的起始序号
+ * @param hi 返回完成的结束序号(包含)
+ * @param copied 返回非零表示内核实际拷贝了数据
+ * @retval 1 读取到完成通知
+ * @retval 2 读取到其他错误队列消息, 忽略
+ * @retval 0 错误队列为空
+ * @retval <0 失败
+ */
+int socket_recv_zerocopy(socket_t socket_fd, uint32_t* lo, uint32_t* hi, int* copied);
+
+/**
+ * 取得并清除套接字上的错误(SO_ERROR)
+ * @param socket_fd
+ * @retval 0 没有错误
+ * @retval 其他 系统错误码
+ */
+int socket_get_error(socket_t socket_fd);
+
+/**
+ * 接收
+ * @param socket_fd
+ * @param data 接收缓冲区指针
+ * @param size 接收缓冲长度
+ * @retval >0 成功
+ * @retval 其他 失败
  */
 int socket_recv(socket_t socket_fd, char* data, uint32_t size);
 
@@ -182,10 +370,34 @@ int socket_getpeername(kchannel_ref_t* channel_ref, kaddress_t* address);
 int socket_getsockname(kchannel_ref_t* channel_ref, kaddress_t* address);
 
 /**
- * ׽Ƿд
- * @retval 0 д
- * @retval 1 д
+ * 检查套接字是否可写
+ * @retval 0 不可写
+ * @retval 1 可写
  */
 int socket_check_send_ready(socket_t socket_fd);
 
+/**
+ * 原子操作 - 交换指针(完整内存屏障)
+ * @param ptr 指针地址
+ * @param value 新值
+ * @return 交换前的值
+ */
+void* atomic_ptr_exchange(void* volatile* ptr, void* value);
+
+/**
+ * 原子操作 - 比较并交换指针(完整内存屏障)
+ * @param ptr 指针地址
+ * @param target 比较值
+ * @param value 当前值等于target时设置的新值
+ * @return 交换前的值, 等于target时交换成功
+ */
+void* atomic_ptr_cas(void* volatile* ptr, void* target, void* value);
+
+/**
+ * 原子操作 - 读取指针(完整内存屏障)
+ * @param ptr 指针地址
+ * @return 指针值
+ */
+void* atomic_ptr_get(void* volatile* ptr);
+
 #endif /* MISC_H */
@@ -28,17 +28,22 @@
 #include "config.h"
 
 /**
- * ȡǰ
+ * 获取当前毫秒
  */
 extern uint64_t time_get_milliseconds();
 
 /**
- * ȡǰ΢
+ * 获取当前微秒
  */
 extern uint64_t time_get_microseconds();
 
 /**
- * ȡ197011յڵĺ
+ * 获取单调时钟毫秒数, 不受系统时间调整影响
+ */
+extern uint64_t time_get_monotonic_milliseconds();
+
+/**
+ * 获取自1970年1月1日到现在的毫秒数
  */
 extern uint64_t time_get_milliseconds_19700101();
 
@@ -55,45 +60,45 @@ extern void knet_localtime(struct tm* tm, const time_t* time);
 extern int time_gettimeofday(struct timeval *tp, void *tzp);
 
 /**
- * ȡõǰĶʱַ
- * @param buffer 
- * @param size С
- * @return ʽΪYYYY-MM-DD HH:mm:SS:MS
+ * 取得当前可阅读时间字符串
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 格式为YYYY-MM-DD HH:mm:SS:MS
  */
 extern char* time_get_string(char* buffer, int size);
 
 /**
- * һαUUIDֻ֤ڲظ
- * @return αUUID
+ * 产生一个伪UUID，只保证本进程内不重复
+ * @return 伪UUID
  */
 extern uint64_t uuid_create();
 
 /**
- * ȡUUID32λ
+ * 取得UUID高32位
  * @param uuid UUID
- * @return 32λ
+ * @return 高32位
  */
 extern uint32_t uuid_get_high32(uint64_t uuid);
 
 /**
- * ȡõǰĿ¼
- * @param buffer ·ָ
- * @param size С
- * @retval 0 ʧ
- * @retval ·ָ
+ * 取得当前工作目录
+ * @param buffer 路径缓冲区指针
+ * @param size 缓冲区大小
+ * @retval 0 失败
+ * @retval 路径缓冲区指针
  */
 extern char* path_getcwd(char* buffer, int size);
 
 /**
- * ȡµϵͳ
- * @return ϵͳ
+ * 获取最新的系统错误码
+ * @return 系统错误码
  */
 extern sys_error_t sys_get_errno();
 
 /**
- * ֽת - 
- * @param ui64 64λ޷
- * @return 64λ޷
+ * 字节序转换 - 主机序到网络序
+ * @param ui64 64位无符号整数
+ * @return 64位无符号整数
  */
 extern uint64_t knet_htonll(uint64_t ui64);
 
@@ -102,9 +107,9 @@ extern uint64_t knet_htonll(uint64_t ui64);
 #endif /* htonll */
 
 /**
- * ֽת - 
- * @param ui64 64λ޷
- * @return 64λ޷
+ * 字节序转换 - 网络序到主机序
+ * @param ui64 64位无符号整数
+ * @return 64位无符号整数
  */
 extern uint64_t knet_ntohll(uint64_t ui64);
 
@@ -113,62 +118,62 @@ extern uint64_t knet_ntohll(uint64_t ui64);
 #endif /* ntohll */
 
 /**
- * ȡùܵص¼
- * @param e ܵص¼ID
- * @return ܵص¼
+ * 取得管道回调事件描述
+ * @param e 管道回调事件ID
+ * @return 管道回调事件描述
  */
 extern const char* get_channel_cb_event_string(knet_channel_cb_event_e e);
 
 /**
- * ȡùܵص¼
- * @param e ܵص¼ID
- * @return ܵص¼
+ * 取得管道回调事件名字
+ * @param e 管道回调事件ID
+ * @return 管道回调事件名字
  */
 extern const char* get_channel_cb_event_name(knet_channel_cb_event_e e);
 
 /**
- * longתΪchar*
+ * long转为char*
  * @param l long
- * @param buffer 洢תַ
- * @param size 
- * @retval 0 ʧ
- * @retval  ɹ
+ * @param buffer 存储转换的字符串
+ * @param size 缓冲区长度
+ * @retval 0 失败
+ * @retval 其他 成功
  */
 extern char* knet_ltoa(long l, char* buffer, int size);
 
 /**
- * long long תΪchar*
+ * long long 转为char*
  * @param ll long long
- * @param buffer 洢תַ
- * @param size 
- * @retval 0 ʧ
- * @retval  ɹ
+ * @param buffer 存储转换的字符串
+ * @param size 缓冲区长度
+ * @retval 0 失败
+ * @retval 其他 成功
  */
 extern char* knet_lltoa(long long ll, char* buffer, int size);
 
 /**
- * ַָ
- * @param src ַָ
- * @param delim ַָ
- * @param n ָӴ
- * @retval 0 ɹ
- * @retval  ʧ
+ * 分割字符串
+ * @param src 待分割字符串
+ * @param delim 分割字符
+ * @param n 分割后子串数量
+ * @retval 0 成功
+ * @retval 其他 失败
  */
 extern int split(const char* src, char delim, int n, ...);
 
 /**
- * ȡIP
- * @param host_name 
- * @param ip IPַ
- * @param size ػ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 获取主机域名的IP
+ * @param host_name 主机域名
+ * @param ip 返回IP字符串
+ * @param size 返回缓冲区长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int get_host_ip_string(const char* host_name, char* ip, int size);
 
 /**
- * ַתlong long
- * @param p ַ
+ * 字符串转long long
+ * @param p 字符串
  * @return long long
  */
 extern long long knet_atoll(const char *p);
@@ -178,20 +183,20 @@ extern long long knet_atoll(const char *p);
 #endif /* defined(WIN32) && !defined(atoll) */
 
 /**
- * mallocָ
- * @param func ָ
+ * 设置malloc函数指针
+ * @param func 函数指针
  */
 extern void knet_set_malloc_func(knet_malloc_func_t func);
 
 /**
- * reallocָ
- * @param func ָ
+ * 设置realloc函数指针
+ * @param func 函数指针
  */
 extern void knet_set_realloc_func(knet_realloc_func_t func);
 
 /**
- * freeָ
- * @param func ָ
+ * 设置free函数指针
+ * @param func 函数指针
  */
 extern void knet_set_free_func(knet_free_func_t func);
 
@@ -27,77 +27,77 @@
 #include "logger.h"
 
 /*
- * ʵֻ㷨۹ں½
+ * 实现基于算法导论关于红黑树的相关章节
  */
 
 struct _rb_node_t {
-    struct _rb_node_t*        parent; /* ڵ */
-    struct _rb_node_t*        left;   /*  */
-    struct _rb_node_t*        right;  /* Һ */
-    uint64_t                  key;    /* ڵ */
-    void*                     ptr;    /* ڵûָ */
-    rb_color_e                color;  /* ڵɫ */
-    knet_rb_node_destroy_cb_t cb;     /* ٺָ */
+    struct _rb_node_t*        parent; /* 父节点 */
+    struct _rb_node_t*        left;   /* 左孩子 */
+    struct _rb_node_t*        right;  /* 右孩子 */
+    uint64_t                  key;    /* 节点键 */
+    void*                     ptr;    /* 节点用户数据指针 */
+    rb_color_e                color;  /* 节点颜色 */
+    knet_rb_node_destroy_cb_t cb;     /* 销毁函数指针 */
 };
 
 struct _rb_tree_t {
-    krbnode_t* root; /* ڵ */
+    krbnode_t* root; /* 根节点 */
 };
 
 /*
- * ʵֻ㷨۹ں½
+ * 实现基于算法导论关于红黑树的相关章节
  */
 
-/* Χڵ */
+/* 外围节点 */
 static krbnode_t nil_node = { 0, 0, 0, 0, 0, rb_color_black };
 static krbnode_t* nil = &nil_node;
 
 /**
- * ٽڵ㼰ӽڵ
- * @param node ڵ
+ * 销毁节点及其所有子节点
+ * @param node 节点
  */
 void krbnode_destroy_recursive(krbnode_t* node);
 
 /**
- * xڵת
- * @param tree 
- * @param x ڵ
+ * 对x节点左旋转
+ * @param tree 红黑树
+ * @param x 节点
  */
 void krbtree_left_rotate(krbtree_t* tree, krbnode_t* x);
 
 /**
- * xڵת
- * @param tree 
- * @param x ڵ
+ * 对x节点右旋转
+ * @param tree 红黑树
+ * @param x 节点
  */
 void krbtree_right_rotate(krbtree_t* tree, krbnode_t* x);
 
 /**
- * ݶĹڵ,ʹϺĹ
- * @param tree 
- * @param x ²Ľڵ
+ * 根据二叉搜索树的规则插入节点后修正树,使其符合红黑树的规则
+ * @param tree 红黑树
+ * @param x 新插入的节点
  */
 void krbtree_insert_fixup(krbtree_t* tree, krbnode_t* x);
 
 /**
- * ݶĹɾڵ,ʹϺĹ
- * @param tree 
- * @param x ҪɾĽڵ
+ * 根据二叉搜索树的规则删除节点后修正树,使其符合红黑树的规则
+ * @param tree 红黑树
+ * @param x 需要删除的节点
  */
 void krbtree_delete_fixup(krbtree_t* tree, krbnode_t* x);
 
 /**
- * ĳڽڵ
- * @param tree ڵ
- * @param key 
- * @return ڵ
+ * 查找某个子树内节点
+ * @param tree 子树根节点
+ * @param key 键
+ * @return 节点
  */
 krbnode_t* krbnode_find(krbnode_t* tree, uint64_t key);
 
 /**
- * ȡxĺ̽ڵ
- * @param x ڵ
- * @return ڵ
+ * 获取x的后继节点
+ * @param x 节点
+ * @return 节点
  */
 krbnode_t* krbnode_get_successor(krbnode_t* x);
 
@@ -172,7 +172,7 @@ void krbtree_insert(krbtree_t* tree, krbnode_t* z) {
     krbnode_t* x = 0;
     verify(tree);
     verify(z);
-    if (!tree->root) { /* ûκνڵ */
+    if (!tree->root) { /* 没有任何节点 */
         z->color  = rb_color_black;
         z->left   = nil;
         z->right  = nil;
@@ -200,7 +200,7 @@ void krbtree_insert(krbtree_t* tree, krbnode_t* z) {
     } else {
         y->right = z;
     }
-    /*  */
+    /* 调整红黑树 */
     krbtree_insert_fixup(tree, z);
 }
 
@@ -254,7 +254,7 @@ void krbtree_delete(krbtree_t* tree, krbnode_t* z) {
     if (y->color == rb_color_black) {
         krbtree_delete_fixup(tree, x);
     }
-    /*  */
+    /* 销毁 */
     krbnode_destroy(z);
 }
 
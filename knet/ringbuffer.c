@@ -25,31 +25,74 @@
 #include <stdlib.h>
 #include "ringbuffer.h"
 #include "logger.h"
+#include "misc.h"
 
 #ifndef min
 #define min(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
 struct _ringbuffer_t {
-    char*    ptr;                   /* ָ */
-    uint32_t read_pos;              /*  */
-    uint32_t write_pos;             /* д */
-    uint32_t max_size;              /* 󳤶 */
-    uint32_t lock_size;             /*  */
-    uint32_t lock_type;             /* ͣ 1   2 д */
-    uint32_t count;                 /* ɶݳ */
-    uint32_t window_read_lock_size; /* ڶ */
-    uint32_t window_read_pos;       /* ڶλ */
+    char*    ptr;                   /* 缓冲区指针 */
+    uint32_t read_pos;              /* 读索引 */
+    uint32_t write_pos;             /* 写索引 */
+    uint32_t max_size;              /* 最大长度 */
+    uint32_t lock_size;             /* 锁定长度 */
+    uint32_t lock_type;             /* 锁定类型， 1： 读锁定  2： 写锁定 */
+    uint32_t count;                 /* 可读数据长度 */
+    uint32_t window_read_lock_size; /* 窗口读锁定长度 */
+    uint32_t window_read_pos;       /* 窗口读位置 */
+    int      mirror;                /* 缓冲区是否双重映射 */
 };
 
+/**
+ * 从缓冲区pos位置拷贝size字节, 绕回时分两次拷贝
+ * @param rb kringbuffer_t实例
+ * @param pos 缓冲区内的起始位置
+ * @param buffer 目标缓冲区
+ * @param size 长度, 不能大于最大长度
+ */
+void _ringbuffer_copy_out(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size);
+
+/**
+ * 向缓冲区pos位置拷贝size字节, 绕回时分两次拷贝
+ * @param rb kringbuffer_t实例
+ * @param pos 缓冲区内的起始位置
+ * @param buffer 源缓冲区
+ * @param size 长度, 不能大于最大长度
+ */
+void _ringbuffer_copy_in(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size);
+
+void _ringbuffer_copy_out(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size) {
+    uint32_t first = rb->max_size - pos;
+    if (rb->mirror || (size <= first)) {
+        /* 双重映射的缓冲区越过末尾的部分映射到起始 */
+        memcpy(buffer, rb->ptr + pos, size);
+        return;
+    }
+    memcpy(buffer, rb->ptr + pos, first);
+    memcpy(buffer + first, rb->ptr, size - first);
+}
+
+void _ringbuffer_copy_in(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size) {
+    uint32_t first = rb->max_size - pos;
+    if (rb->mirror || (size <= first)) {
+        memcpy(rb->ptr + pos, buffer, size);
+        return;
+    }
+    memcpy(rb->ptr + pos, buffer, first);
+    memcpy(rb->ptr, buffer + first, size - first);
+}
+
 kringbuffer_t* ringbuffer_create(uint32_t size) {
     kringbuffer_t* rb = create(kringbuffer_t);
     verify(rb);
     memset(rb, 0, sizeof(kringbuffer_t));
     rb->lock_type = 0;
     rb->max_size  = size;
-    rb->ptr       = create_raw(size);
-    verify(rb->ptr);
+    if (size) {
+        rb->ptr = create_raw(size);
+        verify(rb->ptr);
+    }
     rb->lock_size = 0;
     rb->read_pos  = 0;
     rb->write_pos = 0;
@@ -57,6 +100,34 @@ kringbuffer_t* ringbuffer_create(uint32_t size) {
     return rb;
 }
 
+kringbuffer_t* ringbuffer_create_mirror(uint32_t size) {
+    kringbuffer_t* rb        = 0;
+    char*          ptr       = 0;
+    uint32_t       aligned   = 0;
+    uint32_t       page_size = mirror_memory_get_page_size();
+    if (!page_size || (size < page_size) || (size > 0x7fffffff - page_size)) {
+        /* 系统不支持或小于页长度, 使用普通缓冲区 */
+        return ringbuffer_create(size);
+    }
+    /* 向上对齐到页长度 */
+    aligned = (size + page_size - 1) / page_size * page_size;
+    ptr     = mirror_memory_create(aligned);
+    if (!ptr) {
+        /* 映射失败, 普通缓冲区保持调用者指定的长度 */
+        return ringbuffer_create(size);
+    }
+    rb = ringbuffer_create(0);
+    rb->ptr      = ptr;
+    rb->max_size = aligned;
+    rb->mirror   = 1;
+    return rb;
+}
+
+int ringbuffer_check_mirror(kringbuffer_t* rb) {
+    verify(rb);
+    return rb->mirror;
+}
+
 int ringbuffer_eat_all(kringbuffer_t* rb) {
     verify(rb);
     if (rb->lock_size || rb->lock_type) {
@@ -77,123 +148,112 @@ int ringbuffer_eat(kringbuffer_t* rb, uint32_t size) {
     if (size > rb->count) {
         return error_recvbuffer_not_enough;
     }
+    if (!size) {
+        return error_ok;
+    }
     rb->count -= size;
     rb->read_pos = (rb->read_pos + size) % rb->max_size;
     return error_ok;
 }
 
 uint32_t ringbuffer_read(kringbuffer_t* rb, char* buffer, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(buffer);
     verify(size);
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[rb->read_pos];
-        rb->read_pos = (rb->read_pos + 1) % rb->max_size;
+    if (!size) {
+        return 0;
     }
+    _ringbuffer_copy_out(rb, rb->read_pos, buffer, size);
+    rb->read_pos = (rb->read_pos + size) % rb->max_size;
     rb->count -= size;
     return size;
 }
 
 uint32_t ringbuffer_remove(kringbuffer_t* rb, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(size);
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        rb->read_pos = (rb->read_pos + 1) % rb->max_size;
+    if (!size) {
+        return 0;
     }
+    rb->read_pos = (rb->read_pos + size) % rb->max_size;
     rb->count -= size;
     return size;
 }
 
 uint32_t ringbuffer_write(kringbuffer_t* rb, const char* buffer, uint32_t size) {
-    uint32_t i = 0;
     verify(rb);
     verify(buffer);
     verify(size);
-    size = (((rb->max_size - rb->count) > size) ? size : rb->max_size - rb->count);
-    for (; i < size; i++) {
-        rb->ptr[rb->write_pos] = buffer[i];
-        rb->write_pos = (rb->write_pos + 1) % rb->max_size;
+    size = min(rb->max_size - rb->count, size);
+    if (!size) {
+        return 0;
     }
+    _ringbuffer_copy_in(rb, rb->write_pos, buffer, size);
+    rb->write_pos = (rb->write_pos + size) % rb->max_size;
     rb->count += size;
     return size;
 }
 
 uint32_t ringbuffer_replace(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size) {
-    uint32_t i         = 0;
-    uint32_t write_pos = 0;
     verify(rb);
     verify(buffer);
     verify(size);
     if (size > rb->max_size) {
         return 0;
     }
-    write_pos = (rb->read_pos + pos) % rb->max_size;
-    for (; i < size; i++) {
-        rb->ptr[write_pos] = buffer[i];
-        write_pos = (write_pos + 1) % rb->max_size;
-    }
+    _ringbuffer_copy_in(rb, (uint32_t)(((uint64_t)rb->read_pos + pos) % rb->max_size), buffer, size);
     return size;
 }
 
 uint32_t ringbuffer_copy(kringbuffer_t* rb, char* buffer, uint32_t size) {
-    uint32_t i        = 0;
-    uint32_t read_pos = 0;
     verify(rb);
     verify(buffer);
     verify(size);
-    read_pos = rb->read_pos;
     size = min(rb->count, size);
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[read_pos];
-        read_pos = (read_pos + 1) % rb->max_size;
+    if (!size) {
+        return 0;
     }
+    _ringbuffer_copy_out(rb, rb->read_pos, buffer, size);
     return size;
 }
 
 uint32_t ringbuffer_copy_random(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size) {
-    uint32_t i = 0;
-    uint32_t read_pos = 0;
     verify(rb);
-    verify(pos >= 0);
     verify(size);
     verify(buffer);
-    if (pos + size > rb->count) {
+    if ((uint64_t)pos + size > rb->count) {
         return 0;
     }
-    size = min(rb->count - pos, size);
-    read_pos = (rb->read_pos + pos) % rb->max_size;
-    for (; i < size; i++) {
-        buffer[i] = rb->ptr[read_pos];
-        read_pos = (read_pos + 1) % rb->max_size;
-    }
+    _ringbuffer_copy_out(rb, (rb->read_pos + pos) % rb->max_size, buffer, size);
     return size;
 }
 
 uint32_t ringbuffer_find(kringbuffer_t* rb, const char* target, uint32_t* size) {
-    uint32_t i      = 0; /* Ƿﵽĩβ */
-    int      index  = 0; /* ǰƥ䵽ַ± */
-    int      length = 0; /* ܳ */
-    int      pos    = 0; /* rbڵ± */
+    uint32_t i      = 0; /* 是否达到末尾 */
+    int      index  = 0; /* 当前匹配到的字符下标 */
+    int      length = 0; /* 总长度 */
+    int      pos    = 0; /* 在rb内的下标 */
     verify(rb);
     verify(target);
     verify(size);
+    if (ringbuffer_empty(rb)) {
+        return error_ringbuffer_not_found;
+    }
     length = strlen(target);
     pos    = rb->read_pos % rb->max_size;
     for (; (i < rb->count) && (index < length); i++) {
-        if (rb->ptr[pos] == target[index]) { /* ƥ */
-            index += 1;                        /* ǰλõ */
-            pos    = (pos + 1) % rb->max_size; /* rbλõ */
-        } else { /* ʧ */
-            pos   = (rb->read_pos + i + 1) % rb->max_size; /* rbƥλ */
-            index = 0;                                 /* Ŀַ± */
+        if (rb->ptr[pos] == target[index]) { /* 匹配 */
+            index += 1;                        /* 当前位置递增 */
+            pos    = (pos + 1) % rb->max_size; /* rb读位置递增 */
+        } else { /* 失配 */
+            pos   = (rb->read_pos + i + 1) % rb->max_size; /* 重新设置rb匹配位置 */
+            index = 0;                                 /* 重置目标字符串下标 */
         }
     }
     if (index == length) {
-        *size = i; /* ַtarget */
+        *size = i; /* 搜索所经历的所有字符数，包含target */
         return error_ok;
     }
     return error_ringbuffer_not_found;
@@ -206,10 +266,47 @@ uint32_t ringbuffer_available(kringbuffer_t* rb) {
 
 void ringbuffer_destroy(kringbuffer_t* rb) {
     verify(rb);
-    knet_free(rb->ptr);
+    if (rb->mirror) {
+        mirror_memory_destroy(rb->ptr, rb->max_size);
+    } else if (rb->ptr) {
+        knet_free(rb->ptr);
+    }
     knet_free(rb);
 }
 
+int ringbuffer_swap(kringbuffer_t* rb, char* ptr, uint32_t size, char** old) {
+    char*    segment[2];
+    uint32_t length[2];
+    verify(rb);
+    verify(ptr || !size);
+    verify(old);
+    if (rb->mirror) {
+        /* 双重映射的缓冲区不能更换 */
+        return error_ringbuffer_mirror;
+    }
+    if (rb->lock_size || rb->lock_type) {
+        return error_recvbuffer_locked;
+    }
+    if (rb->count > size) {
+        return error_recvbuffer_not_enough;
+    }
+    /* 可读数据拷贝到新缓冲区起始位置 */
+    ringbuffer_read_segments(rb, segment, length);
+    if (length[0]) {
+        memcpy(ptr, segment[0], length[0]);
+    }
+    if (length[1]) {
+        memcpy(ptr + length[0], segment[1], length[1]);
+    }
+    *old                = rb->ptr;
+    rb->ptr             = ptr;
+    rb->max_size        = size;
+    rb->read_pos        = 0;
+    rb->write_pos       = (rb->count < size) ? rb->count : 0;
+    rb->window_read_pos = 0;
+    return error_ok;
+}
+
 uint32_t ringbuffer_read_lock_size(kringbuffer_t* rb) {
     verify(rb);
     if (ringbuffer_empty(rb)) {
@@ -217,7 +314,10 @@ uint32_t ringbuffer_read_lock_size(kringbuffer_t* rb) {
     }
     rb->lock_type = 1;
     rb->lock_size = 0;
-    if (rb->write_pos > rb->read_pos) {
+    if (rb->mirror) {
+        /* 越过末尾的部分映射到缓冲区起始 */
+        rb->lock_size = rb->count;
+    } else if (rb->write_pos > rb->read_pos) {
         rb->lock_size = rb->write_pos - rb->read_pos;
     } else {
         rb->lock_size = rb->max_size - rb->read_pos;
@@ -253,6 +353,27 @@ void ringbuffer_read_unlock(kringbuffer_t* rb) {
     rb->lock_type = 0;
 }
 
+uint32_t ringbuffer_read_segments(kringbuffer_t* rb, char* ptr[2], uint32_t size[2]) {
+    verify(rb);
+    verify(ptr);
+    verify(size);
+    ptr[0]  = ptr[1]  = 0;
+    size[0] = size[1] = 0;
+    if (ringbuffer_empty(rb)) {
+        return 0;
+    }
+    ptr[0] = rb->ptr + rb->read_pos;
+    if (!rb->mirror && (rb->read_pos + rb->count > rb->max_size)) {
+        /* 绕回到缓冲区起始 */
+        size[0] = rb->max_size - rb->read_pos;
+        ptr[1]  = rb->ptr;
+        size[1] = rb->count - size[0];
+    } else {
+        size[0] = rb->count;
+    }
+    return rb->count;
+}
+
 uint32_t ringbuffer_window_read_lock_size(kringbuffer_t* rb) {
     verify(rb);
     if (ringbuffer_empty(rb)) {
@@ -295,7 +416,9 @@ uint32_t ringbuffer_write_lock_size(kringbuffer_t* rb) {
     }
     rb->lock_type = 2;
     rb->lock_size = 0;
-    if (rb->write_pos >= rb->read_pos) {
+    if (rb->mirror) {
+        rb->lock_size = rb->max_size - rb->count;
+    } else if (rb->write_pos >= rb->read_pos) {
         rb->lock_size = rb->max_size - rb->write_pos;
     } else {
         rb->lock_size = rb->read_pos - rb->write_pos;
@@ -311,6 +434,33 @@ char* ringbuffer_write_lock_ptr(kringbuffer_t* rb) {
     return rb->ptr + rb->write_pos;
 }
 
+uint32_t ringbuffer_write_lock_segments(kringbuffer_t* rb, char* ptr[2], uint32_t size[2]) {
+    verify(rb);
+    verify(ptr);
+    verify(size);
+    ptr[0]  = ptr[1]  = 0;
+    size[0] = size[1] = 0;
+    if (ringbuffer_full(rb)) {
+        return 0;
+    }
+    rb->lock_type = 2;
+    ptr[0] = rb->ptr + rb->write_pos;
+    if (rb->mirror) {
+        size[0] = rb->max_size - rb->count;
+    } else if (rb->write_pos >= rb->read_pos) {
+        size[0] = rb->max_size - rb->write_pos;
+        if (rb->read_pos) {
+            /* 绕回到缓冲区起始 */
+            ptr[1]  = rb->ptr;
+            size[1] = rb->read_pos;
+        }
+    } else {
+        size[0] = rb->read_pos - rb->write_pos;
+    }
+    rb->lock_size = size[0] + size[1];
+    return rb->lock_size;
+}
+
 void ringbuffer_write_commit(kringbuffer_t* rb, uint32_t size) {
     verify(rb);
     if (rb->lock_type != 2) {
@@ -29,208 +29,269 @@
 
 
 /**
- * һringbuffer
- * @param size 󳤶
- * @return kringbuffer_tʵ
+ * 建立一个ringbuffer
+ * @param size 最大长度
+ * @return kringbuffer_t实例
  */
 extern kringbuffer_t* ringbuffer_create(uint32_t size);
 
 /**
- * ringbuffer
- * @param rb kringbuffer_tʵ
+ * 建立一个双重映射的ringbuffer
+ * <pre>
+ * 缓冲区通过memfd映射到相邻的两段虚拟地址, 越过末尾的访问落在缓冲区起始,
+ * 可读和可写空间总是连续的一段, ringbuffer_read_segments()等函数不会返回第二段.
+ * 长度向上对齐到页长度, 系统不支持, size小于页长度或映射失败时建立长度为size的普通ringbuffer.
+ * 双重映射的ringbuffer不能通过ringbuffer_swap()更换缓冲区
+ * </pre>
+ * @param size 最大长度
+ * @return kringbuffer_t实例
+ */
+extern kringbuffer_t* ringbuffer_create_mirror(uint32_t size);
+
+/**
+ * 检查是否为双重映射的ringbuffer
+ * @param rb kringbuffer_t实例
+ * @retval 0 普通的ringbuffer
+ * @retval 非零 双重映射
+ */
+extern int ringbuffer_check_mirror(kringbuffer_t* rb);
+
+/**
+ * 销毁ringbuffer
+ * @param rb kringbuffer_t实例
  */
 extern void ringbuffer_destroy(kringbuffer_t* rb);
 
 /**
- * ȡ
- * @param rb kringbuffer_tʵ
- * @param buffer д뻺ָ
- * @param size д뻺
- * @return ʵʶֽ
+ * 更换缓冲区, 用于调整缓冲区长度
+ * <pre>
+ * 可读数据拷贝到新缓冲区的起始位置, 原缓冲区通过old返回并由调用者释放.
+ * ptr为0且size为0时缓冲区不再持有内存, 写入前需要再次调用本函数
+ * </pre>
+ * @param rb kringbuffer_t实例
+ * @param ptr 新缓冲区
+ * @param size 新缓冲区长度, 不能小于可读字节数
+ * @param old 返回原缓冲区, 可能为0
+ * @retval error_ok 成功
+ * @retval 其他 失败, 缓冲区被锁定或者长度不足
+ */
+extern int ringbuffer_swap(kringbuffer_t* rb, char* ptr, uint32_t size, char** old);
+
+/**
+ * 读取并清除
+ * @param rb kringbuffer_t实例
+ * @param buffer 写入缓冲区指针
+ * @param size 写入缓冲区长度
+ * @return 实际读出字节数
  */
 extern uint32_t ringbuffer_read(kringbuffer_t* rb, char* buffer, uint32_t size);
 
 /**
-* 
-* @param rb kringbuffer_tʵ
-* @param size Ҫֽ
-* @return ʵֽ
+* 清除
+* @param rb kringbuffer_t实例
+* @param size 需要清除的字节数
+* @return 实际清除的字节数
 */
 extern uint32_t ringbuffer_remove(kringbuffer_t* rb, uint32_t size);
 
 /**
- * д
- * @param rb kringbuffer_tʵ
- * @param buffer д뻺ָ
- * @param size д뻺
- * @return ʵдֽ
+ * 写入
+ * @param rb kringbuffer_t实例
+ * @param buffer 写入缓冲区指针
+ * @param size 写入缓冲区长度
+ * @return 实际写入字节数
  */
 extern uint32_t ringbuffer_write(kringbuffer_t* rb, const char* buffer, uint32_t size);
 
 /**
- * 滻
- * @param rb kringbuffer_tʵ
- * @param pos 滻ʼλ
- * @param buffer д뻺ָ
- * @param size д뻺
- * @return ʵдֽ
+ * 替换
+ * @param rb kringbuffer_t实例
+ * @param pos 替换的起始位置
+ * @param buffer 写入缓冲区指针
+ * @param size 写入缓冲区长度
+ * @return 实际写入字节数
  */
 extern uint32_t ringbuffer_replace(kringbuffer_t* rb, uint32_t pos, const char* buffer, uint32_t size);
 
 /**
- * ȡ
- * @param rb kringbuffer_tʵ
- * @param buffer д뻺ָ
- * @param size д뻺
- * @return ʵʶֽ
+ * 读取但不清除
+ * @param rb kringbuffer_t实例
+ * @param buffer 写入缓冲区指针
+ * @param size 写入缓冲区长度
+ * @return 实际读出字节数
  */
 extern uint32_t ringbuffer_copy(kringbuffer_t* rb, char* buffer, uint32_t size);
 
 /**
- * ȡ
- * @param rb kringbuffer_tʵ
- * @param pos ȡʼλ
- * @param buffer д뻺ָ
- * @param size д뻺
- * @return ʵдֽ
+ * 随机读取
+ * @param rb kringbuffer_t实例
+ * @param pos 读取的起始位置
+ * @param buffer 写入缓冲区指针
+ * @param size 写入缓冲区长度
+ * @return 实际写入字节数
  */
 extern uint32_t ringbuffer_copy_random(kringbuffer_t* rb, uint32_t pos, char* buffer, uint32_t size);
 
 /**
- * ָĿ꣬λ
- * @param rb kringbuffer_tʵ
- * @param target Ŀַ
- * @param size λ
- * @retval error_ok ҵ
- * @retval  δҵ
+ * 查找指定的目标，并返回位置
+ * @param rb kringbuffer_t实例
+ * @param target 目标字符串
+ * @param size 位置
+ * @retval error_ok 找到
+ * @retval 其他 未找到
  */
 extern uint32_t ringbuffer_find(kringbuffer_t* rb, const char* target, uint32_t* size);
 
 /**
- * ȡÿɶֽ
- * @param rb kringbuffer_tʵ
- * @return ɶֽ
+ * 取得可读字节数
+ * @param rb kringbuffer_t实例
+ * @return 可读字节数
  */
 extern uint32_t ringbuffer_available(kringbuffer_t* rb);
 
 /**
- * пɶֽ
- * @param rb kringbuffer_tʵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 清除所有可读字节
+ * @param rb kringbuffer_t实例
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int ringbuffer_eat_all(kringbuffer_t* rb);
 
 /**
- * ָȵĿɶֽ
- * @param rb kringbuffer_tʵ
- * @param size Ҫĳ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 清除指定长度的可读字节
+ * @param rb kringbuffer_t实例
+ * @param size 需要清除的长度
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int ringbuffer_eat(kringbuffer_t* rb, uint32_t size);
 
 /**
- * ȡ÷ƻַɶֽ
- * @param rb kringbuffer_tʵ
- * @return ƻַɶֽ
+ * 取得非绕回连续地址的最大可读字节数
+ * @param rb kringbuffer_t实例
+ * @return 非绕回连续地址的最大可读字节数
  */
 extern uint32_t ringbuffer_read_lock_size(kringbuffer_t* rb);
 
 /**
- * ȡÿɶָֹ
- * @param rb kringbuffer_tʵ
- * @return ɶָֹ
+ * 取得可读数据起止指针
+ * @param rb kringbuffer_t实例
+ * @return 可读数据起止指针
  */
 extern char* ringbuffer_read_lock_ptr(kringbuffer_t* rb);
 
 /**
- * ύѾֽ
- * @param rb kringbuffer_tʵ
- * @param size Ѿֽ
+ * 提交并清除已经读到的字节
+ * @param rb kringbuffer_t实例
+ * @param size 已经读出的字节数
  */
 extern void ringbuffer_read_commit(kringbuffer_t* rb, uint32_t size);
 
 /**
- * 
- * @param rb kringbuffer_tʵ
+ * 解除读锁定
+ * @param rb kringbuffer_t实例
  */
 extern void ringbuffer_read_unlock(kringbuffer_t* rb);
 
 /**
- * ⴰ - ȡ÷ƻַɶֽ
- * @param rb kringbuffer_tʵ
- * @return ƻַɶֽ
+ * 取得全部可读数据的地址, 读位置绕回时分为两段
+ * <pre>
+ * 不锁定缓冲区, 没有第二段时size[1]为0, 读取完毕后通过ringbuffer_eat清除
+ * </pre>
+ * @param rb kringbuffer_t实例
+ * @param ptr 两段的起始指针
+ * @param size 两段的长度
+ * @return 可读的总长度
+ */
+extern uint32_t ringbuffer_read_segments(kringbuffer_t* rb, char* ptr[2], uint32_t size[2]);
+
+/**
+ * 虚拟窗口 - 取得非绕回连续地址的最大可读字节数
+ * @param rb kringbuffer_t实例
+ * @return 非绕回连续地址的最大可读字节数
  */
 extern uint32_t ringbuffer_window_read_lock_size(kringbuffer_t* rb);
 
 /**
- * ⴰ - ȡÿɶָֹ
- * @param rb kringbuffer_tʵ
- * @return ɶָֹ
+ * 虚拟窗口 - 取得可读数据起止指针
+ * @param rb kringbuffer_t实例
+ * @return 可读数据起止指针
  */
 extern char* ringbuffer_window_read_lock_ptr(kringbuffer_t* rb);
 
 /**
- * ⴰ - ύѾֽڣ
- * @param rb kringbuffer_tʵ
- * @param size Ѿֽ
+ * 虚拟窗口 - 提交已经读到的字节，但不清除
+ * @param rb kringbuffer_t实例
+ * @param size 已经读出的字节数
  */
 extern void ringbuffer_window_read_commit(kringbuffer_t* rb, uint32_t size);
 
 /**
- * ȡ÷ƻؿд󳤶
- * @param rb kringbuffer_tʵ
- * @return ƻؿд󳤶
+ * 取得非绕回可连续写入的最大长度
+ * @param rb kringbuffer_t实例
+ * @return 非绕回可连续写入的最大长度
  */
 extern uint32_t ringbuffer_write_lock_size(kringbuffer_t* rb);
 
 /**
- * ȡÿдʼָ
- * @param rb kringbuffer_tʵ
- * @return дָֹ
+ * 取得可写起始指针
+ * @param rb kringbuffer_t实例
+ * @return 可写起止指针
  */
 extern char* ringbuffer_write_lock_ptr(kringbuffer_t* rb);
 
 /**
- * ύɹдֽ
- * @param rb kringbuffer_tʵ
- * @param size ɹдֽ
+ * 锁定全部可写空间, 写位置绕回时分为两段
+ * <pre>
+ * 第一段从写位置到缓冲区末尾(或读位置), 第二段从缓冲区起始到读位置, 没有第二段时size[1]为0.
+ * 可以一次填充两段后调用ringbuffer_write_commit提交总长度
+ * </pre>
+ * @param rb kringbuffer_t实例
+ * @param ptr 两段的起始指针
+ * @param size 两段的长度
+ * @return 可写入的总长度
+ */
+extern uint32_t ringbuffer_write_lock_segments(kringbuffer_t* rb, char* ptr[2], uint32_t size[2]);
+
+/**
+ * 提交成功写入的字节数
+ * @param rb kringbuffer_t实例
+ * @param size 成功写入的字节数
  */
 extern void ringbuffer_write_commit(kringbuffer_t* rb, uint32_t size);
 
 /**
- * д
- * @param rb kringbuffer_tʵ
+ * 解除写锁定
+ * @param rb kringbuffer_t实例
  */
 extern void ringbuffer_write_unlock(kringbuffer_t* rb);
 
 /**
- * 
- * @param rb kringbuffer_tʵ
- * @retval 0 δ
- * @retval  
+ * 满
+ * @param rb kringbuffer_t实例
+ * @retval 0 未满
+ * @retval 非零 满
  */
 extern int ringbuffer_full(kringbuffer_t* rb);
 
 /**
- * 
- * @param rb kringbuffer_tʵ
- * @retval 0 ǿ
- * @retval  
+ * 空
+ * @param rb kringbuffer_t实例
+ * @retval 0 非空
+ * @retval 非零 空
  */
 extern int ringbuffer_empty(kringbuffer_t* rb);
 
 /**
- * ȡ󳤶
- * @param rb kringbuffer_tʵ
- * @return 󳤶
+ * 取得最大长度
+ * @param rb kringbuffer_t实例
+ * @return 最大长度
  */
 extern uint32_t ringbuffer_get_max_size(kringbuffer_t* rb);
 
 /**
- * ݴӡĻ
- * @param rb kringbuffer_tʵ
+ * 将内容打印到屏幕
+ * @param rb kringbuffer_t实例
  */
 extern void ringbuffer_print_stdout(kringbuffer_t* rb);
 
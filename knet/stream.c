@@ -59,11 +59,55 @@ int knet_stream_pop(kstream_t* stream, void* buffer, int size) {
     verify(buffer);
     verify(size);
     if (0 < ringbuffer_read(knet_channel_ref_get_ringbuffer(stream->channel_ref), (char*)buffer, size)) {
+        knet_channel_ref_resume_recv(stream->channel_ref);
         return error_ok;
     }
     return error_recv_fail;
 }
 
+int knet_stream_peek_iov(kstream_t* stream, kstream_iovec_t iov[2]) {
+    char*    ptr[2];
+    uint32_t size[2];
+    uint32_t bytes = 0;
+    verify(stream);
+    verify(iov);
+    bytes = ringbuffer_read_segments(knet_channel_ref_get_ringbuffer(stream->channel_ref), ptr, size);
+    iov[0].iov_base = ptr[0];
+    iov[0].iov_len  = size[0];
+    iov[1].iov_base = ptr[1];
+    iov[1].iov_len  = size[1];
+    return (int)bytes;
+}
+
+const void* knet_stream_peek(kstream_t* stream, void* buffer, int size) {
+    char*          ptr[2];
+    uint32_t       len[2];
+    kringbuffer_t* rb = 0;
+    verify(stream);
+    verify(buffer);
+    verify(size > 0);
+    rb = knet_channel_ref_get_ringbuffer(stream->channel_ref);
+    if (ringbuffer_read_segments(rb, ptr, len) < (uint32_t)size) {
+        return 0;
+    }
+    if (len[0] >= (uint32_t)size) {
+        /* 未跨越绕回点, 不拷贝 */
+        return ptr[0];
+    }
+    memcpy(buffer, ptr[0], len[0]);
+    memcpy((char*)buffer + len[0], ptr[1], size - len[0]);
+    return buffer;
+}
+
+int knet_stream_consume(kstream_t* stream, int size) {
+    int error = error_ok;
+    verify(stream);
+    verify(size > 0);
+    error = ringbuffer_eat(knet_channel_ref_get_ringbuffer(stream->channel_ref), (uint32_t)size);
+    knet_channel_ref_resume_recv(stream->channel_ref);
+    return error;
+}
+
 int knet_stream_pop_until(kstream_t* stream, const char* end, void* buffer, int* size) {
     uint32_t max_size = 0;
     int      error    = error_ok;
@@ -83,16 +127,22 @@ int knet_stream_pop_until(kstream_t* stream, const char* end, void* buffer, int*
 }
 
 int knet_stream_eat_all(kstream_t* stream) {
+    int error = error_ok;
     verify(stream);
-    return ringbuffer_eat_all(knet_channel_ref_get_ringbuffer(stream->channel_ref));
+    error = ringbuffer_eat_all(knet_channel_ref_get_ringbuffer(stream->channel_ref));
+    knet_channel_ref_resume_recv(stream->channel_ref);
+    return error;
 }
 
 int knet_stream_eat(kstream_t* stream, int size) {
+    int error = error_ok;
     verify(stream);
     if (!size) {
         return error_ok;
     }
-    return ringbuffer_eat(knet_channel_ref_get_ringbuffer(stream->channel_ref), size);
+    error = ringbuffer_eat(knet_channel_ref_get_ringbuffer(stream->channel_ref), size);
+    knet_channel_ref_resume_recv(stream->channel_ref);
+    return error;
 }
 
 int knet_stream_push(kstream_t* stream, const void* buffer, int size) {
@@ -102,6 +152,14 @@ int knet_stream_push(kstream_t* stream, const void* buffer, int size) {
     return knet_channel_ref_write(stream->channel_ref, (char*)buffer, size);
 }
 
+int knet_stream_push_owned(kstream_t* stream, void* buffer, int size, knet_buffer_free_cb_t free_cb) {
+    verify(stream);
+    verify(buffer);
+    verify(size);
+    verify(free_cb);
+    return knet_channel_ref_write_buffer(stream->channel_ref, (char*)buffer, size, free_cb);
+}
+
 int knet_stream_push_varg(kstream_t* stream, const char* format, ...) {
     char buffer[1024] = {0};
     int len           = 0;
@@ -177,7 +235,7 @@ int knet_stream_push_stream(kstream_t* stream, kstream_t* target) {
     }
     rb = knet_channel_ref_get_ringbuffer(stream->channel_ref);
     verify(rb);
-    /* ringbufferȡдһstream */
+    /* 从ringbuffer内取数据写入另一个stream */
     for (size = ringbuffer_read_lock_size(rb);
         (size);
         ringbuffer_read_commit(rb, size), size = ringbuffer_read_lock_size(rb)) {
@@ -185,10 +243,12 @@ int knet_stream_push_stream(kstream_t* stream, kstream_t* target) {
         verify(ptr);
         if (error_ok != knet_stream_push(target, ptr, size)) {
             ringbuffer_read_commit(rb, size);
+            knet_channel_ref_resume_recv(stream->channel_ref);
             return error_send_fail;
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_resume_recv(stream->channel_ref);
     return error_ok;
 }
 
@@ -204,7 +264,7 @@ int knet_stream_push_stream_count(kstream_t* stream, kstream_t* target, int coun
     }
     rb = knet_channel_ref_get_ringbuffer(stream->channel_ref);
     verify(rb);
-    /* ringbufferȡдһstream */
+    /* 从ringbuffer内取数据写入另一个stream */
     for (size = ringbuffer_read_lock_size(rb);
         (size) && (count);
         ringbuffer_read_commit(rb, size), size = ringbuffer_read_lock_size(rb)) {
@@ -216,10 +276,12 @@ int knet_stream_push_stream_count(kstream_t* stream, kstream_t* target, int coun
         verify(ptr);
         if (error_ok != knet_stream_push(target, ptr, size)) {
             ringbuffer_read_commit(rb, size);
+            knet_channel_ref_resume_recv(stream->channel_ref);
             return error_send_fail;
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_resume_recv(stream->channel_ref);
     return error_ok;
 }
 
@@ -234,7 +296,7 @@ int knet_stream_copy_stream(kstream_t* stream, kstream_t* target) {
     }
     rb = knet_channel_ref_get_ringbuffer(stream->channel_ref);
     verify(rb);
-    /* ringbufferȡдһstreamʹⴰڣ */
+    /* 从ringbuffer内取数据写入另一个stream，使用虚拟窗口，不清除数据 */
     for (size = ringbuffer_window_read_lock_size(rb);
         (size);
         ringbuffer_window_read_commit(rb, size), size = ringbuffer_window_read_lock_size(rb)) {
@@ -256,7 +318,7 @@ int knet_stream_drain_ringbuffer(kstream_t* stream, kringbuffer_t* target) {
     verify(target);
     rb = knet_channel_ref_get_ringbuffer(stream->channel_ref);
     verify(rb);
-    /* ringbufferȡдһringbuffer */
+    /* 从ringbuffer内取数据写入另一个ringbuffer */
     for (size = ringbuffer_read_lock_size(rb);
         (size);
         ringbuffer_read_commit(rb, size), size = ringbuffer_read_lock_size(rb)) {
@@ -264,10 +326,12 @@ int knet_stream_drain_ringbuffer(kstream_t* stream, kringbuffer_t* target) {
         verify(ptr);
         if (size != ringbuffer_write(target, ptr, size)) {
             ringbuffer_read_commit(rb, size);
+            knet_channel_ref_resume_recv(stream->channel_ref);
             return error_send_fail;
         }
     }
     ringbuffer_read_unlock(rb);
+    knet_channel_ref_resume_recv(stream->channel_ref);
     return error_ok;
 }
 
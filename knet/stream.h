@@ -29,15 +29,15 @@
 #include "stream_api.h"
 
 /**
- * ܵ
- * @param channel_ref kchannel_ref_tʵ
- * @return kstream_tʵ
+ * 建立管道流
+ * @param channel_ref kchannel_ref_t实例
+ * @return kstream_t实例
  */
 kstream_t* stream_create(kchannel_ref_t* channel_ref);
 
 /**
- * ٹܵ
- * @param stream kstream_tʵ
+ * 销毁管道流
+ * @param stream kstream_t实例
  */
 void stream_destroy(kstream_t* stream);
 
@@ -28,287 +28,287 @@
 #include "config.h"
 
 /**
- * @defgroup thread ߳
- * ߳
+ * @defgroup thread 线程
+ * 线程相关
  *
  * <pre>
- * ߳
+ * 线程
  *
- * ߳APIṩ˻߳ز:
+ * 线程API提供了基本的线程相关操作:
  *
- * 1. ߳̽
+ * 1. 线程建立销毁
  * 2. TLS
- * 3. ԭӲ
+ * 3. 原子操作
  *
- * thread_runner_start_loopֱkloop_tΪ߳knet_loop_run_once
- * thread_runner_start_timer_loopֱktimer_loop_tΪ߳ktimer_loop_run_once
- * thread_runner_start_multi_loop_vargͬʱжknet_loop_run_oncektimer_loop_run_once
+ * thread_runner_start_loop可以直接以kloop_t作为参数在线程内运行knet_loop_run_once
+ * thread_runner_start_timer_loop可以直接以ktimer_loop_t作为参数在线程内运行ktimer_loop_run_once
+ * thread_runner_start_multi_loop_varg可以同时运行多个knet_loop_run_once或者ktimer_loop_run_once
  * </pre>
  * @{
  */
 
 /**
- * һ߳
- * @param func ̺߳
- * @param params 
- * @return kthread_runner_tʵ
+ * 创建一个线程
+ * @param func 线程函数
+ * @param params 参数
+ * @return kthread_runner_t实例
  */
 extern kthread_runner_t* thread_runner_create(knet_thread_func_t func, void* params);
 
 /**
- * һ߳
- * @param runner kthread_runner_tʵ
+ * 销毁一个线程
+ * @param runner kthread_runner_t实例
  */
 extern void thread_runner_destroy(kthread_runner_t* runner);
 
 /**
- * ߳
- * @param runner kthread_runner_tʵ
- * @param stack_size ߳ջСֽڣ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 启动线程
+ * @param runner kthread_runner_t实例
+ * @param stack_size 线程栈大小（字节）
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int thread_runner_start(kthread_runner_t* runner, int stack_size);
 
 /**
- * ֹͣ߳
- * @param runner kthread_runner_tʵ
+ * 停止线程
+ * @param runner kthread_runner_t实例
  */
 extern void thread_runner_stop(kthread_runner_t* runner);
 
 /**
- * ȡ߳ID
- * @param runner kthread_runner_tʵ
- * @return ߳ID
+ * 获取线程ID
+ * @param runner kthread_runner_t实例
+ * @return 线程ID
  */
 extern thread_id_t thread_runner_get_id(kthread_runner_t* runner);
 
 /**
- * ߳knet_loop_run()
- * @param runner kthread_runner_tʵ
- * @param loop kloop_tʵ
- * @param stack_size ߳ջСֽڣ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 在线程内运行knet_loop_run()
+ * @param runner kthread_runner_t实例
+ * @param loop kloop_t实例
+ * @param stack_size 线程栈大小（字节）
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int thread_runner_start_loop(kthread_runner_t* runner, kloop_t* loop, int stack_size);
 
 /**
- * ߳timer_loop_run()
- * @param runner kthread_runner_tʵ
- * @param timer_loop ktimer_loop_tʵ
- * @param stack_size ߳ջСֽڣ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 在线程内运行timer_loop_run()
+ * @param runner kthread_runner_t实例
+ * @param timer_loop ktimer_loop_t实例
+ * @param stack_size 线程栈大小（字节）
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int thread_runner_start_timer_loop(kthread_runner_t* runner, ktimer_loop_t* timer_loop, int stack_size);
 
 /**
- * ߳kloop_tktimer_loop_t
+ * 在线程内启动多个kloop_t或ktimer_loop_t
  *
- * formatڿжkloop_tlktimer_loop_ttƩ磺ltʶһkloop_tһktimer_loop_t
- * @param runner kthread_runner_tʵ
- * @param stack_size ջС
- * @param format ַ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * format内可以有多个kloop_t（l）或者ktimer_loop_t（t），譬如：lt，标识一个kloop_t，一个ktimer_loop_t
+ * @param runner kthread_runner_t实例
+ * @param stack_size 栈大小
+ * @param format 启动字符串
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 extern int thread_runner_start_multi_loop_varg(kthread_runner_t* runner, int stack_size, const char* format, ...);
 
 /**
- * ȴֹ߳
- * @param runner kthread_runner_tʵ
+ * 等待线程终止
+ * @param runner kthread_runner_t实例
  */
 extern void thread_runner_join(kthread_runner_t* runner);
 
 /**
- * ֹ߳
- * @param runner kthread_runner_tʵ
+ * 终止线程
+ * @param runner kthread_runner_t实例
  */
 extern void thread_runner_exit(kthread_runner_t* runner);
 
 /**
- * ߳Ƿ
- * @param runner kthread_runner_tʵ
- * @retval 0 δ
- * @retval  
+ * 检查线程是否正在运行
+ * @param runner kthread_runner_t实例
+ * @retval 0 未运行
+ * @retval 非零 正在运行
  */
 extern int thread_runner_check_start(kthread_runner_t* runner);
 
 /**
- * ȡ߳вthread_runner_create()ڶ
- * @param runner kthread_runner_tʵ
- * @return ߳в
+ * 取得线程运行参数，thread_runner_create()第二个参数
+ * @param runner kthread_runner_t实例
+ * @return 线程运行参数
  */
 extern void* thread_runner_get_params(kthread_runner_t* runner);
 
 /**
- * ȡ߳ID
- * @return ߳ID
+ * 取得线程ID
+ * @return 线程ID
  */
 extern thread_id_t thread_get_self_id();
 
 /**
- * ˯
- * @param ms ˯ʱ䣨룩
+ * 睡眠
+ * @param ms 睡眠时间（毫秒）
  */
 extern void thread_sleep_ms(int ms);
 
 /**
- * ̱߳ش洢
- * @param runner kthread_runner_tʵ
- * @param data Զָ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 设置线程本地存储
+ * @param runner kthread_runner_t实例
+ * @param data 自定义数据指针
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int thread_set_tls_data(kthread_runner_t* runner, void* data);
 
 /**
- * ȡ̱߳ش洢
- * @param runner kthread_runner_tʵ
- * @retval 0 ȡʧܻ򲻴
- * @retval Чָ
+ * 取得线程本地存储
+ * @param runner kthread_runner_t实例
+ * @retval 0 获取失败或不存在
+ * @retval 有效指针
  */
 void* thread_get_tls_data(kthread_runner_t* runner);
 
 /**
- * ԭӲ - 
- * @param counter atomic_counter_tʵ
- * @return ֵ
+ * 原子操作 - 递增
+ * @param counter atomic_counter_t实例
+ * @return 递增后的值
  */
 extern atomic_counter_t atomic_counter_inc(atomic_counter_t* counter);
 
 /**
- * ԭӲ - ݼ
- * @param counter atomic_counter_tʵ
- * @return ݼֵ
+ * 原子操作 - 递减
+ * @param counter atomic_counter_t实例
+ * @return 递减后的值
  */
 extern atomic_counter_t atomic_counter_dec(atomic_counter_t* counter);
 
 /**
- * ԭӲ - CAS(check and swap)
- * @param counter atomic_counter_tʵ
- * @param target Ŀֵ
- * @param value ֵ
- * @return ֵ
+ * 原子操作 - CAS(check and swap)
+ * @param counter atomic_counter_t实例
+ * @param target 目标值
+ * @param value 新值
+ * @return 操作后的值
  */
 extern atomic_counter_t atomic_counter_cas(atomic_counter_t* counter,
     atomic_counter_t target, atomic_counter_t value);
 
 /**
- * ԭӲ - ֵ
- * @param counter atomic_counter_tʵ
- * @param value ֵ
- * @return ֵ
+ * 原子操作 - 赋值
+ * @param counter atomic_counter_t实例
+ * @param value 新值
+ * @return 操作后的值
  */
 extern atomic_counter_t atomic_counter_set(atomic_counter_t* counter,
     atomic_counter_t value);
 
 /**
- * ԭӲ - ǷΪ
- * @param counter atomic_counter_tʵ
- * @retval 0 
- * @retval  
+ * 原子操作 - 是否为零
+ * @param counter atomic_counter_t实例
+ * @retval 0 非零
+ * @retval 其他 零
  */
 extern int atomic_counter_zero(atomic_counter_t* counter);
 
 /**
- * ʵ
- * @return klock_tʵ
+ * 建立互斥锁实例
+ * @return klock_t实例
  */
 extern klock_t* lock_create();
 
 /**
- * ٻ
- * @param lock klock_tʵ
+ * 销毁互斥锁
+ * @param lock klock_t实例
  */
 extern void lock_destroy(klock_t* lock);
 
 /**
- * 
- * @param lock klock_tʵ
+ * 锁
+ * @param lock klock_t实例
  */
 extern void lock_lock(klock_t* lock);
 
 /**
- * 
- * @param lock klock_tʵ
+ * 测试锁
+ * @param lock klock_t实例
  * @sa pthread_mutex_trylock
  */
 extern int lock_trylock(klock_t* lock);
 
 /**
- * 
- * @param lock klock_tʵ
+ * 解锁
+ * @param lock klock_t实例
  */
 extern void lock_unlock(klock_t* lock);
 
 /**
- * д
- * @return krwlock_tʵ
+ * 建立读写锁
+ * @return krwlock_t实例
  */
 extern krwlock_t* rwlock_create();
 
 /**
- * ٶд
- * @param rwlock krwlock_tʵ
+ * 销毁读写锁
+ * @param rwlock krwlock_t实例
  */
 extern void rwlock_destroy(krwlock_t* rwlock);
 
 /**
- * 
- * @param rwlock krwlock_tʵ
+ * 读者锁
+ * @param rwlock krwlock_t实例
  */
 extern void rwlock_rdlock(krwlock_t* rwlock);
 
 /**
- * ߽
- * @param rwlock krwlock_tʵ
+ * 读者解锁
+ * @param rwlock krwlock_t实例
  */
 extern void rwlock_rdunlock(krwlock_t* rwlock);
 
 /**
- * д
- * @param rwlock krwlock_tʵ
+ * 写者锁
+ * @param rwlock krwlock_t实例
  */
 extern void rwlock_wrlock(krwlock_t* rwlock);
 
 /**
- * д߽
- * @param rwlock krwlock_tʵ
+ * 写者解锁
+ * @param rwlock krwlock_t实例
  */
 extern void rwlock_wrunlock(krwlock_t* rwlock);
 
 /**
- * 
- * @return kcond_tʵ
+ * 建立条件变量
+ * @return kcond_t实例
  */
 extern kcond_t* cond_create();
 
 /**
- * 
- * @param cond kcond_tʵ
+ * 销毁条件变量
+ * @param cond kcond_t实例
  */
 extern void cond_destroy(kcond_t* cond);
 
 /**
- * ȴ
- * @param cond kcond_tʵ
- * @param lock 
+ * 等待唤醒
+ * @param cond kcond_t实例
+ * @param lock 锁
  */
 extern void cond_wait(kcond_t* cond, klock_t* lock);
 
 /**
- * ȴ
- * @param cond kcond_tʵ
- * @param lock 
- * @param ms ȴʱ䣨룩
+ * 等待唤醒
+ * @param cond kcond_t实例
+ * @param lock 锁
+ * @param ms 等待时间（毫秒）
  */
 extern void cond_wait_ms(kcond_t* cond, klock_t* lock, int ms);
 
 /**
- * 
- * @param cond kcond_tʵ
+ * 唤醒
+ * @param cond kcond_t实例
  */
 extern void cond_signal(kcond_t* cond);
 
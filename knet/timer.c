@@ -29,88 +29,97 @@
 #include "rb_tree.h"
 
 /**
- * ʱ
+ * 定时器
  */
 struct _ktimer_t {
-    kdlist_t*       current_list;  /*  */
-    kdlist_node_t*  list_node;     /* ڵ */
-    ktimer_loop_t*  timer_loop;    /* ʱѭ */
-    ktimer_type_e   type;          /* ʱ */
-    ktimer_cb_t     cb;            /* ʱص */
-    void*           data;          /* Զ */
-    uint64_t        ms;            /* ´δʱ */
-    uint64_t        intval;        /* ʱ */
-    int             times;         /*  */
-    int             current_times; /* ǰ */
-    int             stop;          /* ֹ־ */
+    kdlist_t*       current_list;  /* 所属链表 */
+    kdlist_node_t*  list_node;     /* 链表节点 */
+    ktimer_loop_t*  timer_loop;    /* 定时器循环 */
+    ktimer_type_e   type;          /* 定时器类型 */
+    ktimer_cb_t     cb;            /* 定时器回调 */
+    void*           data;          /* 自定义数据 */
+    uint64_t        ms;            /* 下次触发时间 */
+    uint64_t        intval;        /* 定时器间隔 */
+    int             times;         /* 触发最大次数 */
+    int             current_times; /* 当前触发次数 */
+    int             stop;          /* 终止标志 */
 };
 
 /**
- * ʱѭ
+ * 定时器循环
  */
 struct _ktimer_loop_t {
-    krbtree_t* timer_tree; /*  */
-    int        running;    /* б־ */
-    uint64_t   last_tick;  /* һεѭʱ䣨룩 */
-    uint64_t   freq;       /* ѭü() */
+    krbtree_t* timer_tree; /* 红黑树 */
+    int        running;    /* 运行标志 */
+    uint64_t   last_tick;  /* 上一次调用循环的时间（毫秒） */
+    uint64_t   freq;       /* 循环调用间隔(毫秒) */
+    uint64_t   now;        /* 外部设置的当前时间（毫秒） */
+    int        cached;     /* 是否使用外部设置的当前时间 */
 };
 
 /**
- * ٺڵ
+ * 销毁红黑树节点
  */
 void _rb_node_destroy_cb(void* ptr, uint64_t key);
 
 /**
- * Ӷʱ
- * @param timer ʱ
- * @param node ʱڵ
- * @param ms ʱ()
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 添加定时器
+ * @param timer 定时器
+ * @param node 定时器链表节点
+ * @param ms 到期时间戳(毫秒)
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _ktimer_add_node(ktimer_t* timer, kdlist_node_t* node, time_t ms);
 
 /**
- * Ӷʱ
- * @param timer ʱ
- * @param ms ʱ()
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 添加定时器
+ * @param timer 定时器
+ * @param ms 到期时间戳(毫秒)
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _ktimer_add(ktimer_t* timer, time_t ms);
 
+/**
+ * 取得定时器循环的当前时间
+ * @param timer_loop ktimer_loop_t实例
+ * @return 单调时钟时间戳（毫秒）
+ */
+uint64_t _ktimer_loop_now(ktimer_loop_t* timer_loop);
+
 void _rb_node_destroy_cb(void* ptr, uint64_t key) {
     kdlist_node_t* node = 0;
     kdlist_node_t* temp = 0;
     kdlist_t*      list = (kdlist_t*)ptr;
     (void)key;
-    /* ڵĶʱ */
+    /* 销毁链表内的定时器 */
     dlist_for_each_safe(list, node, temp) {
         ktimer_t* timer = (ktimer_t*)dlist_node_get_data(node);
         ktimer_destroy(timer);
     }
-    /*  */
+    /* 销毁链表 */
     dlist_destroy(list);
 }
 
 int _ktimer_add_node(ktimer_t* timer, kdlist_node_t* node, time_t ms) {
     kdlist_t*  list    = 0;
     krbnode_t* rb_node = 0;
-    /* ҽڵ */
+    /* 查找节点 */
     rb_node = krbtree_find(timer->timer_loop->timer_tree, ms);
-    if (!rb_node) { /* δҵڵ */
+    if (!rb_node) { /* 未找到节点 */
         list    = dlist_create();
-        /* ڵ */
+        /* 建立红黑树节点 */
         rb_node = krbnode_create(ms, list, _rb_node_destroy_cb);
-        /* ڵ */
+        /* 插入红黑树节点 */
         krbtree_insert(timer->timer_loop->timer_tree, rb_node);
     }
     if (rb_node) {
-        /* öʱ */
+        /* 设置定时器所属链表 */
         timer->current_list = (kdlist_t*)krbnode_get_ptr(rb_node);
-        /* ӵβ */
+        /* 添加到链表尾部 */
         dlist_add_tail(timer->current_list, node);
-        /* ڵĽڵ */
+        /* 链表内的节点 */
         timer->list_node = node;
     } else {
         return error_fail;
@@ -121,12 +130,13 @@ int _ktimer_add_node(ktimer_t* timer, kdlist_node_t* node, time_t ms) {
 int _ktimer_add(ktimer_t* timer, time_t ms) {
     kdlist_t*  list = 0;
     krbnode_t* rb_node = 0;
-    rb_node = krbtree_find(timer->timer_loop->timer_tree, ms);
+    /* 启动可能发生在loop迭代之外或者耗时较长的回调之后, 截止时间使用当前时间而不是缓存的时间戳 */
+    timer->ms = time_get_monotonic_milliseconds() + ms;
+    rb_node = krbtree_find(timer->timer_loop->timer_tree, timer->ms);
     if (!rb_node) {
         list    = dlist_create();
-        rb_node = krbnode_create(time_get_milliseconds_19700101() + ms,
-            list, _rb_node_destroy_cb);
-        /* ڵ */
+        rb_node = krbnode_create(timer->ms, list, _rb_node_destroy_cb);
+        /* 插入红黑树节点 */
         krbtree_insert(timer->timer_loop->timer_tree, rb_node);
     }
     if (rb_node) {
@@ -138,11 +148,24 @@ int _ktimer_add(ktimer_t* timer, time_t ms) {
     return error_ok;
 }
 
+uint64_t _ktimer_loop_now(ktimer_loop_t* timer_loop) {
+    if (timer_loop->cached) {
+        return timer_loop->now;
+    }
+    return time_get_monotonic_milliseconds();
+}
+
+void ktimer_loop_set_now(ktimer_loop_t* timer_loop, uint64_t ms) {
+    verify(timer_loop);
+    timer_loop->now    = ms;
+    timer_loop->cached = 1;
+}
+
 ktimer_loop_t* ktimer_loop_create(time_t freq) {
     ktimer_loop_t* timer_loop = create(ktimer_loop_t);
     verify(timer_loop);
     memset(timer_loop, 0, sizeof(ktimer_loop_t));
-    timer_loop->last_tick  = time_get_milliseconds_19700101();
+    timer_loop->last_tick  = time_get_monotonic_milliseconds();
     timer_loop->timer_tree = krbtree_create();
     timer_loop->freq       = freq;
     return timer_loop;
@@ -150,7 +173,7 @@ ktimer_loop_t* ktimer_loop_create(time_t freq) {
 
 void ktimer_loop_destroy(ktimer_loop_t* timer_loop) {
     verify(timer_loop);
-    /* ٺ */
+    /* 销毁红黑树 */
     krbtree_destroy(timer_loop->timer_tree);
     knet_free(timer_loop);
 }
@@ -176,57 +199,82 @@ int ktimer_loop_run_once(ktimer_loop_t* timer_loop) {
     kdlist_t*      timers  = 0;
     ktimer_t*      timer   = 0;
     uint64_t       key     = 0;
-    uint64_t       ms      = time_get_milliseconds_19700101(); /* ǰʱ룩 */
+    uint64_t       ms      = 0;
     int            count   = 0;
     verify(timer_loop);
-    /* ¼ϴtickʱ */
+    /* 当前时间戳（毫秒） */
+    ms = _ktimer_loop_now(timer_loop);
+    /* 记录上次tick时间戳 */
     timer_loop->last_tick = ms;
-    /* ʱСڵ */
+    /* 查找时间戳最小节点 */
     rb_node = krbtree_min(timer_loop->timer_tree);
     if (!rb_node) {
-        /* ûнڵ */
+        /* 没有节点 */
         return 0;
     }
-    /* ȡСڵʱ */
+    /* 获取最小节点的时间戳 */
     key = krbnode_get_key(rb_node);
-    while (rb_node && (key < ms)) { /*  */
-        /* ȡǰʱĶʱ */
+    while (rb_node && (key < ms)) { /* 到期 */
+        /* 获取当前时间戳的定时器链表 */
         timers = (kdlist_t*)krbnode_get_ptr(rb_node);
         verify(timers);
-        /* еڵĶʱ */
+        /* 处理所有到期的定时器 */
         dlist_for_each_safe(timers, node, temp) {
             timer = (ktimer_t*)dlist_node_get_data(node);
             verify(timer);
             if (!timer->stop) {
                 if (timer->cb) {
-                    /* ʱ,ûص */
+                    /* 定时器到期,调用回调 */
                     timer->cb(timer, timer->data);
                     count += 1;
-                    /* ô */
+                    /* 调用次数递增 */
                     timer->current_times += 1;
                 }
                 if (!ktimer_check_dead(timer)) {
-                    /* ܱ, ƶʱڵ */
+                    /* 不能被销毁, 移动到新时间戳红黑树节点链表内 */
                     timer->ms = ms + timer->intval;
                     dlist_remove(timers, node);
                     _ktimer_add_node(timer, node, timer->ms);
                 }
             }
         }
-        /* ٺڵ */
+        /* 销毁红黑树节点 */
         krbtree_delete(timer_loop->timer_tree, rb_node);
-        /* ʱСڵ */
+        /* 查找时间戳最小节点 */
         rb_node = krbtree_min(timer_loop->timer_tree);
         if (!rb_node) {
-            /* ûнڵ */
+            /* 没有节点 */
             break;
         }
-        /* ȡСڵʱ */
+        /* 获取最小节点的时间戳 */
         key = krbnode_get_key(rb_node);
     }
     return count;
 }
 
+int ktimer_loop_get_timeout(ktimer_loop_t* timer_loop) {
+    krbnode_t* rb_node = 0;
+    uint64_t   key     = 0;
+    uint64_t   ms      = 0;
+    verify(timer_loop);
+    /* 查找时间戳最小节点 */
+    rb_node = krbtree_min(timer_loop->timer_tree);
+    if (!rb_node) {
+        /* 没有节点, 可以无限等待 */
+        return -1;
+    }
+    key = krbnode_get_key(rb_node);
+    ms  = _ktimer_loop_now(timer_loop);
+    /* ktimer_loop_run_once只处理时间戳小于当前时间的节点 */
+    if (key < ms) {
+        return 0;
+    }
+    if (key - ms >= INT_MAX) {
+        return INT_MAX;
+    }
+    return (int)(key - ms) + 1;
+}
+
 ktimer_loop_t* ktimer_get_loop(ktimer_t* timer) {
     verify(timer);
     return timer->timer_loop;
@@ -268,7 +316,7 @@ int ktimer_stop(ktimer_t* timer) {
     verify(timer);
     timer->stop = 1;
     if (!timer->current_list) {
-        /* δĶʱ, δ붨ʱ */
+        /* 还未启动的定时器, 未放入定时器链表 */
         ktimer_destroy(timer);
     }
     return error_ok;
@@ -288,7 +336,6 @@ int ktimer_start(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms) {
     timer->cb     = cb;
     timer->data   = data;
     timer->type   = ktimer_type_period;
-    timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
     return error_ok;
 }
@@ -307,7 +354,6 @@ int ktimer_start_once(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms) {
     timer->cb     = cb;
     timer->data   = data;
     timer->type   = ktimer_type_once;
-    timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
     return error_ok;
 }
@@ -327,7 +373,6 @@ int ktimer_start_times(ktimer_t* timer, ktimer_cb_t cb, void* data, time_t ms, i
     timer->data   = data;
     timer->type   = ktimer_type_times;
     timer->times  = times;
-    timer->ms     = time_get_milliseconds_19700101() + ms;
     timer->intval = ms;
     return error_ok;
 }
@@ -29,9 +29,27 @@
 #include "timer_api.h"
 
 /**
- * ٶʱ
- * @param timer ktimer_tʵ
+ * 销毁定时器
+ * @param timer ktimer_t实例
  */
 void ktimer_destroy(ktimer_t* timer);
 
+/**
+ * 取得距离最近一个定时器到期的时间间隔
+ * @param timer_loop ktimer_loop_t实例
+ * @retval -1 没有定时器
+ * @retval 其他 距离最近一个定时器到期的毫秒数
+ */
+int ktimer_loop_get_timeout(ktimer_loop_t* timer_loop);
+
+/**
+ * 设置定时器循环的当前时间
+ * <pre>
+ * 由kloop_t每次迭代设置一次, 设置后定时器循环不再自行读取时钟
+ * </pre>
+ * @param timer_loop ktimer_loop_t实例
+ * @param ms 单调时钟时间戳（毫秒）
+ */
+void ktimer_loop_set_now(ktimer_loop_t* timer_loop, uint64_t ms);
+
 #endif /* TIMER_H */
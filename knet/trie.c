@@ -26,130 +26,130 @@
 #include "logger.h"
 
 typedef struct _trie_node_t {
-    struct _trie_node_t* parent;   /* ڵ */
-    struct _trie_node_t* left;     /*  */
-    struct _trie_node_t* center;   /*  */
-    struct _trie_node_t* right;    /*  */
-    uint32_t             ref;      /* ڵü, Ϊſٽڵ */
-    char                 key;      /*  */
-    char*                real_key; /* ĩ˽ڵ */
-    void*                value;    /* ֵ */
+    struct _trie_node_t* parent;   /* 父节点 */
+    struct _trie_node_t* left;     /* 左子树 */
+    struct _trie_node_t* center;   /* 中子树 */
+    struct _trie_node_t* right;    /* 右子树 */
+    uint32_t             ref;      /* 节点引用计数, 计数为零才可以销毁节点 */
+    char                 key;      /* 键 */
+    char*                real_key; /* 末端节点 */
+    void*                value;    /* 值 */
 } ktrie_node_t;
 
 struct _trie_t {
-    ktrie_node_t* root; /* ڵ */
+    ktrie_node_t* root; /* 根节点 */
 };
 
 /**
- * trieڵ
- * @param parent ktrie_node_tڵ
- * @return ktrie_node_tʵ
+ * 建立trie节点
+ * @param parent ktrie_node_t父节点
+ * @return ktrie_node_t实例
  */
 ktrie_node_t* _trie_node_create(ktrie_node_t* parent);
 
 /**
- * trieڵ㣬ݹӽڵ
- * @param node ktrie_node_tʵ
- * @param dtor ڵֵٺ
+ * 销毁trie节点，递归销毁子节点
+ * @param node ktrie_node_t实例
+ * @param dtor 节点值销毁函数
  */
 void _trie_node_destroy(ktrie_node_t* node, knet_trie_dtor_t dtor);
 
 /**
- * trieڵ
- * @param node ktrie_node_tʵ
- * @param dtor ڵֵٺ
+ * 销毁trie节点
+ * @param node ktrie_node_t实例
+ * @param dtor 节点值销毁函数
  */
 void _trie_node_destroy_self(ktrie_node_t* node, knet_trie_dtor_t dtor);
 
 /**
- * trieڵ
- * @param node ktrie_node_tʵ
+ * 重置trie节点
+ * @param node ktrie_node_t实例
  */
 void _trie_node_reset(ktrie_node_t* node);
 
 /**
- * real_keyֶ
- * @param node ktrie_node_tʵ
- * @param real_key 
+ * 设置real_key字段
+ * @param node ktrie_node_t实例
+ * @param real_key 键
  */
 void _trie_node_set_real_key(ktrie_node_t* node, const char* real_key);
 
 /**
- * trieڵ
- * @param node ktrie_node_tʵ
- * @param key 
- * @param s Ӽ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 建立trie节点
+ * @param node ktrie_node_t实例
+ * @param key 键
+ * @param s 子键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _trie_node_insert(ktrie_node_t* node, const char* key, const char* s, void* value);
 
 /**
- * trieڵ
- * @param node ktrie_node_tʵ
- * @param key 
- * @param s Ӽ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 查找trie节点
+ * @param node ktrie_node_t实例
+ * @param key 键
+ * @param s 子键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _trie_node_find(ktrie_node_t* node, const char* key, const char* s, void** value);
 
 /**
- * ɾtrieڵ
- * @param node ktrie_node_tʵ
- * @param s Ӽ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 删除trie节点
+ * @param node ktrie_node_t实例
+ * @param s 子键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _trie_node_remove(ktrie_node_t* node, const char* s, void** value);
 
 /**
- * trieڵ㣬һµ·ڵ
- * @param node ktrie_node_tʵ
- * @param key 
- * @param s Ӽ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 插入trie节点，建立一个新的路径节点
+ * @param node ktrie_node_t实例
+ * @param key 键
+ * @param s 子键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _trie_node_insert_new_path(ktrie_node_t* node, const char* key, const char* s, void* value);
 
 /**
- * trieڵ㣬ʹе·ڵ
- * @param node ktrie_node_tʵ
- * @param key 
- * @param s Ӽ
- * @param value ֵ
- * @retval error_ok ɹ
- * @retval  ʧ
+ * 插入trie节点，使用已有的路径节点
+ * @param node ktrie_node_t实例
+ * @param key 键
+ * @param s 子键
+ * @param value 值
+ * @retval error_ok 成功
+ * @retval 其他 失败
  */
 int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char* s, void* value);
 
 /**
- * ·ڵü
- * @param node ktrie_node_tʵ
- * @param s Ӽ
- * @param start_node صʼڵ
- * @retval 0 
- * @retval  
+ * 减少路径节点的引用计数
+ * @param node ktrie_node_t实例
+ * @param s 子键
+ * @param start_node 返回的起始节点
+ * @retval 0 不能销毁
+ * @retval 非零 可以销毁
  */
 int _trie_node_decref_path(ktrie_node_t* node, ktrie_node_t** start_node, const char* s);
 
 /**
- * ·ڵ
- * @param node ktrie_node_tʵ
- * @param s Ӽ
+ * 销毁路径节点
+ * @param node ktrie_node_t实例
+ * @param s 子键
  */
 void _trie_node_delete_path(ktrie_node_t* node, const char* s);
 
 /**
- * ڵ
- * @param node ktrie_node_tʵ
- * @param func 
- * @param param 
+ * 遍历节点
+ * @param node ktrie_node_t实例
+ * @param func 遍历函数
+ * @param param 遍历函数参数
  */
 int _trie_node_for_each(ktrie_node_t* node, knet_trie_for_each_func_t func, void* param);
 
@@ -228,7 +228,7 @@ void _trie_node_destroy(ktrie_node_t* node, knet_trie_dtor_t dtor) {
 }
 
 void _trie_node_destroy_self(ktrie_node_t* node, knet_trie_dtor_t dtor) {
-    if (node->parent) { /* Ǹڵ */
+    if (node->parent) { /* 非根节点 */
         if (node->parent->left == node) {
             node->parent->left = 0;
         } else if (node->parent->right == node) {
@@ -267,7 +267,7 @@ int _trie_node_find(ktrie_node_t* node, const char* key, const char* s, void** v
         return error_trie_not_found;
     }
     c = *s;
-    if (node->key == c) { /* мڵ */
+    if (node->key == c) { /* 中间节点 */
         s += 1;
         n = *s;
         if (!n) {
@@ -285,11 +285,11 @@ int _trie_node_find(ktrie_node_t* node, const char* key, const char* s, void** v
         if (node->center) {
             return _trie_node_find(node->center, key, s, value);
         }
-    } else if (node->key > c) { /* ߽ڵ */
+    } else if (node->key > c) { /* 左边节点 */
         if (node->left) {
             return _trie_node_find(node->left, key, s, value);
         }
-    } else if (node->key < c) { /* ұ߽ڵ */
+    } else if (node->key < c) { /* 右边节点 */
         if (node->right) {
             return _trie_node_find(node->right, key, s, value);
         }
@@ -318,8 +318,8 @@ int _trie_node_insert_new_path(ktrie_node_t* node, const char* key, const char*
     c = s[0];
     n = s[1];
     node->key = c;
-    if (n) { /* δַ */
-        /* ½ڵĬΪмڵ */
+    if (n) { /* 还有未处理的字符 */
+        /* 所有新节点默认为中间节点 */
         node->center = _trie_node_create(node);
         verify(node->center);
         s += 1;
@@ -330,10 +330,10 @@ int _trie_node_insert_new_path(ktrie_node_t* node, const char* key, const char*
             _trie_node_destroy(node->center, 0);
             node->center = 0;
         }
-    } else { /* ȫ */        
+    } else { /* 全部处理完毕 */        
         node->value = value;
         node->ref  += 1;
-        if (node->real_key) { /* keyѾ */
+        if (node->real_key) { /* key已经存在 */
             return error_trie_key_exist;
         }
         _trie_node_set_real_key(node, key);
@@ -345,7 +345,7 @@ int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char
     char c    = s[0];
     char n    = s[1];
     int error = error_ok;
-    if (n) { /* δַ */
+    if (n) { /* 还有未处理的字符 */
         if (node->key == c) {
             if (!node->center) {
                 node->center = _trie_node_create(node);
@@ -369,7 +369,7 @@ int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char
             }
             error = _trie_node_insert(node->left, key, s, value);
         }
-    } else { /* ȫ */
+    } else { /* 全部处理完毕 */
         if (key == s) {
             if (node->key == c) {
                 return error_trie_key_exist;
@@ -380,7 +380,7 @@ int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char
                     node->right->key   = c;
                     node->right->value = value;
                     node->right->ref  += 1;
-                    if (node->right->real_key) { /* keyѾ */
+                    if (node->right->real_key) { /* key已经存在 */
                         return error_trie_key_exist;
                     }
                     _trie_node_set_real_key(node->right, key);
@@ -394,7 +394,7 @@ int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char
                     node->left->key   = c;
                     node->left->value = value;
                     node->left->ref  += 1;
-                    if (node->left->real_key) { /* keyѾ */
+                    if (node->left->real_key) { /* key已经存在 */
                         return error_trie_key_exist;
                     }
                     _trie_node_set_real_key(node->left, key);
@@ -406,7 +406,7 @@ int _trie_node_insert_exist_path(ktrie_node_t* node, const char* key, const char
             node->key   = c;
             node->value = value;
             node->ref  += 1;
-            if (node->real_key) { /* keyѾ */
+            if (node->real_key) { /* key已经存在 */
                 return error_trie_key_exist;
             }
             _trie_node_set_real_key(node, key);
@@ -419,10 +419,10 @@ int _trie_node_insert(ktrie_node_t* node, const char* key, const char* s, void*
     int  error = error_ok;
     verify(node);
     verify(s);
-    if (!node->key) { /* ½Ľڵ */
+    if (!node->key) { /* 新建立的节点 */
         error = _trie_node_insert_new_path(node, key, s, value);
     } else {
-        /* ڵѾ */
+        /* 节点已经存在 */
         error = _trie_node_insert_exist_path(node, key, s, value);
     }
     return error;
@@ -442,9 +442,9 @@ int _trie_node_remove(ktrie_node_t* node, const char* s, void** value) {
     if (error_ok != error) {
         return error;
     }
-    /* ·ü */
+    /* 减少路径引用计数 */
     if (_trie_node_decref_path(node, &start_node, s)) {
-        /* · */
+        /* 销毁路径 */
         _trie_node_delete_path(start_node, s);
         if (_trie_node_check_orphan(start_node)) {
             _trie_node_destroy_self(start_node, 0);
@@ -452,7 +452,7 @@ int _trie_node_remove(ktrie_node_t* node, const char* s, void** value) {
         start_node = 0;
     }
     if (start_node) {
-        /* ʹǰڵЧ */
+        /* 使当前节点无效 */
         knet_free(start_node->real_key);
         start_node->real_key = 0;
         while (start_node && _trie_node_check_orphan(start_node)) {
@@ -24,9 +24,9 @@
 
 #include "version.h"
 
-#define MAJOR 1 /* 汾 */
-#define MINOR 5 /* ΰ汾 */
-#define PATCH 3 /*  */
+#define MAJOR 1 /* 主版本 */
+#define MINOR 5 /* 次版本 */
+#define PATCH 3 /* 补丁 */
 
 #define KNET_MAJOR(major) #major
 #define KNET_MINOR(minor) #minor
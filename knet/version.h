@@ -26,26 +26,26 @@
 #define VERSION_H
 
 /**
- * ȡõǰ汾ַ
- * @return ǰ汾ַ
+ * 取得当前版本号字符串
+ * @return 当前版本号字符串
  */
 extern const char* knet_get_version_string();
 
 /**
- * ȡ汾
- * @return 汾
+ * 取得主版本号
+ * @return 主版本号
  */
 extern int knet_get_version_major();
 
 /**
- * ȡôΰ汾
- * @return ΰ汾
+ * 取得次版本号
+ * @return 次版本号
  */
 extern int knet_get_version_minor();
 
 /**
- * ȡò汾
- * @return 汾
+ * 取得补丁版本号
+ * @return 补丁版本号
  */
 extern int knet_get_version_path();
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2014-2016, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "write_batch.h"
+#include "loop.h"
+#include "channel_ref.h"
+#include "misc.h"
+#include "logger.h"
+
+/**
+ * 批次内的一次写入, 数据紧跟在记录之后
+ */
+typedef struct _write_batch_record_t {
+    kchannel_ref_t* channel_ref; /* 目标管道 */
+    uint32_t        size;        /* 数据长度 */
+} write_batch_record_t;
+
+/**
+ * 记录按指针长度对齐
+ */
+#define WRITE_BATCH_ALIGN(size) (((size) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
+
+/**
+ * 记录缓冲区的初始长度
+ */
+#define WRITE_BATCH_INIT_SIZE 4096
+
+/**
+ * 批量写入
+ */
+struct _write_batch_t {
+    kloop_t* loop;     /* 管道所属的kloop_t */
+    char*    ptr;      /* 记录缓冲区 */
+    uint32_t length;   /* 已使用的长度 */
+    uint32_t max_size; /* 记录缓冲区长度 */
+    int      count;    /* 写入次数 */
+};
+
+/**
+ * 扩大记录缓冲区, 至少能再容纳size字节
+ * @param batch kwrite_batch_t实例
+ * @param size 需要的长度
+ * @retval error_ok 成功
+ * @retval error_no_memory 内存不足
+ */
+int _write_batch_reserve(kwrite_batch_t* batch, uint32_t size);
+
+int _write_batch_reserve(kwrite_batch_t* batch, uint32_t size) {
+    uint32_t max_size = batch->max_size ? batch->max_size : WRITE_BATCH_INIT_SIZE;
+    char*    ptr      = 0;
+    if (batch->length + size <= batch->max_size) {
+        return error_ok;
+    }
+    while (max_size < batch->length + size) {
+        max_size <<= 1;
+    }
+    ptr = rcreate_raw(batch->ptr, max_size);
+    if (!ptr) {
+        return error_no_memory;
+    }
+    batch->ptr      = ptr;
+    batch->max_size = max_size;
+    return error_ok;
+}
+
+kwrite_batch_t* knet_write_batch_begin(kloop_t* loop) {
+    kwrite_batch_t* batch = 0;
+    verify(loop);
+    batch = create(kwrite_batch_t);
+    verify(batch);
+    if (!batch) {
+        return 0;
+    }
+    memset(batch, 0, sizeof(kwrite_batch_t));
+    batch->loop = loop;
+    return batch;
+}
+
+int knet_write_batch_write(kwrite_batch_t* batch, kchannel_ref_t* channel_ref, const char* data, int size) {
+    write_batch_record_t* record = 0;
+    uint32_t              length = 0;
+    verify(batch);
+    verify(channel_ref);
+    verify(data);
+    verify(size > 0);
+    if (knet_channel_ref_get_loop(channel_ref) != batch->loop) {
+        return error_invalid_channel;
+    }
+    length = (uint32_t)WRITE_BATCH_ALIGN(sizeof(write_batch_record_t) + (uint32_t)size);
+    if (error_ok != _write_batch_reserve(batch, length)) {
+        return error_no_memory;
+    }
+    record              = (write_batch_record_t*)(batch->ptr + batch->length);
+    record->channel_ref = channel_ref;
+    record->size        = (uint32_t)size;
+    memcpy(record + 1, data, size);
+    batch->length += length;
+    batch->count  += 1;
+    return error_ok;
+}
+
+int knet_write_batch_get_count(kwrite_batch_t* batch) {
+    verify(batch);
+    return batch->count;
+}
+
+int knet_write_batch_commit(kwrite_batch_t* batch) {
+    verify(batch);
+    if (!batch->count) {
+        knet_write_batch_destroy(batch);
+        return error_ok;
+    }
+    if (knet_loop_get_thread_id(batch->loop) == thread_get_self_id()) {
+        /* 当前线程内直接处理 */
+        knet_write_batch_process(batch);
+        knet_write_batch_destroy(batch);
+    } else {
+        /* 整个批次作为一个事件, 只唤醒一次 */
+        knet_loop_notify_write_batch(batch->loop, batch);
+    }
+    return error_ok;
+}
+
+void knet_write_batch_cancel(kwrite_batch_t* batch) {
+    verify(batch);
+    knet_write_batch_destroy(batch);
+}
+
+void knet_write_batch_process(kwrite_batch_t* batch) {
+    write_batch_record_t* record = 0;
+    uint32_t              pos    = 0;
+    verify(batch);
+    while (pos < batch->length) {
+        record = (write_batch_record_t*)(batch->ptr + pos);
+        knet_channel_ref_update_write_in_loop(batch->loop, record->channel_ref, (const char*)(record + 1), (int)record->size);
+        pos += (uint32_t)WRITE_BATCH_ALIGN(sizeof(write_batch_record_t) + record->size);
+    }
+}
+
+void knet_write_batch_destroy(kwrite_batch_t* batch) {
+    verify(batch);
+    if (batch->ptr) {
+        knet_free(batch->ptr);
+    }
+    knet_free(batch);
+}
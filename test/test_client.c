@@ -14,15 +14,28 @@ void client_timer_cb(ktimer_t* timer, void* data) {
     printf("Active channel: %d, Recv: %d, Send: %d\n", active_channel, recv_bytes, send_bytes);
 }
 
+knet_loop_backend_e get_backend(const char* name) {
+    if (!strcmp("select", name)) {
+        return loop_backend_select;
+    } else if (!strcmp("epoll", name)) {
+        return loop_backend_epoll;
+    } else if (!strcmp("uring", name)) {
+        return loop_backend_uring;
+    } else if (!strcmp("iocp", name)) {
+        return loop_backend_iocp;
+    }
+    return loop_backend_default;
+}
+
 void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     kchannel_ref_t* connector  = 0;
     char      buffer[1024]    = {0};
     char*     hello           = "hello world";
     int       bytes           = 0;
     kstream_t* stream          = knet_channel_ref_get_stream(channel);
-    if (e & channel_cb_event_connect) { /* ӳɹ */
+    if (e & channel_cb_event_connect) { /* 连接成功 */
         active_channel++;
-        /* д */
+        /* 写入 */
         send_bytes += 12;
         knet_stream_push(stream, hello, 12);
         if (active_channel < client_n) {
@@ -43,7 +56,7 @@ void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
         printf("connect timeout!\n");
         knet_channel_ref_close(channel);
     } else if (e & channel_cb_event_timeout) {
-        /* д */
+        /* 写入 */
         if (error_ok == knet_stream_push(stream, hello, 12)) {
             send_bytes += 12;
         }
@@ -56,10 +69,12 @@ int main(int argc, char* argv[]) {
     ktimer_t*          timer        = 0;
     kchannel_ref_t*     connector    = 0;
     kthread_runner_t*   timer_thread = 0;
+    knet_loop_backend_e backend      = loop_backend_default;
     static const char* helper_string =
         "-n    client count\n"
         "-ip   remote host IP\n"
-        "-port remote host port\n";
+        "-port remote host port\n"
+        "-backend select|epoll|uring|iocp\n";
 
     if (argc > 2) {
         for (i = 1; i < argc; i++) {
@@ -69,6 +84,8 @@ int main(int argc, char* argv[]) {
                 ip = argv[i+1];
             } else if (!strcmp("-port", argv[i])) {
                 port = atoi(argv[i+1]);
+            } else if (!strcmp("-backend", argv[i])) {
+                backend = get_backend(argv[i+1]);
             }
         }
     } else {
@@ -76,7 +93,11 @@ int main(int argc, char* argv[]) {
         exit(0);
     }
 
-    loop       = knet_loop_create();
+    loop       = knet_loop_create_with_backend(backend);
+    if (!loop) {
+        printf("backend unavailable\n");
+        return 0;
+    }
     timer_loop = ktimer_loop_create(1000);
     timer      = ktimer_create(timer_loop);
 
@@ -7,7 +7,7 @@ void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     if (e & channel_cb_event_recv) {
         bytes = knet_stream_available(stream);
         if (error_ok == knet_stream_pop(stream, buffer, sizeof(buffer))) {
-            /* echoд */
+            /* echo写入 */
             if (bytes) {
                 knet_stream_push(stream, buffer, bytes);
             }
@@ -22,6 +22,19 @@ void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     }
 }
 
+knet_loop_backend_e get_backend(const char* name) {
+    if (!strcmp("select", name)) {
+        return loop_backend_select;
+    } else if (!strcmp("epoll", name)) {
+        return loop_backend_epoll;
+    } else if (!strcmp("uring", name)) {
+        return loop_backend_uring;
+    } else if (!strcmp("iocp", name)) {
+        return loop_backend_iocp;
+    }
+    return loop_backend_default;
+}
+
 void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
     if (e & channel_cb_event_accept) {
         printf("accept fd: %d, active channel count: %d, close channel count: %d\n",
@@ -38,6 +51,8 @@ int main(int argc, char* argv[]) {
     int               worker   = 0;
     char*             ip       = 0;
     int               port     = 0;
+    int               reuseport = 0;
+    knet_loop_backend_e backend = loop_backend_default;
     kloop_t*           loop     = 0;
     kloop_t**          loops    = 0;
     kloop_balancer_t*  balancer = 0;
@@ -47,7 +62,9 @@ int main(int argc, char* argv[]) {
     static const char* helper_string =
         "-w    loop worker count\n"
         "-ip   host IP\n"
-        "-port listening port\n";
+        "-port listening port\n"
+        "-reuseport one SO_REUSEPORT listener per loop\n"
+        "-backend select|epoll|uring|iocp\n";
 
     if (argc > 2) {
         for (i = 1; i < argc; i++) {
@@ -57,6 +74,10 @@ int main(int argc, char* argv[]) {
                 port = atoi(argv[i+1]);
             } else if (!strcmp("-w", argv[i])) {
                 worker = atoi(argv[i+1]);
+            } else if (!strcmp("-reuseport", argv[i])) {
+                reuseport = 1;
+            } else if (!strcmp("-backend", argv[i])) {
+                backend = get_backend(argv[i+1]);
             }
         }
     } else {
@@ -65,23 +86,34 @@ int main(int argc, char* argv[]) {
     }
 
     balancer = knet_loop_balancer_create();
-    loop     = knet_loop_create();
+    loop     = knet_loop_create_with_backend(backend);
+    if (!loop) {
+        printf("backend unavailable\n");
+        exit(0);
+    }
+    printf("backend: %s\n", knet_loop_get_backend_name(loop));
     threads  = (kthread_runner_t**)malloc(sizeof(kthread_runner_t*) * worker);
     loops    = (kloop_t**)malloc(sizeof(kloop_t*) * worker);
 
     knet_loop_balancer_attach(balancer, loop);
 
-    acceptor = knet_loop_create_channel(loop, 8, 1024);
-    knet_channel_ref_set_cb(acceptor, acceptor_cb);
-    knet_channel_ref_accept(acceptor, ip, port, 5000);
     for (i = 0; i < worker; i++) {
-        loops[i] = knet_loop_create();
+        loops[i] = knet_loop_create_with_backend(backend);
         knet_loop_balancer_attach(balancer, loops[i]);
         threads[i] = thread_runner_create(0, 0);
         assert(threads[i]);
         thread_runner_start_loop(threads[i], loops[i], 0);
     }
 
+    /* 开启SO_REUSEPORT时, 每个worker都会建立自己的监听器, worker必须先关联到负载均衡器 */
+    acceptor = knet_loop_create_channel(loop, 8, 1024);
+    knet_channel_ref_set_cb(acceptor, acceptor_cb);
+    knet_channel_ref_set_reuseport(acceptor, reuseport);
+    if (error_ok != knet_channel_ref_accept(acceptor, ip, port, 5000)) {
+        printf("knet_channel_ref_accept() failed\n");
+        exit(0);
+    }
+
     knet_loop_run(loop);
 
     for (i = 0; i < worker; i++) {
@@ -31,13 +31,13 @@ CASE(Test_Address) {
     kchannel_ref_t* channel = knet_loop_create_channel(loop, 0, 1024);
     kaddress_t* peer = knet_channel_ref_get_peer_address(channel);
     kaddress_t* local = knet_channel_ref_get_local_address(channel);
-    // δ
+    // 未建立连接
     EXPECT_TRUE(std::string("0.0.0.0") == address_get_ip(peer));
     EXPECT_FALSE(address_get_port(peer));
     EXPECT_TRUE_OUTPUT(std::string("0.0.0.0") == address_get_ip(local), address_get_ip(local));
     EXPECT_FALSE(address_get_port(local));
 
-    knet_channel_ref_close(channel); /* δӣҪֶ */
+    knet_channel_ref_close(channel); /* 未建立起连接，需要手动销毁 */
 
     kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
     kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
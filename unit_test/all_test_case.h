@@ -34,5 +34,8 @@
 #include "trie_case.h"
 #include "ip_filter_case.h"
 #include "misc_case.h"
+#include "loop_case.h"
+#include "write_batch_case.h"
+#include "ringbuffer_case.h"
 
 #endif // ALL_TEST_CASE_H
@@ -69,16 +69,16 @@ CASE(Test_Channel_Ref_Close_Socket_Fd_Outside) {
         static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
             if (e & channel_cb_event_connect) {
                 #ifdef WIN32
-                // ķʽرsocket
+                // 非正常的方式关闭socket
                 closesocket(knet_channel_ref_get_socket_fd(channel));
                 #else
                 close(knet_channel_ref_get_socket_fd(channel));
                 #endif // WIN32
                 kstream_t* s = knet_channel_ref_get_stream(channel);
-                // ΪѾرգʧ
+                // 因为已经被意外关闭，发送失败
                 EXPECT_FALSE(error_ok == knet_stream_push(s, "123", 4));
             } else if (e & channel_cb_event_close) {
-                // knet_loop_runڱǿƹر
+                // 在knet_loop_run内被强制关闭了
                 knet_loop_exit(knet_channel_ref_get_loop(channel));
             }
         }
@@ -154,10 +154,10 @@ CASE(Test_Channel_Connect_Timeout_Reconnect) {
                     knet_channel_ref_accept(acceptor, 0, 8000, 10);
                     Test_Channel_Connect_Timeout2_Accept = true;
                 }
-                // 
+                // 重连
                 knet_channel_ref_reconnect(channel, 2);
             } else if (e & channel_cb_event_connect) {
-                // ɹ˳loop
+                // 重连成功，退出loop
                 knet_loop_exit(knet_channel_ref_get_loop(channel));
             } else if (e & channel_cb_event_close) {
             } else {
@@ -186,7 +186,7 @@ CASE(Test_Channel_Connect_Timeout_Auto_Reconnect) {
                     Test_Channel_Connect_Timeout2_Accept = true;
                 }
             } else if (e & channel_cb_event_connect) {
-                // ɹ˳loop
+                // 重连成功，退出loop
                 knet_loop_exit(knet_channel_ref_get_loop(channel));
             } else if (e & channel_cb_event_close) {
             } else {
@@ -263,22 +263,22 @@ CASE(Test_Channel_Recv_Timeout) {
 kchannel_ref_t* case_Test_Channel_Share_Leave_channel = 0;
 
 CASE(Test_Channel_Share_Leave) {
-    // ʵԹǷﵽҪͨknet_channel_ref_share/knet_channel_ref_leave
-    // ڶ̻߳ʹãֻһ̵߳Ҳڹܵñദʹõֲͳһ
-    // ܵڵ
+    // 本实例测试功能是否达到要求，通常knet_channel_ref_share/knet_channel_ref_leave
+    // 在多线程环境内使用，在只有一个线程的情况下也可以用于管道引用被多处使用但又不想统一管理
+    // 管道生命周期的情况
 
     struct holder {
         static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
             if (e & channel_cb_event_connect) {
-                // һ
+                // 建立一个新引用
                 case_Test_Channel_Share_Leave_channel = knet_channel_ref_share(channel);
-                // رչܵ
+                // 关闭管道
                 knet_channel_ref_close(channel);
             } else if (e & channel_cb_event_close) {
-                // յر¼, Ϊжһãܱܵ
+                // 收到关闭事件, 但是因为有多一个引用，管道不能被销毁
                 knet_loop_exit(knet_channel_ref_get_loop(channel));
-                // knet_loop_exitúܵ״̬ջǻᱻɨһ
-                // ɨйܵ
+                // knet_loop_exit调用后管道的状态最终还是会被扫描一次
+                // 这次扫描中管道将被销毁
             }
         }
     };
@@ -293,13 +293,1006 @@ CASE(Test_Channel_Share_Leave) {
     EXPECT_TRUE(knet_channel_ref_check_state(acceptor, channel_state_accept));
 
     knet_loop_run(loop);
-    // 
+    // 销毁引用
     knet_channel_ref_leave(case_Test_Channel_Share_Leave_channel);
-    // ٹܵ
+    // 销毁管道
     for (int i = 0; i < 3; i++) {
         knet_loop_run_once(loop);
     }
     EXPECT_TRUE(0 == knet_loop_get_close_channel_count(loop));
-    // ʣ3ܵﱻ
+    // 剩余的3条管道在这里被销毁
     knet_loop_destroy(loop);
 }
+
+#ifndef WIN32
+#include <netinet/tcp.h>
+
+bool Test_Channel_Ref_Accept_Socket_Option_Accepted = false;
+
+CASE(Test_Channel_Ref_Accept_Socket_Option) {
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                socket_t fd = knet_channel_ref_get_socket_fd(channel);
+                int nodelay = 0;
+                int keepalive = 1;
+                socklen_t len = sizeof(int);
+                // 选项从监听套接字继承, 与逐个设置的结果相同
+                EXPECT_TRUE(fcntl(fd, F_GETFL, 0) & O_NONBLOCK);
+                EXPECT_TRUE(0 == getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char*)&nodelay, &len));
+                EXPECT_TRUE(nodelay);
+                len = sizeof(int);
+                EXPECT_TRUE(0 == getsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, &len));
+                EXPECT_FALSE(keepalive);
+                Test_Channel_Ref_Accept_Socket_Option_Accepted = true;
+                knet_loop_exit(knet_channel_ref_get_loop(channel));
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8000, 1));
+    knet_channel_ref_connect(connector, "127.0.0.1", 8000, 1);
+    knet_loop_run(loop);
+    EXPECT_TRUE(Test_Channel_Ref_Accept_Socket_Option_Accepted);
+    knet_loop_destroy(loop);
+}
+#endif // WIN32
+
+#define TEST_CHANNEL_REUSEPORT_COUNT 64
+
+atomic_counter_t Test_Channel_Ref_Reuseport_Accepted[2] = {0};
+atomic_counter_t Test_Channel_Ref_Reuseport_Wrong_Thread = 0;
+atomic_counter_t Test_Channel_Ref_Reuseport_Connected = 0;
+kloop_t*         Test_Channel_Ref_Reuseport_Loop[2] = {0};
+kthread_runner_t* Test_Channel_Ref_Reuseport_Runner[2] = {0};
+
+CASE(Test_Channel_Ref_Reuseport) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                atomic_counter_inc(&Test_Channel_Ref_Reuseport_Connected);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                kloop_t* loop = knet_channel_ref_get_loop(channel);
+                for (int i = 0; i < 2; i++) {
+                    if (loop == Test_Channel_Ref_Reuseport_Loop[i]) {
+                        // 在接受连接的kloop_t线程内运行, 没有跨线程转交
+                        if (thread_runner_get_id(Test_Channel_Ref_Reuseport_Runner[i]) != thread_get_self_id()) {
+                            atomic_counter_inc(&Test_Channel_Ref_Reuseport_Wrong_Thread);
+                        }
+                        atomic_counter_inc(&Test_Channel_Ref_Reuseport_Accepted[i]);
+                    }
+                }
+            }
+        }
+    };
+
+    kloop_balancer_t* balancer = knet_loop_balancer_create();
+    kthread_runner_t** runner = Test_Channel_Ref_Reuseport_Runner;
+    for (int i = 0; i < 2; i++) {
+        Test_Channel_Ref_Reuseport_Loop[i] = knet_loop_create();
+        knet_loop_balancer_attach(balancer, Test_Channel_Ref_Reuseport_Loop[i]);
+    }
+    kchannel_ref_t* acceptor = knet_loop_create_channel(Test_Channel_Ref_Reuseport_Loop[0], 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_set_reuseport(acceptor, 1);
+    EXPECT_TRUE(knet_channel_ref_check_reuseport(acceptor));
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8002, TEST_CHANNEL_REUSEPORT_COUNT));
+    // 另一个kloop_t上也建立了监听器
+    EXPECT_TRUE(1 == knet_loop_get_active_channel_count(Test_Channel_Ref_Reuseport_Loop[1]));
+    for (int i = 0; i < 2; i++) {
+        runner[i] = thread_runner_create(0, 0);
+        thread_runner_start_loop(runner[i], Test_Channel_Ref_Reuseport_Loop[i], 0);
+    }
+    // 连接器在不参与负载均衡的kloop_t内运行
+    kloop_t* loop = knet_loop_create();
+    for (int i = 0; i < TEST_CHANNEL_REUSEPORT_COUNT; i++) {
+        kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+        knet_channel_ref_set_cb(connector, &holder::connector_cb);
+        knet_channel_ref_connect(connector, "127.0.0.1", 8002, 1);
+    }
+    for (int i = 0; i < 5000; i++) {
+        if ((Test_Channel_Ref_Reuseport_Connected == TEST_CHANNEL_REUSEPORT_COUNT) &&
+            (Test_Channel_Ref_Reuseport_Accepted[0] + Test_Channel_Ref_Reuseport_Accepted[1] == TEST_CHANNEL_REUSEPORT_COUNT)) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    for (int i = 0; i < 2; i++) {
+        thread_runner_destroy(runner[i]);
+    }
+    EXPECT_TRUE(Test_Channel_Ref_Reuseport_Connected == TEST_CHANNEL_REUSEPORT_COUNT);
+    EXPECT_TRUE(Test_Channel_Ref_Reuseport_Accepted[0] + Test_Channel_Ref_Reuseport_Accepted[1] == TEST_CHANNEL_REUSEPORT_COUNT);
+    // 内核将连接分配到两个监听器
+    EXPECT_TRUE(Test_Channel_Ref_Reuseport_Accepted[0] > 0);
+    EXPECT_TRUE(Test_Channel_Ref_Reuseport_Accepted[1] > 0);
+    EXPECT_TRUE(0 == Test_Channel_Ref_Reuseport_Wrong_Thread);
+    knet_loop_destroy(loop);
+    for (int i = 0; i < 2; i++) {
+        knet_loop_destroy(Test_Channel_Ref_Reuseport_Loop[i]);
+    }
+    knet_loop_balancer_destroy(balancer);
+}
+
+#define TEST_CHANNEL_SEND_GATHER_CHUNK 1024
+#define TEST_CHANNEL_SEND_GATHER_COUNT 4096
+
+int Test_Channel_Send_Gather_Bytes = 0;
+int Test_Channel_Send_Gather_Error = 0;
+
+CASE(Test_Channel_Send_Gather) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[TEST_CHANNEL_SEND_GATHER_CHUNK];
+            if (e & channel_cb_event_connect) {
+                // 一次压入大量缓冲区, 发送链表以聚集方式批量写入
+                for (int i = 0; i < TEST_CHANNEL_SEND_GATHER_COUNT; i++) {
+                    memset(buffer, i & 0xff, sizeof(buffer));
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_SEND_GATHER_CHUNK * 64];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int bytes = knet_stream_available(stream);
+                if (bytes > (int)sizeof(buffer)) {
+                    bytes = (int)sizeof(buffer);
+                }
+                knet_stream_pop(stream, buffer, bytes);
+                // 校验字节顺序: 第k字节属于第k/1024个缓冲区
+                for (int i = 0; i < bytes; i++) {
+                    int offset = Test_Channel_Send_Gather_Bytes + i;
+                    if ((char)((offset / TEST_CHANNEL_SEND_GATHER_CHUNK) & 0xff) != buffer[i]) {
+                        Test_Channel_Send_Gather_Error++;
+                    }
+                }
+                Test_Channel_Send_Gather_Bytes += bytes;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, TEST_CHANNEL_SEND_GATHER_CHUNK * 128);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8005, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, TEST_CHANNEL_SEND_GATHER_COUNT, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8005, 1);
+    for (int i = 0; i < 50000; i++) {
+        if (Test_Channel_Send_Gather_Bytes == TEST_CHANNEL_SEND_GATHER_CHUNK * TEST_CHANNEL_SEND_GATHER_COUNT) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Send_Gather_Bytes == TEST_CHANNEL_SEND_GATHER_CHUNK * TEST_CHANNEL_SEND_GATHER_COUNT);
+    EXPECT_TRUE(0 == Test_Channel_Send_Gather_Error);
+    knet_loop_destroy(loop);
+}
+
+#ifndef WIN32
+#define TEST_CHANNEL_SEND_FILE_BYTES (1024 * 1024 * 3 + 17)
+
+int Test_Channel_Send_File_Bytes = 0;
+int Test_Channel_Send_File_Error = 0;
+
+// 期望收到的第offset个字节: "head" + 文件区域 + "tail"
+char Test_Channel_Send_File_Expect(int offset) {
+    if (offset < 4) {
+        return "head"[offset];
+    }
+    offset -= 4;
+    if (offset < TEST_CHANNEL_SEND_FILE_BYTES) {
+        // 文件从第100字节开始发送
+        return (char)((offset + 100) % 251);
+    }
+    return "tail"[offset - TEST_CHANNEL_SEND_FILE_BYTES];
+}
+
+int Test_Channel_Send_File_Fd = -1;
+
+CASE(Test_Channel_Send_File) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                // 文件区域与前后写入的数据保持顺序
+                knet_stream_push(knet_channel_ref_get_stream(channel), "head", 4);
+                EXPECT_TRUE(error_ok == knet_channel_ref_send_file(channel, Test_Channel_Send_File_Fd, 100, TEST_CHANNEL_SEND_FILE_BYTES));
+                knet_stream_push(knet_channel_ref_get_stream(channel), "tail", 4);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[1024 * 64];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int bytes = knet_stream_available(stream);
+                knet_stream_pop(stream, buffer, bytes);
+                for (int i = 0; i < bytes; i++) {
+                    if (buffer[i] != Test_Channel_Send_File_Expect(Test_Channel_Send_File_Bytes + i)) {
+                        Test_Channel_Send_File_Error++;
+                    }
+                }
+                Test_Channel_Send_File_Bytes += bytes;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    char path[] = "/tmp/knet_send_file_XXXXXX";
+    Test_Channel_Send_File_Fd = mkstemp(path);
+    EXPECT_TRUE(Test_Channel_Send_File_Fd >= 0);
+    unlink(path);
+    static char data[TEST_CHANNEL_SEND_FILE_BYTES + 200];
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (char)(i % 251);
+    }
+    EXPECT_TRUE((int)sizeof(data) == write(Test_Channel_Send_File_Fd, data, sizeof(data)));
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8008, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8008, 1);
+    for (int i = 0; i < 50000; i++) {
+        if (Test_Channel_Send_File_Bytes == TEST_CHANNEL_SEND_FILE_BYTES + 8) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Send_File_Bytes == TEST_CHANNEL_SEND_FILE_BYTES + 8);
+    EXPECT_TRUE(0 == Test_Channel_Send_File_Error);
+    // 发送完毕后管道关闭了文件描述符
+    EXPECT_TRUE(-1 == fcntl(Test_Channel_Send_File_Fd, F_GETFD));
+    knet_loop_destroy(loop);
+}
+#endif // WIN32
+
+#define TEST_CHANNEL_RELAY_UP   (1024 * 1024 * 2)
+#define TEST_CHANNEL_RELAY_DOWN (1024 * 1024)
+
+kchannel_ref_t* Test_Channel_Relay_Upstream  = 0;
+kchannel_ref_t* Test_Channel_Relay_Client    = 0;
+int             Test_Channel_Relay_Connected = 0;
+int             Test_Channel_Relay_Up        = 0;
+int             Test_Channel_Relay_Down      = 0;
+int             Test_Channel_Relay_Error     = 0;
+
+CASE(Test_Channel_Relay) {
+    struct holder {
+        static void push_pattern(kchannel_ref_t* channel, int size) {
+            static char buffer[1024];
+            for (int i = 0; i < size; i += (int)sizeof(buffer)) {
+                memset(buffer, (i / (int)sizeof(buffer)) & 0xff, sizeof(buffer));
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void check_pattern(kchannel_ref_t* channel, int* total) {
+            static char buffer[1024 * 64];
+            kstream_t* stream = knet_channel_ref_get_stream(channel);
+            int bytes = knet_stream_available(stream);
+            knet_stream_pop(stream, buffer, bytes);
+            for (int i = 0; i < bytes; i++) {
+                if (buffer[i] != (char)(((*total + i) / 1024) & 0xff)) {
+                    Test_Channel_Relay_Error++;
+                }
+            }
+            *total += bytes;
+        }
+
+        // 后端服务器收到客户端数据, 全部收到后回应
+        static void backend_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                check_pattern(channel, &Test_Channel_Relay_Up);
+                if (Test_Channel_Relay_Up == TEST_CHANNEL_RELAY_UP) {
+                    push_pattern(channel, TEST_CHANNEL_RELAY_DOWN);
+                }
+            }
+        }
+
+        static void backend_acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::backend_cb);
+            }
+        }
+
+        static void upstream_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                Test_Channel_Relay_Connected = 1;
+            } else if (e & channel_cb_event_recv) {
+                // 中继期间不会收到读事件
+                Test_Channel_Relay_Error++;
+            }
+        }
+
+        // 代理接受客户端连接后与上游连接双向中继
+        static void proxy_acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                EXPECT_TRUE(error_ok == knet_channel_ref_relay(channel, Test_Channel_Relay_Upstream));
+                EXPECT_TRUE(error_ok == knet_channel_ref_relay(Test_Channel_Relay_Upstream, channel));
+                // 已经存在中继关系
+                EXPECT_TRUE(error_ok != knet_channel_ref_relay(channel, Test_Channel_Relay_Upstream));
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                push_pattern(channel, TEST_CHANNEL_RELAY_UP);
+            } else if (e & channel_cb_event_recv) {
+                check_pattern(channel, &Test_Channel_Relay_Down);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* backend = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(backend, &holder::backend_acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(backend, 0, 8010, 1));
+    Test_Channel_Relay_Upstream = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(Test_Channel_Relay_Upstream, &holder::upstream_cb);
+    knet_channel_ref_connect(Test_Channel_Relay_Upstream, "127.0.0.1", 8010, 1);
+    for (int i = 0; (i < 5000) && !Test_Channel_Relay_Connected; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Relay_Connected);
+    kchannel_ref_t* proxy = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(proxy, &holder::proxy_acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(proxy, 0, 8009, 1));
+    Test_Channel_Relay_Client = knet_loop_create_channel(loop, TEST_CHANNEL_RELAY_UP / 1024, 1024 * 64);
+    knet_channel_ref_set_cb(Test_Channel_Relay_Client, &holder::client_cb);
+    knet_channel_ref_connect(Test_Channel_Relay_Client, "127.0.0.1", 8009, 1);
+    for (int i = 0; i < 50000; i++) {
+        if (Test_Channel_Relay_Down == TEST_CHANNEL_RELAY_DOWN) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Relay_Up == TEST_CHANNEL_RELAY_UP);
+    EXPECT_TRUE(Test_Channel_Relay_Down == TEST_CHANNEL_RELAY_DOWN);
+    EXPECT_TRUE(0 == Test_Channel_Relay_Error);
+    EXPECT_TRUE(TEST_CHANNEL_RELAY_UP + TEST_CHANNEL_RELAY_DOWN ==
+        knet_loop_profile_get_relay_bytes(knet_loop_get_profile(loop)));
+    knet_loop_destroy(loop);
+}
+
+#define TEST_CHANNEL_RELAY_FLUSH_BYTES (1024 * 1024 * 16)
+
+kchannel_ref_t* Test_Channel_Relay_Flush_Upstream  = 0;
+kchannel_ref_t* Test_Channel_Relay_Flush_Proxy     = 0;
+kchannel_ref_t* Test_Channel_Relay_Flush_Backend   = 0;
+int             Test_Channel_Relay_Flush_Connected = 0;
+int             Test_Channel_Relay_Flush_Consume   = 0;
+int             Test_Channel_Relay_Flush_Bytes     = 0;
+int             Test_Channel_Relay_Flush_Error     = 0;
+
+CASE(Test_Channel_Relay_Close_Flush) {
+    struct holder {
+        static void consume(kchannel_ref_t* channel) {
+            static char buffer[1024 * 64];
+            kstream_t* stream = knet_channel_ref_get_stream(channel);
+            int bytes = knet_stream_available(stream);
+            knet_stream_pop(stream, buffer, bytes);
+            for (int i = 0; i < bytes; i++) {
+                if (buffer[i] != (char)(((Test_Channel_Relay_Flush_Bytes + i) / 1024) & 0xff)) {
+                    Test_Channel_Relay_Flush_Error++;
+                }
+            }
+            Test_Channel_Relay_Flush_Bytes += bytes;
+        }
+
+        // 后端先不读取, 让代理的内核管道内积压数据
+        static void backend_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if ((e & channel_cb_event_recv) && Test_Channel_Relay_Flush_Consume) {
+                consume(channel);
+            }
+        }
+
+        static void backend_acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Channel_Relay_Flush_Backend = knet_channel_ref_share(channel);
+                knet_channel_ref_set_cb(channel, &holder::backend_cb);
+            }
+        }
+
+        static void upstream_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                Test_Channel_Relay_Flush_Connected = 1;
+            }
+        }
+
+        static void proxy_acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Channel_Relay_Flush_Proxy = knet_channel_ref_share(channel);
+                EXPECT_TRUE(error_ok == knet_channel_ref_relay(channel, Test_Channel_Relay_Flush_Upstream));
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[1024];
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_CHANNEL_RELAY_FLUSH_BYTES; i += (int)sizeof(buffer)) {
+                    memset(buffer, (i / (int)sizeof(buffer)) & 0xff, sizeof(buffer));
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+            }
+        }
+    };
+    Test_Channel_Relay_Flush_Upstream  = 0;
+    Test_Channel_Relay_Flush_Proxy     = 0;
+    Test_Channel_Relay_Flush_Backend   = 0;
+    Test_Channel_Relay_Flush_Connected = 0;
+    Test_Channel_Relay_Flush_Consume   = 0;
+    Test_Channel_Relay_Flush_Bytes     = 0;
+    Test_Channel_Relay_Flush_Error     = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* backend = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(backend, &holder::backend_acceptor_cb);
+    knet_channel_ref_set_recv_backpressure(backend, 1);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(backend, 0, 8022, 1));
+    Test_Channel_Relay_Flush_Upstream = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(Test_Channel_Relay_Flush_Upstream, &holder::upstream_cb);
+    knet_channel_ref_connect(Test_Channel_Relay_Flush_Upstream, "127.0.0.1", 8022, 1);
+    for (int i = 0; (i < 5000) && !Test_Channel_Relay_Flush_Connected; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Relay_Flush_Connected);
+    kchannel_ref_t* proxy = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(proxy, &holder::proxy_acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(proxy, 0, 8023, 1));
+    kchannel_ref_t* client = knet_loop_create_channel(loop, TEST_CHANNEL_RELAY_FLUSH_BYTES / 1024, 1024);
+    knet_channel_ref_set_cb(client, &holder::client_cb);
+    knet_channel_ref_connect(client, "127.0.0.1", 8023, 1);
+    // 运行到后端和上游的内核缓冲区都已填满
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (time_get_monotonic_milliseconds() - start < 500) {
+        knet_loop_run_once(loop);
+    }
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    uint64_t relayed = knet_loop_profile_get_relay_bytes(profile);
+    EXPECT_TRUE(relayed > 0);
+    EXPECT_TRUE(Test_Channel_Relay_Flush_Proxy != 0);
+    // 关闭来源管道, 内核管道内已读取的数据写入上游
+    if (Test_Channel_Relay_Flush_Proxy) {
+        knet_channel_ref_close(Test_Channel_Relay_Flush_Proxy);
+        knet_channel_ref_leave(Test_Channel_Relay_Flush_Proxy);
+    }
+    EXPECT_TRUE(knet_loop_profile_get_relay_bytes(profile) > relayed);
+    EXPECT_TRUE(knet_channel_ref_check_state(Test_Channel_Relay_Flush_Upstream, channel_state_active));
+    Test_Channel_Relay_Flush_Consume = 1;
+    if (Test_Channel_Relay_Flush_Backend) {
+        holder::consume(Test_Channel_Relay_Flush_Backend);
+    }
+    start = time_get_monotonic_milliseconds();
+    while ((Test_Channel_Relay_Flush_Bytes < (int)knet_loop_profile_get_relay_bytes(profile)) &&
+        (time_get_monotonic_milliseconds() - start < 5000)) {
+        knet_loop_run_once(loop);
+    }
+    // 后端收到了中继的全部数据, 包括关闭时内核管道内的数据
+    EXPECT_TRUE(Test_Channel_Relay_Flush_Bytes == (int)knet_loop_profile_get_relay_bytes(profile));
+    EXPECT_TRUE(0 == Test_Channel_Relay_Flush_Error);
+    if (Test_Channel_Relay_Flush_Backend) {
+        knet_channel_ref_leave(Test_Channel_Relay_Flush_Backend);
+    }
+    knet_loop_destroy(loop);
+}
+
+#define TEST_CHANNEL_BACKPRESSURE_BYTES (256 * 1024)
+#define TEST_CHANNEL_BACKPRESSURE_RING  4096
+
+kchannel_ref_t* Test_Channel_Backpressure_Server = 0;
+int             Test_Channel_Backpressure_Close  = 0;
+int             Test_Channel_Backpressure_Full   = 0;
+
+CASE(Test_Channel_Recv_Backpressure) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[1024] = {0};
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_CHANNEL_BACKPRESSURE_BYTES / (int)sizeof(buffer); i++) {
+                    for (int j = 0; j < (int)sizeof(buffer); j++) {
+                        buffer[j] = (char)((i * (int)sizeof(buffer) + j) % 251);
+                    }
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            // 回调内不取出数据, 模拟处理缓慢的消费者
+            if (e & channel_cb_event_close) {
+                Test_Channel_Backpressure_Close++;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                // 继承监听管道的设置
+                EXPECT_TRUE(knet_channel_ref_check_recv_backpressure(channel));
+                Test_Channel_Backpressure_Server = knet_channel_ref_share(channel);
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Channel_Backpressure_Server = 0;
+    Test_Channel_Backpressure_Close  = 0;
+    Test_Channel_Backpressure_Full   = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, TEST_CHANNEL_BACKPRESSURE_RING);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(!knet_channel_ref_check_recv_backpressure(acceptor));
+    knet_channel_ref_set_recv_backpressure(acceptor, 1);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8013, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, TEST_CHANNEL_BACKPRESSURE_BYTES / 1024, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8013, 1);
+    char buffer[1000] = {0};
+    int  offset = 0;
+    int  error  = 0;
+    int  paused = -1; // 暂停读取期间上一次取出后剩余的字节数
+    int  early  = 0;
+    for (int i = 0; (i < 50000) && (offset < TEST_CHANNEL_BACKPRESSURE_BYTES); i++) {
+        knet_loop_run_once(loop);
+        if (!Test_Channel_Backpressure_Server) {
+            continue;
+        }
+        kstream_t* stream = knet_channel_ref_get_stream(Test_Channel_Backpressure_Server);
+        if ((paused >= 0) && ((int)knet_stream_available(stream) > paused)) {
+            // 读缓冲区回落到一半以下之前不会恢复读取
+            early++;
+        }
+        if (knet_stream_available(stream) == TEST_CHANNEL_BACKPRESSURE_RING) {
+            // 读缓冲区满后等待几次循环, 管道不会被关闭
+            if (++Test_Channel_Backpressure_Full % 4) {
+                continue;
+            }
+        }
+        // 在回调之外取出数据, 恢复读取
+        int size = knet_stream_available(stream);
+        if (size > (int)sizeof(buffer)) {
+            size = (int)sizeof(buffer);
+        }
+        if (!size) {
+            continue;
+        }
+        if (knet_stream_available(stream) == TEST_CHANNEL_BACKPRESSURE_RING) {
+            // 读缓冲区满, 已经暂停读取
+            paused = 0;
+        }
+        knet_stream_pop(stream, buffer, size);
+        for (int j = 0; j < size; j++) {
+            if (buffer[j] != (char)((offset + j) % 251)) {
+                error++;
+            }
+        }
+        offset += size;
+        if (paused >= 0) {
+            paused = (int)knet_stream_available(stream);
+            if (paused <= TEST_CHANNEL_BACKPRESSURE_RING / 2) {
+                paused = -1;
+            }
+        }
+    }
+    EXPECT_TRUE(TEST_CHANNEL_BACKPRESSURE_BYTES == offset);
+    EXPECT_TRUE(0 == error);
+    EXPECT_TRUE(0 == early);
+    EXPECT_TRUE(0 == Test_Channel_Backpressure_Close);
+    EXPECT_TRUE(Test_Channel_Backpressure_Full > 0);
+    if (Test_Channel_Backpressure_Server) {
+        knet_channel_ref_leave(Test_Channel_Backpressure_Server);
+    }
+    knet_loop_destroy(loop);
+}
+
+#define TEST_CHANNEL_ELASTIC_BYTES 20000
+
+kchannel_ref_t* Test_Channel_Elastic_Server   = 0;
+int             Test_Channel_Elastic_Recv     = 0;
+int             Test_Channel_Elastic_Error    = 0;
+uint32_t        Test_Channel_Elastic_Max_Size = 0;
+
+CASE(Test_Channel_Elastic_Recv_Buffer) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_ELASTIC_BYTES];
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_CHANNEL_ELASTIC_BYTES; i++) {
+                    buffer[i] = (char)(i % 251);
+                }
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_ELASTIC_BYTES];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                uint32_t   size   = knet_channel_ref_get_recv_buffer_size(channel);
+                if (size > Test_Channel_Elastic_Max_Size) {
+                    Test_Channel_Elastic_Max_Size = size;
+                }
+                // 整帧到达后才取出, 读缓冲区需要扩大
+                if (knet_stream_available(stream) < TEST_CHANNEL_ELASTIC_BYTES) {
+                    return;
+                }
+                knet_stream_pop(stream, buffer, sizeof(buffer));
+                for (int i = 0; i < TEST_CHANNEL_ELASTIC_BYTES; i++) {
+                    if (buffer[i] != (char)(i % 251)) {
+                        Test_Channel_Elastic_Error++;
+                    }
+                }
+                Test_Channel_Elastic_Recv = 1;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                // 第一次可读时才分配
+                EXPECT_TRUE(0 == knet_channel_ref_get_recv_buffer_size(channel));
+                Test_Channel_Elastic_Server = knet_channel_ref_share(channel);
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Channel_Elastic_Server   = 0;
+    Test_Channel_Elastic_Recv     = 0;
+    Test_Channel_Elastic_Error    = 0;
+    Test_Channel_Elastic_Max_Size = 0;
+    kloop_t* loop = knet_loop_create();
+    knet_loop_set_recv_buffer_init(loop, 1024);
+    knet_loop_set_recv_buffer_idle(loop, 100);
+    EXPECT_TRUE(1024 == knet_loop_get_recv_buffer_init(loop));
+    EXPECT_TRUE(100 == knet_loop_get_recv_buffer_idle(loop));
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 64 * 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8014, 1));
+    EXPECT_TRUE(0 == knet_channel_ref_get_recv_buffer_size(acceptor));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8014, 1);
+    for (int i = 0; (i < 50000) && !Test_Channel_Elastic_Recv; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Channel_Elastic_Recv);
+    EXPECT_TRUE(0 == Test_Channel_Elastic_Error);
+    // 初始长度按倍数扩大到能容纳整帧, 不超过最大长度
+    EXPECT_TRUE(32 * 1024 == Test_Channel_Elastic_Max_Size);
+    // 空闲后归还到内存池
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (Test_Channel_Elastic_Server && knet_channel_ref_get_recv_buffer_size(Test_Channel_Elastic_Server) &&
+        (time_get_monotonic_milliseconds() - start < 2000)) {
+        knet_loop_run_once(loop);
+        thread_sleep_ms(1);
+    }
+    EXPECT_TRUE(Test_Channel_Elastic_Server != 0);
+    if (Test_Channel_Elastic_Server) {
+        EXPECT_TRUE(0 == knet_channel_ref_get_recv_buffer_size(Test_Channel_Elastic_Server));
+        // 归还后再次收到数据时重新分配, 再次空闲后同样被回收
+        static char buffer[TEST_CHANNEL_ELASTIC_BYTES];
+        for (int i = 0; i < TEST_CHANNEL_ELASTIC_BYTES; i++) {
+            buffer[i] = (char)(i % 251);
+        }
+        Test_Channel_Elastic_Recv = 0;
+        knet_stream_push(knet_channel_ref_get_stream(connector), buffer, sizeof(buffer));
+        for (int i = 0; (i < 50000) && !Test_Channel_Elastic_Recv; i++) {
+            knet_loop_run_once(loop);
+        }
+        EXPECT_TRUE(Test_Channel_Elastic_Recv);
+        EXPECT_TRUE(0 == Test_Channel_Elastic_Error);
+        start = time_get_monotonic_milliseconds();
+        while (knet_channel_ref_get_recv_buffer_size(Test_Channel_Elastic_Server) &&
+            (time_get_monotonic_milliseconds() - start < 2000)) {
+            knet_loop_run_once(loop);
+            thread_sleep_ms(1);
+        }
+        EXPECT_TRUE(0 == knet_channel_ref_get_recv_buffer_size(Test_Channel_Elastic_Server));
+        knet_channel_ref_leave(Test_Channel_Elastic_Server);
+    }
+    knet_loop_destroy(loop);
+}
+
+#define TEST_CHANNEL_WATERMARK_HIGH  (256 * 1024)
+#define TEST_CHANNEL_WATERMARK_LOW   (64 * 1024)
+#define TEST_CHANNEL_WATERMARK_CHUNK (64 * 1024)
+#define TEST_CHANNEL_WATERMARK_MAX   (256 * 1024 * 1024)
+
+kchannel_ref_t* Test_Channel_Watermark_Server  = 0;
+int             Test_Channel_Watermark_High    = 0;
+int             Test_Channel_Watermark_Drain   = 0;
+int             Test_Channel_Watermark_Close   = 0;
+int             Test_Channel_Watermark_Consume = 0;
+uint64_t        Test_Channel_Watermark_Bytes   = 0;
+
+CASE(Test_Channel_Send_Watermark) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_WATERMARK_CHUNK];
+            if (e & channel_cb_event_connect) {
+                // 对端不读取, 写入直到达到高水位
+                for (int i = 0; !Test_Channel_Watermark_High && (i < TEST_CHANNEL_WATERMARK_MAX / TEST_CHANNEL_WATERMARK_CHUNK); i++) {
+                    if (error_ok != knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer))) {
+                        break;
+                    }
+                }
+            } else if (e & channel_cb_event_send_high) {
+                Test_Channel_Watermark_High++;
+                Test_Channel_Watermark_Bytes = knet_channel_ref_get_send_bytes(channel);
+            } else if (e & channel_cb_event_drain) {
+                Test_Channel_Watermark_Drain++;
+                Test_Channel_Watermark_Bytes = knet_channel_ref_get_send_bytes(channel);
+            } else if (e & channel_cb_event_close) {
+                Test_Channel_Watermark_Close++;
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if ((e & channel_cb_event_recv) && Test_Channel_Watermark_Consume) {
+                knet_stream_eat_all(knet_channel_ref_get_stream(channel));
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Channel_Watermark_Server = knet_channel_ref_share(channel);
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Channel_Watermark_Server  = 0;
+    Test_Channel_Watermark_High    = 0;
+    Test_Channel_Watermark_Drain   = 0;
+    Test_Channel_Watermark_Close   = 0;
+    Test_Channel_Watermark_Consume = 0;
+    Test_Channel_Watermark_Bytes   = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_set_recv_backpressure(acceptor, 1);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8015, 1));
+    // 发送链表最大长度为1, 由字节水位代替
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    EXPECT_TRUE(error_invalid_parameters == knet_channel_ref_set_send_watermark(connector, 1024, 1024));
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_send_watermark(connector, TEST_CHANNEL_WATERMARK_HIGH, TEST_CHANNEL_WATERMARK_LOW));
+    EXPECT_TRUE(TEST_CHANNEL_WATERMARK_HIGH == knet_channel_ref_get_send_high_watermark(connector));
+    EXPECT_TRUE(TEST_CHANNEL_WATERMARK_LOW == knet_channel_ref_get_send_low_watermark(connector));
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    knet_channel_ref_connect(connector, "127.0.0.1", 8015, 1);
+    for (int i = 0; (i < 50000) && !Test_Channel_Watermark_High; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Channel_Watermark_High);
+    EXPECT_TRUE(Test_Channel_Watermark_Bytes >= TEST_CHANNEL_WATERMARK_HIGH);
+    EXPECT_TRUE(0 == Test_Channel_Watermark_Close);
+    // 对端开始读取, 未发送字节数回落
+    Test_Channel_Watermark_Consume = 1;
+    if (Test_Channel_Watermark_Server) {
+        knet_stream_eat_all(knet_channel_ref_get_stream(Test_Channel_Watermark_Server));
+    }
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (!Test_Channel_Watermark_Drain && (time_get_monotonic_milliseconds() - start < 5000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Channel_Watermark_Drain);
+    EXPECT_TRUE(1 == Test_Channel_Watermark_High);
+    EXPECT_TRUE(Test_Channel_Watermark_Bytes <= TEST_CHANNEL_WATERMARK_LOW);
+    EXPECT_TRUE(0 == Test_Channel_Watermark_Close);
+    if (Test_Channel_Watermark_Server) {
+        knet_channel_ref_leave(Test_Channel_Watermark_Server);
+    }
+    knet_loop_destroy(loop);
+}
+
+int      Test_Channel_Watermark_Cap_Fail  = 0;
+int      Test_Channel_Watermark_Cap_Close = 0;
+uint64_t Test_Channel_Watermark_Cap_Bytes = 0;
+
+CASE(Test_Channel_Send_Watermark_Hard_Cap) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_WATERMARK_CHUNK];
+            if (e & channel_cb_event_connect) {
+                // 忽略高水位通知一直写入, 对端不读取
+                for (int i = 0; i < TEST_CHANNEL_WATERMARK_MAX / TEST_CHANNEL_WATERMARK_CHUNK; i++) {
+                    Test_Channel_Watermark_Cap_Bytes = knet_channel_ref_get_send_bytes(channel);
+                    if (error_ok != knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer))) {
+                        Test_Channel_Watermark_Cap_Fail++;
+                        break;
+                    }
+                }
+            } else if (e & channel_cb_event_close) {
+                Test_Channel_Watermark_Cap_Close++;
+            }
+        }
+    };
+    Test_Channel_Watermark_Cap_Fail  = 0;
+    Test_Channel_Watermark_Cap_Close = 0;
+    Test_Channel_Watermark_Cap_Bytes = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_recv_backpressure(acceptor, 1);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8021, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_set_send_watermark(connector, TEST_CHANNEL_WATERMARK_HIGH, TEST_CHANNEL_WATERMARK_LOW));
+    knet_channel_ref_connect(connector, "127.0.0.1", 8021, 1);
+    for (int i = 0; (i < 50000) && !Test_Channel_Watermark_Cap_Fail; i++) {
+        knet_loop_run_once(loop);
+    }
+    // 未发送字节数达到高水位的4倍后写入失败, 最多超出一次写入的长度
+    EXPECT_TRUE(1 == Test_Channel_Watermark_Cap_Fail);
+    EXPECT_TRUE(1 == Test_Channel_Watermark_Cap_Close);
+    EXPECT_TRUE(Test_Channel_Watermark_Cap_Bytes >= TEST_CHANNEL_WATERMARK_HIGH * 4);
+    EXPECT_TRUE(Test_Channel_Watermark_Cap_Bytes < TEST_CHANNEL_WATERMARK_HIGH * 4 + TEST_CHANNEL_WATERMARK_CHUNK);
+    knet_loop_destroy(loop);
+}
+
+kchannel_ref_t* Test_Channel_Cork_Server    = 0;
+uint64_t        Test_Channel_Cork_Held      = 0;
+int             Test_Channel_Cork_First     = 0;
+int             Test_Channel_Cork_Available = 0;
+
+CASE(Test_Channel_Auto_Cork) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                // 一条应答分为头部, 消息体和尾部三次写入
+                char header[10] = {0};
+                char body[100]  = {0};
+                char tail[10]   = {0};
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                EXPECT_TRUE(error_ok == knet_stream_push(stream, header, sizeof(header)));
+                EXPECT_TRUE(error_ok == knet_stream_push(stream, body, sizeof(body)));
+                EXPECT_TRUE(error_ok == knet_stream_push(stream, tail, sizeof(tail)));
+                // 回调内不发送
+                Test_Channel_Cork_Held = knet_channel_ref_get_send_bytes(channel);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if ((e & channel_cb_event_recv) && !Test_Channel_Cork_First) {
+                Test_Channel_Cork_First     = 1;
+                Test_Channel_Cork_Available = knet_stream_available(knet_channel_ref_get_stream(channel));
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                // 继承监听管道的设置
+                EXPECT_TRUE(channel_cork_on == knet_channel_ref_get_auto_cork(channel));
+                Test_Channel_Cork_Server = knet_channel_ref_share(channel);
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Channel_Cork_Server    = 0;
+    Test_Channel_Cork_Held      = 0;
+    Test_Channel_Cork_First     = 0;
+    Test_Channel_Cork_Available = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_set_auto_cork(acceptor, channel_cork_on);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8016, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    EXPECT_TRUE(channel_cork_off == knet_channel_ref_get_auto_cork(connector));
+    knet_channel_ref_set_auto_cork(connector, channel_cork_tcp);
+    EXPECT_TRUE(channel_cork_tcp == knet_channel_ref_get_auto_cork(connector));
+    knet_channel_ref_connect(connector, "127.0.0.1", 8016, 1);
+    for (int i = 0; (i < 50000) && !Test_Channel_Cork_First; i++) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(120 == Test_Channel_Cork_Held);
+    // 三次写入合并为一次发送, 对端第一次读取时全部到达
+    EXPECT_TRUE(120 == Test_Channel_Cork_Available);
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    // 关闭后立即发送
+    knet_channel_ref_set_auto_cork(connector, channel_cork_off);
+    char data[8] = {0};
+    EXPECT_TRUE(error_ok == knet_stream_push(knet_channel_ref_get_stream(connector), data, sizeof(data)));
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    if (Test_Channel_Cork_Server) {
+        knet_channel_ref_leave(Test_Channel_Cork_Server);
+    }
+    knet_loop_destroy(loop);
+}
+
+#if defined(__linux__) && defined(TCP_CORK)
+#define TEST_CHANNEL_CORK_TCP_CHUNK (64 * 1024)
+#define TEST_CHANNEL_CORK_TCP_COUNT 16
+
+kchannel_ref_t* Test_Channel_Cork_Tcp_Connector = 0;
+int             Test_Channel_Cork_Tcp_Bytes     = 0;
+
+CASE(Test_Channel_Auto_Cork_Tcp_Lifetime) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_CHANNEL_CORK_TCP_CHUNK];
+            int size = 16 * 1024;
+            if (e & channel_cb_event_connect) {
+                // 减小发送缓冲区, 一次迭代内无法发送全部合并的数据
+                setsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_SNDBUF, (char*)&size, sizeof(size));
+                for (int i = 0; i < TEST_CHANNEL_CORK_TCP_COUNT; i++) {
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+                Test_Channel_Cork_Tcp_Connector = channel;
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Channel_Cork_Tcp_Bytes += (int)knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+
+        static int corked(kchannel_ref_t* channel) {
+            int       on  = 0;
+            socklen_t len = sizeof(on);
+            getsockopt(knet_channel_ref_get_socket_fd(channel), IPPROTO_TCP, TCP_CORK, (char*)&on, &len);
+            return on;
+        }
+    };
+    Test_Channel_Cork_Tcp_Connector = 0;
+    Test_Channel_Cork_Tcp_Bytes     = 0;
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 1024 * 4);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8027, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, TEST_CHANNEL_CORK_TCP_COUNT, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_set_auto_cork(connector, channel_cork_tcp);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8027, 1);
+    int      pending  = 0;
+    int      uncorked = 0;
+    uint64_t start    = time_get_monotonic_milliseconds();
+    while ((Test_Channel_Cork_Tcp_Bytes < TEST_CHANNEL_CORK_TCP_CHUNK * TEST_CHANNEL_CORK_TCP_COUNT) &&
+        (time_get_monotonic_milliseconds() - start < 10000)) {
+        knet_loop_run_once(loop);
+        if (Test_Channel_Cork_Tcp_Connector && knet_channel_ref_get_send_bytes(Test_Channel_Cork_Tcp_Connector)) {
+            // 发送链表清空前保持TCP_CORK
+            pending++;
+            if (!holder::corked(Test_Channel_Cork_Tcp_Connector)) {
+                uncorked++;
+            }
+        }
+    }
+    EXPECT_TRUE(TEST_CHANNEL_CORK_TCP_CHUNK * TEST_CHANNEL_CORK_TCP_COUNT == Test_Channel_Cork_Tcp_Bytes);
+    EXPECT_TRUE(pending > 0);
+    EXPECT_TRUE(0 == uncorked);
+    // 发送链表清空后关闭TCP_CORK, 不等待内核超时
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    EXPECT_TRUE(0 == holder::corked(connector));
+    knet_loop_destroy(loop);
+}
+#endif // defined(__linux__) && defined(TCP_CORK)
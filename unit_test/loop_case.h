@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2014-2015, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "helper.h"
+#include "knet.h"
+
+CASE(Test_Loop_Wait_Policy) {
+    kloop_t* loop = knet_loop_create();
+    // 默认不自旋, 等待时间由定时器决定
+    EXPECT_TRUE(0 == knet_loop_get_spin_count(loop));
+    EXPECT_TRUE(-1 == knet_loop_get_max_wait(loop));
+    knet_loop_set_spin_count(loop, 100);
+    knet_loop_set_max_wait(loop, 10);
+    EXPECT_TRUE(100 == knet_loop_get_spin_count(loop));
+    EXPECT_TRUE(10 == knet_loop_get_max_wait(loop));
+    // 非法值
+    knet_loop_set_spin_count(loop, -1);
+    knet_loop_set_max_wait(loop, -100);
+    EXPECT_TRUE(0 == knet_loop_get_spin_count(loop));
+    EXPECT_TRUE(-1 == knet_loop_get_max_wait(loop));
+    knet_loop_destroy(loop);
+}
+
+CASE(Test_Loop_Idle_Wakeup) {
+    kloop_t* loop = knet_loop_create();
+    kthread_runner_t* runner = thread_runner_create(0, 0);
+    thread_runner_start_loop(runner, loop, 0);
+    // 空闲的loop阻塞在选取器内
+    thread_sleep_ms(100);
+    uint64_t start = time_get_milliseconds();
+    // 停止线程时唤醒loop
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(time_get_milliseconds() - start < 1000);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_PRODUCER_COUNT 8
+#define TEST_LOOP_PRODUCER_TIMES 100
+
+kchannel_ref_t*  Test_Loop_Cross_Thread_Connector = 0;
+atomic_counter_t Test_Loop_Cross_Thread_Connected = 0;
+int              Test_Loop_Cross_Thread_Bytes     = 0;
+
+CASE(Test_Loop_Cross_Thread_Event) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                atomic_counter_inc(&Test_Loop_Cross_Thread_Connected);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Loop_Cross_Thread_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+
+        static void producer(kthread_runner_t* runner) {
+            // 其他线程写入, 通过跨线程事件队列转到loop线程发送
+            for (int i = 0; i < TEST_LOOP_PRODUCER_TIMES; i++) {
+                knet_stream_push(knet_channel_ref_get_stream(Test_Loop_Cross_Thread_Connector), "1234", 4);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8000, 10));
+    Test_Loop_Cross_Thread_Connector = knet_loop_create_channel(loop, 4096, 1024);
+    knet_channel_ref_set_cb(Test_Loop_Cross_Thread_Connector, &holder::connector_cb);
+    knet_channel_ref_connect(Test_Loop_Cross_Thread_Connector, "127.0.0.1", 8000, 1);
+    kthread_runner_t* runner = thread_runner_create(0, 0);
+    thread_runner_start_loop(runner, loop, 0);
+    while (atomic_counter_zero(&Test_Loop_Cross_Thread_Connected)) {
+        thread_sleep_ms(1);
+    }
+    kthread_runner_t* producers[TEST_LOOP_PRODUCER_COUNT] = {0};
+    for (int i = 0; i < TEST_LOOP_PRODUCER_COUNT; i++) {
+        producers[i] = thread_runner_create(&holder::producer, 0);
+        thread_runner_start(producers[i], 0);
+    }
+    for (int i = 0; i < TEST_LOOP_PRODUCER_COUNT; i++) {
+        thread_runner_join(producers[i]);
+        thread_runner_destroy(producers[i]);
+    }
+    // 等待loop线程处理完所有事件
+    for (int i = 0; i < 5000; i++) {
+        if (Test_Loop_Cross_Thread_Bytes == TEST_LOOP_PRODUCER_COUNT * TEST_LOOP_PRODUCER_TIMES * 4) {
+            break;
+        }
+        thread_sleep_ms(1);
+    }
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(Test_Loop_Cross_Thread_Bytes == TEST_LOOP_PRODUCER_COUNT * TEST_LOOP_PRODUCER_TIMES * 4);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_ACCEPT_COUNT 32
+
+int Test_Loop_Accept_Budget_Accepted  = 0;
+int Test_Loop_Accept_Budget_Connected = 0;
+
+CASE(Test_Loop_Accept_Budget) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                Test_Loop_Accept_Budget_Connected++;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                Test_Loop_Accept_Budget_Accepted++;
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    EXPECT_TRUE(LOOP_DEFAULT_ACCEPT_BUDGET == knet_loop_get_accept_budget(loop));
+    knet_loop_set_accept_budget(loop, -1);
+    EXPECT_TRUE(0 == knet_loop_get_accept_budget(loop));
+    // 每次事件只接受4个连接, 剩余的连接必须在后续循环内接受
+    knet_loop_set_accept_budget(loop, 4);
+    EXPECT_TRUE(4 == knet_loop_get_accept_budget(loop));
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8001, TEST_LOOP_ACCEPT_COUNT));
+    for (int i = 0; i < TEST_LOOP_ACCEPT_COUNT; i++) {
+        kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+        knet_channel_ref_set_cb(connector, &holder::connector_cb);
+        knet_channel_ref_connect(connector, "127.0.0.1", 8001, 1);
+    }
+    for (int i = 0; i < 5000; i++) {
+        if ((Test_Loop_Accept_Budget_Accepted == TEST_LOOP_ACCEPT_COUNT) &&
+            (Test_Loop_Accept_Budget_Connected == TEST_LOOP_ACCEPT_COUNT)) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Loop_Accept_Budget_Accepted == TEST_LOOP_ACCEPT_COUNT);
+    EXPECT_TRUE(Test_Loop_Accept_Budget_Connected == TEST_LOOP_ACCEPT_COUNT);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_ACCEPT_BALANCE_COUNT 16
+
+kloop_t* Test_Loop_Accept_Balance_Loop[2]     = {0};
+int      Test_Loop_Accept_Balance_Accepted[2] = {0};
+
+CASE(Test_Loop_Accept_Balance) {
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                for (int i = 0; i < 2; i++) {
+                    if (knet_channel_ref_get_loop(channel) == Test_Loop_Accept_Balance_Loop[i]) {
+                        Test_Loop_Accept_Balance_Accepted[i]++;
+                    }
+                }
+            }
+        }
+    };
+
+    kloop_balancer_t* balancer = knet_loop_balancer_create();
+    for (int i = 0; i < 2; i++) {
+        Test_Loop_Accept_Balance_Loop[i] = knet_loop_create();
+        knet_loop_balancer_attach(balancer, Test_Loop_Accept_Balance_Loop[i]);
+    }
+    kloop_t* client_loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(Test_Loop_Accept_Balance_Loop[0], 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8019, TEST_LOOP_ACCEPT_BALANCE_COUNT));
+    for (int i = 0; i < TEST_LOOP_ACCEPT_BALANCE_COUNT; i++) {
+        kchannel_ref_t* connector = knet_loop_create_channel(client_loop, 1, 1024);
+        knet_channel_ref_connect(connector, "127.0.0.1", 8019, 1);
+    }
+    // 所有连接在同一批内被接受
+    knet_loop_run_once(client_loop);
+    thread_sleep_ms(50);
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (time_get_monotonic_milliseconds() - start < 2000) {
+        if (Test_Loop_Accept_Balance_Accepted[0] + Test_Loop_Accept_Balance_Accepted[1] == TEST_LOOP_ACCEPT_BALANCE_COUNT) {
+            break;
+        }
+        knet_loop_run_once(Test_Loop_Accept_Balance_Loop[0]);
+        knet_loop_run_once(Test_Loop_Accept_Balance_Loop[1]);
+        knet_loop_run_once(client_loop);
+    }
+    EXPECT_TRUE(Test_Loop_Accept_Balance_Accepted[0] + Test_Loop_Accept_Balance_Accepted[1] == TEST_LOOP_ACCEPT_BALANCE_COUNT);
+    // 每个连接单独选择, 计入未处理的新连接, 突发连接分散到两个loop
+    EXPECT_TRUE(Test_Loop_Accept_Balance_Accepted[0] >= TEST_LOOP_ACCEPT_BALANCE_COUNT / 4);
+    EXPECT_TRUE(Test_Loop_Accept_Balance_Accepted[1] >= TEST_LOOP_ACCEPT_BALANCE_COUNT / 4);
+    knet_loop_destroy(client_loop);
+    for (int i = 0; i < 2; i++) {
+        knet_loop_destroy(Test_Loop_Accept_Balance_Loop[i]);
+    }
+    knet_loop_balancer_destroy(balancer);
+}
+
+#define TEST_LOOP_BACKEND_COUNT 4
+#define TEST_LOOP_BACKEND_BYTES (64 * 1024)
+
+int Test_Loop_Backend_Echo  = 0;
+int Test_Loop_Backend_Error = 0;
+int Test_Loop_Backend_Close = 0;
+
+CASE(Test_Loop_Backend) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_LOOP_BACKEND_BYTES];
+            kstream_t* stream = knet_channel_ref_get_stream(channel);
+            if (e & channel_cb_event_connect) {
+                // 超过套接字单次可写的长度, 发送链表和写事件都会被使用
+                for (int i = 0; i < TEST_LOOP_BACKEND_BYTES; i++) {
+                    buffer[i] = (char)(i % 251);
+                }
+                knet_stream_push(stream, buffer, sizeof(buffer));
+            } else if (e & channel_cb_event_recv) {
+                if (TEST_LOOP_BACKEND_BYTES != knet_stream_available(stream)) {
+                    return;
+                }
+                knet_stream_pop(stream, buffer, sizeof(buffer));
+                for (int i = 0; i < TEST_LOOP_BACKEND_BYTES; i++) {
+                    if (buffer[i] != (char)(i % 251)) {
+                        Test_Loop_Backend_Error++;
+                        break;
+                    }
+                }
+                Test_Loop_Backend_Echo++;
+                // 对端通过读事件得知连接关闭
+                knet_channel_ref_close(channel);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[1024] = {0};
+            int bytes = 0;
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                bytes = knet_stream_available(stream);
+                while (bytes > 0) {
+                    if (bytes > (int)sizeof(buffer)) {
+                        bytes = (int)sizeof(buffer);
+                    }
+                    knet_stream_pop(stream, buffer, bytes);
+                    knet_stream_push(stream, buffer, bytes);
+                    bytes = knet_stream_available(stream);
+                }
+            } else if (e & channel_cb_event_close) {
+                Test_Loop_Backend_Close++;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    // 默认选取器为第一个可用的选取器
+    EXPECT_TRUE(loop_backend_default != knet_loop_get_backend(loop));
+#if LOOP_EPOLL
+    // io_uring只能显式选择, 默认仍然使用epoll
+    EXPECT_TRUE(loop_backend_epoll == knet_loop_get_backend(loop));
+#endif // LOOP_EPOLL
+    EXPECT_TRUE(0 != knet_loop_get_backend_name(loop));
+    knet_loop_destroy(loop);
+    // 依次使用每个编译进库的选取器完成连接, 回显和关闭
+    for (int backend = loop_backend_select; backend <= loop_backend_iocp; backend++) {
+        loop = knet_loop_create_with_backend((knet_loop_backend_e)backend);
+        if (!loop) {
+            continue;
+        }
+        EXPECT_TRUE(backend == knet_loop_get_backend(loop));
+        Test_Loop_Backend_Echo  = 0;
+        Test_Loop_Backend_Error = 0;
+        Test_Loop_Backend_Close = 0;
+        kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 128, 4096);
+        knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+        EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8003, TEST_LOOP_BACKEND_COUNT));
+        for (int i = 0; i < TEST_LOOP_BACKEND_COUNT; i++) {
+            kchannel_ref_t* connector = knet_loop_create_channel(loop, 8, TEST_LOOP_BACKEND_BYTES);
+            knet_channel_ref_set_cb(connector, &holder::connector_cb);
+            knet_channel_ref_connect(connector, "127.0.0.1", 8003, 1);
+        }
+        uint64_t start = time_get_monotonic_milliseconds();
+        while (((Test_Loop_Backend_Echo < TEST_LOOP_BACKEND_COUNT) || (Test_Loop_Backend_Close < TEST_LOOP_BACKEND_COUNT)) &&
+            (time_get_monotonic_milliseconds() - start < 5000)) {
+            knet_loop_run_once(loop);
+        }
+        EXPECT_TRUE(Test_Loop_Backend_Echo == TEST_LOOP_BACKEND_COUNT);
+        EXPECT_TRUE(0 == Test_Loop_Backend_Error);
+        EXPECT_TRUE(Test_Loop_Backend_Close == TEST_LOOP_BACKEND_COUNT);
+        for (int i = 0; (i < 100) && knet_loop_get_close_channel_count(loop); i++) {
+            knet_loop_run_once(loop);
+        }
+        // 只剩下监听管道
+        EXPECT_TRUE(1 == knet_loop_get_active_channel_count(loop));
+        knet_loop_destroy(loop);
+    }
+}
+
+#ifndef WIN32
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+int Test_Loop_Uring_Reset_Close = 0;
+
+CASE(Test_Loop_Uring_Reset) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                knet_stream_push(knet_channel_ref_get_stream(channel), "hello", 5);
+            } else if (e & channel_cb_event_close) {
+                Test_Loop_Uring_Reset_Close++;
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            struct linger linger = {1, 0};
+            if (e & channel_cb_event_recv) {
+                // linger超时为0, 关闭时向对端发送RST
+                setsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_LINGER, (char*)&linger, sizeof(linger));
+                knet_channel_ref_close(channel);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    kloop_t* loop = knet_loop_create_with_backend(loop_backend_uring);
+    if (!loop) {
+        // 不支持io_uring
+        return;
+    }
+    Test_Loop_Uring_Reset_Close = 0;
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8024, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8024, 1);
+    // 没有设置接收超时, 收到RST后由POLLERR/POLLHUP进入关闭流程
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (!Test_Loop_Uring_Reset_Close && (time_get_monotonic_milliseconds() - start < 2000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(1 == Test_Loop_Uring_Reset_Close);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_URING_BACKOFF_COUNT 4
+
+int Test_Loop_Uring_Backoff_Accepted = 0;
+
+CASE(Test_Loop_Uring_Accept_Backoff) {
+    struct holder {
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            (void)channel;
+            if (e & channel_cb_event_accept) {
+                Test_Loop_Uring_Backoff_Accepted++;
+            }
+        }
+    };
+    kloop_t* loop = knet_loop_create_with_backend(loop_backend_uring);
+    if (!loop) {
+        // 不支持io_uring
+        return;
+    }
+    Test_Loop_Uring_Backoff_Accepted = 0;
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8029, TEST_LOOP_URING_BACKOFF_COUNT));
+    socket_t clients[TEST_LOOP_URING_BACKOFF_COUNT] = {0};
+    for (int i = 0; i < TEST_LOOP_URING_BACKOFF_COUNT; i++) {
+        clients[i] = socket(AF_INET, SOCK_STREAM, 0);
+    }
+    // 描述符耗尽(上限为最小的空闲描述符), 接受连接时返回EMFILE.
+    // accept请求在提交时记录描述符上限, 需要在第一次提交前修改
+    int free_fd = dup(0);
+    close(free_fd);
+    struct rlimit old_limit;
+    struct rlimit new_limit;
+    getrlimit(RLIMIT_NOFILE, &old_limit);
+    new_limit          = old_limit;
+    new_limit.rlim_cur = (rlim_t)free_fd;
+    setrlimit(RLIMIT_NOFILE, &new_limit);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(8029);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    for (int i = 0; i < TEST_LOOP_URING_BACKOFF_COUNT; i++) {
+        connect(clients[i], (struct sockaddr*)&addr, sizeof(addr));
+    }
+    int      count = 0;
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (time_get_monotonic_milliseconds() - start < 300) {
+        knet_loop_run_once(loop);
+        count++;
+    }
+    setrlimit(RLIMIT_NOFILE, &old_limit);
+    // 失败的请求不会立即重新提交, 每次迭代都等待(调用者驱动的loop最多等待1毫秒)而不是忙循环
+    EXPECT_TRUE(0 == Test_Loop_Uring_Backoff_Accepted);
+    EXPECT_TRUE(count < 1000);
+    // 描述符恢复后延迟重新提交的请求接受所有等待的连接
+    start = time_get_monotonic_milliseconds();
+    while ((Test_Loop_Uring_Backoff_Accepted < TEST_LOOP_URING_BACKOFF_COUNT) &&
+        (time_get_monotonic_milliseconds() - start < 2000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(TEST_LOOP_URING_BACKOFF_COUNT == Test_Loop_Uring_Backoff_Accepted);
+    for (int i = 0; i < TEST_LOOP_URING_BACKOFF_COUNT; i++) {
+        close(clients[i]);
+    }
+    knet_loop_destroy(loop);
+}
+#endif // WIN32
+
+CASE(Test_Loop_Cached_Time) {
+    kloop_t* loop = knet_loop_create();
+    uint64_t ts = knet_loop_get_time(loop);
+    thread_sleep_ms(20);
+    // 迭代之间不读取时钟
+    EXPECT_TRUE(ts == knet_loop_get_time(loop));
+    knet_loop_run_once(loop);
+    EXPECT_TRUE(knet_loop_get_time(loop) >= ts + 20);
+    // 时间戳来自单调时钟
+    EXPECT_TRUE(knet_loop_get_time(loop) <= time_get_monotonic_milliseconds());
+    // 迭代之外发起连接, 超时时间从当前时间而不是缓存的时间戳计算
+    ts = knet_loop_get_time(loop);
+    thread_sleep_ms(20);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8020, 1);
+    EXPECT_TRUE(knet_loop_get_time(loop) >= ts + 20);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_READ_BUDGET 1024
+#define TEST_LOOP_READ_BYTES  (TEST_LOOP_READ_BUDGET * 32)
+
+int Test_Loop_Read_Budget_Bytes = 0;
+int Test_Loop_Read_Budget_Max   = 0;
+
+CASE(Test_Loop_Read_Budget) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_LOOP_READ_BYTES];
+            if (e & channel_cb_event_connect) {
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_LOOP_READ_BYTES];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int bytes = knet_stream_available(stream);
+                if (bytes > Test_Loop_Read_Budget_Max) {
+                    Test_Loop_Read_Budget_Max = bytes;
+                }
+                Test_Loop_Read_Budget_Bytes += bytes;
+                knet_stream_pop(stream, buffer, bytes);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    EXPECT_TRUE(LOOP_DEFAULT_READ_BUDGET == knet_loop_get_read_budget(loop));
+    knet_loop_set_read_budget(loop, -1);
+    EXPECT_TRUE(0 == knet_loop_get_read_budget(loop));
+    // 每次事件最多读取1024字节, 剩余的数据在后续循环内读取, 不需要新的事件通知
+    knet_loop_set_read_budget(loop, TEST_LOOP_READ_BUDGET);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, TEST_LOOP_READ_BYTES * 2);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8004, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8004, 1);
+    for (int i = 0; i < 5000; i++) {
+        if (Test_Loop_Read_Budget_Bytes == TEST_LOOP_READ_BYTES) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Loop_Read_Budget_Bytes == TEST_LOOP_READ_BYTES);
+    EXPECT_TRUE(Test_Loop_Read_Budget_Max <= TEST_LOOP_READ_BUDGET);
+    knet_loop_destroy(loop);
+}
@@ -113,3 +113,406 @@ CASE(Test_Loop_Profile_Dump_Stream) {
     EXPECT_TRUE(Test_Loop_Profile_Client_Count == Test_Loop_Profile_i);
     knet_loop_destroy(loop);
 }
+
+int Test_Loop_Profile_Echo_Count = 0;
+
+CASE(Test_Loop_Profile_Impl_Ctl_Count) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[8] = {0};
+            if (e & channel_cb_event_connect) {
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            } else if (e & channel_cb_event_recv) {
+                knet_stream_pop(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                if (++Test_Loop_Profile_Echo_Count == 100) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                } else {
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[8] = {0};
+            if (e & channel_cb_event_recv) {
+                knet_stream_pop(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Loop_Profile_Echo_Count = 0;
+    // impl_ctl_count只统计epoll_ctl, 显式使用epoll选取器
+    kloop_t* loop = knet_loop_create_with_backend(loop_backend_epoll);
+    if (!loop) {
+        return;
+    }
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_accept(acceptor, 0, 8000, 10);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, 0, 8000, 0);
+    knet_loop_run(loop);
+    EXPECT_TRUE(100 == Test_Loop_Profile_Echo_Count);
+    // 200次读事件, 事件掩码未改变时不再调用epoll_ctl
+    EXPECT_TRUE(knet_loop_profile_get_impl_ctl_count(knet_loop_get_profile(loop)) < 20);
+    knet_loop_destroy(loop);
+}
+
+#ifndef WIN32
+#include <sys/socket.h>
+
+#define TEST_LOOP_PROFILE_SEND_CHUNK (64 * 1024)
+#define TEST_LOOP_PROFILE_SEND_COUNT 256
+
+kchannel_ref_t* Test_Loop_Profile_Send_Connector = 0;
+int             Test_Loop_Profile_Send_Pushed    = 0;
+int             Test_Loop_Profile_Send_Bytes     = 0;
+
+CASE(Test_Loop_Profile_Impl_Ctl_Count_Send) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            int size = 16 * 1024;
+            if (e & channel_cb_event_connect) {
+                // 减小发送缓冲区, 发送方不断遇到套接字不可写
+                setsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_SNDBUF, (char*)&size, sizeof(size));
+                Test_Loop_Profile_Send_Connector = channel;
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Loop_Profile_Send_Bytes += (int)knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    static char buffer[TEST_LOOP_PROFILE_SEND_CHUNK];
+    Test_Loop_Profile_Send_Connector = 0;
+    Test_Loop_Profile_Send_Pushed    = 0;
+    Test_Loop_Profile_Send_Bytes     = 0;
+    kloop_t* loop = knet_loop_create_with_backend(loop_backend_epoll);
+    if (!loop) {
+        return;
+    }
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 1024 * 4);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8026, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 16, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8026, 1);
+    uint64_t ctl   = 0;
+    uint64_t start = time_get_monotonic_milliseconds();
+    while ((Test_Loop_Profile_Send_Bytes < TEST_LOOP_PROFILE_SEND_CHUNK * TEST_LOOP_PROFILE_SEND_COUNT) &&
+        (time_get_monotonic_milliseconds() - start < 10000)) {
+        if (Test_Loop_Profile_Send_Connector && (Test_Loop_Profile_Send_Pushed < TEST_LOOP_PROFILE_SEND_COUNT) &&
+            (knet_channel_ref_get_send_bytes(Test_Loop_Profile_Send_Connector) < TEST_LOOP_PROFILE_SEND_CHUNK * 8)) {
+            if (!Test_Loop_Profile_Send_Pushed) {
+                // 连接建立之后的epoll_ctl调用
+                ctl = knet_loop_profile_get_impl_ctl_count(profile);
+            }
+            knet_stream_push(knet_channel_ref_get_stream(Test_Loop_Profile_Send_Connector), buffer, sizeof(buffer));
+            Test_Loop_Profile_Send_Pushed++;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(TEST_LOOP_PROFILE_SEND_CHUNK * TEST_LOOP_PROFILE_SEND_COUNT == Test_Loop_Profile_Send_Bytes);
+    ctl = knet_loop_profile_get_impl_ctl_count(profile) - ctl;
+    // 写事件已注册时不再调用epoll_ctl, 只在发送链表清空和重新出现不可写时各调用一次
+    EXPECT_TRUE(ctl < TEST_LOOP_PROFILE_SEND_COUNT);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_PROFILE_DUPLEX_COUNT 128
+
+kchannel_ref_t* Test_Loop_Profile_Duplex_Connector = 0;
+int             Test_Loop_Profile_Duplex_Pushed    = 0;
+int             Test_Loop_Profile_Duplex_Bytes     = 0;
+
+CASE(Test_Loop_Profile_Epoll_Duplex) {
+    struct holder {
+        static void shrink(kchannel_ref_t* channel) {
+            int size = 16 * 1024;
+            setsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_SNDBUF, (char*)&size, sizeof(size));
+            setsockopt(knet_channel_ref_get_socket_fd(channel), SOL_SOCKET, SO_RCVBUF, (char*)&size, sizeof(size));
+        }
+
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                // 两端都减小套接字缓冲区, 读写事件经常同时到达
+                shrink(channel);
+                Test_Loop_Profile_Duplex_Connector = channel;
+            } else if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Loop_Profile_Duplex_Bytes += (int)knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[TEST_LOOP_PROFILE_SEND_CHUNK];
+            if (e & channel_cb_event_recv) {
+                // 接收的同时回送, 两个方向同时有大量数据
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int size = (int)knet_stream_available(stream);
+                while (size > 0) {
+                    if (size > (int)sizeof(buffer)) {
+                        size = (int)sizeof(buffer);
+                    }
+                    knet_stream_pop(stream, buffer, size);
+                    knet_stream_push(stream, buffer, size);
+                    size = (int)knet_stream_available(stream);
+                }
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                shrink(channel);
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    static char buffer[TEST_LOOP_PROFILE_SEND_CHUNK];
+    Test_Loop_Profile_Duplex_Connector = 0;
+    Test_Loop_Profile_Duplex_Pushed    = 0;
+    Test_Loop_Profile_Duplex_Bytes     = 0;
+    kloop_t* loop = knet_loop_create_with_backend(loop_backend_epoll);
+    if (!loop) {
+        return;
+    }
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1024, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8028, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 16, 1024 * 64);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8028, 1);
+    uint64_t start = time_get_monotonic_milliseconds();
+    while ((Test_Loop_Profile_Duplex_Bytes < TEST_LOOP_PROFILE_SEND_CHUNK * TEST_LOOP_PROFILE_DUPLEX_COUNT) &&
+        (time_get_monotonic_milliseconds() - start < 10000)) {
+        if (Test_Loop_Profile_Duplex_Connector && (Test_Loop_Profile_Duplex_Pushed < TEST_LOOP_PROFILE_DUPLEX_COUNT) &&
+            (knet_channel_ref_get_send_bytes(Test_Loop_Profile_Duplex_Connector) < TEST_LOOP_PROFILE_SEND_CHUNK * 8)) {
+            knet_stream_push(knet_channel_ref_get_stream(Test_Loop_Profile_Duplex_Connector), buffer, sizeof(buffer));
+            Test_Loop_Profile_Duplex_Pushed++;
+        }
+        knet_loop_run_once(loop);
+    }
+    // 同时到达的读写事件都被处理, 写事件不会因为事件掩码未改变而丢失
+    EXPECT_TRUE(TEST_LOOP_PROFILE_DUPLEX_COUNT == Test_Loop_Profile_Duplex_Pushed);
+    EXPECT_TRUE(TEST_LOOP_PROFILE_SEND_CHUNK * TEST_LOOP_PROFILE_DUPLEX_COUNT == Test_Loop_Profile_Duplex_Bytes);
+    knet_loop_destroy(loop);
+}
+#endif // WIN32
+
+int Test_Loop_Profile_Notify_Echo = 0;
+
+CASE(Test_Loop_Profile_Exclude_Notify_Channel) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[8] = {0};
+            if (e & channel_cb_event_connect) {
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            } else if (e & channel_cb_event_recv) {
+                knet_stream_pop(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                Test_Loop_Profile_Notify_Echo++;
+                knet_channel_ref_close(channel);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[8] = {0};
+            if (e & channel_cb_event_recv) {
+                knet_stream_pop(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    // 每个选取器的内部唤醒机制(eventfd或事件通知管道)都不计入统计数据
+    for (int backend = loop_backend_select; backend <= loop_backend_iocp; backend++) {
+        kloop_t* loop = knet_loop_create_with_backend((knet_loop_backend_e)backend);
+        if (!loop) {
+            continue;
+        }
+        kloop_profile_t* profile = knet_loop_get_profile(loop);
+        EXPECT_TRUE(0 == knet_loop_profile_get_established_channel_count(profile));
+        EXPECT_TRUE(0 == knet_loop_profile_get_active_channel_count(profile));
+        EXPECT_TRUE(0 == knet_loop_get_active_channel_count(loop));
+        kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
+        knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+        knet_channel_ref_accept(acceptor, 0, 8000, 10);
+        EXPECT_TRUE(1 == knet_loop_profile_get_established_channel_count(profile));
+        EXPECT_TRUE(1 == knet_loop_get_active_channel_count(loop));
+        // 一次完整的连接, 回显和关闭, 统计数据同样不包含唤醒机制
+        Test_Loop_Profile_Notify_Echo = 0;
+        kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+        knet_channel_ref_set_cb(connector, &holder::connector_cb);
+        knet_channel_ref_connect(connector, "127.0.0.1", 8000, 1);
+        uint64_t start = time_get_monotonic_milliseconds();
+        while (((knet_loop_get_active_channel_count(loop) > 1) || !Test_Loop_Profile_Notify_Echo) &&
+            (time_get_monotonic_milliseconds() - start < 2000)) {
+            knet_loop_run_once(loop);
+        }
+        EXPECT_TRUE(1 == Test_Loop_Profile_Notify_Echo);
+        EXPECT_TRUE(16 == knet_loop_profile_get_sent_bytes(profile));
+        EXPECT_TRUE(16 == knet_loop_profile_get_recv_bytes(profile));
+        EXPECT_TRUE(1 == knet_loop_profile_get_established_channel_count(profile));
+        EXPECT_TRUE(1 == knet_loop_get_active_channel_count(loop));
+        knet_loop_destroy(loop);
+    }
+}
+
+#define TEST_LOOP_PROFILE_RECV_BYTES (64 * 1024)
+
+int Test_Loop_Profile_Recv_Offset = 0;
+int Test_Loop_Profile_Recv_Error  = 0;
+
+CASE(Test_Loop_Profile_Recv_Syscall) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[1024] = {0};
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_LOOP_PROFILE_RECV_BYTES / (int)sizeof(buffer); i++) {
+                    for (int j = 0; j < (int)sizeof(buffer); j++) {
+                        buffer[j] = (char)((i * (int)sizeof(buffer) + j) % 251);
+                    }
+                    knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            // 每次只取出一部分, 使读缓冲区的写位置不断绕回
+            char buffer[700] = {0};
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                while ((int)knet_stream_available(stream) >= (int)sizeof(buffer) ||
+                    ((int)knet_stream_available(stream) + Test_Loop_Profile_Recv_Offset == TEST_LOOP_PROFILE_RECV_BYTES)) {
+                    int size = (int)knet_stream_available(stream);
+                    if (!size) {
+                        break;
+                    }
+                    if (size > (int)sizeof(buffer)) {
+                        size = (int)sizeof(buffer);
+                    }
+                    knet_stream_pop(stream, buffer, size);
+                    for (int i = 0; i < size; i++) {
+                        if (buffer[i] != (char)((Test_Loop_Profile_Recv_Offset + i) % 251)) {
+                            Test_Loop_Profile_Recv_Error++;
+                        }
+                    }
+                    Test_Loop_Profile_Recv_Offset += size;
+                }
+                if (Test_Loop_Profile_Recv_Offset == TEST_LOOP_PROFILE_RECV_BYTES) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Loop_Profile_Recv_Offset = 0;
+    Test_Loop_Profile_Recv_Error  = 0;
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 128, 1000);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    knet_channel_ref_accept(acceptor, 0, 8011, 10);
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 128, 1000);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, 0, 8011, 0);
+    knet_loop_run(loop);
+    EXPECT_TRUE(TEST_LOOP_PROFILE_RECV_BYTES == Test_Loop_Profile_Recv_Offset);
+    EXPECT_TRUE(0 == Test_Loop_Profile_Recv_Error);
+    EXPECT_TRUE(TEST_LOOP_PROFILE_RECV_BYTES == knet_loop_profile_get_recv_bytes(profile));
+    EXPECT_TRUE(knet_loop_profile_get_recv_syscall_count(profile) > 0);
+    EXPECT_TRUE(knet_loop_profile_get_recv_syscall_per_kb(profile) > 0.0);
+    knet_loop_destroy(loop);
+}
+
+#define TEST_LOOP_PROFILE_WRAP_RING  1000
+#define TEST_LOOP_PROFILE_WRAP_BYTES 700
+
+kchannel_ref_t* Test_Loop_Profile_Wrap_Connector = 0;
+int             Test_Loop_Profile_Wrap_Bytes     = 0;
+
+CASE(Test_Loop_Profile_Recv_Syscall_Wrap) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char buffer[TEST_LOOP_PROFILE_WRAP_BYTES] = {0};
+            if (e & channel_cb_event_connect) {
+                Test_Loop_Profile_Wrap_Connector = channel;
+                knet_stream_push(knet_channel_ref_get_stream(channel), buffer, sizeof(buffer));
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            // 取出数据而不是清空读缓冲区, 读位置不会回到起点
+            char buffer[TEST_LOOP_PROFILE_WRAP_RING] = {0};
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int bytes = (int)knet_stream_available(stream);
+                knet_stream_pop(stream, buffer, bytes);
+                Test_Loop_Profile_Wrap_Bytes += bytes;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Loop_Profile_Wrap_Connector = 0;
+    Test_Loop_Profile_Wrap_Bytes     = 0;
+    kloop_t* loop = knet_loop_create();
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, TEST_LOOP_PROFILE_WRAP_RING);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8025, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8025, 1);
+    uint64_t start = time_get_monotonic_milliseconds();
+    while ((Test_Loop_Profile_Wrap_Bytes < TEST_LOOP_PROFILE_WRAP_BYTES) && (time_get_monotonic_milliseconds() - start < 2000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(TEST_LOOP_PROFILE_WRAP_BYTES == Test_Loop_Profile_Wrap_Bytes);
+    // 第二次写入时读缓冲区的写位置在700, 可写空间分为300和700两段
+    char buffer[TEST_LOOP_PROFILE_WRAP_BYTES] = {0};
+    if (Test_Loop_Profile_Wrap_Connector) {
+        knet_stream_push(knet_channel_ref_get_stream(Test_Loop_Profile_Wrap_Connector), buffer, sizeof(buffer));
+    }
+    start = time_get_monotonic_milliseconds();
+    while ((Test_Loop_Profile_Wrap_Bytes < TEST_LOOP_PROFILE_WRAP_BYTES * 2) && (time_get_monotonic_milliseconds() - start < 2000)) {
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(TEST_LOOP_PROFILE_WRAP_BYTES * 2 == Test_Loop_Profile_Wrap_Bytes);
+    // 逐段接收并读到EAGAIN需要5次系统调用(700+EAGAIN, 300+400+EAGAIN), 两段一次readv()且短读即停止只需要2次
+    EXPECT_TRUE(knet_loop_profile_get_recv_syscall_count(profile) >= 2);
+    EXPECT_TRUE(knet_loop_profile_get_recv_syscall_count(profile) < 5);
+    knet_loop_destroy(loop);
+}
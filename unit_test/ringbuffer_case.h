@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2014-2015, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "helper.h"
+#include "knet.h"
+
+CASE(Test_Ringbuffer_Mirror) {
+    char     data[2000] = {0};
+    char     buffer[2000] = {0};
+    char*    ptr[2];
+    uint32_t size[2];
+    // 小于页长度时使用普通缓冲区
+    kringbuffer_t* rb = ringbuffer_create_mirror(100);
+    EXPECT_TRUE(0 == ringbuffer_check_mirror(rb));
+    EXPECT_TRUE(100 == ringbuffer_get_max_size(rb));
+    ringbuffer_destroy(rb);
+    rb = ringbuffer_create_mirror(5000);
+    if (!ringbuffer_check_mirror(rb)) {
+        // 系统不支持
+        EXPECT_TRUE(5000 == ringbuffer_get_max_size(rb));
+        ringbuffer_destroy(rb);
+        return;
+    }
+    uint32_t max_size = ringbuffer_get_max_size(rb);
+    EXPECT_TRUE(max_size >= 5000);
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (char)(i % 251);
+    }
+    // 读写位置移动到接近末尾
+    char* fill = new char[max_size];
+    EXPECT_TRUE(max_size - 100 == ringbuffer_write(rb, fill, max_size - 100));
+    EXPECT_TRUE(max_size - 200 == ringbuffer_read(rb, fill, max_size - 200));
+    delete[] fill;
+    // 跨越末尾的写入
+    EXPECT_TRUE(sizeof(data) == ringbuffer_write(rb, data, sizeof(data)));
+    EXPECT_TRUE(2100 == ringbuffer_available(rb));
+    // 可读空间是连续的一段
+    EXPECT_TRUE(2100 == ringbuffer_read_segments(rb, ptr, size));
+    EXPECT_TRUE(2100 == size[0]);
+    EXPECT_TRUE(0 == size[1]);
+    EXPECT_TRUE(!memcmp(ptr[0] + 100, data, sizeof(data)));
+    EXPECT_TRUE(2100 == ringbuffer_read_lock_size(rb));
+    ringbuffer_read_unlock(rb);
+    // 可写空间是连续的一段
+    EXPECT_TRUE(max_size - 2100 == ringbuffer_write_lock_segments(rb, ptr, size));
+    EXPECT_TRUE(0 == size[1]);
+    ringbuffer_write_unlock(rb);
+    EXPECT_TRUE(error_ok == ringbuffer_eat(rb, 100));
+    EXPECT_TRUE(sizeof(buffer) == ringbuffer_read(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, data, sizeof(data)));
+    // 不能更换缓冲区
+    char* old = 0;
+    EXPECT_TRUE(error_ringbuffer_mirror == ringbuffer_swap(rb, buffer, sizeof(buffer), &old));
+    ringbuffer_destroy(rb);
+}
+
+CASE(Test_Ringbuffer_Wrap) {
+    char buffer[16] = {0};
+    kringbuffer_t* rb = ringbuffer_create(10);
+    EXPECT_TRUE(7 == ringbuffer_write(rb, "0123456", 7));
+    EXPECT_TRUE(5 == ringbuffer_read(rb, buffer, 5));
+    EXPECT_TRUE(!memcmp(buffer, "01234", 5));
+    // 写入跨越末尾, 超出可写空间的部分被截断
+    EXPECT_TRUE(8 == ringbuffer_write(rb, "abcdefghij", 10));
+    EXPECT_TRUE(10 == ringbuffer_available(rb));
+    EXPECT_TRUE(10 == ringbuffer_copy(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "56abcdefgh", 10));
+    // 跨越末尾的随机读取和替换
+    EXPECT_TRUE(0 == ringbuffer_copy_random(rb, 8, buffer, 4));
+    EXPECT_TRUE(4 == ringbuffer_copy_random(rb, 2, buffer, 4));
+    EXPECT_TRUE(!memcmp(buffer, "abcd", 4));
+    EXPECT_TRUE(4 == ringbuffer_replace(rb, 1, "WXYZ", 4));
+    EXPECT_TRUE(3 == ringbuffer_remove(rb, 3));
+    EXPECT_TRUE(7 == ringbuffer_read(rb, buffer, sizeof(buffer)));
+    EXPECT_TRUE(!memcmp(buffer, "YZdefgh", 7));
+    EXPECT_TRUE(ringbuffer_empty(rb));
+    ringbuffer_destroy(rb);
+}
+
+#define TEST_RINGBUFFER_BENCH_BYTES (1024 * 1024 * 256)
+
+CASE(Test_Ringbuffer_Throughput) {
+    static const uint32_t sizes[] = {64, 1024, 4096, 16384, 65536};
+    // 最大长度不是消息长度的整数倍, 读写位置会跨越末尾
+    kringbuffer_t* rb     = ringbuffer_create(100000);
+    char*          data   = new char[65536];
+    char*          buffer = new char[65536];
+    for (int i = 0; i < 65536; i++) {
+        data[i] = (char)(i % 251);
+    }
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        uint32_t size   = sizes[i];
+        uint32_t times  = TEST_RINGBUFFER_BENCH_BYTES / size;
+        int      errors = 0;
+        uint64_t start  = time_get_monotonic_milliseconds();
+        for (uint32_t j = 0; j < times; j++) {
+            ringbuffer_write(rb, data, size);
+            ringbuffer_copy_random(rb, 0, buffer, size);
+            if (size != ringbuffer_read(rb, buffer, size)) {
+                errors++;
+            }
+        }
+        uint64_t elapsed = time_get_monotonic_milliseconds() - start;
+        EXPECT_TRUE(0 == errors);
+        EXPECT_TRUE(!memcmp(buffer, data, size));
+        // 每次消息经过一次写入和两次读出
+        std::cout << "ringbuffer " << size << " bytes: "
+                  << (uint64_t)TEST_RINGBUFFER_BENCH_BYTES / 1024 / 1024 * 1000 / (elapsed ? elapsed : 1)
+                  << " MB/s" << std::endl;
+    }
+    delete[] data;
+    delete[] buffer;
+    ringbuffer_destroy(rb);
+}
@@ -34,11 +34,11 @@ CASE(Test_Stream_Push_Stream) {
     struct holder {
         static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {            
             if (e & channel_cb_event_recv) {
-                // һյ
+                // 第一个连接器收到服务器发来的数据
                 if (channel == Test_Stream_Push_Stream_Connector1) {
                     kstream_t* stream1 = knet_channel_ref_get_stream(channel);
                     kstream_t* stream2 = knet_channel_ref_get_stream(Test_Stream_Push_Stream_Connector2);
-                    // һͻ˵дڶclient_cbص
+                    // 将服务器第一个客户端的数据写入第二个连接器，将触发client_cb回调
                     EXPECT_TRUE(error_ok == knet_stream_push_stream(stream1, stream2));
                 }
             }
@@ -48,7 +48,7 @@ CASE(Test_Stream_Push_Stream) {
             if (e & channel_cb_event_recv) {
                 if (channel == Test_Stream_Push_Stream_Client2) {
                     kstream_t* stream = knet_channel_ref_get_stream(channel);
-                    // յknet_stream_push_stream
+                    // 收到由knet_stream_push_stream发来的数据
                     EXPECT_TRUE(error_ok == knet_stream_eat(stream, 4));
                     EXPECT_FALSE(knet_stream_available(stream));
                     knet_loop_exit(knet_channel_ref_get_loop(channel));
@@ -64,9 +64,9 @@ CASE(Test_Stream_Push_Stream) {
                     Test_Stream_Push_Stream_Client1 = channel;
                 }
                 knet_channel_ref_set_cb(channel, client_cb);
-                // ͻ˶Ѿӳɹ
+                // 两个客户端都已经连接成功
                 if (Test_Stream_Push_Stream_Client1 && Test_Stream_Push_Stream_Client2) {
-                    // һͻд4ֽ
+                    // 向第一个客户端写入4个字节
                     kstream_t* stream = knet_channel_ref_get_stream(Test_Stream_Push_Stream_Client1);
                     EXPECT_TRUE(error_ok == knet_stream_push(stream, "123", 4));
                 }
@@ -81,8 +81,8 @@ CASE(Test_Stream_Push_Stream) {
     kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024);
     knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
     knet_channel_ref_accept(acceptor, "127.0.0.1", 8000, 1);
-    // ͻ
-    // õһ¼ص
+    // 启动两个客户端
+    // 设置第一个连接器事件回调
     knet_channel_ref_set_cb(Test_Stream_Push_Stream_Connector1, &holder::connector_cb);
     knet_channel_ref_connect(Test_Stream_Push_Stream_Connector1, "127.0.0.1", 8000, 1);
     knet_channel_ref_connect(Test_Stream_Push_Stream_Connector2, "127.0.0.1", 8000, 1);
@@ -100,11 +100,11 @@ CASE(Test_Stream_Copy_Stream) {
     struct holder {
         static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {            
             if (e & channel_cb_event_recv) {
-                // һյ
+                // 第一个连接器收到服务器发来的数据
                 if (channel == Test_Stream_Copy_Stream_Connector1) {
                     kstream_t* stream1 = knet_channel_ref_get_stream(channel);
                     kstream_t* stream2 = knet_channel_ref_get_stream(Test_Stream_Copy_Stream_Connector2);
-                    // һͻ˵дڶclient_cbص
+                    // 将服务器第一个客户端的数据写入第二个连接器，将触发client_cb回调
                     EXPECT_TRUE(error_ok == knet_stream_copy_stream(stream1, stream2));
                     EXPECT_TRUE(4 == knet_stream_available(stream1));
                 }
@@ -115,7 +115,7 @@ CASE(Test_Stream_Copy_Stream) {
             if (e & channel_cb_event_recv) {
                 if (channel == Test_Stream_Copy_Stream_Client2) {
                     kstream_t* stream = knet_channel_ref_get_stream(channel);
-                    // յknet_stream_copy_stream
+                    // 收到由knet_stream_copy_stream发来的数据
                     EXPECT_TRUE(error_ok == knet_stream_eat(stream, 4));
                     EXPECT_FALSE(knet_stream_available(stream));
                     knet_loop_exit(knet_channel_ref_get_loop(channel));
@@ -131,9 +131,9 @@ CASE(Test_Stream_Copy_Stream) {
                     Test_Stream_Copy_Stream_Client1 = channel;
                 }
                 knet_channel_ref_set_cb(channel, client_cb);
-                // ͻ˶Ѿӳɹ
+                // 两个客户端都已经连接成功
                 if (Test_Stream_Copy_Stream_Client1 && Test_Stream_Copy_Stream_Client2) {
-                    // һͻд4ֽ
+                    // 向第一个客户端写入4个字节
                     kstream_t* stream = knet_channel_ref_get_stream(Test_Stream_Copy_Stream_Client1);
                     EXPECT_TRUE(error_ok == knet_stream_push(stream, "123", 4));
                 }
@@ -149,8 +149,8 @@ CASE(Test_Stream_Copy_Stream) {
     knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
     knet_channel_ref_accept(acceptor, "127.0.0.1", 8000, 1);
 
-    // ͻ
-    // õһ¼ص
+    // 启动两个客户端
+    // 设置第一个连接器事件回调
     knet_channel_ref_set_cb(Test_Stream_Copy_Stream_Connector1, &holder::connector_cb);
     knet_channel_ref_connect(Test_Stream_Copy_Stream_Connector1, "127.0.0.1", 8000, 1);
     knet_channel_ref_connect(Test_Stream_Copy_Stream_Connector2, "127.0.0.1", 8000, 1);
@@ -158,3 +158,326 @@ CASE(Test_Stream_Copy_Stream) {
     knet_loop_run(loop);
     knet_loop_destroy(loop);
 }
+
+#define TEST_STREAM_PUSH_OWNED_BYTES (1024 * 1024)
+
+int   Test_Stream_Push_Owned_Bytes = 0;
+int   Test_Stream_Push_Owned_Error = 0;
+int   Test_Stream_Push_Owned_Free  = 0;
+void* Test_Stream_Push_Owned_Ptr   = 0;
+
+CASE(Test_Stream_Push_Owned) {
+    struct holder {
+        static void free_cb(void* buffer) {
+            if (buffer == Test_Stream_Push_Owned_Ptr) {
+                Test_Stream_Push_Owned_Free++;
+            }
+            free(buffer);
+        }
+
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                Test_Stream_Push_Owned_Ptr = malloc(TEST_STREAM_PUSH_OWNED_BYTES);
+                memset(Test_Stream_Push_Owned_Ptr, 'a', TEST_STREAM_PUSH_OWNED_BYTES);
+                // 缓冲区直接放入发送链表, 发送完毕后才会调用free_cb
+                EXPECT_TRUE(error_ok == knet_stream_push_owned(knet_channel_ref_get_stream(channel),
+                    Test_Stream_Push_Owned_Ptr, TEST_STREAM_PUSH_OWNED_BYTES, &holder::free_cb));
+                // 未发送的字节数不能超过写入的字节数
+                if (knet_channel_ref_get_send_bytes(channel) > TEST_STREAM_PUSH_OWNED_BYTES) {
+                    Test_Stream_Push_Owned_Error++;
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Stream_Push_Owned_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8006, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    // 未连接时写入失败, 缓冲区同样被释放
+    Test_Stream_Push_Owned_Ptr = malloc(16);
+    EXPECT_TRUE(error_ok != knet_stream_push_owned(knet_channel_ref_get_stream(connector),
+        Test_Stream_Push_Owned_Ptr, 16, &holder::free_cb));
+    EXPECT_TRUE(1 == Test_Stream_Push_Owned_Free);
+    Test_Stream_Push_Owned_Free = 0;
+    knet_channel_ref_connect(connector, "127.0.0.1", 8006, 1);
+    for (int i = 0; i < 50000; i++) {
+        if (Test_Stream_Push_Owned_Bytes == TEST_STREAM_PUSH_OWNED_BYTES) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    EXPECT_TRUE(Test_Stream_Push_Owned_Bytes == TEST_STREAM_PUSH_OWNED_BYTES);
+    EXPECT_TRUE(1 == Test_Stream_Push_Owned_Free);
+    EXPECT_TRUE(0 == Test_Stream_Push_Owned_Error);
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    // 其他线程写入, 缓冲区经由跨线程事件放入发送链表
+    kthread_runner_t* runner = thread_runner_create(0, 0);
+    thread_runner_start_loop(runner, loop, 0);
+    Test_Stream_Push_Owned_Ptr = malloc(TEST_STREAM_PUSH_OWNED_BYTES);
+    memset(Test_Stream_Push_Owned_Ptr, 'b', TEST_STREAM_PUSH_OWNED_BYTES);
+    EXPECT_TRUE(error_ok == knet_stream_push_owned(knet_channel_ref_get_stream(connector),
+        Test_Stream_Push_Owned_Ptr, TEST_STREAM_PUSH_OWNED_BYTES, &holder::free_cb));
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (time_get_monotonic_milliseconds() - start < 5000) {
+        if (Test_Stream_Push_Owned_Bytes == TEST_STREAM_PUSH_OWNED_BYTES * 2) {
+            break;
+        }
+        thread_sleep_ms(1);
+    }
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(Test_Stream_Push_Owned_Bytes == TEST_STREAM_PUSH_OWNED_BYTES * 2);
+    EXPECT_TRUE(2 == Test_Stream_Push_Owned_Free);
+    EXPECT_TRUE(0 == knet_channel_ref_get_send_bytes(connector));
+    knet_loop_destroy(loop);
+}
+
+#define TEST_STREAM_ZEROCOPY_COUNT 4
+
+int Test_Stream_Push_Owned_Zerocopy_Bytes = 0;
+int Test_Stream_Push_Owned_Zerocopy_Free  = 0;
+
+CASE(Test_Stream_Push_Owned_Zerocopy) {
+    struct holder {
+        static void free_cb(void* buffer) {
+            Test_Stream_Push_Owned_Zerocopy_Free++;
+            // 释放前改写内容, 如果在内核通知完成之前释放, 接收方会收到被改写的数据
+            memset(buffer, 'z', TEST_STREAM_PUSH_OWNED_BYTES);
+            free(buffer);
+        }
+
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_STREAM_ZEROCOPY_COUNT; i++) {
+                    void* buffer = malloc(TEST_STREAM_PUSH_OWNED_BYTES);
+                    memset(buffer, 'a' + i, TEST_STREAM_PUSH_OWNED_BYTES);
+                    EXPECT_TRUE(error_ok == knet_stream_push_owned(knet_channel_ref_get_stream(channel),
+                        buffer, TEST_STREAM_PUSH_OWNED_BYTES, &holder::free_cb));
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            static char buffer[1024 * 64];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                int bytes = knet_stream_available(stream);
+                knet_stream_pop(stream, buffer, bytes);
+                // 数据按写入顺序到达
+                for (int i = 0; i < bytes; i++) {
+                    int offset = Test_Stream_Push_Owned_Zerocopy_Bytes + i;
+                    EXPECT_TRUE(buffer[i] == 'a' + offset / TEST_STREAM_PUSH_OWNED_BYTES);
+                }
+                Test_Stream_Push_Owned_Zerocopy_Bytes += bytes;
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    EXPECT_TRUE(0 == knet_loop_get_zerocopy_threshold(loop));
+    knet_loop_set_zerocopy_threshold(loop, 16384);
+    EXPECT_TRUE(16384 == knet_loop_get_zerocopy_threshold(loop));
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8007, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, TEST_STREAM_ZEROCOPY_COUNT, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8007, 1);
+    for (int i = 0; i < 50000; i++) {
+        // 缓冲区在内核通知完成后才释放
+        if ((Test_Stream_Push_Owned_Zerocopy_Free == TEST_STREAM_ZEROCOPY_COUNT) &&
+            (Test_Stream_Push_Owned_Zerocopy_Bytes == TEST_STREAM_PUSH_OWNED_BYTES * TEST_STREAM_ZEROCOPY_COUNT)) {
+            break;
+        }
+        knet_loop_run_once(loop);
+    }
+    kloop_profile_t* profile = knet_loop_get_profile(loop);
+    EXPECT_TRUE(Test_Stream_Push_Owned_Zerocopy_Bytes == TEST_STREAM_PUSH_OWNED_BYTES * TEST_STREAM_ZEROCOPY_COUNT);
+    EXPECT_TRUE(Test_Stream_Push_Owned_Zerocopy_Free == TEST_STREAM_ZEROCOPY_COUNT);
+    // 不支持MSG_ZEROCOPY的系统上发送次数为0
+    EXPECT_TRUE(knet_loop_profile_get_zerocopy_send_count(profile) == knet_loop_profile_get_zerocopy_complete_count(profile));
+    knet_loop_destroy(loop);
+}
+
+#define TEST_STREAM_PEEK_FRAMES 500
+
+int Test_Stream_Peek_Frames = 0;
+int Test_Stream_Peek_Error  = 0;
+int Test_Stream_Peek_Wrap   = 0;
+
+CASE(Test_Stream_Peek_Iov) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            unsigned char frame[256] = {0};
+            if (e & channel_cb_event_connect) {
+                // 帧格式: 1字节长度 + 内容, 内容的每个字节为帧序号
+                for (int i = 0; i < TEST_STREAM_PEEK_FRAMES; i++) {
+                    frame[0] = (unsigned char)(i % 200 + 20);
+                    memset(frame + 1, i % 256, frame[0]);
+                    knet_stream_push(knet_channel_ref_get_stream(channel), frame, frame[0] + 1);
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            char            buffer[256] = {0};
+            kstream_iovec_t iov[2];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                for (;;) {
+                    int available = knet_stream_peek_iov(stream, iov);
+                    if ((int)(iov[0].iov_len + iov[1].iov_len) != available) {
+                        Test_Stream_Peek_Error++;
+                    }
+                    if (iov[1].iov_len) {
+                        Test_Stream_Peek_Wrap++;
+                    }
+                    if (!available) {
+                        break;
+                    }
+                    // 长度就是第一段的第一个字节, 不需要拷贝
+                    int size = *(unsigned char*)iov[0].iov_base;
+                    if (available < size + 1) {
+                        break;
+                    }
+                    const unsigned char* frame = (const unsigned char*)knet_stream_peek(stream, buffer, size + 1);
+                    if (!frame) {
+                        Test_Stream_Peek_Error++;
+                        break;
+                    }
+                    for (int i = 1; i <= size; i++) {
+                        if (frame[i] != (unsigned char)(Test_Stream_Peek_Frames % 256)) {
+                            Test_Stream_Peek_Error++;
+                            break;
+                        }
+                    }
+                    EXPECT_TRUE(error_ok == knet_stream_consume(stream, size + 1));
+                    Test_Stream_Peek_Frames++;
+                }
+                if (Test_Stream_Peek_Frames == TEST_STREAM_PEEK_FRAMES) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Stream_Peek_Frames = 0;
+    Test_Stream_Peek_Error  = 0;
+    Test_Stream_Peek_Wrap   = 0;
+    kloop_t* loop = knet_loop_create();
+    // 读缓冲区长度不是帧长度的整数倍, 帧会跨越绕回点
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1000);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8012, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1024, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8012, 1);
+    knet_loop_run(loop);
+    EXPECT_TRUE(TEST_STREAM_PEEK_FRAMES == Test_Stream_Peek_Frames);
+    EXPECT_TRUE(0 == Test_Stream_Peek_Error);
+    EXPECT_TRUE(Test_Stream_Peek_Wrap > 0);
+    // 可读字节不足时返回0
+    char buffer[8] = {0};
+    EXPECT_TRUE(0 == knet_stream_peek(knet_channel_ref_get_stream(connector), buffer, sizeof(buffer)));
+    knet_loop_destroy(loop);
+}
+
+CASE(Test_Stream_Peek_Iov_Mirror) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            unsigned char frame[256] = {0};
+            if (e & channel_cb_event_connect) {
+                for (int i = 0; i < TEST_STREAM_PEEK_FRAMES; i++) {
+                    frame[0] = (unsigned char)(i % 200 + 20);
+                    memset(frame + 1, i % 256, frame[0]);
+                    knet_stream_push(knet_channel_ref_get_stream(channel), frame, frame[0] + 1);
+                }
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            kstream_iovec_t iov[2];
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                for (;;) {
+                    int available = knet_stream_peek_iov(stream, iov);
+                    if (iov[1].iov_len) {
+                        Test_Stream_Peek_Wrap++;
+                    }
+                    if (!available) {
+                        break;
+                    }
+                    // 帧总是在第一段内, 直接解析
+                    const unsigned char* frame = (const unsigned char*)iov[0].iov_base;
+                    int size = frame[0];
+                    if (available < size + 1) {
+                        break;
+                    }
+                    for (int i = 1; i <= size; i++) {
+                        if (frame[i] != (unsigned char)(Test_Stream_Peek_Frames % 256)) {
+                            Test_Stream_Peek_Error++;
+                            break;
+                        }
+                    }
+                    EXPECT_TRUE(error_ok == knet_stream_consume(stream, size + 1));
+                    Test_Stream_Peek_Frames++;
+                }
+                if (Test_Stream_Peek_Frames == TEST_STREAM_PEEK_FRAMES) {
+                    knet_loop_exit(knet_channel_ref_get_loop(channel));
+                }
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+    Test_Stream_Peek_Frames = 0;
+    Test_Stream_Peek_Error  = 0;
+    Test_Stream_Peek_Wrap   = 0;
+    kloop_t* loop = knet_loop_create();
+    EXPECT_TRUE(0 == knet_loop_get_recv_buffer_mirror(loop));
+    knet_loop_set_recv_buffer_mirror(loop, 1);
+    EXPECT_TRUE(0 != knet_loop_get_recv_buffer_mirror(loop));
+    // 读缓冲区双重映射, 跨越末尾的帧仍然是连续的一段
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 5000);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8018, 1));
+    kchannel_ref_t* connector = knet_loop_create_channel(loop, 1024, 1024);
+    knet_channel_ref_set_cb(connector, &holder::connector_cb);
+    knet_channel_ref_connect(connector, "127.0.0.1", 8018, 1);
+    knet_loop_run(loop);
+    EXPECT_TRUE(TEST_STREAM_PEEK_FRAMES == Test_Stream_Peek_Frames);
+    EXPECT_TRUE(0 == Test_Stream_Peek_Error);
+    EXPECT_TRUE(0 == Test_Stream_Peek_Wrap);
+    knet_loop_destroy(loop);
+}
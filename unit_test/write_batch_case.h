@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2014-2015, dennis wang
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "helper.h"
+#include "knet.h"
+
+#define TEST_WRITE_BATCH_CHANNELS 4
+#define TEST_WRITE_BATCH_TIMES    100
+
+kchannel_ref_t*  Test_Write_Batch_Connector[TEST_WRITE_BATCH_CHANNELS] = {0};
+atomic_counter_t Test_Write_Batch_Connected = 0;
+int              Test_Write_Batch_Bytes     = 0;
+
+CASE(Test_Write_Batch) {
+    struct holder {
+        static void connector_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_connect) {
+                atomic_counter_inc(&Test_Write_Batch_Connected);
+            }
+        }
+
+        static void client_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_recv) {
+                kstream_t* stream = knet_channel_ref_get_stream(channel);
+                Test_Write_Batch_Bytes += knet_stream_available(stream);
+                knet_stream_eat_all(stream);
+            }
+        }
+
+        static void acceptor_cb(kchannel_ref_t* channel, knet_channel_cb_event_e e) {
+            if (e & channel_cb_event_accept) {
+                knet_channel_ref_set_cb(channel, &holder::client_cb);
+            }
+        }
+    };
+
+    kloop_t* loop = knet_loop_create();
+    kloop_t* other_loop = knet_loop_create();
+    kchannel_ref_t* acceptor = knet_loop_create_channel(loop, 1, 1024 * 64);
+    knet_channel_ref_set_cb(acceptor, &holder::acceptor_cb);
+    EXPECT_TRUE(error_ok == knet_channel_ref_accept(acceptor, 0, 8017, 10));
+    for (int i = 0; i < TEST_WRITE_BATCH_CHANNELS; i++) {
+        Test_Write_Batch_Connector[i] = knet_loop_create_channel(loop, 1, 1024 * 64);
+        knet_channel_ref_set_cb(Test_Write_Batch_Connector[i], &holder::connector_cb);
+        knet_channel_ref_connect(Test_Write_Batch_Connector[i], "127.0.0.1", 8017, 1);
+    }
+    kthread_runner_t* runner = thread_runner_create(0, 0);
+    thread_runner_start_loop(runner, loop, 0);
+    while (Test_Write_Batch_Connected < TEST_WRITE_BATCH_CHANNELS) {
+        thread_sleep_ms(1);
+    }
+    // 其他kloop_t的管道不能加入批次
+    kchannel_ref_t* other = knet_loop_create_channel(other_loop, 1, 1024);
+    kwrite_batch_t* batch = knet_write_batch_begin(loop);
+    EXPECT_TRUE(error_invalid_channel == knet_write_batch_write(batch, other, "1234", 4));
+    EXPECT_TRUE(0 == knet_write_batch_get_count(batch));
+    // 放弃的批次不发送任何数据
+    EXPECT_TRUE(error_ok == knet_write_batch_write(batch, Test_Write_Batch_Connector[0], "1234", 4));
+    EXPECT_TRUE(1 == knet_write_batch_get_count(batch));
+    knet_write_batch_cancel(batch);
+    // 大量小消息作为一个事件提交
+    batch = knet_write_batch_begin(loop);
+    for (int i = 0; i < TEST_WRITE_BATCH_TIMES; i++) {
+        for (int j = 0; j < TEST_WRITE_BATCH_CHANNELS; j++) {
+            EXPECT_TRUE(error_ok == knet_write_batch_write(batch, Test_Write_Batch_Connector[j], "1234", 4));
+        }
+    }
+    EXPECT_TRUE(TEST_WRITE_BATCH_TIMES * TEST_WRITE_BATCH_CHANNELS == knet_write_batch_get_count(batch));
+    EXPECT_TRUE(error_ok == knet_write_batch_commit(batch));
+    uint64_t start = time_get_monotonic_milliseconds();
+    while (time_get_monotonic_milliseconds() - start < 2000) {
+        if (Test_Write_Batch_Bytes == TEST_WRITE_BATCH_TIMES * TEST_WRITE_BATCH_CHANNELS * 4) {
+            break;
+        }
+        thread_sleep_ms(1);
+    }
+    thread_runner_destroy(runner);
+    EXPECT_TRUE(Test_Write_Batch_Bytes == TEST_WRITE_BATCH_TIMES * TEST_WRITE_BATCH_CHANNELS * 4);
+    knet_channel_ref_close(other);
+    knet_loop_destroy(other_loop);
+    knet_loop_destroy(loop);
+}